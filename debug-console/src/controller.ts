@@ -2,6 +2,8 @@ import { EventBus } from './eventBus';
 import { BleMidiConnection } from './bleMidi';
 import { SerialConnection } from './serial';
 import { Logger } from './logger';
+import { ProfilerMonitor } from './profiler';
+import { TelemetryStore } from './telemetry';
 import type { AppSettings } from './types';
 import { DEFAULT_SETTINGS } from './types';
 
@@ -9,6 +11,8 @@ export class MidiController {
   private bleMidi: BleMidiConnection;
   private serial: SerialConnection;
   private logger: Logger;
+  private profiler: ProfilerMonitor;
+  private telemetry: TelemetryStore;
   private eventBus: EventBus;
   private settings: AppSettings;
   
@@ -29,6 +33,8 @@ export class MidiController {
       maxEntries: this.settings.logMaxEntries,
       showDelta: this.settings.showDeltaTimes,
     });
+    this.profiler = new ProfilerMonitor(eventBus);
+    this.telemetry = new TelemetryStore(eventBus);
 
     // Initialize knob values
     Object.entries(this.settings.ccMapping).forEach(([name, cc]) => {
@@ -61,6 +67,11 @@ export class MidiController {
     return this.serial.connected;
   }
 
+  // Serial CLI (firmware built with DEBUG_ENABLED)
+  async sendSerialCommand(command: string): Promise<void> {
+    await this.serial.sendCommand(command);
+  }
+
   // MIDI operations
   async sendNoteOn(note: number, velocity?: number): Promise<void> {
     const vel = velocity ?? (this.accentEnabled && this.settings.accentMode === 'velocity'
@@ -225,6 +236,14 @@ export class MidiController {
     return this.logger;
   }
 
+  getProfiler(): ProfilerMonitor {
+    return this.profiler;
+  }
+
+  getTelemetry(): TelemetryStore {
+    return this.telemetry;
+  }
+
   // Settings
   getSettings(): AppSettings {
     return { ...this.settings };
@@ -27,9 +27,10 @@ export class Logger {
       searchTerm: config.searchTerm || '',
     };
 
-    // Subscribe to event bus
+    // Subscribe to event bus. Telemetry events arrive at clock rate and would
+    // push the text log out of the ring; TelemetryStore keeps them instead.
     this.eventBus.subscribe((entry) => {
-      if (!this.paused) {
+      if (!this.paused && entry.source !== 'TELEMETRY') {
         this.addEntry(entry);
       }
     });
@@ -152,6 +153,8 @@ export class Logger {
         return 'CYD→SER';
       case 'SERIAL_OUT':
         return 'SER→CYD';
+      case 'TELEMETRY':
+        return 'CYD→TEL';
     }
   }
 
@@ -164,6 +167,7 @@ export class Logger {
         return 'midi-in';
       case 'SERIAL_IN':
       case 'SERIAL_OUT':
+      case 'TELEMETRY':
         return 'serial-in';
     }
   }
@@ -4,11 +4,16 @@ import { MidiController } from './controller';
 import { Synth303 } from './synth303';
 import { formatTime, formatDelta, formatMidiMessage } from './types';
 import type { LogEntry } from './types';
+import type { ProfileSnapshot } from './profiler';
+import { TELEMETRY_EVENT_NAMES, TELEMETRY_METRICS, TELEMETRY_PROTOCOL_VERSION, DURATION_EVENTS } from './telemetry';
+import type { TelemetryMetric } from './telemetry';
 
 // Initialize app
 const eventBus = new EventBus();
 const controller = new MidiController(eventBus);
 const logger = controller.getLogger();
+const profiler = controller.getProfiler();
+const telemetry = controller.getTelemetry();
 const synth = new Synth303();
 
 // ============================================================
@@ -45,6 +50,23 @@ const clearLogBtn = $('clear-log');
 const saveLogBtn = $('save-log');
 const logViewer = $('log-viewer');
 
+// Profiler
+const profileLiveCheck = $('profile-live') as HTMLInputElement;
+const profileResetBtn = $('profile-reset');
+const profileTraceBtn = $('profile-trace') as HTMLButtonElement;
+const profileStatus = $('profile-status');
+const profileSections = $('profile-sections');
+const profileTasks = $('profile-tasks');
+
+// Telemetry
+const telemetryStreamCheck = $('telemetry-stream') as HTMLInputElement;
+const telemetryMetricSelect = $('telemetry-metric') as HTMLSelectElement;
+const telemetryClearBtn = $('telemetry-clear');
+const telemetrySaveBtn = $('telemetry-save');
+const telemetryStatus = $('telemetry-status');
+const telemetryTimeline = $('telemetry-timeline') as HTMLCanvasElement;
+const telemetryHistogram = $('telemetry-histogram') as HTMLCanvasElement;
+
 // ============================================================
 // Synth Visualizer Setup
 // ============================================================
@@ -193,6 +215,94 @@ saveLogBtn.addEventListener('click', () => {
   downloadFile('cyd-debug-log.txt', content);
 });
 
+// Profiler controls
+const PROFILE_POLL_MS = 1000;
+const TRACE_MS = 1000;
+let profilePollId: number | undefined;
+
+async function sendProfileCommand(command: string): Promise<void> {
+  if (!controller.isSerialConnected()) {
+    profileStatus.textContent = 'Connect Serial first';
+    return;
+  }
+  try {
+    await controller.sendSerialCommand(command);
+  } catch (error) {
+    profileStatus.textContent = `Send failed: ${error}`;
+  }
+}
+
+profileLiveCheck.addEventListener('change', () => {
+  window.clearInterval(profilePollId);
+  profilePollId = undefined;
+  if (profileLiveCheck.checked) {
+    sendProfileCommand('PROFILE');
+    profilePollId = window.setInterval(() => sendProfileCommand('PROFILE'), PROFILE_POLL_MS);
+  }
+});
+
+profileResetBtn.addEventListener('click', () => {
+  profiler.clearHistory();
+  sendProfileCommand('PROFILE RESET');
+});
+
+profileTraceBtn.addEventListener('click', async () => {
+  profileTraceBtn.disabled = true;
+  profileStatus.textContent = 'Recording trace...';
+  await sendProfileCommand(`PROFILE TRACE START ${TRACE_MS}`);
+  // The device stops recording on its own; ask for the dump once it has
+  window.setTimeout(async () => {
+    await sendProfileCommand('PROFILE TRACE');
+    profileTraceBtn.disabled = false;
+  }, TRACE_MS + 200);
+});
+
+profiler.onSnapshot((snapshot) => {
+  renderProfile(snapshot);
+});
+
+profiler.onTrace((traceJson, events) => {
+  profileStatus.textContent = `Trace: ${events} events saved (open in ui.perfetto.dev)`;
+  downloadFile('cyd-trace.json', traceJson);
+});
+
+// Telemetry controls
+const TELEMETRY_REDRAW_MS = 250;
+const TELEMETRY_WINDOW_US = 2000000;
+
+TELEMETRY_METRICS.forEach(({ id, label }) => {
+  const option = document.createElement('option');
+  option.value = id;
+  option.textContent = label;
+  telemetryMetricSelect.appendChild(option);
+});
+
+telemetryStreamCheck.addEventListener('change', async () => {
+  if (!controller.isSerialConnected()) {
+    telemetryStatus.textContent = 'Connect Serial first';
+    telemetryStreamCheck.checked = false;
+    return;
+  }
+  try {
+    await controller.sendSerialCommand(telemetryStreamCheck.checked ? 'TELEMETRY ON' : 'TELEMETRY OFF');
+  } catch (error) {
+    telemetryStatus.textContent = `Send failed: ${error}`;
+  }
+});
+
+telemetryMetricSelect.addEventListener('change', () => renderTelemetry());
+
+telemetryClearBtn.addEventListener('click', () => {
+  telemetry.clear();
+  renderTelemetry();
+});
+
+telemetrySaveBtn.addEventListener('click', () => {
+  downloadFile('cyd-telemetry.csv', telemetry.toCsv());
+});
+
+window.setInterval(() => renderTelemetry(), TELEMETRY_REDRAW_MS);
+
 // ============================================================
 // Rendering
 // ============================================================
@@ -211,6 +321,107 @@ function updateConnectionStatus(): void {
   connectSerialBtn.textContent = serialConnected ? 'Disconnect Serial' : 'Connect Serial';
 }
 
+function renderProfile(snapshot: ProfileSnapshot): void {
+  const cpuNote = snapshot.runtimeStats ? '' : ' (no run-time stats: task CPU unavailable)';
+  profileStatus.textContent = `Window ${snapshot.windowMs} ms, ${snapshot.tasks.length} tasks${cpuNote}`;
+
+  profileSections.innerHTML =
+    '<tr><th>Section</th><th>calls/s</th><th>avg µs</th><th>max µs</th><th>10 s max</th>' +
+    '<th>peak µs</th><th>load %</th><th>10 s load</th></tr>' +
+    snapshot.sections
+      .map(s => `<tr><td>${s.name}</td><td>${s.calls}</td><td>${s.avgUs}</td><td>${s.maxUs}</td>` +
+        `<td>${s.rollingMaxUs}</td><td>${s.peakUs}</td><td>${s.load.toFixed(1)}</td>` +
+        `<td>${s.rollingLoad.toFixed(1)}</td></tr>`)
+      .join('');
+
+  // Lowest free stack first: those are the tasks closest to overflowing
+  const tasks = [...snapshot.tasks].sort((a, b) => a.stackFree - b.stackFree);
+  profileTasks.innerHTML =
+    '<tr><th>Task</th><th>prio</th><th>core</th><th>stack free B</th><th>CPU %</th></tr>' +
+    tasks
+      .map(t => `<tr><td>${t.name}</td><td>${t.priority}</td><td>${t.core < 0 ? '-' : t.core}</td>` +
+        `<td class="${t.stackFree < 512 ? 'warn' : ''}">${t.stackFree}</td>` +
+        `<td>${t.cpu === null ? '-' : t.cpu.toFixed(1)}</td></tr>`)
+      .join('');
+}
+
+function renderTelemetry(): void {
+  const latest = telemetry.latestUs();
+  const version = telemetry.getDeviceVersion();
+  if (version === null) {
+    if (telemetryStreamCheck.checked) telemetryStatus.textContent = 'Waiting for telemetry...';
+  } else {
+    const mismatch = version !== TELEMETRY_PROTOCOL_VERSION ? ` (protocol ${version}, console ${TELEMETRY_PROTOCOL_VERSION})` : '';
+    telemetryStatus.textContent =
+      `${telemetry.eventsPerSecond()} events/s, ${telemetry.getDeviceDropped()} dropped on the device${mismatch}`;
+  }
+  drawTelemetryTimeline(latest);
+  drawTelemetryHistogram(telemetryMetricSelect.value as TelemetryMetric);
+}
+
+// One lane per event type over the last TELEMETRY_WINDOW_US; durations are bars
+function drawTelemetryTimeline(latestUs: number): void {
+  const ctx = telemetryTimeline.getContext('2d')!;
+  const width = telemetryTimeline.width = telemetryTimeline.offsetWidth;
+  const height = telemetryTimeline.height = telemetryTimeline.offsetHeight;
+  const lanes = TELEMETRY_EVENT_NAMES.slice(1);  // Not SYNC
+  const laneHeight = height / lanes.length;
+  const labelWidth = 110;
+  const fromUs = latestUs - TELEMETRY_WINDOW_US;
+  const xOf = (tUs: number) => labelWidth + ((tUs - fromUs) / TELEMETRY_WINDOW_US) * (width - labelWidth);
+
+  ctx.fillStyle = '#0a0a0a';
+  ctx.fillRect(0, 0, width, height);
+  ctx.font = '10px Courier New';
+  ctx.textBaseline = 'middle';
+  lanes.forEach((name, i) => {
+    ctx.fillStyle = '#888';
+    ctx.fillText(name, 4, (i + 0.5) * laneHeight);
+  });
+  if (latestUs === 0) return;
+
+  ctx.fillStyle = '#00d4ff';
+  for (const event of telemetry.getRange(fromUs, latestUs)) {
+    const lane = lanes.indexOf(event.event);
+    if (lane < 0) continue;
+    const y = lane * laneHeight + 1;
+    if (DURATION_EVENTS.has(event.event)) {
+      // The timestamp is the start of the measured span
+      const x = xOf(event.tUs);
+      ctx.fillRect(x, y, Math.max(1, xOf(event.tUs + event.value) - x), laneHeight - 2);
+    } else {
+      ctx.fillRect(xOf(event.tUs), y, 1, laneHeight - 2);
+    }
+  }
+}
+
+function drawTelemetryHistogram(metric: TelemetryMetric): void {
+  const ctx = telemetryHistogram.getContext('2d')!;
+  const width = telemetryHistogram.width = telemetryHistogram.offsetWidth;
+  const height = telemetryHistogram.height = telemetryHistogram.offsetHeight;
+  const histogram = telemetry.histogram(metric);
+
+  ctx.fillStyle = '#0a0a0a';
+  ctx.fillRect(0, 0, width, height);
+  ctx.font = '10px Courier New';
+  ctx.fillStyle = '#888';
+  ctx.textBaseline = 'top';
+  ctx.fillText(`n=${histogram.count} p50=${histogram.p50} p99=${histogram.p99} max=${histogram.max} µs`, 4, 2);
+  if (histogram.count === 0) return;
+
+  const top = 16;
+  const bottom = height - 14;
+  const peak = Math.max(...histogram.buckets.map(b => b.count));
+  const barWidth = width / histogram.buckets.length;
+  histogram.buckets.forEach((bucket, i) => {
+    const barHeight = ((bottom - top) * bucket.count) / peak;
+    ctx.fillStyle = '#00d4ff';
+    ctx.fillRect(i * barWidth + 2, bottom - barHeight, barWidth - 4, barHeight);
+    ctx.fillStyle = '#888';
+    ctx.fillText(`${bucket.from}`, i * barWidth + 2, bottom + 2);
+  });
+}
+
 let renderScheduled = false;
 
 function renderLog(): void {
@@ -299,6 +510,8 @@ function formatSource(source: string): string {
       return 'CYD→SER';
     case 'SERIAL_OUT':
       return 'SER→CYD';
+    case 'TELEMETRY':
+      return 'CYD→TEL';
     default:
       return source;
   }
@@ -330,9 +543,11 @@ function generateLogFile(): string {
   return output;
 }
 
-// Subscribe to log updates
-eventBus.subscribe(() => {
-  renderLog();
+// Subscribe to log updates; telemetry is redrawn on its own timer
+eventBus.subscribe((entry) => {
+  if (entry.source !== 'TELEMETRY') {
+    renderLog();
+  }
 });
 
 function downloadFile(filename: string, content: string): void {
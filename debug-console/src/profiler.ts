@@ -0,0 +1,146 @@
+import { EventBus } from './eventBus';
+
+// ============================================================
+// Profiler - parses the firmware's PROFILE CLI output
+// ============================================================
+
+export interface ProfileTask {
+  name: string;
+  priority: number;
+  core: number;        // -1: not pinned
+  stackFree: number;   // bytes
+  cpu: number | null;  // % of one core, null without run-time stats
+}
+
+export interface ProfileSection {
+  name: string;
+  calls: number;
+  avgUs: number;
+  maxUs: number;
+  peakUs: number;      // longest since the last reset on the device
+  load: number;        // % of one core
+  dropped: number;
+  rollingMaxUs: number;  // longest over the last historyLength windows
+  rollingLoad: number;   // mean load over the same windows
+}
+
+export interface ProfileSnapshot {
+  windowMs: number;
+  runtimeStats: boolean;
+  tasks: ProfileTask[];
+  sections: ProfileSection[];
+}
+
+type SnapshotCallback = (snapshot: ProfileSnapshot) => void;
+type TraceCallback = (traceJson: string, events: number) => void;
+
+const PREFIX = 'CLI: PROF ';
+
+export class ProfilerMonitor {
+  private tasks: ProfileTask[] = [];
+  private sections: ProfileSection[] = [];
+  private history = new Map<string, { maxUs: number; load: number }[]>();
+  private historyLength: number;
+  private traceLines: string[] | null = null;
+  private snapshotListeners: SnapshotCallback[] = [];
+  private traceListeners: TraceCallback[] = [];
+
+  constructor(eventBus: EventBus, historyLength = 10) {
+    this.historyLength = historyLength;
+    eventBus.subscribe((entry) => {
+      if (entry.source === 'SERIAL_IN' && entry.serial) {
+        this.handleLine(entry.serial.line);
+      }
+    });
+  }
+
+  onSnapshot(callback: SnapshotCallback): void {
+    this.snapshotListeners.push(callback);
+  }
+
+  onTrace(callback: TraceCallback): void {
+    this.traceListeners.push(callback);
+  }
+
+  clearHistory(): void {
+    this.history.clear();
+  }
+
+  private handleLine(line: string): void {
+    const start = line.indexOf(PREFIX);
+    if (start < 0) return;
+    const body = line.substring(start + PREFIX.length);
+
+    if (body.startsWith('TRACE ')) {
+      this.handleTraceLine(body.substring(6));
+    } else if (body.startsWith('TASK ')) {
+      const [name, ...rest] = body.substring(5).split(' ');
+      const fields = parseFields(rest);
+      this.tasks.push({
+        name,
+        priority: parseInt(fields.prio ?? '0', 10),
+        core: parseInt(fields.core ?? '-1', 10),
+        stackFree: parseInt(fields.stack_free ?? '0', 10),
+        cpu: fields.cpu === undefined || fields.cpu === '-' ? null : parseFloat(fields.cpu),
+      });
+    } else if (body.startsWith('SEC ')) {
+      const [name, ...rest] = body.substring(4).split(' ');
+      const fields = parseFields(rest);
+      const maxUs = parseInt(fields.max ?? '0', 10);
+      const load = parseFloat(fields.load ?? '0');
+      const samples = this.history.get(name) ?? [];
+      samples.push({ maxUs, load });
+      if (samples.length > this.historyLength) samples.shift();
+      this.history.set(name, samples);
+      this.sections.push({
+        name,
+        calls: parseInt(fields.calls ?? '0', 10),
+        avgUs: parseInt(fields.avg ?? '0', 10),
+        maxUs,
+        peakUs: parseInt(fields.peak ?? '0', 10),
+        load,
+        dropped: parseInt(fields.dropped ?? '0', 10),
+        rollingMaxUs: Math.max(...samples.map(s => s.maxUs)),
+        rollingLoad: samples.reduce((sum, s) => sum + s.load, 0) / samples.length,
+      });
+    } else if (body.startsWith('END ')) {
+      const fields = parseFields(body.substring(4).split(' '));
+      const snapshot: ProfileSnapshot = {
+        windowMs: parseInt(fields.window ?? '0', 10),
+        runtimeStats: fields.runtime_stats === '1',
+        tasks: this.tasks,
+        sections: this.sections,
+      };
+      this.tasks = [];
+      this.sections = [];
+      this.snapshotListeners.forEach(callback => callback(snapshot));
+    }
+  }
+
+  private handleTraceLine(rest: string): void {
+    if (rest.startsWith('BEGIN')) {
+      this.traceLines = [];
+    } else if (rest === 'END') {
+      if (this.traceLines === null) return;
+      const events = this.traceLines;
+      this.traceLines = null;
+      const json = `{"traceEvents":[\n${events.join(',\n')}\n],"displayTimeUnit":"ms"}\n`;
+      const count = events.filter(e => e.includes('"ph":"X"')).length;
+      this.traceListeners.forEach(callback => callback(json, count));
+    } else if (rest.startsWith('{') && this.traceLines !== null) {
+      this.traceLines.push(rest);
+    }
+  }
+}
+
+// "key=value" tokens; units (us, B, %, ms) are stripped by parseInt/parseFloat
+function parseFields(tokens: string[]): Record<string, string> {
+  const fields: Record<string, string> = {};
+  for (const token of tokens) {
+    const eq = token.indexOf('=');
+    if (eq > 0) {
+      fields[token.substring(0, eq)] = token.substring(eq + 1);
+    }
+  }
+  return fields;
+}
@@ -1,8 +1,9 @@
 import { EventBus } from './eventBus';
+import { TelemetryStreamSplitter, formatTelemetryEvent } from './telemetry';
 
 export class SerialConnection {
   private port: SerialPort | null = null;
-  private reader: ReadableStreamDefaultReader<string> | null = null;
+  private reader: ReadableStreamDefaultReader<Uint8Array> | null = null;
   private eventBus: EventBus;
   private baudRate: number;
   public connected = false;
@@ -46,14 +47,13 @@ export class SerialConnection {
     this.connected = false;
   }
 
+  // Bytes, not a TextDecoderStream: binary telemetry frames share the port
+  // with the text log and are split out before the text is decoded
   private async startReading(): Promise<void> {
     if (!this.port || !this.port.readable) return;
 
-    const textDecoder = new TextDecoderStream();
-    const readableStreamClosed = this.port.readable.pipeTo(textDecoder.writable as any);
-    this.reader = textDecoder.readable.getReader();
-
-    let buffer = '';
+    this.reader = this.port.readable.getReader();
+    const splitter = new TelemetryStreamSplitter();
 
     try {
       while (true) {
@@ -61,12 +61,9 @@ export class SerialConnection {
         if (done) {
           break;
         }
+        if (!value) continue;
 
-        buffer += value;
-        
-        // Process complete lines
-        const lines = buffer.split('\n');
-        buffer = lines.pop() || ''; // Keep incomplete line in buffer
+        const { lines, events } = splitter.feed(value);
 
         for (const line of lines) {
           const trimmed = line.trim();
@@ -79,12 +76,20 @@ export class SerialConnection {
             });
           }
         }
+
+        for (const event of events) {
+          this.eventBus.emit({
+            source: 'TELEMETRY',
+            text: `TELEM   ${formatTelemetryEvent(event)}`,
+            tDeltaMs: 0,
+            telemetry: event,
+          });
+        }
       }
     } catch (error) {
       console.error('Serial read error:', error);
     } finally {
       this.reader.releaseLock();
-      await readableStreamClosed.catch(() => { /* ignore */ });
     }
   }
 
@@ -0,0 +1,258 @@
+import { EventBus } from './eventBus';
+import type { TelemetryEvent, TelemetryEventName } from './types';
+
+// ============================================================
+// Telemetry - binary event frames from the firmware (include/telemetry.h)
+// ============================================================
+
+export const TELEMETRY_PROTOCOL_VERSION = 1;
+const PAYLOAD_BYTES = 13;
+const MAX_ENCODED_BYTES = PAYLOAD_BYTES + 1;
+
+// TelemetryEventId, in order
+export const TELEMETRY_EVENT_NAMES: TelemetryEventName[] = [
+  'SYNC', 'CLOCK_TICK', 'CLOCK_OUT', 'CLOCK_DISPATCH', 'CLOCK_CATCHUP', 'EXT_CLOCK',
+  'TRANSPORT', 'MIDI_OUT', 'MIDI_IN', 'QUEUE_SEND', 'FRAME',
+];
+
+// Events whose value is a duration in microseconds
+export const DURATION_EVENTS = new Set<TelemetryEventName>(['CLOCK_DISPATCH', 'QUEUE_SEND', 'FRAME']);
+
+export function cobsDecode(data: Uint8Array): Uint8Array | null {
+  const out: number[] = [];
+  let i = 0;
+  while (i < data.length) {
+    const code = data[i];
+    if (code === 0 || i + code > data.length) return null;
+    for (let j = 1; j < code; j++) out.push(data[i + j]);
+    i += code;
+    if (code !== 0xff && i !== data.length) out.push(0);
+  }
+  return Uint8Array.from(out);
+}
+
+export function decodePayload(payload: Uint8Array | null): Omit<TelemetryEvent, 'tUs'> | null {
+  if (!payload || payload.length !== PAYLOAD_BYTES) return null;
+  let sum = 0;
+  for (let i = 0; i < 12; i++) sum += payload[i];
+  if (((0xff - (sum & 0xff)) & 0xff) !== payload[12] || payload[0] >= TELEMETRY_EVENT_NAMES.length) return null;
+  const view = new DataView(payload.buffer, payload.byteOffset, payload.byteLength);
+  return {
+    event: TELEMETRY_EVENT_NAMES[payload[0]],
+    arg8: payload[1],
+    arg16: view.getUint16(2, true),
+    timestampUs: view.getUint32(4, true),
+    value: view.getUint32(8, true),
+  };
+}
+
+// Splits serial bytes into text lines and telemetry events. Text never holds
+// a zero byte; frames are 0x00 <COBS> 0x00. A frame that does not decode
+// (the port opened mid-frame) goes back to the text and the zero that closed
+// it starts the next frame.
+export class TelemetryStreamSplitter {
+  private inFrame = false;
+  private frame: number[] = [];
+  private text: number[] = [];
+  private textDecoder = new TextDecoder();
+  private wrapOffset = 0;
+  private lastTimestamp: number | null = null;
+  badFrames = 0;
+
+  feed(data: Uint8Array): { lines: string[]; events: TelemetryEvent[] } {
+    const lines: string[] = [];
+    const events: TelemetryEvent[] = [];
+    for (const byte of data) {
+      if (!this.inFrame) {
+        if (byte === 0) {
+          this.inFrame = true;
+          this.frame = [];
+        } else {
+          this.text.push(byte);
+          if (byte === 0x0a) {
+            lines.push(this.textDecoder.decode(Uint8Array.from(this.text)));
+            this.text = [];
+          }
+        }
+        continue;
+      }
+      if (byte !== 0) {
+        this.frame.push(byte);
+        if (this.frame.length > MAX_ENCODED_BYTES) {
+          this.text.push(...this.frame);  // Too long for a frame: it was text
+          this.frame = [];
+          this.inFrame = false;
+        }
+        continue;
+      }
+      if (this.frame.length === 0) continue;  // Zero after zero: the next frame starts here
+      const decoded = decodePayload(cobsDecode(Uint8Array.from(this.frame)));
+      if (decoded) {
+        events.push({ ...decoded, tUs: this.unwrap(decoded.timestampUs) });
+        this.inFrame = false;
+      } else {
+        this.badFrames++;
+        this.text.push(...this.frame);
+      }
+      this.frame = [];
+    }
+    return { lines, events };
+  }
+
+  // The firmware's micros() wraps every 71 minutes
+  private unwrap(timestampUs: number): number {
+    if (this.lastTimestamp !== null && timestampUs < this.lastTimestamp &&
+        this.lastTimestamp - timestampUs > 0x80000000) {
+      this.wrapOffset += 0x100000000;
+    }
+    this.lastTimestamp = timestampUs;
+    return timestampUs + this.wrapOffset;
+  }
+}
+
+export interface HistogramBucket {
+  from: number;   // us, inclusive
+  to: number;     // us, inclusive
+  count: number;
+}
+
+export interface TelemetryHistogram {
+  buckets: HistogramBucket[];  // Powers of two
+  count: number;
+  p50: number;
+  p99: number;
+  max: number;
+}
+
+export type TelemetryMetric =
+  | 'tickInterval'
+  | 'extClockInterval'
+  | 'clockOut'
+  | 'dispatch'
+  | 'queueSend'
+  | 'midiInLatency'
+  | 'frame';
+
+export const TELEMETRY_METRICS: { id: TelemetryMetric; label: string }[] = [
+  { id: 'tickInterval', label: 'Clock tick interval' },
+  { id: 'extClockInterval', label: 'External clock interval' },
+  { id: 'clockOut', label: 'Tick to 0xF8 sent' },
+  { id: 'dispatch', label: 'Clock module dispatch' },
+  { id: 'queueSend', label: 'BLE/WiFi batch send' },
+  { id: 'midiInLatency', label: 'DIN input latency' },
+  { id: 'frame', label: 'UI frame' },
+];
+
+// Keeps the last maxEvents telemetry events for the timeline and histograms
+export class TelemetryStore {
+  private events: TelemetryEvent[] = [];
+  private maxEvents: number;
+  private deviceDropped = 0;
+  private deviceVersion: number | null = null;
+
+  constructor(eventBus: EventBus, maxEvents = 20000) {
+    this.maxEvents = maxEvents;
+    eventBus.subscribe((entry) => {
+      if (entry.source === 'TELEMETRY' && entry.telemetry) {
+        this.add(entry.telemetry);
+      }
+    });
+  }
+
+  private add(event: TelemetryEvent): void {
+    if (event.event === 'SYNC') {
+      this.deviceVersion = event.arg16;
+      this.deviceDropped = event.value;
+      return;
+    }
+    this.events.push(event);
+    if (this.events.length > this.maxEvents * 1.25) {
+      this.events = this.events.slice(-this.maxEvents);
+    }
+  }
+
+  clear(): void {
+    this.events = [];
+  }
+
+  getDeviceDropped(): number {
+    return this.deviceDropped;
+  }
+
+  getDeviceVersion(): number | null {
+    return this.deviceVersion;
+  }
+
+  latestUs(): number {
+    return this.events.length > 0 ? this.events[this.events.length - 1].tUs : 0;
+  }
+
+  // Events with tUs in [fromUs, toUs]
+  getRange(fromUs: number, toUs: number): TelemetryEvent[] {
+    return this.events.filter(e => e.tUs >= fromUs && e.tUs <= toUs);
+  }
+
+  eventsPerSecond(): number {
+    const latest = this.latestUs();
+    return this.getRange(latest - 1000000, latest).length;
+  }
+
+  histogram(metric: TelemetryMetric): TelemetryHistogram {
+    const values = this.metricValues(metric).sort((a, b) => a - b);
+    const bucketMap = new Map<number, number>();
+    for (const v of values) {
+      const from = v <= 0 ? 0 : 2 ** Math.floor(Math.log2(v));
+      bucketMap.set(from, (bucketMap.get(from) ?? 0) + 1);
+    }
+    const buckets = [...bucketMap.entries()]
+      .sort((a, b) => a[0] - b[0])
+      .map(([from, count]) => ({ from, to: from === 0 ? 0 : from * 2 - 1, count }));
+    const pct = (p: number) => values.length ? values[Math.min(values.length - 1, Math.floor(p * values.length))] : 0;
+    return { buckets, count: values.length, p50: pct(0.5), p99: pct(0.99), max: values.length ? values[values.length - 1] : 0 };
+  }
+
+  toCsv(): string {
+    return 't_us,event,arg8,arg16,value\n' +
+      this.events.map(e => `${e.tUs},${e.event},${e.arg8},${e.arg16},${e.value}`).join('\n') + '\n';
+  }
+
+  private metricValues(metric: TelemetryMetric): number[] {
+    const values = (name: TelemetryEventName) => this.events.filter(e => e.event === name).map(e => e.value);
+    const intervals = (name: TelemetryEventName) => {
+      const times = this.events.filter(e => e.event === name).map(e => e.tUs);
+      const out: number[] = [];
+      for (let i = 1; i < times.length; i++) {
+        const delta = times[i] - times[i - 1];
+        if (delta < 1000000) out.push(delta);  // A longer gap is a stopped clock
+      }
+      return out;
+    };
+    switch (metric) {
+      case 'tickInterval': return intervals('CLOCK_TICK');
+      case 'extClockInterval': return intervals('EXT_CLOCK');
+      case 'clockOut': return values('CLOCK_OUT');
+      case 'dispatch': return values('CLOCK_DISPATCH');
+      case 'queueSend': return values('QUEUE_SEND');
+      case 'midiInLatency': return values('MIDI_IN').filter(v => v > 0);
+      case 'frame': return values('FRAME');
+    }
+  }
+}
+
+export function formatTelemetryEvent(e: TelemetryEvent): string {
+  switch (e.event) {
+    case 'CLOCK_TICK': return `CLOCK_TICK tick=${e.value}`;
+    case 'CLOCK_OUT': return `CLOCK_OUT tick=${e.arg16} +${e.value}us`;
+    case 'CLOCK_DISPATCH': return `DISPATCH tick=${e.arg16} ${e.value}us`;
+    case 'CLOCK_CATCHUP': return `CATCHUP steps=${e.arg16} ticks=${e.value}`;
+    case 'EXT_CLOCK': return `EXT_CLOCK src=${e.arg8}`;
+    case 'TRANSPORT': return `TRANSPORT ${e.arg8 ? 'START' : 'STOP'} tick=${e.value}`;
+    case 'MIDI_OUT':
+    case 'MIDI_IN':
+      return `${e.event} ${e.arg8.toString(16)} ${(e.arg16 >> 8).toString(16)} ${(e.arg16 & 0xff).toString(16)}` +
+        (e.event === 'MIDI_IN' && e.value ? ` ${e.value}us` : '');
+    case 'QUEUE_SEND': return `QUEUE_SEND n=${e.arg16} left=${e.arg8} ${e.value}us`;
+    case 'FRAME': return `FRAME mode=${e.arg8} ${e.value}us`;
+    default: return `${e.event} ${e.arg8} ${e.arg16} ${e.value}`;
+  }
+}
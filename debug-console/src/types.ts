@@ -7,7 +7,8 @@ export type LogSource =
   | "BLE_IN"
   | "BLE_OUT"
   | "SERIAL_IN"
-  | "SERIAL_OUT";
+  | "SERIAL_OUT"
+  | "TELEMETRY";
 
 export type MidiKind =
   | "NOTE_ON"
@@ -38,6 +39,28 @@ export interface SerialData {
   line: string;
 }
 
+export type TelemetryEventName =
+  | "SYNC"
+  | "CLOCK_TICK"
+  | "CLOCK_OUT"
+  | "CLOCK_DISPATCH"
+  | "CLOCK_CATCHUP"
+  | "EXT_CLOCK"
+  | "TRANSPORT"
+  | "MIDI_OUT"
+  | "MIDI_IN"
+  | "QUEUE_SEND"
+  | "FRAME";
+
+export interface TelemetryEvent {
+  event: TelemetryEventName;
+  arg8: number;
+  arg16: number;
+  value: number;
+  timestampUs: number;  // device micros(), 32-bit
+  tUs: number;          // timestampUs extended across wraps
+}
+
 export interface LogEntry {
   id: string;
   tAbsMs: number;      // Date.now()
@@ -47,6 +70,7 @@ export interface LogEntry {
   text: string;        // human-readable line
   midi?: MidiData;
   serial?: SerialData;
+  telemetry?: TelemetryEvent;
 }
 
 // ============================================================
@@ -0,0 +1,60 @@
+#ifndef ACTIVE_NOTES_H
+#define ACTIVE_NOTES_H
+
+#include <stdint.h>
+
+/**
+ * Active notes - which notes are sounding, per channel, as sent by sendMIDI()
+ *
+ * One bit per (channel, note): 16 x 128 bits, updated from every task that
+ * sends MIDI with atomic word operations. Note-on sets a bit; note-off,
+ * note-on with velocity 0, and CC 120/123 clear it. Panics and scene changes
+ * use it to send note-offs only for notes that are really held, instead of
+ * blind 128-note or all-channel bursts.
+ *
+ * Stuck-note detection is generational: a sweep flags notes that were
+ * already sounding at the previous sweep and have seen no note-on or
+ * note-off since, so a note is reported after one to two sweep periods
+ * without any activity on it.
+ */
+
+struct ActiveNoteMap {
+  uint32_t sounding[16][4];
+  uint32_t untouched[16][4];  // Sounding at the last sweep and not touched since
+};
+
+void activeNotesTrack(ActiveNoteMap &map, uint8_t status, uint8_t data1, uint8_t data2);
+uint8_t activeNotesVoiceCount(const ActiveNoteMap &map, uint8_t channel);
+
+// The map fed by sendMIDI()
+void activeNotesTrack(uint8_t status, uint8_t data1, uint8_t data2);
+bool activeNoteIsSounding(uint8_t channel, uint8_t note);  // channel 0-15
+uint8_t activeNotesVoiceCount(uint8_t channel);
+uint16_t activeNotesTotal();
+
+// Sends a note-off through sendMIDI() for each sounding note on the channel
+// (0-15) and returns how many were sent
+uint16_t activeNotesRelease(uint8_t channel);
+uint16_t activeNotesReleaseAll();
+
+// Call from the UI loop; sweeps every kActiveNotesSweepMs and logs new stuck notes
+static constexpr uint32_t kActiveNotesSweepMs = 15000;
+void activeNotesService(uint32_t nowMs);
+uint16_t activeNotesStuckCount();  // Flagged by the last sweep
+
+struct ActiveNotesBurstResult {
+  uint16_t sounding;      // Notes held in the scenario
+  uint16_t blindMessages; // 128 note-offs on each channel in use
+  uint16_t hardMessages;  // CC 123 + CC 120 on all 16 channels
+  uint16_t softMessages;  // One note-off per sounding note
+  uint32_t blindDinUs;    // Wire time of each burst at 31250 baud, 3 bytes per message
+  uint32_t hardDinUs;
+  uint32_t softDinUs;
+  bool ok;                // Soft panic released exactly the sounding notes
+};
+
+// Plays a seeded chord pattern into a scratch map, releases it with each panic
+// style and compares the bursts; the live map is not touched
+ActiveNotesBurstResult activeNotesRunBurstCheck(uint8_t channels, uint8_t notesPerChannel);
+
+#endif // ACTIVE_NOTES_H
@@ -7,4 +7,5 @@ void switchMode(AppMode mode);
 void exitToMenu();
 void appDrawCurrentMode();
 void appHandleCurrentMode();
+uint8_t appModeClockRedraw(AppMode mode);
 
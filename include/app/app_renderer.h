@@ -2,7 +2,37 @@
 
 #include <stdint.h>
 
+#include "common_definitions.h"
+
+// Frame governor: redraw requests (RedrawReason bits, from any task) are
+// coalesced and drawn at most appRendererGetMaxFps() times a second. Clock
+// reasons the current mode does not redraw on are dropped, so a static screen
+// draws nothing while the clock runs. A frame is rendered and flushed before
+// the next one can start.
+static constexpr uint8_t kRendererDefaultFps = 30;
+static constexpr uint8_t kRendererMaxFps = 60;
+
 void appRendererInit();
 void appRendererLoopTick(uint32_t now);
 void appRendererProcessRedraw();
+void appRendererRequest(uint8_t reasons);
+
+// Ends a UI loop pass: sleeps a tick unless a frame is due or inputPending,
+// and samples the UI core's idle time
+void appRendererIdle(bool inputPending);
+
+void appRendererSetMaxFps(uint8_t fps);
+uint8_t appRendererGetMaxFps();
+
+struct RendererModeStats {
+  uint32_t frames;
+  uint32_t dropped;      // Clock requests the mode does not redraw on
+  uint32_t coalesced;    // Passes a pending request waited for its frame slot
+  uint32_t renderUs;     // Draw and flush time
+  uint32_t maxRenderUs;
+  uint32_t activeMs;     // Time on screen
+  int8_t idlePercent;    // UI core IDLE task share; -1 without FreeRTOS run-time stats
+};
 
+RendererModeStats appRendererGetModeStats(AppMode mode);
+void appRendererResetStats();
@@ -0,0 +1,92 @@
+#ifndef BACKGROUND_GENERATOR_H
+#define BACKGROUND_GENERATOR_H
+
+#include "clocked_module.h"
+#include "common_definitions.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+/**
+ * Background generators
+ *
+ * A generator mode (Euclid, Grids, Raga) keeps its playback logic in a
+ * BackgroundGenerator that the clock runtime steps on every clock tick, so it
+ * keeps playing when another screen is in the foreground. The mode's screen
+ * is only a view: switchMode() attaches the generator whose view is the new
+ * mode and detaches the rest, and a detached generator requests no redraws.
+ *
+ * advance() runs in the clock task under the generator's lock; the view holds
+ * the same lock (ViewLock) while it edits the generator's state. If the view
+ * has it when a tick comes, that tick is skipped and the generator catches up
+ * on the next one, as it does when the runtime defers it for budget.
+ */
+class BackgroundGenerator : public ClockedModule {
+public:
+  BackgroundGenerator(const char *typeId, const char *displayName, AppMode view)
+      : typeId_(typeId), displayName_(displayName), view_(view) {}
+
+  const char *typeId() const override { return typeId_; }
+  const char *displayName() const override { return displayName_; }
+  void init() override {}
+  void reset() override {}
+  uint16_t ticksPerStep() const override { return 1; }
+  void onStep(const StepContext &ctx) override;
+  void setParam(uint16_t, int32_t) override {}
+  int32_t getParam(uint16_t) const override { return 0; }
+
+  AppMode view() const { return view_; }
+  bool viewAttached() const { return attached_; }
+  void attachView() { attached_ = true; }
+  void detachView() { attached_ = false; }
+
+  // Recursive, so a view helper that locks may be called from a locked handler
+  void lock();
+  void unlock();
+  uint32_t busySkips() const { return busySkips_; }  // Ticks skipped while a view held the lock
+
+  class ViewLock {
+  public:
+    explicit ViewLock(BackgroundGenerator &generator) : generator_(generator) { generator_.lock(); }
+    ~ViewLock() { generator_.unlock(); }
+
+  private:
+    BackgroundGenerator &generator_;
+  };
+
+protected:
+  // One clock tick's worth of playback; reads the clock manager's tick count
+  virtual void advance() = 0;
+
+private:
+  friend void initBackgroundGenerators();
+
+  const char *typeId_;
+  const char *displayName_;
+  AppMode view_;
+  volatile bool attached_ = false;
+  SemaphoreHandle_t mutex_ = nullptr;
+  volatile uint32_t busySkips_ = 0;
+};
+
+// Generators are registered during static initialisation and never removed
+void registerBackgroundGenerator(BackgroundGenerator *generator);
+
+#define REGISTER_BACKGROUND_GENERATOR(Generator) \
+  namespace { \
+    struct Generator##BackgroundRegistrar { \
+      Generator##BackgroundRegistrar() { registerBackgroundGenerator(&Generator); } \
+    }; \
+    static Generator##BackgroundRegistrar g_##Generator##BackgroundRegistrar; \
+  }
+
+// Creates the locks and adds every generator to the clock runtime; call once
+// after clockRuntime.init()
+void initBackgroundGenerators();
+
+// Attaches the generator whose view is mode, detaches the others
+void backgroundGeneratorsShowView(AppMode mode);
+
+size_t backgroundGeneratorCount();
+BackgroundGenerator *backgroundGenerator(size_t index);
+
+#endif // BACKGROUND_GENERATOR_H
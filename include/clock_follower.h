@@ -0,0 +1,85 @@
+#ifndef CLOCK_FOLLOWER_H
+#define CLOCK_FOLLOWER_H
+
+#include <stdint.h>
+
+/**
+ * Clock follower - tempo and phase tracking for an external MIDI clock
+ *
+ * Incoming 0xF8 pulses are noisy: BLE connection intervals, WiFi batching and
+ * UI-loop polling move them around by milliseconds. The follower runs an
+ * alpha-beta filter (a steady-state Kalman filter for constant tempo) over
+ * the pulse timestamps to estimate the pulse period and the ideal time of the
+ * latest pulse. A phase loop then trims the period of the local tick timer
+ * (uClock), so output ticks stay evenly spaced and line up with the filtered
+ * input instead of copying its jitter.
+ *
+ * A gap longer than 1.5 periods is read as lost pulses: the pulse count
+ * catches up and the estimate is not disturbed. The caller lets the timer
+ * run ahead of the last pulse by at most kClockFollowerFlywheelTicks, so
+ * short dropouts are bridged and a silent source stops the output within a
+ * beat.
+ *
+ * The class does no locking and no I/O; the clock manager owns the live
+ * instance, and the simulation below drives the same code.
+ */
+
+static constexpr uint32_t kClockFollowerFlywheelTicks = 24;
+
+class ClockFollower {
+public:
+  void reset();
+
+  // Feeds one pulse. outTicks/outTickUs are the local tick count and the time
+  // of the latest local tick, used for the phase comparison.
+  void onPulse(uint32_t timestampUs, uint32_t outTicks, uint32_t outTickUs);
+
+  bool hasEstimate() const { return stage_ == 2; }
+  bool locked() const { return lockCount_ >= kLockPulses; }
+  uint32_t pulses() const { return pulses_; }  // Including pulses inferred from gaps
+  uint32_t lostPulses() const { return lostPulses_; }
+  float periodUs() const { return periodUs_; }           // Filtered input period
+  float outputPeriodUs() const { return outPeriodUs_; }  // Period to run the local timer at
+  float tempoBpm() const;
+  float outputTempoBpm() const;
+  float jitterUs() const { return jitterUs_; }         // Mean absolute input residual
+  float phaseErrorUs() const { return phaseErrorUs_; }  // Local tick minus filtered input
+
+private:
+  static constexpr uint8_t kLockPulses = 12;
+
+  uint8_t stage_ = 0;      // 0: no pulse yet, 1: first pulse seen, 2: tracking
+  uint32_t pulses_ = 0;
+  uint32_t tracked_ = 0;   // Pulses since the estimate (re)started
+  uint32_t lostPulses_ = 0;
+  uint32_t estUs_ = 0;     // Filtered time of the latest pulse
+  float estFracUs_ = 0.0f;
+  float periodUs_ = 0.0f;
+  float outPeriodUs_ = 0.0f;
+  float jitterUs_ = 0.0f;
+  float phaseErrorUs_ = 0.0f;
+  uint8_t lockCount_ = 0;
+};
+
+struct ClockFollowerSimResult {
+  uint32_t pulses;
+  uint32_t lostPulses;
+  uint32_t inJitterUs;     // Standard deviation of input pulse intervals
+  uint32_t inPeakUs;       // Largest deviation of an input interval from the true period
+  uint32_t outJitterUs;    // Standard deviation of output tick intervals, from a bar after lock
+  uint32_t outPeakUs;
+  uint32_t phasePeakUs;    // Largest offset of an output tick from the true clock, from a bar after lock
+  uint32_t lockPulses;     // Pulses until the follower reported lock
+  float tempoErrorBpm;     // Measured minus true tempo at the end
+  bool ok;                 // Locked, output jitter below input, tempo within 0.1%
+};
+
+// Synthetic external clock at bpm with uniform timing error of +/-jitterUs on
+// each pulse and dropPercent of pulses lost, followed for `beats` beats by the
+// follower and a modelled local timer. With csv set, prints an "in" line per
+// received pulse and an "out" line per local tick (interval and offset from
+// the true clock, in us) for plotting.
+ClockFollowerSimResult clockFollowerRunSimulation(uint16_t bpm, uint32_t jitterUs, uint8_t dropPercent,
+                                                  uint16_t beats, bool csv);
+
+#endif // CLOCK_FOLLOWER_H
@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <Arduino.h>
 
+#include "telemetry.h"
+
 constexpr uint8_t CLOCK_TICKS_PER_QUARTER = 24;
 constexpr uint8_t CLOCK_TICKS_PER_SIXTEENTH = CLOCK_TICKS_PER_QUARTER / 4;
 constexpr uint8_t CLOCK_QUARTERS_PER_BAR = 4;
@@ -17,7 +19,8 @@ void clockManagerSequencerStarted();
 void clockManagerSequencerStopped();
 void clockManagerExternalStart();
 void clockManagerExternalStop();
-void clockManagerExternalClock();
+// timestampUs: micros() when the 0xF8 arrived, as close to the transport as possible
+void clockManagerExternalClock(uint32_t timestampUs);
 void clockManagerExternalContinue();
 uint32_t clockManagerGetTickCount();
 bool clockManagerHasTickAdvanced(uint32_t &lastSeenTick);
@@ -25,6 +28,20 @@ bool clockManagerIsBarStart();
 bool clockManagerIsSixteenthTick(uint32_t tick);
 bool clockManagerIsRunning();
 
+struct ClockFollowerStatus {
+  bool following;   // uClock runs as the local timer for the external clock
+  bool tracking;    // The follower has a period estimate
+  bool locked;
+  uint32_t pulses;
+  uint32_t lostPulses;
+  float tempoBpm;        // Measured external tempo
+  float outputTempoBpm;  // Local timer tempo, including the phase trim
+  float jitterUs;        // Mean absolute deviation of incoming pulses
+  float phaseErrorUs;    // Local tick minus filtered pulse
+};
+
+ClockFollowerStatus clockManagerGetFollowerStatus();
+
 struct SequencerSyncState {
   bool playing = false;
   bool startPending = false;
@@ -109,12 +126,9 @@ struct SequencerSyncState {
       return 0;
     }
     lastTick += steps * stepIntervalTicks;
-#if defined(DEBUG_ENABLED) && DEBUG_ENABLED
     if (steps > 1) {
-      Serial.printf("[ClockManager] consumed %u ticks (%u steps at %u-tick interval)\n", tickDiff,
-                    steps, stepIntervalTicks);
+      telemetryEmit(TelemetryEventId::CLOCK_CATCHUP, 0, static_cast<uint16_t>(steps), tickDiff);
     }
-#endif
     return steps;
   }
 
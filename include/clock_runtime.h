@@ -17,6 +17,16 @@
  * - Step boundary computation and module dispatch
  * - Start/stop quantization
  * - Swing timing
+ *
+ * Ticks are fed by the clock manager from the MIDI clock task, once per MIDI
+ * clock pulse it sends (internal uClock or an external master), so modules
+ * stay locked to the clock other gear receives. The clock manager owns the
+ * clock, start and stop bytes; the runtime only dispatches.
+ *
+ * Background modules (registerBackgroundModule) step on every tick the clock
+ * manager delivers, running or not, so generators keep playing while another
+ * screen is in the foreground. They share a CPU budget per tick and every
+ * slot's onStep() time is accounted (getModuleLoad).
  */
 
 // Transport states
@@ -127,6 +137,13 @@ public:
    * Set swing amount (0-50%)
    */
   void setSwing(uint8_t percent);
+
+  /**
+   * Set a slot's swing (0-50%), or kSwingFollowGlobal to use setSwing()'s value.
+   * Odd steps are delayed by ticksPerStep * swing / 100 ticks.
+   */
+  void setModuleSwing(int slotId, uint8_t percent);
+  static constexpr uint8_t kSwingFollowGlobal = 0xFF;
   
   // ========== Quantization Settings ==========
   
@@ -135,6 +152,21 @@ public:
   
   QuantizeMode getStartQuantize() const { return startQuantize_; }
   QuantizeMode getStopQuantize() const { return stopQuantize_; }
+
+  /**
+   * Run action(arg) once from the clock task at the next bar start (bars count
+   * from the transport start), before that bar's steps are dispatched. Runs with
+   * the runtime's module lock held, so it must be short and must not call back
+   * into the runtime, except setModuleMute() and setModuleSwing(), which see the
+   * held lock and write directly.
+   * If the transport stops first, cancel(arg) runs instead, under the same lock,
+   * from whichever task stopped it.
+   * @return false if another bar action is already pending or the transport is stopped
+   */
+  using BarAction = void (*)(void* arg);
+  bool requestBarAction(BarAction action, void* arg, BarAction cancel = nullptr);
+  void cancelBarAction();
+  bool hasBarAction() const { return barActionPending_; }
   
   // ========== Module Management ==========
   
@@ -143,6 +175,16 @@ public:
    * @return slot ID (or -1 on failure)
    */
   int registerModule(ClockedModule* module, uint8_t midiChannel = 0);
+
+  /**
+   * Register a module that steps on every clock tick whatever the transport
+   * state, and gets no transport callbacks: it follows the clock manager
+   * itself (e.g. through SequencerSyncState). Once the tick's background
+   * budget is spent, the remaining background modules are deferred to the
+   * next tick, so they must catch up from the clock rather than count calls.
+   * @return slot ID (or -1 on failure)
+   */
+  int registerBackgroundModule(ClockedModule* module, uint8_t midiChannel = 0);
   
   /**
    * Unregister a module
@@ -164,11 +206,37 @@ public:
    * Get module at slot
    */
   ClockedModule* getModule(int slotId);
+  size_t getModuleCount() const { return slotCount_; }
+  
+  // ========== CPU Accounting ==========
+  
+  static constexpr uint32_t kDefaultBackgroundBudgetUs = 2000;
+  static constexpr uint32_t kLoadWindowTicks = 96;  // One bar
+  
+  struct ModuleLoad {
+    const char* name;
+    bool background;
+    uint32_t usPerTickX10;  // onStep() time per tick over the last window, in 0.1 us
+    uint32_t maxUs;         // Longest onStep() since the last reset
+    uint32_t steps;
+    uint32_t deferred;      // Background ticks skipped because the budget was spent
+  };
+  
+  /**
+   * Background onStep() time allowed per tick; modules whose turn comes after
+   * it is spent wait for the next tick. Turns rotate so none is always last.
+   */
+  void setBackgroundBudgetUs(uint32_t us) { backgroundBudgetUs_ = us; }
+  uint32_t getBackgroundBudgetUs() const { return backgroundBudgetUs_; }
+  
+  bool getModuleLoad(int slotId, ModuleLoad& out) const;
+  uint32_t getBackgroundUsPerTickX10() const { return backgroundUsPerTickX10_; }
+  void resetModuleLoad();
   
   // ========== Update (called from clock task) ==========
   
   /**
-   * Process clock tick (called from uClock callback or external clock)
+   * Process clock tick (called from the clock task after each MIDI clock pulse)
    * @param tick Current tick count (if external) or 0 to auto-increment
    */
   void processTick(uint32_t tick = 0);
@@ -180,18 +248,31 @@ private:
     uint8_t midiChannel;
     bool mute;
     bool enabled;
+    uint8_t swing;
+    bool background;
     uint32_t lastStepTick;
     uint32_t stepIndex;
+    // Accounting; read by the UI without the lock, so published per window
+    uint32_t windowUs;
+    uint32_t usPerTickX10;
+    uint32_t maxUs;
+    uint32_t steps;
+    uint32_t deferred;
     
     Slot() : module(nullptr), midiChannel(0), mute(false), enabled(true),
-             lastStepTick(0), stepIndex(0) {}
+             swing(kSwingFollowGlobal), background(false), lastStepTick(0), stepIndex(0),
+             windowUs(0), usPerTickX10(0), maxUs(0), steps(0), deferred(0) {}
   };
   
-  static constexpr size_t kMaxSlots = 8;
+  static constexpr size_t kMaxSlots = 20;
+  // Ticks missed while the slot lock was busy are replayed, up to one bar
+  static constexpr uint32_t kMaxCatchUpTicks = 96;
   
   // State
   TransportState state_;
   uint32_t currentTick_;
+  uint32_t dispatchedTick_;  // Last tick whose steps were dispatched
+  uint32_t runStartTick_;    // Tick of the last transition to RUNNING; bars count from here
   uint32_t startPendingAtTick_;
   uint32_t stopPendingAtTick_;
   uint16_t bpm_;
@@ -200,22 +281,40 @@ private:
   QuantizeMode startQuantize_;
   QuantizeMode stopQuantize_;
   
+  BarAction barAction_;
+  BarAction barActionCancel_;
+  void* barActionArg_;
+  volatile bool barActionPending_;
+  bool startDeferred_;  // The start transition found the module lock busy
+  
   // Slots
   Slot slots_[kMaxSlots];
   size_t slotCount_;
   SemaphoreHandle_t slotsMutex_;
   
+  uint32_t backgroundBudgetUs_;
+  size_t backgroundCursor_;        // Background slot that goes first on the next tick
+  uint32_t windowTicks_;
+  uint32_t backgroundWindowUs_;
+  uint32_t backgroundUsPerTickX10_;
+  
   // Internal methods
   void transitionToRunning();
   void transitionToStopped();
   bool shouldStartNow(uint32_t tick);
   bool shouldStopNow(uint32_t tick);
+  int addSlot(ClockedModule* module, uint8_t midiChannel, bool background);
+  bool callerHoldsSlots() const;
+  void dropBarActionLocked();
   void dispatchStepToModules(uint32_t tick);
-  void sendTransportMessage(TransportState newState);
+  void dispatchTickLocked(uint32_t tick, bool running);
+  void dispatchBackgroundLocked(uint32_t tick);
+  bool stepSlotLocked(Slot& slot, uint32_t tick);
+  void publishLoadLocked();
   uint32_t getTicksPerBar() const;
   bool isBarStart(uint32_t tick) const;
   bool isStepBoundary(uint32_t tick, uint16_t ticksPerStep) const;
-  uint32_t applySwing(uint32_t tick, uint16_t ticksPerStep) const;
+  bool stepDueAt(uint32_t tick, uint16_t ticksPerStep, uint8_t swing, uint32_t &stepTick) const;
 };
 
 // Global instance
@@ -25,10 +25,11 @@ struct StepContext {
   uint16_t stepInBar;     // 0..stepsPerBar-1
   uint16_t ticksPerStep;  // Module's chosen ticks/step
   bool isBarStart;        // True if this step is at the start of a bar
+  bool muted;             // Slot is muted: advance the playhead but send no notes
   
   StepContext() : tick(0), bpm_x10(1200), ppqn(24), barIndex(0),
                   tickInBar(0), stepIndex(0), stepInBar(0),
-                  ticksPerStep(6), isBarStart(false) {}
+                  ticksPerStep(6), isBarStart(false), muted(false) {}
 };
 
 // Parameter IDs (common across modules, modules can extend)
@@ -92,13 +93,14 @@ public:
   /**
    * Get the number of MIDI clock ticks per step for this module
    * Must divide 24 evenly (e.g., 6 for 1/16 notes, 12 for 1/8 notes)
+   * Return 0 to receive no steps (module is idle)
    * Default: 6 ticks (1/16 note resolution)
    */
   virtual uint16_t ticksPerStep() const { return 6; }
   
   /**
    * Whether this module's playhead should advance while muted
-   * Default: true (module stays in sync even when muted)
+   * Default: true (module stays in sync even when muted; ctx.muted is set)
    */
   virtual bool advanceWhileMuted() const { return true; }
   
@@ -133,7 +135,8 @@ public:
   /**
    * Serialize module state
    * Override to save module-specific state
-   * Format is module-defined
+   * Format is module-defined; set outSize past maxSize if the state did not fit.
+   * Modules registered with sceneRegisterClockedModule() are saved in scenes.
    */
   virtual void serialize(uint8_t* buffer, size_t maxSize, size_t& outSize) const {
     outSize = 0;
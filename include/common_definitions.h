@@ -169,8 +169,17 @@ extern uint8_t midiPacket[];
 extern TouchState touch;
 extern AppMode currentMode;
 
-// Redraw control - to minimize unnecessary redraws
-extern volatile bool needsRedraw;
+// Redraw control - to minimize unnecessary redraws. Requests say what changed;
+// the renderer draws at most once per frame slot, and only for clock reasons
+// the current mode declares in its mode table entry.
+enum RedrawReason : uint8_t {
+  REDRAW_PARAM = 1 << 0,      // Mode state changed (requestRedraw())
+  REDRAW_TRANSPORT = 1 << 1,  // Run state or tempo shown in the header
+  REDRAW_TICK = 1 << 2,       // Any clock tick
+  REDRAW_STEP = 1 << 3,       // A sixteenth-note boundary
+  REDRAW_BEAT = 1 << 4,       // A quarter-note boundary
+};
+
 extern uint16_t sharedBPM;
 extern MidiClockMaster midiClockMaster;
 extern bool displayColorsInverted;
@@ -182,6 +191,7 @@ extern uint8_t slotSystemSlotCount;
 void setDisplayInversion(bool invert);
 void rotateDisplay180();
 void requestRedraw();
+void requestRedrawFor(uint8_t reasons);
 void setSharedBPM(uint16_t bpm);
 
 #endif
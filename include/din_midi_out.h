@@ -0,0 +1,66 @@
+#ifndef DIN_MIDI_OUT_H
+#define DIN_MIDI_OUT_H
+
+#include <stdint.h>
+
+/**
+ * DIN MIDI output engine - paced UART output with running status
+ *
+ * Channel messages go into a byte ring, encoded with running status (a
+ * note-off with velocity 0 is sent as a note-on with velocity 0 so chords
+ * share one status byte). A pump keeps only a few bytes in the UART FIFO, so
+ * a realtime byte (F8/FA/FB/FC) written directly to the FIFO leaves within
+ * that many byte times instead of waiting behind a whole note burst. The MIDI
+ * spec allows realtime bytes between any two bytes of a message.
+ *
+ * The engine keeps a wire-time budget at 31250 baud (320 us per byte) and
+ * logs when the backlog of ring and FIFO passes kDinBacklogWarnUs, before the
+ * ring itself overflows.
+ */
+
+static constexpr uint32_t kDinByteUs = 320;          // 10 bits per byte at 31250 baud
+static constexpr uint32_t kDinBacklogWarnUs = 50000;  // Audibly late; the ring holds about 160 ms
+
+// Creates the pump task; called from initHardwareMIDI()
+void initDinMidiOut();
+
+// Queues a 1-3 byte message; realtime status bytes go out ahead of queued data
+void dinMidiSend(uint8_t status, uint8_t data1, uint8_t data2, uint8_t length);
+void dinMidiSendRealtime(uint8_t message);
+
+struct DinMidiStats {
+  uint32_t messages;
+  uint32_t bytesWritten;       // Channel data bytes handed to the UART
+  uint32_t runningStatusSaved; // Status bytes left out
+  uint32_t realtimeBytes;
+  uint32_t overflowDrops;      // Messages lost to a full ring
+  uint32_t backlogWarnings;
+  uint32_t maxBacklogUs;       // Ring plus FIFO, in wire time
+  uint8_t maxRealtimeAhead;    // Most bytes found in the FIFO ahead of a realtime byte
+};
+
+DinMidiStats dinMidiGetStats();
+void dinMidiResetStats();
+
+struct DinJitterResult {
+  uint32_t clocks;
+  uint32_t legacyBytes;     // Byte-per-write path, no running status
+  uint32_t engineBytes;
+  uint32_t legacyMaxUs;     // Clock byte delay behind its tick
+  uint32_t legacyMeanUs;
+  uint32_t legacyJitterUs;  // Max minus min delay
+  uint32_t engineMaxUs;
+  uint32_t engineMeanUs;
+  uint32_t engineJitterUs;
+  uint32_t boundUs;         // FIFO lead in wire time
+  uint32_t maxBacklogUs;
+  bool ok;                  // Engine jitter within boundUs
+};
+
+// Replays a dense chord pattern (a chord change on every eighth note, queued
+// just before the clock byte of the same tick) against a modelled 31250 baud
+// wire, through the old in-order path and through this engine's scheduler
+// with its FIFO lead and 1 ms pump. Does not touch the UART.
+DinJitterResult dinMidiRunJitterSimulation(uint16_t bpm, uint8_t chordNotes, uint16_t bars);
+
+#endif // DIN_MIDI_OUT_H
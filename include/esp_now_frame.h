@@ -0,0 +1,151 @@
+#ifndef ESP_NOW_FRAME_H
+#define ESP_NOW_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * ESP-NOW MIDI framing - batched messages with sequence numbers
+ *
+ * Every message produced within a clock tick shares one ESP-NOW frame instead
+ * of costing a frame each. Messages are encoded straight into the frame
+ * buffer handed to esp_now_send(), and the receiver decodes them in place
+ * from the receive callback's buffer.
+ *
+ * Frame layout (little endian):
+ *   0     magic 'M' (a data byte, so a frame never looks like plain MIDI)
+ *   1     version
+ *   2-3   sequence number
+ *   4-7   clock pulses sent before this frame (the sender's tick count)
+ *   8-11  sender esp_timer time at send, in us (latency tracking)
+ *   12-13 how long the frame's clock pulse waited before the send, in us
+ *   14    message bytes that follow
+ *   15    redundant entries after the messages
+ *   ...   messages, each with its own status byte (no running status)
+ *   ...   redundant entries: frames back (1-3), transport status (FA/FB/FC)
+ *
+ * Start/Continue/Stop are repeated in up to three following frames, so a
+ * single lost frame cannot leave a receiver running or stopped. Clock pulses
+ * are not repeated: the tick count tells the receiver exactly how many pulses
+ * it missed, and the clock follower bridges them.
+ */
+
+static constexpr uint8_t kEspNowFrameMagic = 0x4D;
+static constexpr uint8_t kEspNowFrameVersion = 1;
+static constexpr size_t kEspNowFrameHeaderBytes = 16;
+static constexpr size_t kEspNowFrameMaxBytes = 250;  // ESP-NOW payload limit
+static constexpr uint8_t kEspNowMaxRedundancy = 3;
+
+using EspNowMessageSink = void (*)(uint8_t status, uint8_t data1, uint8_t data2, uint32_t timestampUs);
+
+// Length of a message by its status byte, 0 for bytes that cannot start one
+uint8_t espNowMessageLength(uint8_t status);
+
+class EspNowFrameWriter {
+public:
+  void setRedundancy(uint8_t frames);
+  uint8_t redundancy() const { return redundancy_; }
+
+  // Encodes one message into the open frame. Returns false when the frame is
+  // full; finish and send it, then append again.
+  bool append(uint8_t status, uint8_t data1, uint8_t data2, uint32_t nowUs);
+
+  bool empty() const { return length_ == kEspNowFrameHeaderBytes; }
+  bool holdsClock() const { return clocks_ > 0; }
+  uint32_t openedUs() const { return openedUs_; }
+
+  // Completes the header and redundancy block in place and returns the frame
+  // length; data() stays valid until the next append.
+  size_t finish(uint32_t nowUs);
+  const uint8_t *data() const { return frame_; }
+
+  uint16_t sequence() const { return sequence_; }
+
+private:
+  struct TransportHistory {
+    uint16_t sequence;
+    uint8_t count;
+    uint8_t status[2];
+  };
+
+  void reset();
+
+  uint8_t frame_[kEspNowFrameMaxBytes] = {};
+  size_t length_ = kEspNowFrameHeaderBytes;
+  uint16_t sequence_ = 0;
+  uint32_t tick_ = 0;
+  uint32_t openedUs_ = 0;
+  uint32_t clockQueuedUs_ = 0;
+  uint8_t clocks_ = 0;
+  uint8_t redundancy_ = 2;
+  TransportHistory pending_ = {};
+  TransportHistory history_[kEspNowMaxRedundancy] = {};
+};
+
+struct EspNowLinkStats {
+  uint32_t frames;          // Distinct frames received
+  uint32_t messages;
+  uint32_t lostFrames;      // Sequence gaps not filled by a late frame
+  uint32_t reordered;       // Frames that arrived after a later one
+  uint32_t duplicates;
+  uint32_t recovered;       // Transport messages delivered from a redundant copy
+  uint32_t lostClocks;      // Clock pulses missed or too late to feed the clock
+  uint32_t resyncs;         // Sequence jumps treated as a sender restart
+  uint64_t totalLatencyUs;  // Over the lowest transit time seen (clocks are not synchronised)
+  uint32_t maxLatencyUs;
+};
+
+// Receive side of one sender. Tracks the last 32 sequence numbers, so a frame
+// up to 32 frames late is still delivered (apart from its clock pulses).
+class EspNowFrameReader {
+public:
+  void reset();
+
+  // Decodes a frame and delivers its messages to `sink`. Returns false for
+  // data that is not a valid frame.
+  bool onFrame(const uint8_t *data, size_t length, uint32_t rxUs, EspNowMessageSink sink);
+
+  const EspNowLinkStats &stats() const { return stats_; }
+  void resetStats() { stats_ = {}; }
+
+private:
+  void trackLatency(uint32_t offsetUs);
+
+  bool known_ = false;
+  uint16_t lastSequence_ = 0;
+  uint32_t missing_ = 0;        // Bit i: frame lastSequence_ - 1 - i not received
+  uint32_t unsynced_ = 0;       // Missing bits from before the first frame, never counted as lost
+  uint32_t transportDone_ = 0;  // Bit i: that frame's transport already delivered
+  uint32_t nextTick_ = 0;
+  uint32_t minOffsetUs_ = 0;
+  uint32_t windowMinUs_ = 0;
+  uint16_t windowFrames_ = 0;
+  EspNowLinkStats stats_ = {};
+};
+
+struct EspNowLoopbackResult {
+  uint32_t messages;
+  uint32_t frames;             // Batched frames sent; unbatched would be one per message
+  uint32_t droppedFrames;      // By the simulated link
+  uint32_t delayedFrames;
+  uint32_t transportSent;
+  uint32_t transportDelivered;
+  uint32_t transportUnrecoverable;  // Lost with every redundant copy
+  uint32_t clocksSent;
+  uint32_t clocksDelivered;
+  uint32_t notesSent;
+  uint32_t notesDelivered;
+  uint32_t meanLatencyUs;
+  uint32_t maxLatencyUs;
+  EspNowLinkStats stats;
+  bool ok;                     // Receiver stats match what the link did
+};
+
+// Loopback over a simulated lossy link: 120 BPM clock with chords and a
+// Stop/Continue every two bars, framed by EspNowFrameWriter, dropping
+// lossPercent of frames and holding reorderPercent back behind the next
+// frame, decoded by EspNowFrameReader. Does not touch the radio.
+EspNowLoopbackResult espNowRunLoopbackSimulation(uint8_t lossPercent, uint8_t reorderPercent, uint8_t redundancy,
+                                                 uint16_t seconds);
+
+#endif // ESP_NOW_FRAME_H
@@ -2,6 +2,7 @@
 #define ESP_NOW_MIDI_MODULE_H
 
 #include "common_definitions.h"
+#include "esp_now_frame.h"
 
 #if ESP_NOW_ENABLED
 
@@ -20,9 +21,16 @@ struct EspNowMidiState {
   EspNowMode mode = ESP_NOW_OFF;
   uint32_t messagesSent = 0;
   uint32_t messagesReceived = 0;
+  uint32_t framesSent = 0;
+  uint32_t sendErrors = 0;
+  bool batching = true;    // One frame per clock tick (see esp_now_frame.h); off: one library packet per message
+  uint8_t redundancy = 2;  // Frames that repeat each Start/Continue/Stop
   uint8_t peerMAC[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}; // Default broadcast MAC
 };
 
+// Receive statistics of one sender, by MAC address
+static constexpr uint8_t kEspNowMaxLinks = 8;
+
 // Global ESP-NOW MIDI instance
 extern esp_now_midi espNowMIDI;
 extern EspNowMidiState espNowState;
@@ -53,9 +61,23 @@ void clearEspNowPeers();
 // Get number of connected peers
 int getEspNowPeerCount();
 
-// Send MIDI message via ESP-NOW
+// Send MIDI message via ESP-NOW. With batching on, the message joins the
+// current frame; a new clock pulse, a full frame or espNowMidiService() sends it.
 void sendEspNowMidi(uint8_t status, uint8_t data1, uint8_t data2);
 
+// Sends a frame that has been open for kEspNowFrameHoldUs. Called every
+// millisecond from the clock task, so messages queued after a tick's clock
+// pulse (notes from the MIDI out buffer task) travel in the same frame.
+void espNowMidiService();
+
+void setEspNowBatching(bool enabled);
+void setEspNowRedundancy(uint8_t frames);
+
+// Links are created for each sender whose frames arrive
+uint8_t getEspNowLinkCount();
+bool getEspNowLinkStats(uint8_t index, uint8_t mac[6], EspNowLinkStats &stats);
+void resetEspNowLinkStats();
+
 // MIDI message handlers (called when ESP-NOW MIDI received)
 void onEspNowNoteOn(byte channel, byte note, byte velocity);
 void onEspNowNoteOff(byte channel, byte note, byte velocity);
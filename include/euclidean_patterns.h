@@ -0,0 +1,68 @@
+#ifndef EUCLIDEAN_PATTERNS_H
+#define EUCLIDEAN_PATTERNS_H
+
+#include <stdint.h>
+
+/**
+ * Euclidean pattern engine
+ *
+ * Patterns are 64-bit masks: bit i set means step i fires, and only the low
+ * `length` bits are meaningful. E(k, n) comes from a flash table generated by
+ * scripts/gen_euclid_tables.py, so building a pattern is a lookup and a rotate.
+ */
+
+#define EUCLIDEAN_PATTERN_MAX_STEPS 64
+
+enum class EuclidLogicOp : uint8_t {
+  NONE = 0,
+  AND,
+  OR,
+  XOR,
+  COUNT
+};
+
+inline uint64_t euclidLengthMask(uint8_t length) {
+  return length >= 64 ? ~0ULL : ((1ULL << length) - 1ULL);
+}
+
+inline uint64_t euclidInvert(uint64_t mask, uint8_t length) {
+  return ~mask & euclidLengthMask(length);
+}
+
+inline uint64_t euclidCombine(uint64_t a, uint64_t b, EuclidLogicOp op) {
+  switch (op) {
+    case EuclidLogicOp::AND: return a & b;
+    case EuclidLogicOp::OR:  return a | b;
+    case EuclidLogicOp::XOR: return a ^ b;
+    default:                 return a;
+  }
+}
+
+// E(events, length) from the table; events is clamped to length, length to 64
+uint64_t euclidPattern(uint8_t events, uint8_t length);
+
+// Rotate within `length` bits; positive rotation moves hits later in the bar
+uint64_t euclidRotate(uint64_t mask, uint8_t length, int rotation);
+
+// Bucket algorithm evaluated at runtime, used to verify the table
+uint64_t euclidPatternBucket(uint8_t events, uint8_t length);
+
+const char *euclidLogicOpName(EuclidLogicOp op);
+
+struct EuclidCheckResult {
+  uint32_t checked;
+  uint32_t failures;
+};
+
+struct EuclidBenchResult {
+  uint32_t iterations;
+  uint32_t bucketUs;  // Runtime bucket fill into a bool array plus rotation
+  uint32_t tableUs;   // Table lookup plus mask rotate
+};
+
+// Compares every E(k, n), n <= 64, against the bucket reference and checks
+// onset counts and rotation round-trips
+EuclidCheckResult euclidRunExhaustiveCheck();
+EuclidBenchResult euclidRunBenchmark(uint32_t iterations);
+
+#endif // EUCLIDEAN_PATTERNS_H
@@ -0,0 +1,640 @@
+// Generated by scripts/gen_euclid_tables.py - do not edit by hand.
+#ifndef EUCLIDEAN_TABLES_H
+#define EUCLIDEAN_TABLES_H
+
+#include <stdint.h>
+
+#define EUCLIDEAN_TABLE_MAX_STEPS 64
+#define EUCLIDEAN_TABLE_INDEX(k, n) ((n) * ((n) + 1) / 2 + (k))
+
+// E(k, n) at EUCLIDEAN_TABLE_INDEX(k, n); bit i = step i fires
+static const uint64_t kEuclideanTable[2145] = {
+    // n = 0
+    0x0000000000000000ULL,
+    // n = 1
+    0x0000000000000000ULL, 0x0000000000000001ULL,
+    // n = 2
+    0x0000000000000000ULL, 0x0000000000000002ULL, 0x0000000000000003ULL,
+    // n = 3
+    0x0000000000000000ULL, 0x0000000000000004ULL, 0x0000000000000006ULL, 0x0000000000000007ULL,
+    // n = 4
+    0x0000000000000000ULL, 0x0000000000000008ULL, 0x000000000000000AULL, 0x000000000000000EULL,
+    0x000000000000000FULL,
+    // n = 5
+    0x0000000000000000ULL, 0x0000000000000010ULL, 0x0000000000000014ULL, 0x000000000000001AULL,
+    0x000000000000001EULL, 0x000000000000001FULL,
+    // n = 6
+    0x0000000000000000ULL, 0x0000000000000020ULL, 0x0000000000000024ULL, 0x000000000000002AULL,
+    0x0000000000000036ULL, 0x000000000000003EULL, 0x000000000000003FULL,
+    // n = 7
+    0x0000000000000000ULL, 0x0000000000000040ULL, 0x0000000000000048ULL, 0x0000000000000054ULL,
+    0x000000000000006AULL, 0x0000000000000076ULL, 0x000000000000007EULL, 0x000000000000007FULL,
+    // n = 8
+    0x0000000000000000ULL, 0x0000000000000080ULL, 0x0000000000000088ULL, 0x00000000000000A4ULL,
+    0x00000000000000AAULL, 0x00000000000000DAULL, 0x00000000000000EEULL, 0x00000000000000FEULL,
+    0x00000000000000FFULL,
+    // n = 9
+    0x0000000000000000ULL, 0x0000000000000100ULL, 0x0000000000000110ULL, 0x0000000000000124ULL,
+    0x0000000000000154ULL, 0x00000000000001AAULL, 0x00000000000001B6ULL, 0x00000000000001EEULL,
+    0x00000000000001FEULL, 0x00000000000001FFULL,
+    // n = 10
+    0x0000000000000000ULL, 0x0000000000000200ULL, 0x0000000000000210ULL, 0x0000000000000248ULL,
+    0x0000000000000294ULL, 0x00000000000002AAULL, 0x000000000000035AULL, 0x00000000000003B6ULL,
+    0x00000000000003DEULL, 0x00000000000003FEULL, 0x00000000000003FFULL,
+    // n = 11
+    0x0000000000000000ULL, 0x0000000000000400ULL, 0x0000000000000420ULL, 0x0000000000000488ULL,
+    0x0000000000000524ULL, 0x0000000000000554ULL, 0x00000000000006AAULL, 0x00000000000006DAULL,
+    0x0000000000000776ULL, 0x00000000000007DEULL, 0x00000000000007FEULL, 0x00000000000007FFULL,
+    // n = 12
+    0x0000000000000000ULL, 0x0000000000000800ULL, 0x0000000000000820ULL, 0x0000000000000888ULL,
+    0x0000000000000924ULL, 0x0000000000000A94ULL, 0x0000000000000AAAULL, 0x0000000000000D6AULL,
+    0x0000000000000DB6ULL, 0x0000000000000EEEULL, 0x0000000000000FBEULL, 0x0000000000000FFEULL,
+    0x0000000000000FFFULL,
+    // n = 13
+    0x0000000000000000ULL, 0x0000000000001000ULL, 0x0000000000001040ULL, 0x0000000000001110ULL,
+    0x0000000000001248ULL, 0x00000000000014A4ULL, 0x0000000000001554ULL, 0x0000000000001AAAULL,
+    0x0000000000001B5AULL, 0x0000000000001DB6ULL, 0x0000000000001EEEULL, 0x0000000000001FBEULL,
+    0x0000000000001FFEULL, 0x0000000000001FFFULL,
+    // n = 14
+    0x0000000000000000ULL, 0x0000000000002000ULL, 0x0000000000002040ULL, 0x0000000000002210ULL,
+    0x0000000000002448ULL, 0x0000000000002924ULL, 0x0000000000002A54ULL, 0x0000000000002AAAULL,
+    0x000000000000356AULL, 0x00000000000036DAULL, 0x0000000000003B76ULL, 0x0000000000003DEEULL,
+    0x0000000000003F7EULL, 0x0000000000003FFEULL, 0x0000000000003FFFULL,
+    // n = 15
+    0x0000000000000000ULL, 0x0000000000004000ULL, 0x0000000000004080ULL, 0x0000000000004210ULL,
+    0x0000000000004888ULL, 0x0000000000004924ULL, 0x0000000000005294ULL, 0x0000000000005554ULL,
+    0x0000000000006AAAULL, 0x0000000000006B5AULL, 0x0000000000006DB6ULL, 0x0000000000007776ULL,
+    0x0000000000007BDEULL, 0x0000000000007F7EULL, 0x0000000000007FFEULL, 0x0000000000007FFFULL,
+    // n = 16
+    0x0000000000000000ULL, 0x0000000000008000ULL, 0x0000000000008080ULL, 0x0000000000008420ULL,
+    0x0000000000008888ULL, 0x0000000000009248ULL, 0x000000000000A4A4ULL, 0x000000000000AA54ULL,
+    0x000000000000AAAAULL, 0x000000000000D5AAULL, 0x000000000000DADAULL, 0x000000000000EDB6ULL,
+    0x000000000000EEEEULL, 0x000000000000FBDEULL, 0x000000000000FEFEULL, 0x000000000000FFFEULL,
+    0x000000000000FFFFULL,
+    // n = 17
+    0x0000000000000000ULL, 0x0000000000010000ULL, 0x0000000000010100ULL, 0x0000000000010820ULL,
+    0x0000000000011110ULL, 0x0000000000012448ULL, 0x0000000000014924ULL, 0x0000000000015294ULL,
+    0x0000000000015554ULL, 0x000000000001AAAAULL, 0x000000000001AD6AULL, 0x000000000001B6DAULL,
+    0x000000000001DBB6ULL, 0x000000000001EEEEULL, 0x000000000001F7DEULL, 0x000000000001FEFEULL,
+    0x000000000001FFFEULL, 0x000000000001FFFFULL,
+    // n = 18
+    0x0000000000000000ULL, 0x0000000000020000ULL, 0x0000000000020100ULL, 0x0000000000020820ULL,
+    0x0000000000022110ULL, 0x0000000000024488ULL, 0x0000000000024924ULL, 0x00000000000294A4ULL,
+    0x000000000002A954ULL, 0x000000000002AAAAULL, 0x00000000000355AAULL, 0x0000000000036B5AULL,
+    0x0000000000036DB6ULL, 0x000000000003BB76ULL, 0x000000000003DDEEULL, 0x000000000003EFBEULL,
+    0x000000000003FDFEULL, 0x000000000003FFFEULL, 0x000000000003FFFFULL,
+    // n = 19
+    0x0000000000000000ULL, 0x0000000000040000ULL, 0x0000000000040200ULL, 0x0000000000041040ULL,
+    0x0000000000044210ULL, 0x0000000000048888ULL, 0x0000000000049248ULL, 0x0000000000052524ULL,
+    0x0000000000054A94ULL, 0x0000000000055554ULL, 0x000000000006AAAAULL, 0x000000000006B56AULL,
+    0x000000000006DADAULL, 0x0000000000076DB6ULL, 0x0000000000077776ULL, 0x000000000007BDEEULL,
+    0x000000000007EFBEULL, 0x000000000007FDFEULL, 0x000000000007FFFEULL, 0x000000000007FFFFULL,
+    // n = 20
+    0x0000000000000000ULL, 0x0000000000080000ULL, 0x0000000000080200ULL, 0x0000000000082040ULL,
+    0x0000000000084210ULL, 0x0000000000088888ULL, 0x0000000000092248ULL, 0x00000000000A4924ULL,
+    0x00000000000A5294ULL, 0x00000000000AA954ULL, 0x00000000000AAAAAULL, 0x00000000000D56AAULL,
+    0x00000000000D6B5AULL, 0x00000000000DB6DAULL, 0x00000000000EDBB6ULL, 0x00000000000EEEEEULL,
+    0x00000000000F7BDEULL, 0x00000000000FDFBEULL, 0x00000000000FFBFEULL, 0x00000000000FFFFEULL,
+    0x00000000000FFFFFULL,
+    // n = 21
+    0x0000000000000000ULL, 0x0000000000100000ULL, 0x0000000000100400ULL, 0x0000000000102040ULL,
+    0x0000000000108420ULL, 0x0000000000111110ULL, 0x0000000000122448ULL, 0x0000000000124924ULL,
+    0x000000000014A4A4ULL, 0x0000000000152A54ULL, 0x0000000000155554ULL, 0x00000000001AAAAAULL,
+    0x00000000001AB56AULL, 0x00000000001B5B5AULL, 0x00000000001B6DB6ULL, 0x00000000001DBB76ULL,
+    0x00000000001EEEEEULL, 0x00000000001F7BDEULL, 0x00000000001FBF7EULL, 0x00000000001FFBFEULL,
+    0x00000000001FFFFEULL, 0x00000000001FFFFFULL,
+    // n = 22
+    0x0000000000000000ULL, 0x0000000000200000ULL, 0x0000000000200400ULL, 0x0000000000204080ULL,
+    0x0000000000210420ULL, 0x0000000000222110ULL, 0x0000000000244488ULL, 0x0000000000249248ULL,
+    0x0000000000292524ULL, 0x00000000002A5294ULL, 0x00000000002AA554ULL, 0x00000000002AAAAAULL,
+    0x00000000003556AAULL, 0x000000000035AD6AULL, 0x000000000036D6DAULL, 0x00000000003B6DB6ULL,
+    0x00000000003BB776ULL, 0x00000000003DDEEEULL, 0x00000000003EF7DEULL, 0x00000000003FBF7EULL,
+    0x00000000003FF7FEULL, 0x00000000003FFFFEULL, 0x00000000003FFFFFULL,
+    // n = 23
+    0x0000000000000000ULL, 0x0000000000400000ULL, 0x0000000000400800ULL, 0x0000000000408080ULL,
+    0x0000000000420820ULL, 0x0000000000442210ULL, 0x0000000000488888ULL, 0x0000000000492248ULL,
+    0x0000000000524924ULL, 0x00000000005294A4ULL, 0x0000000000552A54ULL, 0x0000000000555554ULL,
+    0x00000000006AAAAAULL, 0x00000000006AD5AAULL, 0x00000000006D6B5AULL, 0x00000000006DB6DAULL,
+    0x000000000076DDB6ULL, 0x0000000000777776ULL, 0x00000000007BDDEEULL, 0x00000000007DF7DEULL,
+    0x00000000007F7F7EULL, 0x00000000007FF7FEULL, 0x00000000007FFFFEULL, 0x00000000007FFFFFULL,
+    // n = 24
+    0x0000000000000000ULL, 0x0000000000800000ULL, 0x0000000000800800ULL, 0x0000000000808080ULL,
+    0x0000000000820820ULL, 0x0000000000884210ULL, 0x0000000000888888ULL, 0x0000000000922448ULL,
+    0x0000000000924924ULL, 0x0000000000A4A4A4ULL, 0x0000000000A94A94ULL, 0x0000000000AAA554ULL,
+    0x0000000000AAAAAAULL, 0x0000000000D55AAAULL, 0x0000000000D6AD6AULL, 0x0000000000DADADAULL,
+    0x0000000000DB6DB6ULL, 0x0000000000EDDBB6ULL, 0x0000000000EEEEEEULL, 0x0000000000F7BDEEULL,
+    0x0000000000FBEFBEULL, 0x0000000000FEFEFEULL, 0x0000000000FFEFFEULL, 0x0000000000FFFFFEULL,
+    0x0000000000FFFFFFULL,
+    // n = 25
+    0x0000000000000000ULL, 0x0000000001000000ULL, 0x0000000001001000ULL, 0x0000000001010100ULL,
+    0x0000000001041040ULL, 0x0000000001084210ULL, 0x0000000001111110ULL, 0x0000000001224488ULL,
+    0x0000000001249248ULL, 0x0000000001492924ULL, 0x00000000014A5294ULL, 0x000000000154AA54ULL,
+    0x0000000001555554ULL, 0x0000000001AAAAAAULL, 0x0000000001AB55AAULL, 0x0000000001AD6B5AULL,
+    0x0000000001B6D6DAULL, 0x0000000001DB6DB6ULL, 0x0000000001DDBB76ULL, 0x0000000001EEEEEEULL,
+    0x0000000001EF7BDEULL, 0x0000000001FBEFBEULL, 0x0000000001FEFEFEULL, 0x0000000001FFEFFEULL,
+    0x0000000001FFFFFEULL, 0x0000000001FFFFFFULL,
+    // n = 26
+    0x0000000000000000ULL, 0x0000000002000000ULL, 0x0000000002001000ULL, 0x0000000002020100ULL,
+    0x0000000002081040ULL, 0x0000000002108420ULL, 0x0000000002221110ULL, 0x0000000002444888ULL,
+    0x0000000002491248ULL, 0x0000000002924924ULL, 0x00000000029494A4ULL, 0x0000000002A54A94ULL,
+    0x0000000002AA9554ULL, 0x0000000002AAAAAAULL, 0x0000000003555AAAULL, 0x00000000035AB56AULL,
+    0x00000000036B5B5AULL, 0x00000000036DB6DAULL, 0x0000000003B6DDB6ULL, 0x0000000003BBB776ULL,
+    0x0000000003DDDEEEULL, 0x0000000003EF7BDEULL, 0x0000000003F7DFBEULL, 0x0000000003FDFEFEULL,
+    0x0000000003FFDFFEULL, 0x0000000003FFFFFEULL, 0x0000000003FFFFFFULL,
+    // n = 27
+    0x0000000000000000ULL, 0x0000000004000000ULL, 0x0000000004002000ULL, 0x0000000004020100ULL,
+    0x0000000004102040ULL, 0x0000000004210420ULL, 0x0000000004422110ULL, 0x0000000004888888ULL,
+    0x0000000004912448ULL, 0x0000000004924924ULL, 0x0000000005252524ULL, 0x00000000054A5294ULL,
+    0x000000000552A954ULL, 0x0000000005555554ULL, 0x0000000006AAAAAAULL, 0x0000000006AB55AAULL,
+    0x0000000006B5AD6AULL, 0x0000000006DADADAULL, 0x0000000006DB6DB6ULL, 0x00000000076EDBB6ULL,
+    0x0000000007777776ULL, 0x0000000007BBDDEEULL, 0x0000000007DEFBDEULL, 0x0000000007EFDFBEULL,
+    0x0000000007FBFDFEULL, 0x0000000007FFDFFEULL, 0x0000000007FFFFFEULL, 0x0000000007FFFFFFULL,
+    // n = 28
+    0x0000000000000000ULL, 0x0000000008000000ULL, 0x0000000008002000ULL, 0x0000000008040200ULL,
+    0x0000000008102040ULL, 0x0000000008410820ULL, 0x0000000008842210ULL, 0x0000000008888888ULL,
+    0x0000000009122448ULL, 0x0000000009249248ULL, 0x000000000A492924ULL, 0x000000000A5294A4ULL,
+    0x000000000A952A54ULL, 0x000000000AAA9554ULL, 0x000000000AAAAAAAULL, 0x000000000D556AAAULL,
+    0x000000000D5AB56AULL, 0x000000000DAD6B5AULL, 0x000000000DB6B6DAULL, 0x000000000EDB6DB6ULL,
+    0x000000000EDDBB76ULL, 0x000000000EEEEEEEULL, 0x000000000F7BBDEEULL, 0x000000000FBEF7DEULL,
+    0x000000000FDFBF7EULL, 0x000000000FFBFDFEULL, 0x000000000FFFBFFEULL, 0x000000000FFFFFFEULL,
+    0x000000000FFFFFFFULL,
+    // n = 29
+    0x0000000000000000ULL, 0x0000000010000000ULL, 0x0000000010004000ULL, 0x0000000010080200ULL,
+    0x0000000010204080ULL, 0x0000000010820820ULL, 0x0000000011084210ULL, 0x0000000011111110ULL,
+    0x0000000012244488ULL, 0x0000000012491248ULL, 0x0000000014924924ULL, 0x0000000014A4A4A4ULL,
+    0x0000000015295294ULL, 0x000000001552A954ULL, 0x0000000015555554ULL, 0x000000001AAAAAAAULL,
+    0x000000001AAD56AAULL, 0x000000001AD6AD6AULL, 0x000000001B5B5B5AULL, 0x000000001B6DB6DAULL,
+    0x000000001DB6EDB6ULL, 0x000000001DDBBB76ULL, 0x000000001EEEEEEEULL, 0x000000001EF7BDEEULL,
+    0x000000001F7DF7DEULL, 0x000000001FDFBF7EULL, 0x000000001FF7FDFEULL, 0x000000001FFFBFFEULL,
+    0x000000001FFFFFFEULL, 0x000000001FFFFFFFULL,
+    // n = 30
+    0x0000000000000000ULL, 0x0000000020000000ULL, 0x0000000020004000ULL, 0x0000000020080200ULL,
+    0x0000000020404080ULL, 0x0000000020820820ULL, 0x0000000021084210ULL, 0x0000000022221110ULL,
+    0x0000000024444888ULL, 0x0000000024892248ULL, 0x0000000024924924ULL, 0x0000000029292524ULL,
+    0x00000000294A5294ULL, 0x000000002A952A54ULL, 0x000000002AAA5554ULL, 0x000000002AAAAAAAULL,
+    0x0000000035556AAAULL, 0x00000000356AD5AAULL, 0x0000000035AD6B5AULL, 0x0000000036D6DADAULL,
+    0x0000000036DB6DB6ULL, 0x000000003B6EDBB6ULL, 0x000000003BBB7776ULL, 0x000000003DDDEEEEULL,
+    0x000000003DEF7BDEULL, 0x000000003EFBEFBEULL, 0x000000003FBF7F7EULL, 0x000000003FEFFBFEULL,
+    0x000000003FFF7FFEULL, 0x000000003FFFFFFEULL, 0x000000003FFFFFFFULL,
+    // n = 31
+    0x0000000000000000ULL, 0x0000000040000000ULL, 0x0000000040008000ULL, 0x0000000040100400ULL,
+    0x0000000040808080ULL, 0x0000000041041040ULL, 0x0000000042108420ULL, 0x0000000044422110ULL,
+    0x0000000048888888ULL, 0x0000000049122448ULL, 0x0000000049249248ULL, 0x0000000052494924ULL,
+    0x00000000529494A4ULL, 0x0000000054A94A94ULL, 0x00000000554AA954ULL, 0x0000000055555554ULL,
+    0x000000006AAAAAAAULL, 0x000000006AB556AAULL, 0x000000006B56B56AULL, 0x000000006D6B6B5AULL,
+    0x000000006DB6B6DAULL, 0x0000000076DB6DB6ULL, 0x0000000076EDDBB6ULL, 0x0000000077777776ULL,
+    0x000000007BBDDEEEULL, 0x000000007DEF7BDEULL, 0x000000007EFBEFBEULL, 0x000000007F7F7F7EULL,
+    0x000000007FEFFBFEULL, 0x000000007FFF7FFEULL, 0x000000007FFFFFFEULL, 0x000000007FFFFFFFULL,
+    // n = 32
+    0x0000000000000000ULL, 0x0000000080000000ULL, 0x0000000080008000ULL, 0x0000000080200400ULL,
+    0x0000000080808080ULL, 0x0000000082081040ULL, 0x0000000084208420ULL, 0x0000000088442210ULL,
+    0x0000000088888888ULL, 0x0000000091224488ULL, 0x0000000092489248ULL, 0x00000000A4924924ULL,
+    0x00000000A4A4A4A4ULL, 0x00000000A94A5294ULL, 0x00000000AA54AA54ULL, 0x00000000AAAA5554ULL,
+    0x00000000AAAAAAAAULL, 0x00000000D555AAAAULL, 0x00000000D5AAD5AAULL, 0x00000000D6B5AD6AULL,
+    0x00000000DADADADAULL, 0x00000000DB6DB6DAULL, 0x00000000EDB6EDB6ULL, 0x00000000EEDDBB76ULL,
+    0x00000000EEEEEEEEULL, 0x00000000F7BBDDEEULL, 0x00000000FBDEFBDEULL, 0x00000000FDF7EFBEULL,
+    0x00000000FEFEFEFEULL, 0x00000000FFDFFBFEULL, 0x00000000FFFEFFFEULL, 0x00000000FFFFFFFEULL,
+    0x00000000FFFFFFFFULL,
+    // n = 33
+    0x0000000000000000ULL, 0x0000000100000000ULL, 0x0000000100010000ULL, 0x0000000100200400ULL,
+    0x0000000101010100ULL, 0x0000000104082040ULL, 0x0000000108210420ULL, 0x0000000110844210ULL,
+    0x0000000111111110ULL, 0x0000000122244488ULL, 0x0000000124892248ULL, 0x0000000124924924ULL,
+    0x0000000149292524ULL, 0x000000014A5294A4ULL, 0x0000000152A54A94ULL, 0x00000001552AA554ULL,
+    0x0000000155555554ULL, 0x00000001AAAAAAAAULL, 0x00000001AAB556AAULL, 0x00000001AD5AB56AULL,
+    0x00000001B5AD6B5AULL, 0x00000001B6B6D6DAULL, 0x00000001B6DB6DB6ULL, 0x00000001DB76DDB6ULL,
+    0x00000001DDBBB776ULL, 0x00000001EEEEEEEEULL, 0x00000001EF7BBDEEULL, 0x00000001F7BEF7DEULL,
+    0x00000001FBF7DFBEULL, 0x00000001FEFEFEFEULL, 0x00000001FFBFF7FEULL, 0x00000001FFFEFFFEULL,
+    0x00000001FFFFFFFEULL, 0x00000001FFFFFFFFULL,
+    // n = 34
+    0x0000000000000000ULL, 0x0000000200000000ULL, 0x0000000200010000ULL, 0x0000000200400800ULL,
+    0x0000000202010100ULL, 0x0000000208102040ULL, 0x0000000210410820ULL, 0x0000000221084210ULL,
+    0x0000000222211110ULL, 0x0000000244448888ULL, 0x0000000248912448ULL, 0x0000000249249248ULL,
+    0x0000000292494924ULL, 0x000000029494A4A4ULL, 0x00000002A5295294ULL, 0x00000002A954AA54ULL,
+    0x00000002AAA95554ULL, 0x00000002AAAAAAAAULL, 0x000000035555AAAAULL, 0x0000000356AB55AAULL,
+    0x000000035AD5AD6AULL, 0x000000036B6B5B5AULL, 0x000000036DB5B6DAULL, 0x00000003B6DB6DB6ULL,
+    0x00000003B76DDBB6ULL, 0x00000003BBBB7776ULL, 0x00000003DDDDEEEEULL, 0x00000003DEF7BDEEULL,
+    0x00000003EFBDF7DEULL, 0x00000003F7EFDFBEULL, 0x00000003FDFDFEFEULL, 0x00000003FFBFF7FEULL,
+    0x00000003FFFDFFFEULL, 0x00000003FFFFFFFEULL, 0x00000003FFFFFFFFULL,
+    // n = 35
+    0x0000000000000000ULL, 0x0000000400000000ULL, 0x0000000400020000ULL, 0x0000000400800800ULL,
+    0x0000000404020100ULL, 0x0000000408102040ULL, 0x0000000420820820ULL, 0x0000000421084210ULL,
+    0x0000000444222110ULL, 0x0000000488888888ULL, 0x0000000489122448ULL, 0x0000000492489248ULL,
+    0x0000000524924924ULL, 0x0000000525252524ULL, 0x00000005294A5294ULL, 0x000000054A952A54ULL,
+    0x00000005552AA554ULL, 0x0000000555555554ULL, 0x00000006AAAAAAAAULL, 0x00000006AAD55AAAULL,
+    0x00000006AD5AB56AULL, 0x00000006B5AD6B5AULL, 0x00000006DADADADAULL, 0x00000006DB6DB6DAULL,
+    0x000000076DB76DB6ULL, 0x000000076EDDBB76ULL, 0x0000000777777776ULL, 0x00000007BBDDDEEEULL,
+    0x00000007BDEF7BDEULL, 0x00000007DF7DF7DEULL, 0x00000007EFDFBF7EULL, 0x00000007FBFDFEFEULL,
+    0x00000007FF7FF7FEULL, 0x00000007FFFDFFFEULL, 0x00000007FFFFFFFEULL, 0x00000007FFFFFFFFULL,
+    // n = 36
+    0x0000000000000000ULL, 0x0000000800000000ULL, 0x0000000800020000ULL, 0x0000000800800800ULL,
+    0x0000000804020100ULL, 0x0000000810204080ULL, 0x0000000820820820ULL, 0x0000000842108420ULL,
+    0x0000000884422110ULL, 0x0000000888888888ULL, 0x0000000912224488ULL, 0x0000000924492248ULL,
+    0x0000000924924924ULL, 0x0000000A49492924ULL, 0x0000000A529294A4ULL, 0x0000000A94A94A94ULL,
+    0x0000000AA552A954ULL, 0x0000000AAAA95554ULL, 0x0000000AAAAAAAAAULL, 0x0000000D5556AAAAULL,
+    0x0000000D56AB55AAULL, 0x0000000D6AD6AD6AULL, 0x0000000DAD6B6B5AULL, 0x0000000DB6B6D6DAULL,
+    0x0000000DB6DB6DB6ULL, 0x0000000EDBB6DDB6ULL, 0x0000000EEDDBBB76ULL, 0x0000000EEEEEEEEEULL,
+    0x0000000F77BBDDEEULL, 0x0000000FBDEF7BDEULL, 0x0000000FBEFBEFBEULL, 0x0000000FEFDFBF7EULL,
+    0x0000000FF7FBFDFEULL, 0x0000000FFEFFEFFEULL, 0x0000000FFFFBFFFEULL, 0x0000000FFFFFFFFEULL,
+    0x0000000FFFFFFFFFULL,
+    // n = 37
+    0x0000000000000000ULL, 0x0000001000000000ULL, 0x0000001000040000ULL, 0x0000001001001000ULL,
+    0x0000001008040200ULL, 0x0000001020404080ULL, 0x0000001041041040ULL, 0x0000001084208420ULL,
+    0x0000001108842210ULL, 0x0000001111111110ULL, 0x0000001222444888ULL, 0x0000001244912448ULL,
+    0x0000001249249248ULL, 0x00000014924A4924ULL, 0x00000014A4A4A4A4ULL, 0x00000015294A5294ULL,
+    0x000000154A952A54ULL, 0x0000001554AAA554ULL, 0x0000001555555554ULL, 0x0000001AAAAAAAAAULL,
+    0x0000001AAB555AAAULL, 0x0000001AB56AD5AAULL, 0x0000001AD6B5AD6AULL, 0x0000001B5B5B5B5AULL,
+    0x0000001B6DB5B6DAULL, 0x0000001DB6DB6DB6ULL, 0x0000001DBB6EDBB6ULL, 0x0000001DDDBBB776ULL,
+    0x0000001EEEEEEEEEULL, 0x0000001EF77BDDEEULL, 0x0000001F7BDF7BDEULL, 0x0000001FBEFBEFBEULL,
+    0x0000001FDFBFBF7EULL, 0x0000001FF7FBFDFEULL, 0x0000001FFEFFEFFEULL, 0x0000001FFFFBFFFEULL,
+    0x0000001FFFFFFFFEULL, 0x0000001FFFFFFFFFULL,
+    // n = 38
+    0x0000000000000000ULL, 0x0000002000000000ULL, 0x0000002000040000ULL, 0x0000002002001000ULL,
+    0x0000002010040200ULL, 0x0000002040408080ULL, 0x0000002082041040ULL, 0x0000002108210420ULL,
+    0x0000002210844210ULL, 0x0000002222211110ULL, 0x0000002444448888ULL, 0x0000002489122448ULL,
+    0x0000002492449248ULL, 0x0000002924924924ULL, 0x0000002929252524ULL, 0x000000294A5294A4ULL,
+    0x0000002A54A54A94ULL, 0x0000002AA552A954ULL, 0x0000002AAAA55554ULL, 0x0000002AAAAAAAAAULL,
+    0x000000355556AAAAULL, 0x000000355AAD56AAULL, 0x00000035AB56B56AULL, 0x00000036B5AD6B5AULL,
+    0x00000036D6D6DADAULL, 0x00000036DB6DB6DAULL, 0x0000003B6DB76DB6ULL, 0x0000003B76EDDBB6ULL,
+    0x0000003BBBB77776ULL, 0x0000003DDDDEEEEEULL, 0x0000003DEF77BDEEULL, 0x0000003EF7DEFBDEULL,
+    0x0000003F7DF7EFBEULL, 0x0000003FBFBF7F7EULL, 0x0000003FEFF7FDFEULL, 0x0000003FFDFFEFFEULL,
+    0x0000003FFFF7FFFEULL, 0x0000003FFFFFFFFEULL, 0x0000003FFFFFFFFFULL,
+    // n = 39
+    0x0000000000000000ULL, 0x0000004000000000ULL, 0x0000004000080000ULL, 0x0000004002001000ULL,
+    0x0000004020080200ULL, 0x0000004080808080ULL, 0x0000004102081040ULL, 0x0000004208410820ULL,
+    0x0000004421084210ULL, 0x0000004442221110ULL, 0x0000004888888888ULL, 0x0000004891224488ULL,
+    0x0000004922491248ULL, 0x0000004924924924ULL, 0x000000524A492924ULL, 0x00000052929494A4ULL,
+    0x00000054A52A5294ULL, 0x000000552A552A54ULL, 0x0000005552AA9554ULL, 0x0000005555555554ULL,
+    0x0000006AAAAAAAAAULL, 0x0000006AAB555AAAULL, 0x0000006AD5AAD5AAULL, 0x0000006B5AD5AD6AULL,
+    0x0000006D6B6B5B5AULL, 0x0000006DB5B6D6DAULL, 0x0000006DB6DB6DB6ULL, 0x00000076DBB6DDB6ULL,
+    0x000000776EDDBB76ULL, 0x0000007777777776ULL, 0x0000007BBBDDDEEEULL, 0x0000007BDEF7BDEEULL,
+    0x0000007DF7BEF7DEULL, 0x0000007EFBF7DFBEULL, 0x0000007F7F7F7F7EULL, 0x0000007FDFF7FDFEULL,
+    0x0000007FFBFFDFFEULL, 0x0000007FFFF7FFFEULL, 0x0000007FFFFFFFFEULL, 0x0000007FFFFFFFFFULL,
+    // n = 40
+    0x0000000000000000ULL, 0x0000008000000000ULL, 0x0000008000080000ULL, 0x0000008004002000ULL,
+    0x0000008020080200ULL, 0x0000008080808080ULL, 0x0000008204082040ULL, 0x0000008410420820ULL,
+    0x0000008421084210ULL, 0x0000008884422110ULL, 0x0000008888888888ULL, 0x0000009122244488ULL,
+    0x0000009224892248ULL, 0x0000009249249248ULL, 0x000000A4924A4924ULL, 0x000000A4A4A4A4A4ULL,
+    0x000000A5294A5294ULL, 0x000000A952A54A94ULL, 0x000000AA954AA954ULL, 0x000000AAAAA55554ULL,
+    0x000000AAAAAAAAAAULL, 0x000000D5555AAAAAULL, 0x000000D56AAD56AAULL, 0x000000D6AD5AB56AULL,
+    0x000000D6B5AD6B5AULL, 0x000000DADADADADAULL, 0x000000DB6DADB6DAULL, 0x000000EDB6DB6DB6ULL,
+    0x000000EDBB6EDBB6ULL, 0x000000EEDDDBBB76ULL, 0x000000EEEEEEEEEEULL, 0x000000F77BBDDEEEULL,
+    0x000000F7BDEF7BDEULL, 0x000000FBEFBDF7DEULL, 0x000000FDFBEFDFBEULL, 0x000000FEFEFEFEFEULL,
+    0x000000FFBFEFFBFEULL, 0x000000FFFBFFDFFEULL, 0x000000FFFFEFFFFEULL, 0x000000FFFFFFFFFEULL,
+    0x000000FFFFFFFFFFULL,
+    // n = 41
+    0x0000000000000000ULL, 0x0000010000000000ULL, 0x0000010000100000ULL, 0x0000010008002000ULL,
+    0x0000010040100400ULL, 0x0000010101010100ULL, 0x0000010408102040ULL, 0x0000010820820820ULL,
+    0x0000010842108420ULL, 0x0000011088442210ULL, 0x0000011111111110ULL, 0x0000012224444888ULL,
+    0x0000012448922448ULL, 0x0000012492449248ULL, 0x0000014924924924ULL, 0x0000014949292524ULL,
+    0x0000014A529294A4ULL, 0x0000015295295294ULL, 0x00000154AA54AA54ULL, 0x0000015552AA9554ULL,
+    0x0000015555555554ULL, 0x000001AAAAAAAAAAULL, 0x000001AAAD556AAAULL, 0x000001AB55AB55AAULL,
+    0x000001AD6AD6AD6AULL, 0x000001B5AD6D6B5AULL, 0x000001B6B6D6DADAULL, 0x000001B6DB6DB6DAULL,
+    0x000001DB6DBB6DB6ULL, 0x000001DBB76DDBB6ULL, 0x000001DDDBBBB776ULL, 0x000001EEEEEEEEEEULL,
+    0x000001EF77BBDDEEULL, 0x000001F7BDEF7BDEULL, 0x000001F7DF7DF7DEULL, 0x000001FBF7EFDFBEULL,
+    0x000001FEFEFEFEFEULL, 0x000001FFBFEFFBFEULL, 0x000001FFF7FFDFFEULL, 0x000001FFFFEFFFFEULL,
+    0x000001FFFFFFFFFEULL, 0x000001FFFFFFFFFFULL,
+    // n = 42
+    0x0000000000000000ULL, 0x0000020000000000ULL, 0x0000020000100000ULL, 0x0000020008002000ULL,
+    0x0000020080100400ULL, 0x0000020202010100ULL, 0x0000020408102040ULL, 0x0000020820820820ULL,
+    0x0000021084108420ULL, 0x0000022108842210ULL, 0x0000022222111110ULL, 0x0000024444488888ULL,
+    0x0000024489122448ULL, 0x0000024922491248ULL, 0x0000024924924924ULL, 0x000002924A492924ULL,
+    0x000002949494A4A4ULL, 0x000002A5294A5294ULL, 0x000002A54A952A54ULL, 0x000002AA554AA954ULL,
+    0x000002AAAA955554ULL, 0x000002AAAAAAAAAAULL, 0x00000355555AAAAAULL, 0x00000355AAB556AAULL,
+    0x00000356AD5AB56AULL, 0x0000035AD6B5AD6AULL, 0x0000036B6B5B5B5AULL, 0x0000036DADB6B6DAULL,
+    0x0000036DB6DB6DB6ULL, 0x000003B6DDB6EDB6ULL, 0x000003B76EDDBB76ULL, 0x000003BBBBB77776ULL,
+    0x000003DDDDDEEEEEULL, 0x000003DEEF7BBDEEULL, 0x000003EF7BDF7BDEULL, 0x000003EFBEFBEFBEULL,
+    0x000003F7EFDFBF7EULL, 0x000003FDFDFEFEFEULL, 0x000003FF7FDFFBFEULL, 0x000003FFEFFFBFFEULL,
+    0x000003FFFFDFFFFEULL, 0x000003FFFFFFFFFEULL, 0x000003FFFFFFFFFFULL,
+    // n = 43
+    0x0000000000000000ULL, 0x0000040000000000ULL, 0x0000040000200000ULL, 0x0000040010004000ULL,
+    0x0000040100200400ULL, 0x0000040402020100ULL, 0x0000040810204080ULL, 0x0000041041041040ULL,
+    0x0000042104210420ULL, 0x0000044210884210ULL, 0x0000044442221110ULL, 0x0000048888888888ULL,
+    0x0000048912224488ULL, 0x0000049224892248ULL, 0x0000049249249248ULL, 0x0000052492524924ULL,
+    0x0000052525252524ULL, 0x000005294A5294A4ULL, 0x0000054A94A94A94ULL, 0x00000552A954AA54ULL,
+    0x000005554AAA9554ULL, 0x0000055555555554ULL, 0x000006AAAAAAAAAAULL, 0x000006AAB5556AAAULL,
+    0x000006AD56AB55AAULL, 0x000006B56B56B56AULL, 0x000006D6B5AD6B5AULL, 0x000006DADADADADAULL,
+    0x000006DB6DADB6DAULL, 0x0000076DB6DB6DB6ULL, 0x0000076DDB76DDB6ULL, 0x00000776EDDDBB76ULL,
+    0x0000077777777776ULL, 0x000007BBBDDDEEEEULL, 0x000007BDEF77BDEEULL, 0x000007DEFBDEFBDEULL,
+    0x000007EFBEFBEFBEULL, 0x000007F7EFDFBF7EULL, 0x000007FBFDFDFEFEULL, 0x000007FEFFDFFBFEULL,
+    0x000007FFEFFFBFFEULL, 0x000007FFFFDFFFFEULL, 0x000007FFFFFFFFFEULL, 0x000007FFFFFFFFFFULL,
+    // n = 44
+    0x0000000000000000ULL, 0x0000080000000000ULL, 0x0000080000200000ULL, 0x0000080020004000ULL,
+    0x0000080100200400ULL, 0x0000080804020100ULL, 0x0000081020204080ULL, 0x0000082082041040ULL,
+    0x0000084108210420ULL, 0x0000088421084210ULL, 0x0000088844222110ULL, 0x0000088888888888ULL,
+    0x0000091122244488ULL, 0x0000092248912448ULL, 0x0000092492249248ULL, 0x00000A4924924924ULL,
+    0x00000A4949292524ULL, 0x00000A52929494A4ULL, 0x00000A94A52A5294ULL, 0x00000AA54A952A54ULL,
+    0x00000AA9552AA554ULL, 0x00000AAAAA955554ULL, 0x00000AAAAAAAAAAAULL, 0x00000D55556AAAAAULL,
+    0x00000D55AAB556AAULL, 0x00000D5AB56AD5AAULL, 0x00000D6B5AB5AD6AULL, 0x00000DAD6D6B6B5AULL,
+    0x00000DB5B6B6D6DAULL, 0x00000DB6DB6DB6DAULL, 0x00000EDB6DBB6DB6ULL, 0x00000EDDB76EDBB6ULL,
+    0x00000EEDDDBBB776ULL, 0x00000EEEEEEEEEEEULL, 0x00000F77BBBDDEEEULL, 0x00000F7BDEF7BDEEULL,
+    0x00000FBDF7BEF7DEULL, 0x00000FDF7DFBEFBEULL, 0x00000FEFDFBFBF7EULL, 0x00000FF7FBFDFEFEULL,
+    0x00000FFDFFBFF7FEULL, 0x00000FFFDFFFBFFEULL, 0x00000FFFFFBFFFFEULL, 0x00000FFFFFFFFFFEULL,
+    0x00000FFFFFFFFFFFULL,
+    // n = 45
+    0x0000000000000000ULL, 0x0000100000000000ULL, 0x0000100000400000ULL, 0x0000100020004000ULL,
+    0x0000100200400800ULL, 0x0000100804020100ULL, 0x0000102020404080ULL, 0x0000104102081040ULL,
+    0x0000108210410820ULL, 0x0000108421084210ULL, 0x0000110884422110ULL, 0x0000111111111110ULL,
+    0x0000122224444888ULL, 0x0000124489122448ULL, 0x0000124912491248ULL, 0x0000124924924924ULL,
+    0x0000149252494924ULL, 0x000014A4A4A4A4A4ULL, 0x000014A5294A5294ULL, 0x0000152A54A54A94ULL,
+    0x0000154AA552A954ULL, 0x000015552AAA5554ULL, 0x0000155555555554ULL, 0x00001AAAAAAAAAAAULL,
+    0x00001AAAB5556AAAULL, 0x00001AAD56AB55AAULL, 0x00001AD5AB5AB56AULL, 0x00001AD6B5AD6B5AULL,
+    0x00001B5B5B5B5B5AULL, 0x00001B6DADB6B6DAULL, 0x00001B6DB6DB6DB6ULL, 0x00001DB6EDB6EDB6ULL,
+    0x00001DBB76EDDBB6ULL, 0x00001DDDBBBB7776ULL, 0x00001EEEEEEEEEEEULL, 0x00001EEF77BBDDEEULL,
+    0x00001EF7BDEF7BDEULL, 0x00001F7DEFBEF7DEULL, 0x00001FBEFDF7EFBEULL, 0x00001FDFBFBF7F7EULL,
+    0x00001FEFF7FBFDFEULL, 0x00001FFDFFBFF7FEULL, 0x00001FFFBFFF7FFEULL, 0x00001FFFFFBFFFFEULL,
+    0x00001FFFFFFFFFFEULL, 0x00001FFFFFFFFFFFULL,
+    // n = 46
+    0x0000000000000000ULL, 0x0000200000000000ULL, 0x0000200000400000ULL, 0x0000200040008000ULL,
+    0x0000200400400800ULL, 0x0000201008040200ULL, 0x0000204040408080ULL, 0x0000208104082040ULL,
+    0x0000210410420820ULL, 0x0000210842108420ULL, 0x0000221108442210ULL, 0x0000222222111110ULL,
+    0x0000244444488888ULL, 0x0000244891224488ULL, 0x0000249124492248ULL, 0x0000249249249248ULL,
+    0x0000292492524924ULL, 0x0000292929252524ULL, 0x0000294A525294A4ULL, 0x00002A52A5295294ULL,
+    0x00002A952A552A54ULL, 0x00002AA9552AA554ULL, 0x00002AAAAA555554ULL, 0x00002AAAAAAAAAAAULL,
+    0x00003555556AAAAAULL, 0x00003556AAD55AAAULL, 0x0000356AD56AD5AAULL, 0x000035AD5AD6AD6AULL,
+    0x000036B5AD6D6B5AULL, 0x000036D6D6DADADAULL, 0x000036DB6D6DB6DAULL, 0x00003B6DB6DB6DB6ULL,
+    0x00003B6EDB76DDB6ULL, 0x00003BB76EDDBB76ULL, 0x00003BBBBB777776ULL, 0x00003DDDDDEEEEEEULL,
+    0x00003DEEF77BDDEEULL, 0x00003EF7BDEF7BDEULL, 0x00003EFBEF7DF7DEULL, 0x00003F7EFBF7DFBEULL,
+    0x00003FBFBF7F7F7EULL, 0x00003FEFF7FBFDFEULL, 0x00003FFBFF7FF7FEULL, 0x00003FFFBFFF7FFEULL,
+    0x00003FFFFF7FFFFEULL, 0x00003FFFFFFFFFFEULL, 0x00003FFFFFFFFFFFULL,
+    // n = 47
+    0x0000000000000000ULL, 0x0000400000000000ULL, 0x0000400000800000ULL, 0x0000400080008000ULL,
+    0x0000400800800800ULL, 0x0000402010040200ULL, 0x0000408080808080ULL, 0x0000410204102040ULL,
+    0x0000420820820820ULL, 0x0000421084108420ULL, 0x0000442110844210ULL, 0x0000444422221110ULL,
+    0x0000488888888888ULL, 0x0000489112244488ULL, 0x0000491244912448ULL, 0x0000492492249248ULL,
+    0x0000524924924924ULL, 0x0000524A49492924ULL, 0x000052929494A4A4ULL, 0x000054A5294A5294ULL,
+    0x000054A952A54A94ULL, 0x0000554AA552A954ULL, 0x000055552AAA5554ULL, 0x0000555555555554ULL,
+    0x00006AAAAAAAAAAAULL, 0x00006AAAD555AAAAULL, 0x00006AB55AAD56AAULL, 0x00006B56AD5AB56AULL,
+    0x00006B5AD6B5AD6AULL, 0x00006D6D6B6B5B5AULL, 0x00006DB5B6B6D6DAULL, 0x00006DB6DB6DB6DAULL,
+    0x000076DB6DDB6DB6ULL, 0x000076EDBB6EDBB6ULL, 0x0000776EEDDBBB76ULL, 0x0000777777777776ULL,
+    0x00007BBBDDDDEEEEULL, 0x00007BDEEF7BBDEEULL, 0x00007DEF7BEF7BDEULL, 0x00007DF7DF7DF7DEULL,
+    0x00007EFDFBEFDFBEULL, 0x00007F7F7F7F7F7EULL, 0x00007FDFEFFBFDFEULL, 0x00007FF7FF7FF7FEULL,
+    0x00007FFF7FFF7FFEULL, 0x00007FFFFF7FFFFEULL, 0x00007FFFFFFFFFFEULL, 0x00007FFFFFFFFFFFULL,
+    // n = 48
+    0x0000000000000000ULL, 0x0000800000000000ULL, 0x0000800000800000ULL, 0x0000800080008000ULL,
+    0x0000800800800800ULL, 0x0000804010080200ULL, 0x0000808080808080ULL, 0x0000820408102040ULL,
+    0x0000820820820820ULL, 0x0000842084208420ULL, 0x0000884210884210ULL, 0x0000888444222110ULL,
+    0x0000888888888888ULL, 0x0000911222444888ULL, 0x0000922448922448ULL, 0x0000924892489248ULL,
+    0x0000924924924924ULL, 0x0000A49292494924ULL, 0x0000A4A4A4A4A4A4ULL, 0x0000A5294A5294A4ULL,
+    0x0000A94A94A94A94ULL, 0x0000AA54AA54AA54ULL, 0x0000AAA554AAA554ULL, 0x0000AAAAAA555554ULL,
+    0x0000AAAAAAAAAAAAULL, 0x0000D55555AAAAAAULL, 0x0000D55AAAD55AAAULL, 0x0000D5AAD5AAD5AAULL,
+    0x0000D6AD6AD6AD6AULL, 0x0000DAD6B5AD6B5AULL, 0x0000DADADADADADAULL, 0x0000DB6D6DB6B6DAULL,
+    0x0000DB6DB6DB6DB6ULL, 0x0000EDB6EDB6EDB6ULL, 0x0000EDDBB6EDDBB6ULL, 0x0000EEEDDDBBB776ULL,
+    0x0000EEEEEEEEEEEEULL, 0x0000F77BBBDDDEEEULL, 0x0000F7BDEEF7BDEEULL, 0x0000FBDEFBDEFBDEULL,
+    0x0000FBEFBEFBEFBEULL, 0x0000FDFBF7EFDFBEULL, 0x0000FEFEFEFEFEFEULL, 0x0000FFBFEFF7FDFEULL,
+    0x0000FFEFFEFFEFFEULL, 0x0000FFFEFFFEFFFEULL, 0x0000FFFFFEFFFFFEULL, 0x0000FFFFFFFFFFFEULL,
+    0x0000FFFFFFFFFFFFULL,
+    // n = 49
+    0x0000000000000000ULL, 0x0001000000000000ULL, 0x0001000001000000ULL, 0x0001000100010000ULL,
+    0x0001001001001000ULL, 0x0001008020080200ULL, 0x0001010101010100ULL, 0x0001020408102040ULL,
+    0x0001041041041040ULL, 0x0001084108210420ULL, 0x0001108421084210ULL, 0x0001110884422110ULL,
+    0x0001111111111110ULL, 0x0001222244448888ULL, 0x0001224489122448ULL, 0x0001248924492248ULL,
+    0x0001249249249248ULL, 0x0001492492924924ULL, 0x0001494929292524ULL, 0x00014A52529494A4ULL,
+    0x00015294A54A5294ULL, 0x000152A54A952A54ULL, 0x0001552A9552A954ULL, 0x00015554AAAA5554ULL,
+    0x0001555555555554ULL, 0x0001AAAAAAAAAAAAULL, 0x0001AAAB5555AAAAULL, 0x0001AAD56AAD56AAULL,
+    0x0001AB56AD5AB56AULL, 0x0001AD6B5AB5AD6AULL, 0x0001B5ADAD6B6B5AULL, 0x0001B6B6D6D6DADAULL,
+    0x0001B6DB6D6DB6DAULL, 0x0001DB6DB6DB6DB6ULL, 0x0001DB76DBB6DDB6ULL, 0x0001DBB76EDDBB76ULL,
+    0x0001DDDDBBBB7776ULL, 0x0001EEEEEEEEEEEEULL, 0x0001EEF77BBDDEEEULL, 0x0001EF7BDEF7BDEEULL,
+    0x0001F7BEF7DEFBDEULL, 0x0001FBEFBEFBEFBEULL, 0x0001FBF7EFDFBF7EULL, 0x0001FEFEFEFEFEFEULL,
+    0x0001FF7FDFF7FDFEULL, 0x0001FFEFFEFFEFFEULL, 0x0001FFFEFFFEFFFEULL, 0x0001FFFFFEFFFFFEULL,
+    0x0001FFFFFFFFFFFEULL, 0x0001FFFFFFFFFFFFULL,
+    // n = 50
+    0x0000000000000000ULL, 0x0002000000000000ULL, 0x0002000001000000ULL, 0x0002000200010000ULL,
+    0x0002002001001000ULL, 0x0002008020080200ULL, 0x0002020201010100ULL, 0x0002040810204080ULL,
+    0x0002082081041040ULL, 0x0002104208410820ULL, 0x0002108421084210ULL, 0x0002211088442210ULL,
+    0x0002222221111110ULL, 0x0002444444888888ULL, 0x0002448911224488ULL, 0x0002489224892248ULL,
+    0x0002492491249248ULL, 0x0002924924924924ULL, 0x0002925249492924ULL, 0x0002949494A4A4A4ULL,
+    0x000294A5294A5294ULL, 0x0002A54A54A94A94ULL, 0x0002A954A954AA54ULL, 0x0002AA9554AAA554ULL,
+    0x0002AAAAA9555554ULL, 0x0002AAAAAAAAAAAAULL, 0x0003555555AAAAAAULL, 0x0003556AAB555AAAULL,
+    0x000356AB55AB55AAULL, 0x00035AB5AB56B56AULL, 0x00035AD6B5AD6B5AULL, 0x00036B6B6B5B5B5AULL,
+    0x00036DADB5B6D6DAULL, 0x00036DB6DB6DB6DAULL, 0x0003B6DB6DDB6DB6ULL, 0x0003B6EDBB6EDBB6ULL,
+    0x0003BB76EDDDBB76ULL, 0x0003BBBBBB777776ULL, 0x0003DDDDDDEEEEEEULL, 0x0003DEEF77BBDDEEULL,
+    0x0003DEF7BDEF7BDEULL, 0x0003EFBDF7BEF7DEULL, 0x0003F7DF7DFBEFBEULL, 0x0003FBF7EFDFBF7EULL,
+    0x0003FDFDFDFEFEFEULL, 0x0003FEFFBFEFFBFEULL, 0x0003FFDFFDFFEFFEULL, 0x0003FFFDFFFEFFFEULL,
+    0x0003FFFFFDFFFFFEULL, 0x0003FFFFFFFFFFFEULL, 0x0003FFFFFFFFFFFFULL,
+    // n = 51
+    0x0000000000000000ULL, 0x0004000000000000ULL, 0x0004000002000000ULL, 0x0004000200010000ULL,
+    0x0004004002001000ULL, 0x0004010040100400ULL, 0x0004040202010100ULL, 0x0004081020204080ULL,
+    0x0004104082081040ULL, 0x0004208210410820ULL, 0x0004210842108420ULL, 0x0004422108842210ULL,
+    0x0004444222211110ULL, 0x0004888888888888ULL, 0x0004891122244488ULL, 0x0004912248912448ULL,
+    0x0004924892489248ULL, 0x0004924924924924ULL, 0x0005249292494924ULL, 0x0005252525252524ULL,
+    0x0005294A525294A4ULL, 0x00054A52A5295294ULL, 0x000552A54A952A54ULL, 0x000554AA954AA954ULL,
+    0x00055552AAA95554ULL, 0x0005555555555554ULL, 0x0006AAAAAAAAAAAAULL, 0x0006AAAB5555AAAAULL,
+    0x0006AB556AB556AAULL, 0x0006AD5AB56AD5AAULL, 0x0006B5AB5AD5AD6AULL, 0x0006D6B5ADAD6B5AULL,
+    0x0006DADADADADADAULL, 0x0006DB6B6DB5B6DAULL, 0x0006DB6DB6DB6DB6ULL, 0x00076DB76DB76DB6ULL,
+    0x00076EDBB76DDBB6ULL, 0x000776EEDDDBBB76ULL, 0x0007777777777776ULL, 0x0007BBBBDDDDEEEEULL,
+    0x0007BDDEF77BDDEEULL, 0x0007DEF7BDEF7BDEULL, 0x0007DF7BEFBDF7DEULL, 0x0007EFBF7DF7EFBEULL,
+    0x0007F7EFDFDFBF7EULL, 0x0007FBFBFDFDFEFEULL, 0x0007FEFFBFEFFBFEULL, 0x0007FFBFFDFFEFFEULL,
+    0x0007FFFBFFFDFFFEULL, 0x0007FFFFFDFFFFFEULL, 0x0007FFFFFFFFFFFEULL, 0x0007FFFFFFFFFFFFULL,
+    // n = 52
+    0x0000000000000000ULL, 0x0008000000000000ULL, 0x0008000002000000ULL, 0x0008000400020000ULL,
+    0x0008004002001000ULL, 0x0008020080100400ULL, 0x0008080402020100ULL, 0x0008102020404080ULL,
+    0x0008204102081040ULL, 0x0008410410820820ULL, 0x0008421082108420ULL, 0x0008842210844210ULL,
+    0x0008884442221110ULL, 0x0008888888888888ULL, 0x0009112222444888ULL, 0x0009224489122448ULL,
+    0x0009244922491248ULL, 0x0009249249249248ULL, 0x000A492492924924ULL, 0x000A4A4949292524ULL,
+    0x000A5252929494A4ULL, 0x000A94A5294A5294ULL, 0x000A952A52A54A94ULL, 0x000AA552A954AA54ULL,
+    0x000AAA5552AA9554ULL, 0x000AAAAAA9555554ULL, 0x000AAAAAAAAAAAAAULL, 0x000D555556AAAAAAULL,
+    0x000D556AAB555AAAULL, 0x000D5AAD56AB55AAULL, 0x000D6AD5AB5AB56AULL, 0x000D6B5AD6B5AD6AULL,
+    0x000DAD6D6B6B5B5AULL, 0x000DB5B6B6D6DADAULL, 0x000DB6DB6B6DB6DAULL, 0x000EDB6DB6DB6DB6ULL,
+    0x000EDB76DBB6DDB6ULL, 0x000EDDBB76EDDBB6ULL, 0x000EEEDDDBBBB776ULL, 0x000EEEEEEEEEEEEEULL,
+    0x000F777BBBDDDEEEULL, 0x000F7BDDEF7BBDEEULL, 0x000FBDEF7BEF7BDEULL, 0x000FBEFBEF7DF7DEULL,
+    0x000FDF7EFBF7DFBEULL, 0x000FEFDFDFBFBF7EULL, 0x000FF7FBFBFDFEFEULL, 0x000FFDFF7FEFFBFEULL,
+    0x000FFF7FFBFFDFFEULL, 0x000FFFFBFFFDFFFEULL, 0x000FFFFFFBFFFFFEULL, 0x000FFFFFFFFFFFFEULL,
+    0x000FFFFFFFFFFFFFULL,
+    // n = 53
+    0x0000000000000000ULL, 0x0010000000000000ULL, 0x0010000004000000ULL, 0x0010000800020000ULL,
+    0x0010008004002000ULL, 0x0010040080200400ULL, 0x0010100804020100ULL, 0x0010202040408080ULL,
+    0x0010408204082040ULL, 0x0010820820820820ULL, 0x0010842084208420ULL, 0x0011084211084210ULL,
+    0x0011108844422110ULL, 0x0011111111111110ULL, 0x0012222444448888ULL, 0x0012244891224488ULL,
+    0x0012489224892248ULL, 0x0012492491249248ULL, 0x0014924924924924ULL, 0x001492924A492924ULL,
+    0x0014A4A4A4A4A4A4ULL, 0x0014A5294A5294A4ULL, 0x0015295295295294ULL, 0x00154A952A952A54ULL,
+    0x001552AA554AA954ULL, 0x00155552AAA95554ULL, 0x0015555555555554ULL, 0x001AAAAAAAAAAAAAULL,
+    0x001AAAAD5556AAAAULL, 0x001AAD55AAB556AAULL, 0x001AB56AD56AD5AAULL, 0x001AD6AD6AD6AD6AULL,
+    0x001B5AD6B5AD6B5AULL, 0x001B5B5B5B5B5B5AULL, 0x001B6D6DB5B6D6DAULL, 0x001B6DB6DB6DB6DAULL,
+    0x001DB6DB6EDB6DB6ULL, 0x001DB76DDB76DDB6ULL, 0x001DDBB76EDDBB76ULL, 0x001DDDDBBBBB7776ULL,
+    0x001EEEEEEEEEEEEEULL, 0x001EEF77BBBDDEEEULL, 0x001EF7BDEEF7BDEEULL, 0x001F7BDF7BDF7BDEULL,
+    0x001F7DF7DF7DF7DEULL, 0x001FBF7DFBF7DFBEULL, 0x001FDFDFBFBF7F7EULL, 0x001FEFF7FBFDFEFEULL,
+    0x001FFBFF7FDFFBFEULL, 0x001FFF7FFBFFDFFEULL, 0x001FFFF7FFFDFFFEULL, 0x001FFFFFFBFFFFFEULL,
+    0x001FFFFFFFFFFFFEULL, 0x001FFFFFFFFFFFFFULL,
+    // n = 54
+    0x0000000000000000ULL, 0x0020000000000000ULL, 0x0020000004000000ULL, 0x0020000800020000ULL,
+    0x0020010004002000ULL, 0x0020080100200400ULL, 0x0020100804020100ULL, 0x0020404040808080ULL,
+    0x0020810204102040ULL, 0x0020820820820820ULL, 0x0021082104210420ULL, 0x0022108421084210ULL,
+    0x0022110884422110ULL, 0x0022222221111110ULL, 0x0024444444888888ULL, 0x0024488912224488ULL,
+    0x0024892244912448ULL, 0x0024924492489248ULL, 0x0024924924924924ULL, 0x00292494924A4924ULL,
+    0x0029292925252524ULL, 0x00294A4A529294A4ULL, 0x002A5294A54A5294ULL, 0x002A54A952A54A94ULL,
+    0x002A954AA552A954ULL, 0x002AAA5552AA9554ULL, 0x002AAAAAA5555554ULL, 0x002AAAAAAAAAAAAAULL,
+    0x0035555556AAAAAAULL, 0x003555AAAD556AAAULL, 0x00355AAD56AB55AAULL, 0x0035AB56AD5AB56AULL,
+    0x0035AD6B56B5AD6AULL, 0x0036B5ADAD6B6B5AULL, 0x0036D6D6D6DADADAULL, 0x0036DB6B6DB5B6DAULL,
+    0x0036DB6DB6DB6DB6ULL, 0x003B6DBB6DB76DB6ULL, 0x003B76DDB76EDBB6ULL, 0x003BB76EEDDBBB76ULL,
+    0x003BBBBBB7777776ULL, 0x003DDDDDDEEEEEEEULL, 0x003DDEEF77BBDDEEULL, 0x003DEF7BDEF7BDEEULL,
+    0x003EF7DEF7DEFBDEULL, 0x003EFBEFBEFBEFBEULL, 0x003F7EFDF7EFDFBEULL, 0x003FBFBFBF7F7F7EULL,
+    0x003FDFEFF7FBFDFEULL, 0x003FF7FEFFDFFBFEULL, 0x003FFEFFF7FFDFFEULL, 0x003FFFEFFFFBFFFEULL,
+    0x003FFFFFF7FFFFFEULL, 0x003FFFFFFFFFFFFEULL, 0x003FFFFFFFFFFFFFULL,
+    // n = 55
+    0x0000000000000000ULL, 0x0040000000000000ULL, 0x0040000008000000ULL, 0x0040001000040000ULL,
+    0x0040020008002000ULL, 0x0040080100200400ULL, 0x0040201008040200ULL, 0x0040808080808080ULL,
+    0x0041020408102040ULL, 0x0041041041041040ULL, 0x0042084108210420ULL, 0x0042108421084210ULL,
+    0x0044221108442210ULL, 0x0044444222211110ULL, 0x0048888888888888ULL, 0x0048891122244488ULL,
+    0x0049122449122448ULL, 0x0049244922491248ULL, 0x0049249249249248ULL, 0x0052492494924924ULL,
+    0x00524A4949292524ULL, 0x005292949494A4A4ULL, 0x005294A5294A5294ULL, 0x0054A94A94A94A94ULL,
+    0x00552A552A552A54ULL, 0x00554AA9552AA554ULL, 0x0055554AAAA95554ULL, 0x0055555555555554ULL,
+    0x006AAAAAAAAAAAAAULL, 0x006AAAB55556AAAAULL, 0x006AAD55AAB556AAULL, 0x006AD5AAD5AAD5AAULL,
+    0x006B56B56B56B56AULL, 0x006B5AD6B5AD6B5AULL, 0x006D6D6B6B6B5B5AULL, 0x006DADB5B6B6D6DAULL,
+    0x006DB6DB6B6DB6DAULL, 0x0076DB6DB6DB6DB6ULL, 0x0076DBB6DDB6EDB6ULL, 0x0076EDDBB6EDDBB6ULL,
+    0x00776EEDDDBBB776ULL, 0x0077777777777776ULL, 0x007BBBBDDDDEEEEEULL, 0x007BDDEEF7BBDDEEULL,
+    0x007BDEF7BDEF7BDEULL, 0x007DEFBDF7BEF7DEULL, 0x007EFBEFBEFBEFBEULL, 0x007EFDFBF7EFDFBEULL,
+    0x007F7F7F7F7F7F7EULL, 0x007FDFEFF7FBFDFEULL, 0x007FEFFDFFBFF7FEULL, 0x007FFDFFF7FFDFFEULL,
+    0x007FFFEFFFFBFFFEULL, 0x007FFFFFF7FFFFFEULL, 0x007FFFFFFFFFFFFEULL, 0x007FFFFFFFFFFFFFULL,
+    // n = 56
+    0x0000000000000000ULL, 0x0080000000000000ULL, 0x0080000008000000ULL, 0x0080002000040000ULL,
+    0x0080020008002000ULL, 0x0080100200400800ULL, 0x0080402008040200ULL, 0x0080808080808080ULL,
+    0x0081020408102040ULL, 0x0082082081041040ULL, 0x0084108208410820ULL, 0x0084210842108420ULL,
+    0x0088422108842210ULL, 0x0088884442221110ULL, 0x0088888888888888ULL, 0x0091122224444888ULL,
+    0x0091224489122448ULL, 0x0092449124892248ULL, 0x0092492489249248ULL, 0x00A4924924924924ULL,
+    0x00A492924A492924ULL, 0x00A4A4A4A4A4A4A4ULL, 0x00A5294A4A5294A4ULL, 0x00A94A54A52A5294ULL,
+    0x00A952A54A952A54ULL, 0x00AA954AA552A954ULL, 0x00AAA9554AAA9554ULL, 0x00AAAAAAA5555554ULL,
+    0x00AAAAAAAAAAAAAAULL, 0x00D555555AAAAAAAULL, 0x00D556AAAD556AAAULL, 0x00D56AB55AAD56AAULL,
+    0x00D5AB56AD5AB56AULL, 0x00D6B5AB5AD5AD6AULL, 0x00DAD6B5ADAD6B5AULL, 0x00DADADADADADADAULL,
+    0x00DB6B6DADB6B6DAULL, 0x00DB6DB6DB6DB6DAULL, 0x00EDB6DB6EDB6DB6ULL, 0x00EDBB6EDB76DDB6ULL,
+    0x00EDDBB76EDDBB76ULL, 0x00EEEDDDDBBBB776ULL, 0x00EEEEEEEEEEEEEEULL, 0x00F777BBBDDDEEEEULL,
+    0x00F7BBDEEF7BBDEEULL, 0x00FBDEF7BDEF7BDEULL, 0x00FBEF7DEFBEF7DEULL, 0x00FDF7DF7EFBEFBEULL,
+    0x00FDFBF7EFDFBF7EULL, 0x00FEFEFEFEFEFEFEULL, 0x00FFBFDFEFFBFDFEULL, 0x00FFEFFDFFBFF7FEULL,
+    0x00FFFBFFEFFFBFFEULL, 0x00FFFFDFFFFBFFFEULL, 0x00FFFFFFEFFFFFFEULL, 0x00FFFFFFFFFFFFFEULL,
+    0x00FFFFFFFFFFFFFFULL,
+    // n = 57
+    0x0000000000000000ULL, 0x0100000000000000ULL, 0x0100000010000000ULL, 0x0100002000040000ULL,
+    0x0100040010004000ULL, 0x0100200400400800ULL, 0x0100802010040200ULL, 0x0101010101010100ULL,
+    0x0102040810204080ULL, 0x0104102082041040ULL, 0x0108208410420820ULL, 0x0108421082108420ULL,
+    0x0110842210844210ULL, 0x0111088844222110ULL, 0x0111111111111110ULL, 0x0122222444448888ULL,
+    0x0122448911224488ULL, 0x0124491244912448ULL, 0x0124922492449248ULL, 0x0124924924924924ULL,
+    0x014924A4924A4924ULL, 0x0149492929252524ULL, 0x014A5252929494A4ULL, 0x015294A5294A5294ULL,
+    0x0152A52A54A54A94ULL, 0x0154AA54AA54AA54ULL, 0x01554AA9552AA554ULL, 0x0155552AAAA55554ULL,
+    0x0155555555555554ULL, 0x01AAAAAAAAAAAAAAULL, 0x01AAAAB55556AAAAULL, 0x01AAB556AAD55AAAULL,
+    0x01AB55AB55AB55AAULL, 0x01AD5AB5AB56B56AULL, 0x01AD6B5AD6B5AD6AULL, 0x01B5ADAD6D6B6B5AULL,
+    0x01B6B6B6D6D6DADAULL, 0x01B6DB5B6DB5B6DAULL, 0x01B6DB6DB6DB6DB6ULL, 0x01DB6DBB6DB76DB6ULL,
+    0x01DBB6EDBB6EDBB6ULL, 0x01DDBB76EEDDBB76ULL, 0x01DDDDBBBBB77776ULL, 0x01EEEEEEEEEEEEEEULL,
+    0x01EEF777BBDDDEEEULL, 0x01EF7BBDEF77BDEEULL, 0x01F7BDEF7DEF7BDEULL, 0x01F7DF7BEFBDF7DEULL,
+    0x01FBEFBF7DF7EFBEULL, 0x01FDFBF7EFDFBF7EULL, 0x01FEFEFEFEFEFEFEULL, 0x01FF7FBFEFF7FDFEULL,
+    0x01FFDFFBFFBFF7FEULL, 0x01FFFBFFEFFFBFFEULL, 0x01FFFFBFFFF7FFFEULL, 0x01FFFFFFEFFFFFFEULL,
+    0x01FFFFFFFFFFFFFEULL, 0x01FFFFFFFFFFFFFFULL,
+    // n = 58
+    0x0000000000000000ULL, 0x0200000000000000ULL, 0x0200000010000000ULL, 0x0200004000080000ULL,
+    0x0200080010004000ULL, 0x0200400400800800ULL, 0x0201004010080200ULL, 0x0202020201010100ULL,
+    0x0204081010204080ULL, 0x0208204102081040ULL, 0x0210410410820820ULL, 0x0210841084208420ULL,
+    0x0221084211084210ULL, 0x0222110884422110ULL, 0x0222222211111110ULL, 0x0244444448888888ULL,
+    0x0244889112244488ULL, 0x0248912448922448ULL, 0x0249224912491248ULL, 0x0249249249249248ULL,
+    0x0292492494924924ULL, 0x0292524A49492924ULL, 0x0294949494A4A4A4ULL, 0x0294A5294A5294A4ULL,
+    0x02A52A5295295294ULL, 0x02A952A54A952A54ULL, 0x02AA552A9552A954ULL, 0x02AAA5554AAA9554ULL,
+    0x02AAAAAA95555554ULL, 0x02AAAAAAAAAAAAAAULL, 0x035555555AAAAAAAULL, 0x03555AAAB5556AAAULL,
+    0x0355AAD55AAD56AAULL, 0x0356AD5AB56AD5AAULL, 0x035AD5AD5AD6AD6AULL, 0x036B5AD6B5AD6B5AULL,
+    0x036B6B6B5B5B5B5AULL, 0x036DADB5B6B6D6DAULL, 0x036DB6DB5B6DB6DAULL, 0x03B6DB6DB6DB6DB6ULL,
+    0x03B6DDB6DDB6EDB6ULL, 0x03B76EDBB76DDBB6ULL, 0x03BB776EDDDBBB76ULL, 0x03BBBBBBB7777776ULL,
+    0x03DDDDDDDEEEEEEEULL, 0x03DDEEF77BBDDEEEULL, 0x03DEF7BDDEF7BDEEULL, 0x03EF7BEF7BDF7BDEULL,
+    0x03EFBEFBDF7DF7DEULL, 0x03F7DFBEFDF7EFBEULL, 0x03FBF7EFDFDFBF7EULL, 0x03FDFDFDFEFEFEFEULL,
+    0x03FEFFBFDFF7FDFEULL, 0x03FFBFFBFF7FF7FEULL, 0x03FFF7FFDFFFBFFEULL, 0x03FFFFBFFFF7FFFEULL,
+    0x03FFFFFFDFFFFFFEULL, 0x03FFFFFFFFFFFFFEULL, 0x03FFFFFFFFFFFFFFULL,
+    // n = 59
+    0x0000000000000000ULL, 0x0400000000000000ULL, 0x0400000020000000ULL, 0x0400008000080000ULL,
+    0x0400100020004000ULL, 0x0400800800800800ULL, 0x0402008020080200ULL, 0x0404040202010100ULL,
+    0x0408101020404080ULL, 0x0410208104082040ULL, 0x0420820820820820ULL, 0x0421042104210420ULL,
+    0x0442108421084210ULL, 0x0442211088442210ULL, 0x0444442222211110ULL, 0x0488888888888888ULL,
+    0x0488911222444888ULL, 0x0491224489122448ULL, 0x0492249124492248ULL, 0x0492492489249248ULL,
+    0x0524924924924924ULL, 0x0524949252494924ULL, 0x0525252525252524ULL, 0x05294A4A529294A4ULL,
+    0x054A5294A94A5294ULL, 0x054A952A52A54A94ULL, 0x0552A954A954AA54ULL, 0x05552AA5552AA554ULL,
+    0x0555552AAAA55554ULL, 0x0555555555555554ULL, 0x06AAAAAAAAAAAAAAULL, 0x06AAAAD5555AAAAAULL,
+    0x06AAD55AAAD55AAAULL, 0x06AD56AB56AB55AAULL, 0x06B56AD5AD5AB56AULL, 0x06B5AD6B56B5AD6AULL,
+    0x06D6B5B5AD6D6B5AULL, 0x06DADADADADADADAULL, 0x06DB6B6DADB6B6DAULL, 0x06DB6DB6DB6DB6DAULL,
+    0x076DB6DB76DB6DB6ULL, 0x076DDB6EDBB6DDB6ULL, 0x076EDDBB76EDDBB6ULL, 0x07776EEDDDBBB776ULL,
+    0x0777777777777776ULL, 0x07BBBBDDDDDEEEEEULL, 0x07BDDEEF77BBDDEEULL, 0x07BDEF7BDEF7BDEEULL,
+    0x07DEFBDEFBDEFBDEULL, 0x07DF7DF7DF7DF7DEULL, 0x07EFDF7EFBF7DFBEULL, 0x07F7EFEFDFBFBF7EULL,
+    0x07FBFBFDFDFEFEFEULL, 0x07FDFF7FDFF7FDFEULL, 0x07FF7FF7FF7FF7FEULL, 0x07FFEFFFDFFFBFFEULL,
+    0x07FFFF7FFFF7FFFEULL, 0x07FFFFFFDFFFFFFEULL, 0x07FFFFFFFFFFFFFEULL, 0x07FFFFFFFFFFFFFFULL,
+    // n = 60
+    0x0000000000000000ULL, 0x0800000000000000ULL, 0x0800000020000000ULL, 0x0800008000080000ULL,
+    0x0800100020004000ULL, 0x0800800800800800ULL, 0x0802008020080200ULL, 0x0808040402020100ULL,
+    0x0810102020404080ULL, 0x0820408204082040ULL, 0x0820820820820820ULL, 0x0842084108210420ULL,
+    0x0842108421084210ULL, 0x0884421108842210ULL, 0x0888844422221110ULL, 0x0888888888888888ULL,
+    0x0911122224444888ULL, 0x0912244891224488ULL, 0x0922489224892248ULL, 0x0924922492449248ULL,
+    0x0924924924924924ULL, 0x0A4924A4924A4924ULL, 0x0A4A494929292524ULL, 0x0A5252929494A4A4ULL,
+    0x0A5294A5294A5294ULL, 0x0A94A94A94A94A94ULL, 0x0AA54A952A952A54ULL, 0x0AA954AA954AA954ULL,
+    0x0AAA95552AAA5554ULL, 0x0AAAAAAA95555554ULL, 0x0AAAAAAAAAAAAAAAULL, 0x0D5555556AAAAAAAULL,
+    0x0D555AAAB5556AAAULL, 0x0D56AAD56AAD56AAULL, 0x0D5AB56AB56AD5AAULL, 0x0D6AD6AD6AD6AD6AULL,
+    0x0D6B5AD6B5AD6B5AULL, 0x0DADAD6D6B6B5B5AULL, 0x0DB5B6B6B6D6DADAULL, 0x0DB6DADB6DADB6DAULL,
+    0x0DB6DB6DB6DB6DB6ULL, 0x0EDB6DDB6DBB6DB6ULL, 0x0EDBB6EDBB6EDBB6ULL, 0x0EEDDBB76EDDBB76ULL,
+    0x0EEEDDDDBBBB7776ULL, 0x0EEEEEEEEEEEEEEEULL, 0x0F777BBBBDDDEEEEULL, 0x0F7BBDEEF77BDDEEULL,
+    0x0F7BDEF7BDEF7BDEULL, 0x0FBDF7BEF7DEFBDEULL, 0x0FBEFBEFBEFBEFBEULL, 0x0FDFBEFDFBEFDFBEULL,
+    0x0FEFDFDFBFBF7F7EULL, 0x0FF7FBFBFDFDFEFEULL, 0x0FFBFEFFBFEFFBFEULL, 0x0FFEFFEFFEFFEFFEULL,
+    0x0FFFDFFFBFFF7FFEULL, 0x0FFFFEFFFFEFFFFEULL, 0x0FFFFFFFBFFFFFFEULL, 0x0FFFFFFFFFFFFFFEULL,
+    0x0FFFFFFFFFFFFFFFULL,
+    // n = 61
+    0x0000000000000000ULL, 0x1000000000000000ULL, 0x1000000040000000ULL, 0x1000010000100000ULL,
+    0x1000200040008000ULL, 0x1001001001001000ULL, 0x1004010040100400ULL, 0x1010080404020100ULL,
+    0x1020204040408080ULL, 0x1040810208102040ULL, 0x1041041041041040ULL, 0x1082104208410820ULL,
+    0x1084210842108420ULL, 0x1108442110844210ULL, 0x1110888444222110ULL, 0x1111111111111110ULL,
+    0x1222224444488888ULL, 0x1224488912224488ULL, 0x1244912248912448ULL, 0x1249124912491248ULL,
+    0x1249249249249248ULL, 0x14924924A4924924ULL, 0x1492925249492924ULL, 0x14A4A4A4A4A4A4A4ULL,
+    0x14A5294A4A5294A4ULL, 0x15294A94A52A5294ULL, 0x152A54A952A54A94ULL, 0x154AA552A954AA54ULL,
+    0x1554AAA554AAA554ULL, 0x155554AAAAA55554ULL, 0x1555555555555554ULL, 0x1AAAAAAAAAAAAAAAULL,
+    0x1AAAAB55555AAAAAULL, 0x1AAB555AAB555AAAULL, 0x1AB55AAD56AB55AAULL, 0x1AD5AB56AD5AB56AULL,
+    0x1AD6B56B5AD5AD6AULL, 0x1B5AD6B5B5AD6B5AULL, 0x1B5B5B5B5B5B5B5AULL, 0x1B6D6DADB6B6D6DAULL,
+    0x1B6DB6DB5B6DB6DAULL, 0x1DB6DB6DB6DB6DB6ULL, 0x1DB6EDB6EDB6EDB6ULL, 0x1DBB6EDDB76EDBB6ULL,
+    0x1DDBB776EDDDBB76ULL, 0x1DDDDDBBBBB77776ULL, 0x1EEEEEEEEEEEEEEEULL, 0x1EEF777BBBDDDEEEULL,
+    0x1EF7BBDEEF7BBDEEULL, 0x1F7BDEF7BDEF7BDEULL, 0x1F7DEFBDF7BEF7DEULL, 0x1FBEFBEFBEFBEFBEULL,
+    0x1FBF7EFDF7EFDFBEULL, 0x1FDFDFBFBFBF7F7EULL, 0x1FEFF7FBFBFDFEFEULL, 0x1FFBFEFFBFEFFBFEULL,
+    0x1FFEFFEFFEFFEFFEULL, 0x1FFFDFFFBFFF7FFEULL, 0x1FFFFEFFFFEFFFFEULL, 0x1FFFFFFFBFFFFFFEULL,
+    0x1FFFFFFFFFFFFFFEULL, 0x1FFFFFFFFFFFFFFFULL,
+    // n = 62
+    0x0000000000000000ULL, 0x2000000000000000ULL, 0x2000000040000000ULL, 0x2000020000100000ULL,
+    0x2000400040008000ULL, 0x2002002001001000ULL, 0x2008020040100400ULL, 0x2020100804020100ULL,
+    0x2040404040808080ULL, 0x2081020408102040ULL, 0x2082082041041040ULL, 0x2104208210410820ULL,
+    0x2108421042108420ULL, 0x2210844210884210ULL, 0x2221108844422110ULL, 0x2222222211111110ULL,
+    0x2444444448888888ULL, 0x2448891122244488ULL, 0x2489122449122448ULL, 0x2491248924492248ULL,
+    0x2492492449249248ULL, 0x2924924924924924ULL, 0x2924A49252494924ULL, 0x2929292925252524ULL,
+    0x294A4A52529494A4ULL, 0x2A5294A5294A5294ULL, 0x2A54A54A54A94A94ULL, 0x2A952A952A552A54ULL,
+    0x2AA554AA554AA954ULL, 0x2AAA95552AAA5554ULL, 0x2AAAAAAA55555554ULL, 0x2AAAAAAAAAAAAAAAULL,
+    0x355555556AAAAAAAULL, 0x35556AAAD555AAAAULL, 0x355AAB556AB556AAULL, 0x356AD56AD5AAD5AAULL,
+    0x35AB5AB56B56B56AULL, 0x35AD6B5AD6B5AD6AULL, 0x36B5B5AD6D6B6B5AULL, 0x36D6D6D6DADADADAULL,
+    0x36DB5B6D6DB6B6DAULL, 0x36DB6DB6DB6DB6DAULL, 0x3B6DB6DB76DB6DB6ULL, 0x3B6EDB76DBB6DDB6ULL,
+    0x3B76EDDB76EDDBB6ULL, 0x3BB776EEDDDBBB76ULL, 0x3BBBBBBB77777776ULL, 0x3DDDDDDDEEEEEEEEULL,
+    0x3DDEEF777BBDDEEEULL, 0x3DEF7BBDEF77BDEEULL, 0x3EF7BDEF7DEF7BDEULL, 0x3EFBDF7DEFBEF7DEULL,
+    0x3F7DF7DF7EFBEFBEULL, 0x3F7EFDFBF7EFDFBEULL, 0x3FBFBFBF7F7F7F7EULL, 0x3FDFEFF7FBFDFEFEULL,
+    0x3FF7FDFF7FEFFBFEULL, 0x3FFDFFDFFEFFEFFEULL, 0x3FFFBFFF7FFF7FFEULL, 0x3FFFFDFFFFEFFFFEULL,
+    0x3FFFFFFF7FFFFFFEULL, 0x3FFFFFFFFFFFFFFEULL, 0x3FFFFFFFFFFFFFFFULL,
+    // n = 63
+    0x0000000000000000ULL, 0x4000000000000000ULL, 0x4000000080000000ULL, 0x4000020000100000ULL,
+    0x4000800080008000ULL, 0x4004002002001000ULL, 0x4010020080100400ULL, 0x4020100804020100ULL,
+    0x4080808080808080ULL, 0x4081020408102040ULL, 0x4104102082041040ULL, 0x4208210410420820ULL,
+    0x4210821084108420ULL, 0x4421084221084210ULL, 0x4422110884422110ULL, 0x4444422222111110ULL,
+    0x4888888888888888ULL, 0x4889112222444888ULL, 0x4891224489122448ULL, 0x4922489224892248ULL,
+    0x4924912492449248ULL, 0x4924924924924924ULL, 0x5249252492524924ULL, 0x52524A4949292524ULL,
+    0x529292949494A4A4ULL, 0x5294A5294A5294A4ULL, 0x54A54A52A5295294ULL, 0x54A952A54A952A54ULL,
+    0x552A954AA552A954ULL, 0x5552AA9554AAA554ULL, 0x555552AAAA955554ULL, 0x5555555555555554ULL,
+    0x6AAAAAAAAAAAAAAAULL, 0x6AAAAB55555AAAAAULL, 0x6AAD556AAB555AAAULL, 0x6AB55AAD56AB55AAULL,
+    0x6AD5AB56AD5AB56AULL, 0x6B5AB5AD5AD6AD6AULL, 0x6D6B5AD6B5AD6B5AULL, 0x6D6D6B6B6B5B5B5AULL,
+    0x6DADB5B6B6D6DADAULL, 0x6DB6DADB6DADB6DAULL, 0x6DB6DB6DB6DB6DB6ULL, 0x76DB6EDB6DBB6DB6ULL,
+    0x76DDB76DDB76DDB6ULL, 0x76EDDBB76EDDBB76ULL, 0x7776EEDDDDBBB776ULL, 0x7777777777777776ULL,
+    0x7BBBBBDDDDDEEEEEULL, 0x7BBDDEEF77BBDDEEULL, 0x7BDEF7BDDEF7BDEEULL, 0x7DEF7BEF7BDF7BDEULL,
+    0x7DF7DEFBEFBDF7DEULL, 0x7EFBEFDF7DFBEFBEULL, 0x7EFDFBF7EFDFBF7EULL, 0x7F7F7F7F7F7F7F7EULL,
+    0x7FBFDFEFF7FBFDFEULL, 0x7FEFFBFF7FDFFBFEULL, 0x7FFBFFDFFDFFEFFEULL, 0x7FFF7FFF7FFF7FFEULL,
+    0x7FFFFBFFFFDFFFFEULL, 0x7FFFFFFF7FFFFFFEULL, 0x7FFFFFFFFFFFFFFEULL, 0x7FFFFFFFFFFFFFFFULL,
+    // n = 64
+    0x0000000000000000ULL, 0x8000000000000000ULL, 0x8000000080000000ULL, 0x8000040000200000ULL,
+    0x8000800080008000ULL, 0x8008004002001000ULL, 0x8020040080200400ULL, 0x8040201008040200ULL,
+    0x8080808080808080ULL, 0x8102040810204080ULL, 0x8208104082081040ULL, 0x8410410420820820ULL,
+    0x8420842084208420ULL, 0x8842108421084210ULL, 0x8844221088442210ULL, 0x8888444422221110ULL,
+    0x8888888888888888ULL, 0x9111222244448888ULL, 0x9122448891224488ULL, 0x9224892244912448ULL,
+    0x9248924892489248ULL, 0x9249249249249248ULL, 0xA4924924A4924924ULL, 0xA49492524A492924ULL,
+    0xA4A4A4A4A4A4A4A4ULL, 0xA529494A529294A4ULL, 0xA94A5294A94A5294ULL, 0xA952A52A54A54A94ULL,
+    0xAA54AA54AA54AA54ULL, 0xAA9552AA554AA954ULL, 0xAAAA5554AAAA5554ULL, 0xAAAAAAAA55555554ULL,
+    0xAAAAAAAAAAAAAAAAULL, 0xD5555555AAAAAAAAULL, 0xD555AAAAD555AAAAULL, 0xD56AAD55AAB556AAULL,
+    0xD5AAD5AAD5AAD5AAULL, 0xD6AD5AD5AB5AB56AULL, 0xD6B5AD6AD6B5AD6AULL, 0xDAD6B6B5AD6D6B5AULL,
+    0xDADADADADADADADAULL, 0xDB6B6DADB5B6D6DAULL, 0xDB6DB6DADB6DB6DAULL, 0xEDB6DB6DB6DB6DB6ULL,
+    0xEDB6EDB6EDB6EDB6ULL, 0xEDDB76DDBB6EDBB6ULL, 0xEEDDBB76EEDDBB76ULL, 0xEEEEDDDDBBBB7776ULL,
+    0xEEEEEEEEEEEEEEEEULL, 0xF777BBBBDDDDEEEEULL, 0xF7BBDDEEF7BBDDEEULL, 0xF7BDEF7BDEF7BDEEULL,
+    0xFBDEFBDEFBDEFBDEULL, 0xFBEFBEFBDF7DF7DEULL, 0xFDF7EFBEFDF7EFBEULL, 0xFEFDFBF7EFDFBF7EULL,
+    0xFEFEFEFEFEFEFEFEULL, 0xFFBFDFEFF7FBFDFEULL, 0xFFDFFBFEFFDFFBFEULL, 0xFFF7FFBFFDFFEFFEULL,
+    0xFFFEFFFEFFFEFFFEULL, 0xFFFFFBFFFFDFFFFEULL, 0xFFFFFFFEFFFFFFFEULL, 0xFFFFFFFFFFFFFFFEULL,
+    0xFFFFFFFFFFFFFFFFULL,
+};
+
+#endif // EUCLIDEAN_TABLES_H
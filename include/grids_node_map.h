@@ -0,0 +1,173 @@
+// Generated by scripts/gen_grids_nodes.py - do not edit by hand.
+#ifndef GRIDS_NODE_MAP_H
+#define GRIDS_NODE_MAP_H
+
+#include <stdint.h>
+#include <pgmspace.h>
+
+#define GRIDS_NODES 5
+#define GRIDS_NODE_STEPS 32
+#define GRIDS_NODE_INSTRUMENTS 3
+#define GRIDS_NODE_BYTES (GRIDS_NODE_STEPS * GRIDS_NODE_INSTRUMENTS)
+#define GRIDS_COORD_QUANT_SHIFT 3
+
+// [x node][y node][kick 0-31, snare 32-63, hat 64-95]
+static const uint8_t PROGMEM kGridsNodeMap[GRIDS_NODES][GRIDS_NODES][GRIDS_NODE_BYTES] = {
+  {
+    {
+      255,   0,   0,   0, 230,   0,   0,   0, 230,   0,   0,   0, 230,   0,   0,   0, 255,   0,   0,   0, 230,   0,   0,   0, 230,   0,   0,   0, 230,   0,   0,   0,
+        0,   0,   0,   0, 255,   0,   0,   5,   0,   0,  10,   0, 255,   0,   0,   7,   0,   0,   0,   0, 255,   0,   0,   0,   0,   0,   7,   0, 255,   0,   0,   0,
+      142,  26, 210,  50, 155,  54, 217,  42, 143,  54, 211,  25, 153,  27, 210,  48, 159,  51, 220,  37, 146,  47, 217,  51, 155,  50, 214,  46, 156,  45, 208,  25,
+    },
+    {
+      255,   9,   0,   7, 230,  13,   0,   9, 230,  21,   0,  19, 230,  20,   0,  17, 255,  12,   0,   8, 230,  20,   0,   6, 230,  17,   0,  19, 230,   5,   0,  19,
+        0,   0,  14,   0, 255,   0,   0,  37,   0,   0,  44,   0, 255,   0,   0,  46,   0,   0,  28,   0, 255,   0,   0,  10,   0,   0,  25,   0, 255,   0,   0,  57,
+      140,  84, 220,  70, 157,  86, 200,  76, 152,  92, 206,  72, 153,  92, 200,  62, 156,  76, 207,  88, 154,  92, 215,  80, 157,  92, 207,  82, 151,  66, 207,  68,
+    },
+    {
+      255,  14,   0,  16, 230,  15,   0,  33, 230,  20,   0,  30, 230,  26,   0,  24, 255,  12,   0,  20, 230,  38,   0,  35, 230,  42,   0,  34, 230,  44,   0,  38,
+        0,   0,  50,   0, 255,   0,   0,  73,   0,   0,  64,   0, 255,   0,   0, 104,   0,   0,  62,   0, 255,   0,   0,  44,   0,   0,  67,   0, 255,   0,   0,  88,
+      153, 121, 216, 117, 145, 105, 217, 128, 145, 114, 207, 125, 147, 113, 200, 123, 145, 116, 210, 129, 145, 129, 204, 124, 156, 111, 216, 125, 151, 118, 216, 111,
+    },
+    {
+      255,  38,   0,  67, 230,  27,   0,  50, 230,  60,   0,  21, 230,  16,   0,  60, 255,  40,   0,  68, 230,  37,   0,  33, 230,  60,   0,  67, 230,  68,   0,  60,
+        0,   0,  82,   0, 255,   0,   0, 118,   0,   0, 109,   0, 255,   0,   0, 150,   0,   0,  82,   0, 255,   0,   0,  66,   0,   0, 110,   0, 255,   0,   0, 146,
+      140, 166, 202, 148, 145, 140, 218, 138, 141, 142, 209, 152, 140, 144, 208, 146, 155, 168, 219, 158, 152, 150, 213, 162, 152, 158, 218, 164, 154, 146, 204, 150,
+    },
+    {
+      255,  50,   0,  58, 230,  33,   0,  70, 230,  81,   0,  39, 230,  31,   0,  28, 255,  22,   0,  71, 230,  90,   0,  57, 230,  27,   0,  48, 230,  86,   0,  88,
+        0,   0,  98,   0, 255,   0,   0, 180,   0,   0, 145,   0, 255,   0,   0, 199,   0,   0, 116,   0, 255,   0,   0,  76,   0,   0, 127,   0, 255,   0,   0, 180,
+      160, 182, 208, 190, 148, 183, 206, 177, 145, 205, 209, 204, 149, 201, 220, 202, 151, 205, 202, 192, 159, 201, 210, 184, 152, 175, 216, 204, 147, 184, 205, 193,
+    },
+  },
+  {
+    {
+      255,   0,   0,  50, 192,   0,  32,   0, 192,   0,  59,  23, 192,   0,  41,   0, 255,   0,   0,  27, 192,   0,  45,   0, 192,  18,   0,  54, 192,   0,  36,   0,
+        0,   0,  12,   0, 255,   0,   0,   0,   0,   0,   1,   0, 255,   0,   0,   0,   0,   0,   0,   0, 255,   0,   0,   0,   0,   0,   0,   0, 255,   0,   0,  11,
+      145,  62, 192,  38, 144,  50, 209,  60, 159,  54, 204,  52, 144,  38, 194,  38, 140,  62, 190,  62, 146,  54, 196,  38, 145,  62, 195,  62, 149,  60, 200,  44,
+    },
+    {
+      255,   8,   0,  50, 192,  13,  32,   6, 192,   5,  59,  23, 192,  20,  41,  17, 255,  15,   0,  27, 192,  14,  45,  20, 192,  18,   0,  54, 192,  22,  36,  22,
+        0,   0,  37,   0, 255,   0,   0,  36,   0,   0,  44,   0, 255,   0,   0,  59,   0,   0,  40,   0, 255,   0,   0,  18,   0,   0,  39,   0, 255,   0,   0,  37,
+      159,  98, 192,  76, 153,  96, 200,  90, 142,  99, 201,  81, 153,  85, 198,  99, 154,  96, 193,  99, 146,  76, 210,  86, 149,  88, 193,  90, 141,  92, 208,  98,
+    },
+    {
+      255,  30,   0,  50, 192,  35,  32,  13, 192,  14,  59,  44, 192,  16,  41,  33, 255,  14,   0,  42, 192,  24,  45,  12, 192,  18,   0,  54, 192,  36,  36,  14,
+        0,   0,  43,   0, 255,   0,   0,  89,   0,   0,  77,   0, 255,   0,   0,  95,   0,   0,  66,   0, 255,   0,   0,  39,   0,   0,  57,   0, 255,   0,   0,  82,
+      160, 110, 210, 126, 158, 116, 191, 124, 158, 134, 208, 128, 152, 112, 191, 110, 147, 126, 191, 126, 157, 128, 194, 114, 149, 118, 203, 110, 144, 124, 207, 130,
+    },
+    {
+      255,  37,   0,  50, 192,  51,  32,  27, 192,  33,  59,  23, 192,  22,  41,  28, 255,  38,   0,  63, 192,  34,  45,  53, 192,  18,   0,  58, 192,  62,  36,  58,
+        0,   0,  81,   0, 255,   0,   0, 132,   0,   0, 108,   0, 255,   0,   0, 150,   0,   0,  80,   0, 255,   0,   0,  61,   0,   0, 102,   0, 255,   0,   0, 141,
+      140, 152, 198, 167, 156, 147, 203, 160, 155, 173, 202, 165, 143, 161, 198, 173, 143, 151, 192, 163, 152, 170, 209, 149, 152, 164, 193, 147, 141, 162, 200, 175,
+    },
+    {
+      255,  79,   0,  67, 192,  54,  32,  37, 192,  43,  59,  23, 192,  63,  41,  84, 255,  79,   0,  30, 192,  62,  45,  90, 192,  25,   0,  68, 192,  41,  36,  77,
+        0,   0,  95,   0, 255,   0,   0, 161,   0,   0, 145,   0, 255,   0,   0, 211,   0,   0, 109,   0, 255,   0,   0,  80,   0,   0, 131,   0, 255,   0,   0, 185,
+      156, 188, 208, 204, 142, 210, 202, 182, 143, 210, 199, 196, 146, 184, 197, 210, 153, 194, 192, 210, 148, 198, 196, 186, 152, 182, 198, 190, 150, 196, 191, 206,
+    },
+  },
+  {
+    {
+      255,   0,   0, 100, 155,   0,  64,   0, 155,   0, 118,  46, 155,   0,  82,   0, 255,   0,   0,  54, 155,   0,  90,   0, 155,  36,   0, 108, 155,   0,  72,   0,
+        0,   0,   1,   0, 255,   0,   0,   0,   0,   0,   7,   0, 255,   0,   0,   0,   0,   0,   0,   0, 255,   0,   0,   0,   0,   0,   0,   0, 255,   0,   0,   1,
+      148,  46, 194,  70, 145,  69, 189,  49, 151,  57, 184,  51, 154,  64, 187,  68, 154,  47, 199,  50, 152,  61, 181,  57, 158,  54, 180,  53, 147,  55, 184,  42,
+    },
+    {
+      255,  19,   0, 100, 155,  19,  64,  21, 155,  11, 118,  46, 155,  21,  82,  20, 255,  11,   0,  54, 155,  19,  90,  14, 155,  36,   0, 108, 155,  22,  72,   6,
+        0,   0,  34,   0, 255,   0,   0,  44,   0,   0,  46,   0, 255,   0,   0,  57,   0,   0,  37,   0, 255,   0,   0,  15,   0,   0,  45,   0, 255,   0,   0,  46,
+      159,  84, 180,  98, 156,  86, 182,  92, 141,  78, 181,  98, 146,  80, 187,  92, 159,  98, 180,  86, 154,  90, 190,  94, 154, 106, 198, 104, 146,  80, 196, 100,
+    },
+    {
+      255,  40,   0, 100, 155,  44,  64,  32, 155,  19, 118,  46, 155,  10,  82,  34, 255,  40,   0,  54, 155,  39,  90,  24, 155,  36,   0, 108, 155,  38,  72,  34,
+        0,   0,  42,   0, 255,   0,   0,  78,   0,   0,  65,   0, 255,   0,   0,  93,   0,   0,  54,   0, 255,   0,   0,  48,   0,   0,  74,   0, 255,   0,   0,  90,
+      150, 132, 192, 120, 142, 137, 180, 143, 141, 116, 196, 132, 147, 120, 182, 131, 153, 141, 194, 117, 143, 127, 193, 134, 144, 128, 197, 136, 150, 134, 199, 130,
+    },
+    {
+      255,  40,   0, 100, 155,  32,  64,  37, 155,  28, 118,  46, 155,  32,  82,  27, 255,  22,   0,  66, 155,  35,  90,  43, 155,  36,   0, 108, 155,  27,  72,  16,
+        0,   0,  79,   0, 255,   0,   0, 116,   0,   0, 110,   0, 255,   0,   0, 146,   0,   0, 101,   0, 255,   0,   0,  58,   0,   0, 104,   0, 255,   0,   0, 130,
+      148, 160, 191, 174, 147, 166, 195, 170, 157, 172, 198, 176, 153, 156, 191, 166, 153, 174, 200, 176, 150, 166, 200, 170, 143, 158, 191, 162, 159, 158, 200, 158,
+    },
+    {
+      255,  33,   0, 100, 155,  51,  64,  54, 155,  52, 118,  57, 155,  29,  82,  77, 255,  58,   0,  79, 155,  70,  90,  70, 155,  36,   0, 108, 155,  48,  72,  60,
+        0,   0,  96,   0, 255,   0,   0, 167,   0,   0, 160,   0, 255,   0,   0, 199,   0,   0, 124,   0, 255,   0,   0,  81,   0,   0, 144,   0, 255,   0,   0, 180,
+      157, 219, 188, 204, 145, 218, 180, 209, 160, 193, 182, 217, 143, 210, 199, 211, 150, 218, 180, 193, 142, 208, 188, 208, 146, 210, 192, 210, 152, 201, 198, 195,
+    },
+  },
+  {
+    {
+      255,   0,   0, 149, 118,   0,  95,   0, 118,   0, 176,  68, 118,   0, 122,   0, 255,   0,   0,  82, 118,   0, 136,   0, 118,  55,   0, 163, 118,   0, 109,   0,
+        0,   0,   0,   0, 255,   0,   0,   0,   0,   0,   0,   0, 255, 165,   0,   0,   0,   0,   0,   0, 255,   0,   0,   0,   0,   0,   0,   0, 170,   0, 240,   0,
+      149,  62, 186,  60, 153,  72, 177,  74, 158,  72, 184,  50, 153,  62, 185,  78, 142,  78, 184,  74, 158,  48, 181,  54, 154,  52, 188,  64, 150,  52, 190,  66,
+    },
+    {
+      255,  16,   0, 149, 118,  20,  95,  14, 118,  18, 176,  68, 118,  19, 122,   5, 255,  18,   0,  82, 118,  12, 136,  12, 118,  55,   0, 163, 118,  14, 109,  16,
+        0,   0,  21,   0, 255,   0,   0,  53,   0,   0,  45,   0, 255, 165,   0,  59,   0,   0,  18,   0, 255,   0,   0,  29,   0,   0,  31,   0, 170,   0, 240,  38,
+      148, 110, 170,  87, 144,  96, 189, 100, 160,  98, 170, 101, 154, 105, 184,  90, 159, 115, 190, 103, 149,  94, 177, 103, 149,  86, 181,  94, 148,  87, 183, 111,
+    },
+    {
+      255,  43,   0, 149, 118,  29,  95,  33, 118,  28, 176,  68, 118,  44, 122,  28, 255,  17,   0,  82, 118,  26, 136,  34, 118,  55,   0, 163, 118,  42, 109,  30,
+        0,   0,  41,   0, 255,   0,   0,  95,   0,   0,  76,   0, 255, 165,   0, 108,   0,   0,  65,   0, 255,   0,   0,  36,   0,   0,  60,   0, 170,   0, 240, 101,
+      146, 142, 174, 126, 157, 144, 187, 148, 146, 136, 180, 148, 157, 138, 173, 152, 160, 132, 172, 122, 149, 136, 183, 134, 142, 140, 186, 124, 155, 150, 190, 146,
+    },
+    {
+      255,  32,   0, 149, 118,  58,  95,  46, 118,  38, 176,  68, 118,  62, 122,  62, 255,  32,   0,  82, 118,  43, 136,  58, 118,  55,   0, 163, 118,  39, 109,  26,
+        0,   0,  71,   0, 255,   0,   0, 135,   0,   0, 126,   0, 255, 165,   0, 148,   0,   0,  85,   0, 255,   0,   0,  61,   0,   0,  95,   0, 170,   0, 240, 142,
+      146, 178, 181, 178, 158, 176, 186, 168, 146, 186, 185, 168, 146, 179, 179, 182, 148, 169, 170, 177, 150, 163, 182, 169, 147, 175, 182, 178, 157, 189, 181, 176,
+    },
+    {
+      255,  25,   0, 149, 118,  35,  95,  85, 118,  45, 176,  70, 118,  64, 122,  87, 255,  57,   0,  82, 118,  53, 136,  33, 118,  55,   0, 163, 118,  61, 109,  54,
+        0,   0, 111,   0, 255,   0,   0, 166,   0,   0, 149,   0, 255, 165,   0, 191,   0,   0, 126,   0, 255,   0,   0,  82,   0,   0, 124,   0, 170,   0, 240, 196,
+      142, 216, 176, 226, 143, 214, 187, 224, 154, 202, 182, 222, 142, 218, 173, 228, 153, 210, 170, 204, 143, 222, 188, 214, 153, 216, 182, 220, 154, 200, 179, 222,
+    },
+  },
+  {
+    {
+      255,   0,   0, 199,  80,   0, 127,   0,  80,   0, 235,  91,  80,   0, 163,   0, 255,   0,   0, 109,  80,   0, 181,   0,  80,  73,   0, 217,  80,   0, 145,   0,
+        0,   0,   1,   0, 255,   0,   0,   8,   0,   0,   9,   0, 255, 180,   0,   0,   0,   0,   0,   0, 255,   0,   0,   0,   0,   0,   0,   0, 170,   0, 240,   0,
+      160,  77, 176,  63, 155,  60, 172,  74, 142,  58, 166,  83, 158,  55, 167,  63, 141,  77, 166,  62, 143,  82, 162,  81, 146,  62, 168,  73, 149,  62, 169,  56,
+    },
+    {
+      255,  10,   0, 199,  80,  18, 127,  14,  80,  20, 235,  91,  80,  20, 163,  21, 255,  11,   0, 109,  80,  22, 181,  12,  80,  73,   0, 217,  80,  17, 145,  18,
+        0,   0,  15,   0, 255,   0,   0,  54,   0,   0,  33,   0, 255, 180,   0,  40,   0,   0,  40,   0, 255,   0,   0,  23,   0,   0,  29,   0, 170,   0, 240,  38,
+      153,  98, 179, 110, 154, 116, 161, 102, 150, 104, 177, 108, 155,  96, 163,  98, 160, 114, 171,  94, 140, 108, 164, 120, 142, 118, 163, 100, 140,  94, 174, 116,
+    },
+    {
+      255,  18,   0, 199,  80,  12, 127,  38,  80,  22, 235,  91,  80,  32, 163,  15, 255,  24,   0, 109,  80,  13, 181,  30,  80,  73,   0, 217,  80,  38, 145,  13,
+        0,   0,  46,   0, 255,   0,   0,  90,   0,   0,  72,   0, 255, 180,   0, 106,   0,   0,  61,   0, 255,   0,   0,  37,   0,   0,  65,   0, 170,   0, 240,  80,
+      143, 156, 178, 138, 156, 151, 178, 152, 141, 135, 170, 143, 159, 131, 170, 140, 148, 147, 165, 158, 152, 131, 169, 143, 160, 159, 176, 138, 144, 146, 168, 139,
+    },
+    {
+      255,  43,   0, 199,  80,  16, 127,  44,  80,  56, 235,  91,  80,  65, 163,  49, 255,  27,   0, 109,  80,  40, 181,  57,  80,  73,   0, 217,  80,  58, 145,  17,
+        0,   0,  82,   0, 255,   0,   0, 136,   0,   0, 117,   0, 255, 180,   0, 141,   0,   0,  78,   0, 255,   0,   0,  74,   0,   0, 103,   0, 170,   0, 240, 128,
+      153, 186, 171, 170, 141, 194, 166, 182, 141, 172, 178, 190, 151, 182, 165, 186, 159, 192, 166, 182, 151, 188, 178, 188, 151, 172, 178, 172, 149, 192, 170, 172,
+    },
+    {
+      255,  69,   0, 199,  80,  47, 127,  41,  80,  44, 235,  91,  80,  31, 163,  39, 255,  56,   0, 109,  80,  76, 181,  79,  80,  73,   0, 217,  80,  86, 145,  41,
+        0,   0,  94,   0, 255,   0,   0, 170,   0,   0, 161,   0, 255, 180,   0, 203,   0,   0, 123,   0, 255,   0,   0,  97,   0,   0, 133,   0, 170,   0, 240, 195,
+      148, 212, 179, 226, 145, 224, 170, 230, 149, 209, 162, 231, 157, 232, 180, 220, 151, 232, 161, 214, 146, 213, 170, 222, 150, 228, 162, 213, 149, 234, 163, 211,
+    },
+  },
+};
+
+struct GridsGoldenPattern {
+  uint8_t x;
+  uint8_t y;
+  uint32_t fnv1a;
+};
+
+// FNV-1a over the 96 interpolated levels at each (x, y)
+static const GridsGoldenPattern kGridsGoldenPatterns[10] = {
+    {0, 0, 0x394094F0u},
+    {255, 0, 0x992BA47Eu},
+    {0, 255, 0x50BA0A50u},
+    {255, 255, 0x78A1973Au},
+    {128, 128, 0x0C854624u},
+    {64, 192, 0x9721FA1Eu},
+    {200, 40, 0xADE5B44Cu},
+    {17, 99, 0xE55855DCu},
+    {99, 17, 0xFD1212C7u},
+    {248, 248, 0x78A1973Au},
+};
+
+#endif // GRIDS_NODE_MAP_H
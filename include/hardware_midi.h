@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 
+#include "din_midi_out.h"
+
 // Hardware MIDI Configuration
 // Set to 0 for UART0 (GPIO1/3 - Serial Breakout, no USB debug)
 // Set to 2 for UART2 (GPIO16/17 - Expansion GPIOs, keeps USB debug)
@@ -30,6 +32,7 @@
   // UART2 - Uses expansion GPIOs
   #define MIDI_RX_PIN 16  // GPIO16 (RX2)
   #define MIDI_TX_PIN 17  // GPIO17 (TX2)
+  #define MIDI_SERIAL MIDISerial
   // Keep debug output available when using UART2
   #define DEBUG_ENABLED true
 #else
@@ -66,44 +69,25 @@ inline void initHardwareMIDI() {
   // UART2 - initialize separate MIDI serial
   MIDISerial.begin(MIDI_BAUD_RATE, SERIAL_8N1, MIDI_RX_PIN, MIDI_TX_PIN);
 #endif
+  initDinMidiOut();
 }
 
-// Send 3-byte MIDI message to hardware output
+// Send 3-byte MIDI message to hardware output (paced, running status)
 inline void sendHardwareMIDI(uint8_t byte1, uint8_t byte2, uint8_t byte3) {
   if (!HARDWARE_MIDI_ENABLED) return;
-  
-#if HARDWARE_MIDI_UART == 0
-  Serial.write(byte1);
-  Serial.write(byte2);
-  Serial.write(byte3);
-#elif HARDWARE_MIDI_UART == 2
-  MIDISerial.write(byte1);
-  MIDISerial.write(byte2);
-  MIDISerial.write(byte3);
-#endif
+  dinMidiSend(byte1, byte2, byte3, 3);
 }
 
 // Send 2-byte MIDI message to hardware output (e.g., program change)
 inline void sendHardwareMIDI(uint8_t byte1, uint8_t byte2) {
   if (!HARDWARE_MIDI_ENABLED) return;
-  
-#if HARDWARE_MIDI_UART == 0
-  Serial.write(byte1);
-  Serial.write(byte2);
-#elif HARDWARE_MIDI_UART == 2
-  MIDISerial.write(byte1);
-  MIDISerial.write(byte2);
-#endif
+  dinMidiSend(byte1, byte2, 0, 2);
 }
 
+// Realtime bytes go out ahead of queued channel data
 inline void sendHardwareMIDISingle(uint8_t byte1) {
   if (!HARDWARE_MIDI_ENABLED) return;
-  
-#if HARDWARE_MIDI_UART == 0
-  Serial.write(byte1);
-#elif HARDWARE_MIDI_UART == 2
-  MIDISerial.write(byte1);
-#endif
+  dinMidiSend(byte1, 0, 0, 1);
 }
 
 #endif // HARDWARE_MIDI_H
@@ -0,0 +1,127 @@
+#ifndef HEADLESS_ROUTER_H
+#define HEADLESS_ROUTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * MIDI routing matrix for the headless dongle
+ *
+ * Every source port has a route to every other port: a message type mask and
+ * a channel mask. The routes compile into a flat table of destination masks
+ * indexed by source, message type and channel, so routing a message is one
+ * lookup. Messages are copied once, from the input buffer into each
+ * destination's batch, and a batch is handed to the port writer in one call
+ * (one UART write, one BLE notify per 20 bytes, one USB write).
+ *
+ * The router does no locking; the caller serialises routeMessage() and
+ * flush(). Routes persist in NVS (Preferences namespace "midirouter").
+ */
+
+enum class MidiPort : uint8_t { USB = 0, BLE, DIN, ESP_NOW, COUNT };
+
+static constexpr uint8_t kMidiPortCount = static_cast<uint8_t>(MidiPort::COUNT);
+
+enum MidiRouteType : uint8_t {
+  ROUTE_NOTE = 1 << 0,       // 8x, 9x
+  ROUTE_PRESSURE = 1 << 1,   // Ax, Dx
+  ROUTE_CC = 1 << 2,         // Bx
+  ROUTE_PROGRAM = 1 << 3,    // Cx
+  ROUTE_PITCH = 1 << 4,      // Ex
+  ROUTE_CLOCK = 1 << 5,      // F8
+  ROUTE_TRANSPORT = 1 << 6,  // FA, FB, FC
+  ROUTE_SYSTEM = 1 << 7,     // SysEx and system common (F0-F7)
+};
+
+static constexpr uint8_t kMidiRouteTypeCount = 8;
+static constexpr uint8_t kRouteAllTypes = 0xFF;
+static constexpr uint16_t kRouteAllChannels = 0xFFFF;
+static constexpr size_t kRouteBatchBytes = 128;
+static constexpr uint8_t kRouteBatchMessages = 32;
+static constexpr size_t kMidiSysExMaxBytes = 128;
+
+struct MidiRoute {
+  uint16_t channels;  // Bit n: channel n + 1 (system messages pass when any bit is set)
+  uint8_t types;      // MidiRouteType bits
+};
+
+struct MidiRouteStats {
+  uint32_t messages;
+  uint64_t totalLatencyUs;  // Input timestamp to the destination write
+  uint32_t maxLatencyUs;
+};
+
+// Length of the complete message at data (SysEx up to and including F7), 0
+// when data does not start a message
+size_t midiMessageLength(const uint8_t *data, size_t available);
+
+const char *midiPortName(MidiPort port);
+
+// Assembles complete messages from a byte stream (DIN, USB, BLE payload):
+// running status, realtime bytes inside other messages, SysEx up to
+// kMidiSysExMaxBytes (longer ones are dropped)
+class MidiStreamParser {
+public:
+  // Returns true when the byte completes a message; it stays valid until the
+  // next feed()
+  bool feed(uint8_t byte);
+  const uint8_t *message() const { return message_; }
+  size_t length() const { return length_; }
+
+private:
+  uint8_t buffer_[kMidiSysExMaxBytes] = {};
+  size_t count_ = 0;
+  uint8_t status_ = 0;
+  uint8_t expected_ = 0;
+  bool sysExOverflow_ = false;
+  uint8_t realtime_ = 0;
+  const uint8_t *message_ = nullptr;
+  size_t length_ = 0;
+};
+
+using MidiPortWriter = void (*)(MidiPort port, const uint8_t *bytes, size_t length);
+
+class MidiRouter {
+public:
+  explicit MidiRouter(MidiPortWriter writer) : writer_(writer) {}
+
+  // Every source to every other port, all channels, everything but clock:
+  // the dongle is the clock master and sends its own pulses
+  void setDefaults();
+  void setRoute(MidiPort source, MidiPort destination, MidiRoute route);
+  MidiRoute getRoute(MidiPort source, MidiPort destination) const;
+
+  // Queues one complete message for every destination its route allows.
+  // Returns the destination mask (bit per MidiPort).
+  uint8_t routeMessage(MidiPort source, const uint8_t *message, size_t length, uint32_t rxUs);
+  // Writes every pending batch
+  void flush();
+
+  MidiRouteStats stats(MidiPort source, MidiPort destination) const;
+  uint32_t unrouted(MidiPort source) const { return unrouted_[static_cast<uint8_t>(source)]; }
+  void resetStats();
+
+  bool load();
+  bool save() const;
+
+private:
+  struct Batch {
+    uint8_t bytes[kRouteBatchBytes];
+    size_t length;
+    uint8_t count;
+    uint8_t source[kRouteBatchMessages];
+    uint32_t rxUs[kRouteBatchMessages];
+  };
+
+  void compile();
+  void flushPort(uint8_t destination);
+
+  MidiPortWriter writer_;
+  MidiRoute routes_[kMidiPortCount][kMidiPortCount] = {};
+  uint8_t table_[kMidiPortCount][kMidiRouteTypeCount][16] = {};  // Destination masks
+  Batch batches_[kMidiPortCount] = {};
+  MidiRouteStats stats_[kMidiPortCount][kMidiPortCount] = {};
+  uint32_t unrouted_[kMidiPortCount] = {};
+};
+
+#endif // HEADLESS_ROUTER_H
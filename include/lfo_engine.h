@@ -0,0 +1,138 @@
+#ifndef LFO_ENGINE_H
+#define LFO_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Background LFO bank
+ *
+ * kLfoCount LFOs run from an esp_timer at kLfoControlRateHz, whatever mode
+ * is in the foreground. Phase is a 32-bit accumulator (one cycle = 2^32) and
+ * shapes come from a sine table or the phase bits, so the rate does not
+ * depend on how long a UI frame took.
+ *
+ * A free running LFO adds a fixed 32.32 increment per step. A synced LFO has no
+ * accumulator: its phase is computed from the clock manager's tick count,
+ * (tick % syncTicks) / syncTicks, so it is exact at every tick and never
+ * drifts from the clock. Between ticks it moves on by the time since the last
+ * tick over the last tick interval, stopping short of the next tick's phase,
+ * so it holds when the clock stops.
+ *
+ * Outputs go through sendMIDIControl() and sendMIDIPitchBend(), so each
+ * transport still gets them at its coalescer rate.
+ */
+
+enum class LfoWaveform : uint8_t { SINE = 0, TRIANGLE, SQUARE, SAW, COUNT };
+enum class LfoTarget : uint8_t { CC = 0, PITCH_BEND };
+
+static constexpr uint8_t kLfoCount = 4;
+static constexpr uint32_t kLfoControlRateHz = 500;
+static constexpr uint16_t kLfoMinRateMilliHz = 100;    // 0.1 Hz
+static constexpr uint16_t kLfoMaxRateMilliHz = 10000;  // 10 Hz
+
+struct LfoConfig {
+  bool running;
+  LfoWaveform waveform;
+  LfoTarget target;
+  uint8_t channel;       // 0-15
+  uint8_t cc;            // CC target only
+  uint8_t amount;        // 0-127: depth either side of the centre value
+  uint16_t rateMilliHz;  // Free running rate
+  uint16_t syncTicks;    // 0: free running; else one cycle every syncTicks clock ticks
+};
+
+struct LfoOutput {
+  uint8_t index;
+  LfoTarget target;
+  uint8_t channel;
+  uint8_t cc;
+  uint16_t value;  // 0-127, or 0-16383 for pitch bend
+};
+
+// -32767..32767 for phase 0..2^32-1; sine and triangle start at their
+// midpoint and minimum, as the LFO mode has always drawn them
+int16_t lfoWaveSample(LfoWaveform waveform, uint32_t phase);
+
+// The LFOs and the clock position; no locking, no I/O, so the drift
+// simulation drives the same code as the timer
+class LfoBank {
+public:
+  // Starting a free running LFO restarts it at phase 0; anything else keeps
+  // the phase
+  void configure(uint8_t index, const LfoConfig &config);
+  LfoConfig config(uint8_t index) const;
+  void resetPhase(uint8_t index);
+
+  // tick: the clock manager's tick count; timestampUs: when it happened
+  void clockTick(uint32_t tick, uint32_t timestampUs);
+
+  // One control step; writes the outputs whose value changed to out (room for
+  // kLfoCount) and returns how many
+  size_t step(uint32_t nowUs, LfoOutput *out);
+
+  uint32_t phase(uint8_t index) const;   // Free running: the next step's phase
+  uint16_t output(uint8_t index) const;  // Last value emitted
+
+private:
+  struct Voice {
+    LfoConfig config;
+    uint32_t phase;
+    uint32_t phaseFraction;  // Free running: the 32 bits below phase
+    uint64_t increment;      // Per step, free running, 32.32
+    uint32_t syncBase;       // Phase at the last tick
+    uint64_t syncRatio;      // Phase per microsecond up to the next tick, 16.16
+    uint16_t output;
+    bool emitted;
+  };
+
+  void updateSync(Voice &voice);
+  uint32_t syncPhase(const Voice &voice, uint32_t nowUs) const;
+
+  Voice voices_[kLfoCount] = {};
+  uint32_t tick_ = 0;
+  uint32_t tickUs_ = 0;
+  uint32_t tickIntervalUs_ = 0;  // 0 until two consecutive ticks arrived
+  bool haveTick_ = false;
+};
+
+struct LfoEngineStats {
+  uint32_t steps;
+  uint32_t outputs;    // Values handed to the coalescer
+  uint32_t maxStepUs;  // Longest timer callback
+  uint32_t maxGapUs;   // Longest time between two steps
+};
+
+// Starts the control-rate timer; every LFO starts stopped, on the LFO mode's
+// defaults (CC 1, 1 Hz sine)
+void initLfoEngine();
+
+// Called by the clock manager for every tick it emits (any context, ISR included)
+void lfoEngineClockTick(uint32_t tick, uint32_t timestampUs);
+
+void lfoEngineConfigure(uint8_t index, const LfoConfig &config);
+LfoConfig lfoEngineGetConfig(uint8_t index);
+uint32_t lfoEngineGetPhase(uint8_t index);
+uint16_t lfoEngineGetOutput(uint8_t index);
+
+LfoEngineStats lfoEngineGetStats();
+void lfoEngineResetStats();
+
+struct LfoDriftResult {
+  uint32_t bars;
+  uint32_t ticks;
+  uint32_t steps;
+  uint32_t barStartErrors;  // Bar starts where a synced LFO was not at phase 0
+  uint32_t reversals;       // Steps where a synced LFO moved backwards
+  float maxTickError;       // Synced phase against the jitter-free clock, in ticks
+  float freeDriftDeg;       // Free running LFO against its exact rate, at the end
+  uint32_t elapsedMs;
+  bool ok;
+};
+
+// Runs bars of 24 PPQN clock at bpm, with up to jitterUs of timestamp jitter,
+// through a separate bank stepped at the control rate: a 1-bar and a
+// quarter-note synced LFO and a free running 1 Hz LFO. Sends nothing.
+LfoDriftResult lfoRunDriftSimulation(uint32_t bars, uint16_t bpm, uint16_t jitterUs);
+
+#endif // LFO_ENGINE_H
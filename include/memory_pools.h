@@ -0,0 +1,33 @@
+#ifndef MEMORY_POOLS_H
+#define MEMORY_POOLS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Memory pools - long-lived buffers placed by size and access pattern
+ *
+ * Large, rarely-touched buffers (looper event storage, caches) are taken from
+ * PSRAM when the board has it and from the internal heap otherwise, instead of
+ * sitting in static DRAM next to the display's DMA buffers. Each allocation is
+ * named and listed in the boot memory report together with any hot state that
+ * deliberately stays in internal RAM.
+ */
+
+enum class PoolPlacement : uint8_t {
+  PSRAM = 0,   // Allocated in PSRAM
+  INTERNAL,    // Allocated in internal RAM (no PSRAM, or PSRAM full)
+  STATIC       // Static DRAM, recorded for the report only
+};
+
+// Returns nullptr (and records the failure) if neither heap has room. Pools are
+// never freed; scratch buffers may be, with heap_caps_free(), and repeated
+// allocations under one name are listed once, at the largest size seen
+void *poolAllocatePreferPsram(const char *name, size_t bytes);
+
+// Records static DRAM state so the report shows what stays internal on purpose
+void poolNoteStatic(const char *name, size_t bytes);
+
+void poolPrintReport();
+
+#endif // MEMORY_POOLS_H
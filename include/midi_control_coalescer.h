@@ -0,0 +1,107 @@
+#ifndef MIDI_CONTROL_COALESCER_H
+#define MIDI_CONTROL_COALESCER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Output-stage coalescer for continuous controllers
+ *
+ * LFOs, the XY pad and the encoder and Waaave panels produce a CC or pitch
+ * bend on every UI pass or touch move. Those go through sendMIDIControl() and
+ * friends instead of sendMIDI(). Each (channel, controller) keeps only its
+ * latest value, and every destination sends what changed at most its max rate
+ * times a second, from the MIDI output task. Notes and clock no longer queue
+ * behind a controller flood, and the latest value always goes out, at most
+ * one window late.
+ *
+ * 14-bit controllers (CC 0-31, LSB on CC 32-63) and NRPNs (select on CC
+ * 99/98, data on CC 6/38) go out as MSB/LSB pairs. The MSB is repeated only
+ * when it changed, and the NRPN select only when the destination last had
+ * another parameter selected on that channel.
+ *
+ * Switches (CC 64-69), buttons and channel mode messages (CC 120-127) must
+ * not lose a value inside a window; keep sending them with sendMIDI().
+ */
+
+enum class MidiControlKind : uint8_t { CC7 = 0, CC14, NRPN, PITCH_BEND };
+
+static constexpr uint8_t kMidiControlDestinations = 4;  // MidiOutPort::COUNT
+static constexpr size_t kMidiControlSlots = 32;
+static constexpr size_t kMidiControlMaxMessages = kMidiControlSlots * 4;  // One flush: NRPN is four CCs
+
+// Receives the messages of a flush, one destination at a time
+using MidiControlEmit = void (*)(uint8_t destination, uint8_t status, uint8_t data1, uint8_t data2);
+
+// Slot table and encoding; no locking, no I/O, so the simulation drives the
+// same code as the output task
+class MidiControlCoalescer {
+public:
+  // Records the latest value. A new controller takes a free slot, or one whose
+  // value every destination has; returns false when there is none (the
+  // caller sends the value directly).
+  bool update(MidiControlKind kind, uint8_t channel, uint16_t controller, uint16_t value);
+
+  // Emits every value that changed for destination since its last flush.
+  // Returns the messages emitted.
+  size_t flush(uint8_t destination, MidiControlEmit emit);
+
+private:
+  struct Slot {
+    bool used;
+    MidiControlKind kind;
+    uint8_t channel;
+    uint16_t controller;  // CC number, NRPN parameter; unused for pitch bend
+    uint16_t value;
+    uint8_t pending;      // Bit per destination
+    uint8_t known;        // Bit per destination: sent[] is valid
+    uint16_t sent[kMidiControlDestinations];
+  };
+
+  Slot slots_[kMidiControlSlots] = {};
+  // Per destination and channel: the NRPN parameter last selected
+  uint16_t nrpnSelected_[kMidiControlDestinations][16] = {};
+  bool nrpnKnown_[kMidiControlDestinations][16] = {};
+};
+
+struct MidiControlStats {
+  uint32_t updates;        // sendMIDIControl*() calls
+  uint32_t overflows;      // Sent directly: no free slot
+  uint32_t requestedBytes; // Per destination, had every update gone out as it came
+  uint32_t sentBytes[kMidiControlDestinations];
+  uint32_t sentMessages[kMidiControlDestinations];
+  uint32_t flushes[kMidiControlDestinations];
+};
+
+// channel 0-15; values are clamped to 7 or 14 bits
+void sendMIDIControl(uint8_t channel, uint8_t controller, uint8_t value);
+void sendMIDIControl14(uint8_t channel, uint8_t controller, uint16_t value);  // controller 0-31
+void sendMIDINrpn(uint8_t channel, uint16_t parameter, uint16_t value);       // 14-bit parameter and value
+void sendMIDIPitchBend(uint8_t channel, uint16_t value);                      // 0-16383, 8192 = centre
+
+// Called from the MIDI output task on every pass
+void midiControlService(uint32_t nowUs);
+
+// 0 sends on every output task pass (about 1 kHz)
+void midiControlSetMaxRate(uint8_t destination, uint16_t hz);
+uint16_t midiControlGetMaxRate(uint8_t destination);
+
+MidiControlStats midiControlGetStats();
+void midiControlResetStats();
+
+struct MidiControlSimResult {
+  uint32_t updates;
+  uint32_t requestedBytes;
+  uint32_t sentBytes[kMidiControlDestinations];
+  uint16_t maxStep[kMidiControlDestinations];  // Largest jump between consecutive pitch bend values sent
+  uint16_t inputMaxStep;                       // The same, for the values fed in
+  uint32_t maxLagUs[kMidiControlDestinations]; // Update to send
+  bool ok;                                     // Every destination ended on the final values
+};
+
+// Feeds a pitch bend LFO (14-bit, 0.5 Hz), a CC LFO and an XY pad sweep at
+// the UI loop's update rate through a separate coalescer, flushing each
+// destination at its configured max rate. Does not touch any transport.
+MidiControlSimResult midiControlRunSimulation(uint16_t updateHz, uint16_t seconds);
+
+#endif // MIDI_CONTROL_COALESCER_H
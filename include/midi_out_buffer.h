@@ -1,6 +1,7 @@
 #ifndef MIDI_OUT_BUFFER_H
 #define MIDI_OUT_BUFFER_H
 
+#include <atomic>
 #include <stdint.h>
 #include <stddef.h>
 #include <freertos/FreeRTOS.h>
@@ -18,10 +19,44 @@
  * - Thread-safe enqueueing from any context (ISR-safe)
  * - Dedicated output task for minimal jitter
  * - Scheduled note-offs with tick-based timing
- * - Panic/all-notes-off on stop/reset
+ * - Soft panic on stop/reset: note-offs only for the notes that are sounding
  * - Integration with BLE, Hardware MIDI, WiFi transports
+ *
+ * The buffer is the only MIDI clock emitter. The clock manager posts each
+ * tick from the timer ISR (or the external pulse) with its timestamp; the
+ * output task wakes on it and sends F8 on every transport ahead of any queued
+ * channel events. Start/Continue/Stop share that realtime lane, so they stay
+ * in order with the clock.
  */
 
+enum class MidiClockTransport : uint8_t { BLE = 0, DIN, ESP_NOW, WIFI, COUNT };
+
+// Each transport reports every F8 it actually sends, wherever it came from,
+// so a second clock path shows up in the trace
+void midiClockTraceCount(MidiClockTransport transport);
+
+struct MidiClockTraceResult {
+  bool running;
+  uint16_t quarters;       // Complete quarter notes checked
+  uint16_t target;
+  uint32_t badQuarters;    // A transport sent something other than 0 or 24 clocks
+  uint16_t minPerQuarter[static_cast<uint8_t>(MidiClockTransport::COUNT)];
+  uint16_t maxPerQuarter[static_cast<uint8_t>(MidiClockTransport::COUNT)];
+  uint32_t clocks;         // Emitted while tracing
+  uint32_t meanLatencyUs;  // Tick timestamp until every transport has the pulse
+  uint32_t minLatencyUs;   // (sent, or queued for the BLE and WiFi senders)
+  uint32_t maxLatencyUs;
+  uint32_t laneDrops;      // Realtime lane full
+};
+
+// Counts F8 per transport between quarter-note ticks of the running clock
+void midiClockTraceStart(uint16_t quarters);
+MidiClockTraceResult midiClockTraceResult();
+
+// F8 pulses the output task has handed to the transports since boot, and the
+// clock manager tick of the last one; read together
+void midiClockSentCount(uint32_t &count, uint32_t &lastTick);
+
 // MIDI event types
 enum class MidiEventType : uint8_t {
   NOTE_ON = 0,
@@ -31,7 +66,8 @@ enum class MidiEventType : uint8_t {
   START,
   CONTINUE,
   STOP,
-  NOTE_WITH_DURATION  // Special: note-on with auto note-off
+  NOTE_WITH_DURATION,  // Special: note-on with auto note-off
+  RELEASE_SOUNDING     // Special: note-off for each sounding note (channel 0xFF = all)
 };
 
 // MIDI event structure (fixed size for ring buffer)
@@ -79,8 +115,9 @@ public:
   // Note with automatic note-off after duration (in ticks)
   bool note(uint8_t channel, uint8_t note, uint8_t velocity, uint16_t durationTicks);
   
-  // Transport messages
-  bool midiClock();
+  // Realtime lane. clockTick() may be called from an ISR; tick is the clock
+  // manager's tick count, timestampUs when the tick happened.
+  bool clockTick(uint32_t tick, uint32_t timestampUs);
   bool midiStart();
   bool midiContinue();
   bool midiStop();
@@ -94,6 +131,15 @@ public:
   // Send all notes off for specific channel
   void allNotesOff(uint8_t channel);
   
+  // Soft panic: note-offs for the notes the active-note map holds, sent from
+  // the output task after everything queued before it. Falls back to the CC
+  // burst when the queue is full.
+  void softPanic();
+  // Returns a ticket that releaseDone() reports once the output task has sent
+  // the note-offs; 0 (already done) when the CC fallback was used
+  uint32_t releaseSounding(uint8_t channel);
+  bool releaseDone(uint32_t ticket) const;
+  
   // Get buffer statistics
   size_t getQueuedCount() const;
   size_t getActiveNoteCount() const;
@@ -105,6 +151,8 @@ private:
   volatile size_t writeIndex_;
   volatile size_t readIndex_;
   mutable SemaphoreHandle_t mutex_;
+  uint32_t releaseTicket_;  // Last ticket handed out, under mutex_
+  std::atomic<uint32_t> releasesDone_;
   
   // Scheduled note-offs
   ScheduledNoteOff scheduledNotes_[kMaxScheduledNotes];
@@ -115,7 +163,9 @@ private:
   volatile bool running_;
   
   // Internal methods
-  bool enqueue(const MidiEvent& event);
+  bool pushRealtime(uint8_t status, uint32_t tick, uint32_t timestampUs);
+  void emitRealtime();
+  bool enqueue(const MidiEvent& event, uint32_t* releaseTicket = nullptr);
   bool dequeue(MidiEvent& event);
   void processEvent(const MidiEvent& event);
   void sendMidiMessage(uint8_t status, uint8_t data1, uint8_t data2);
@@ -5,9 +5,45 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+// Receives every complete channel-voice message (note, CC, program change,
+// pitch bend...) parsed from an input transport. Called on the clock task for
+// UART/UDP (drained from the RX queue), the BLE task, or the ESP-NOW
+// callback, so it must not block. timestampUs is esp_timer_get_time() at the
+// time the bytes arrived; source is the MidiClockMaster it arrived on
+// (CLOCK_INTERNAL for messages injected on the device itself).
+using MidiChannelInputHandler = void (*)(uint8_t status, uint8_t data1, uint8_t data2,
+                                         uint32_t timestampUs, uint8_t source);
+
+// DIN and UDP input is read by a dedicated RX task (core 0) that wakes on UART
+// receive events, timestamps the bytes and queues parsed events. The clock
+// task drains the queue with midiTransportProcessInput() before each clock
+// update, so input latency no longer depends on the UI frame time.
+enum class MidiRxMode : uint8_t {
+  TASK = 0,  // RX task reads, clock task handles
+  UI_LOOP    // Previous behaviour: handleMidiTransports() polls from appLoop
+};
+
+struct MidiRxStats {
+  uint32_t events;         // DIN events handled
+  uint64_t totalLatencyUs; // Arrival (UART receive event) to handling
+  uint32_t maxLatencyUs;
+  uint32_t lateEvents;     // Handled more than 2 ms after arrival
+  uint32_t drops;          // Queue full
+  uint32_t queueHighWater;
+};
+
 void initMidiTransports();
-void handleMidiTransports();
+void handleMidiTransports();       // UI loop; reads only in MidiRxMode::UI_LOOP
+void midiTransportProcessInput();  // Clock task
+// Returns once no read by the previous reader is in progress
+void midiTransportSetRxMode(MidiRxMode mode);
+MidiRxMode midiTransportGetRxMode();
+MidiRxStats midiTransportGetRxStats();
+void midiTransportResetRxStats();
 void midiTransportProcessIncomingBytes(const uint8_t *data, size_t length);
+void midiTransportProcessChannelMessage(uint8_t status, uint8_t data1, uint8_t data2,
+                                        uint8_t source);
+void midiTransportSetChannelInputHandler(MidiChannelInputHandler handler);
 void sendWiFiMidiMessage(const uint8_t *data, size_t length);
 bool midiTransportIsPulseActive();
 
@@ -0,0 +1,96 @@
+#ifndef MIDI_TRANSPORT_QUEUE_H
+#define MIDI_TRANSPORT_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * Per-transport MIDI output queues
+ *
+ * BLE notify() and WiFiUDP::endPacket() can block for milliseconds on a
+ * congested link. Each slow transport gets a bounded queue drained by its own
+ * sender task, so the caller pays for an enqueue only and the DIN byte that
+ * follows it is never held behind a slow link. The sender takes up to
+ * kBatch messages per wake and hands them to the transport in one call.
+ *
+ * Drop policy, per queue:
+ * - MIDI_QUEUE_KEEP_REALTIME: F8/FA/FB/FC may use the last kRealtimeReserve
+ *   slots, which channel messages cannot take; a realtime message that still
+ *   finds the queue full evicts the oldest channel message.
+ * - MIDI_QUEUE_COALESCE_CC: a CC whose controller is the last message queued
+ *   on its channel (realtime and other channels aside) replaces the queued
+ *   value, so a backed-up link sends the latest value rather than the whole
+ *   sweep. A CC behind any other message on the channel, another CC included,
+ *   is queued, so RPN/NRPN sequences keep their order.
+ * Anything else that does not fit is dropped and counted.
+ */
+
+enum MidiQueuePolicy : uint8_t {
+  MIDI_QUEUE_KEEP_REALTIME = 1 << 0,
+  MIDI_QUEUE_COALESCE_CC = 1 << 1,
+};
+
+struct MidiQueuedMessage {
+  uint8_t status;
+  uint8_t data1;
+  uint8_t data2;
+  uint8_t length;  // 1-3 bytes
+};
+
+using MidiQueueSender = void (*)(const MidiQueuedMessage *messages, size_t count);
+
+struct MidiQueueStats {
+  uint32_t queued;
+  uint32_t sent;
+  uint32_t batches;        // Sender calls
+  uint32_t coalesced;      // CCs that replaced a queued value
+  uint32_t dropped;        // Channel messages that found the queue full
+  uint32_t evicted;        // Channel messages pushed out by realtime
+  uint32_t realtimeDrops;  // Realtime with nothing left to evict
+  uint32_t maxSendUs;      // Longest single sender call
+  uint16_t maxDepth;
+};
+
+class MidiTransportQueue {
+public:
+  static constexpr size_t kCapacity = 64;
+  static constexpr size_t kRealtimeReserve = 16;
+  static constexpr size_t kBatch = 16;
+
+  MidiTransportQueue(const char *name, MidiQueueSender sender, uint8_t policy);
+
+  // Creates the sender task (pinned to core, at priority)
+  bool begin(UBaseType_t priority, BaseType_t core);
+
+  // Never blocks; returns false when the message was dropped
+  bool push(uint8_t status, uint8_t data1, uint8_t data2, uint8_t length);
+
+  const char *name() const { return name_; }
+  size_t depth() const;
+  MidiQueueStats stats() const;
+  void resetStats();
+
+  // Fault injection: the sender waits this long before every call, standing
+  // in for a congested link
+  void setSendDelayMs(uint16_t ms) { sendDelayMs_ = ms; }
+  uint16_t sendDelayMs() const { return sendDelayMs_; }
+
+private:
+  static void senderTask(void *parameter);
+  void senderLoop();
+  bool evictOldestChannelLocked();
+
+  const char *name_;
+  MidiQueueSender sender_;
+  uint8_t policy_;
+  MidiQueuedMessage entries_[kCapacity] = {};  // Oldest first
+  size_t count_ = 0;
+  mutable portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+  TaskHandle_t task_ = nullptr;
+  volatile uint16_t sendDelayMs_ = 0;
+  MidiQueueStats stats_ = {};
+};
+
+#endif // MIDI_TRANSPORT_QUEUE_H
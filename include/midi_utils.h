@@ -9,13 +9,36 @@
 #include "esp_now_midi_module.h"
 #endif
 
+class MidiTransportQueue;
+
+// Output transports, for senders that address one at a time
+enum class MidiOutPort : uint8_t { BLE = 0, DIN, ESP_NOW, WIFI, COUNT };
+
 // MIDI utility functions
+// DIN and ESP-NOW are written in place; BLE and WiFi go through their own
+// output queues (midi_transport_queue.h), so a slow link cannot hold up the
+// others
 void sendMIDI(byte cmd, byte note, byte vel);
+// sendMIDI() to every transport but `skip` (MidiOutPort::COUNT skips none), for
+// effects that must not play back into the transport their input came from
+void sendMIDIExcept(MidiOutPort skip, byte cmd, byte note, byte vel);
+// One transport only; no note tracking (controllers, see midi_control_coalescer.h).
+// Realtime bytes (0xF8-0xFF) go out as single-byte messages
+void sendMIDITo(MidiOutPort port, byte cmd, byte data1, byte data2);
+// Realtime senders write to every transport at once; clock and transport
+// messages go through midiOutBuffer (clockTick/midiStart/...) so there is one
+// emitter and one ordering
 void sendMIDIClock();
 void sendMIDIStart();
+void sendMIDIContinue();
 void sendMIDIStop();
 int getNoteInScale(int scaleIndex, int degree, int octave);
 String getNoteNameFromMIDI(int midiNote);
 void stopAllModes();
 
+// Starts the BLE and WiFi sender tasks
+void initMidiOutputQueues();
+uint8_t midiOutputQueueCount();
+MidiTransportQueue *midiOutputQueue(uint8_t index);
+
 #endif
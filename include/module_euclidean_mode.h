@@ -4,23 +4,27 @@
 #include "common_definitions.h"
 #include "midi_utils.h"
 #include "ui_elements.h"
+#include "euclidean_patterns.h"
 
-#define EUCLIDEAN_MAX_STEPS 32
+#define EUCLIDEAN_MAX_STEPS EUCLIDEAN_PATTERN_MAX_STEPS
 #define EUCLIDEAN_VOICE_COUNT 8
 
 struct EuclideanVoice {
-  uint8_t steps;
+  uint8_t steps;          // Voice length; voices wrap independently (polymetric)
   uint8_t events;
   int8_t rotation;
   uint8_t midiNote;
   uint16_t color;
-  bool pattern[EUCLIDEAN_MAX_STEPS];
+  bool inverted;
+  EuclidLogicOp logicOp;  // Combines this voice's hits with logicSource's on each step
+  uint8_t logicSource;
+  uint8_t position;       // Next step to play
+  uint64_t mask;          // Rotated (and inverted) pattern, bit i = step i
 };
 
 struct EuclideanState {
   EuclideanVoice voices[EUCLIDEAN_VOICE_COUNT];
   uint8_t bpm;
-  uint8_t currentStep;
   bool tripletMode;
   bool pendingNoteRelease[EUCLIDEAN_VOICE_COUNT];
   uint32_t tripletAccumulator;
@@ -32,5 +36,7 @@ void initializeEuclideanMode();
 void drawEuclideanMode();
 void handleEuclideanMode();
 void updateEuclideanSequencer();
+void setEuclideanVoiceLogic(uint8_t voice, EuclidLogicOp op, uint8_t source);
+void setEuclideanVoiceInverted(uint8_t voice, bool inverted);
 
 #endif // MODULE_EUCLIDEAN_MODE_H
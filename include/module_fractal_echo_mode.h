@@ -8,7 +8,12 @@
 // Maximum values for arrays
 #define FRAC_MAX_TAPS 4
 #define FRAC_MAX_ITER 6
-#define FRAC_MAX_EVENTS 128
+// One slot per echo, held from scheduling until its Note Off is sent. The
+// default parameters (3 iterations x 4 taps = 12 echoes, ~0.6 s per slot on
+// average) keep 100 live notes/s near 700 slots. A note schedules at most
+// FRAC_MAX_TAPS * FRAC_MAX_ITER (24) echoes, so maxEchoesPerNote (default 32)
+// only limits below that; heavier settings shed echoes, counted as dropped.
+#define FRAC_MAX_EVENTS 1024
 
 // Fractal parameters
 struct FractalParams {
@@ -30,19 +35,39 @@ struct FractalParams {
   int8_t offsets[FRAC_MAX_ITER];
 };
 
-// Scheduled MIDI event
-struct MidiEvent {
-  uint32_t dueTimeMs;
-  uint8_t status;
-  uint8_t data1;
-  uint8_t data2;
-  bool active;
+// Scheduled echo (min-heap entry ordered by dueTimeUs). A slot carries one
+// echo through both phases: it fires as Note On, then is re-armed in place
+// as the matching Note Off lengthMs later.
+struct FractalEchoEvent {
+  uint32_t dueTimeUs;
+  uint32_t channel : 4;
+  uint32_t noteOn : 1;
+  uint32_t note : 7;
+  uint32_t velocity : 7;
+  uint32_t lengthMs : 12;
+  uint32_t probe : 1;  // First echo of a latency-probe input note
+  uint8_t skipPort;    // MidiOutPort the input arrived on (COUNT: local input)
+};
+
+// Live-input counters (reset with resetFractalEchoStats())
+struct FractalEchoStats {
+  uint32_t notesIn;          // Note Ons received from transports
+  uint32_t echoesScheduled;
+  uint32_t echoesSent;
+  uint32_t dropped;          // Echoes rejected because the scheduler was full
+  uint32_t loopsIgnored;     // Inputs matching an echo just sent (MIDI thru, a second unit)
+  uint16_t queued;
+  uint16_t peakQueued;
+  uint32_t lastIngestUs;     // Input timestamp -> echoes scheduled
+  uint32_t maxIngestUs;
+  uint32_t maxLatenessUs;    // Echo due time -> handed to sendMIDI
+  uint32_t lastFirstEchoUs;  // Input timestamp -> first echo sent (includes tap delay)
+  uint32_t minFirstEchoUs;
+  uint32_t maxFirstEchoUs;
 };
 
 // Fractal Note Echo effect state
 extern FractalParams fractalParams;
-extern MidiEvent eventQueue[FRAC_MAX_EVENTS];
-extern int eventQueueSize;
 
 // UI state
 extern int fractalPage;  // 0=Timing, 1=Dynamics, 2=Offsets
@@ -52,9 +77,21 @@ void initializeFractalEchoMode();
 void drawFractalEchoMode();
 void handleFractalEchoMode();
 
-// Effect processing
+// Effect processing. The effect is always on: initFractalEchoService() hooks
+// it into MIDI input at boot and processFractalEcho() is serviced from the
+// clock task, independent of which mode is in the foreground.
+void initFractalEchoService();
 void processFractalEcho();
 void addFractalEcho(uint8_t note, uint8_t velocity, uint8_t channel);
-void processMidiEvents();
+// Echoes go to every transport but the one the input arrived on
+void fractalEchoHandleMidiInput(uint8_t status, uint8_t data1, uint8_t data2, uint32_t timestampUs,
+                                uint8_t source);
+
+// Diagnostics
+FractalEchoStats getFractalEchoStats();
+void resetFractalEchoStats();
+// Inject notesPerSecond synthetic Note Ons through the live input path for
+// `seconds`, then print the stats once every echo has drained.
+void startFractalEchoBench(uint16_t notesPerSecond, uint16_t seconds);
 
 #endif // MODULE_FRACTAL_ECHO_MODE_H
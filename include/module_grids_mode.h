@@ -4,8 +4,10 @@
 #include "common_definitions.h"
 #include "ui_elements.h"
 #include "midi_utils.h"
+#include "grids_node_map.h"
 
-#define GRIDS_STEPS 16
+#define GRIDS_STEPS GRIDS_NODE_STEPS
+#define GRIDS_INSTRUMENTS GRIDS_NODE_INSTRUMENTS
 #define GRIDS_MIN_BPM 60
 #define GRIDS_MAX_BPM 240
 
@@ -23,9 +25,17 @@ struct GridsState {
   uint8_t hatNote;
   uint8_t swing;
   uint8_t accentThreshold;
-  uint8_t kickPattern[GRIDS_STEPS];
-  uint8_t snarePattern[GRIDS_STEPS];
-  uint8_t hatPattern[GRIDS_STEPS];
+  uint8_t chaos;                                   // 0-255, scales per-cycle perturbation
+  uint8_t perturbation[GRIDS_INSTRUMENTS];         // Redrawn at step 0 of each cycle
+  uint8_t levels[GRIDS_INSTRUMENTS][GRIDS_STEPS];  // Kick, snare, hat
+};
+
+struct GridsBenchResult {
+  uint32_t iterations;
+  uint32_t regenerateUs;  // Total for full interpolations
+  uint32_t cachedUs;      // Total for cache lookups of the same positions
+  uint32_t cacheHits;
+  uint32_t cacheMisses;
 };
 
 extern GridsState grids;
@@ -34,5 +44,7 @@ void initializeGridsMode();
 void drawGridsMode();
 void handleGridsMode();
 void regenerateGridsPattern();
+GridsBenchResult runGridsBenchmark(uint32_t iterations);
+int checkGridsGoldenPatterns();  // Returns the number of mismatching positions
 
 #endif // MODULE_GRIDS_MODE_H
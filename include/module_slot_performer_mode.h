@@ -1,8 +1,46 @@
 #ifndef MODULE_SLOT_PERFORMER_MODE_H
 #define MODULE_SLOT_PERFORMER_MODE_H
 
+// Allocates the looper event pool (PSRAM when present); call once at boot
+void initSlotPerformerMemory();
+
 void initializeSlotPerformerMode();
 void drawSlotPerformerMode();
 void handleSlotPerformerMode();
 
+struct SlotLooperBenchResult {
+  uint32_t bars;
+  uint32_t events;    // Events across all 12 loopers
+  uint32_t scanUs;    // Every event compared on every tick
+  uint32_t cursorUs;  // Sorted segments walked with a play cursor
+  uint32_t played;    // Events emitted per method (must match)
+};
+
+// Plays 12 full loopers for `bars` bars from a scratch pool, without touching live slots
+SlotLooperBenchResult runSlotLooperBenchmark(uint32_t bars);
+
+struct SlotDriftResult {
+  bool ran;              // False if the transport is stopped
+  uint32_t clockTicks;   // F8 pulses midiOutBuffer sent since the slot transport started
+  uint32_t slotTicks;    // Ticks Slot Performer processed over the same span
+  int32_t drift;         // clockTicks - slotTicks
+  uint32_t engineSteps;  // Engine steps dispatched by ClockRuntime
+};
+
+// Compares the running transport against the MIDI clock it follows
+SlotDriftResult measureSlotPerformerDrift();
+
+struct SlotDispatchResult {
+  bool ran;                      // False if the clock was busy
+  uint32_t fedTicks;             // Ticks fed to the private runtime
+  uint32_t processedTicks;       // Ticks Slot Performer processed from them
+  uint32_t engineSteps;          // Engine steps the runtime dispatched
+  uint32_t expectedEngineSteps;  // One per 6 ticks per engine slot
+};
+
+// Feeds `minutes` of ticks at the current BPM through a private ClockRuntime
+// with MIDI output suppressed and counts what it dispatches. No F8 is sent, so
+// this cannot see clock drift. Needs Slot Performer stopped and the MIDI clock idle.
+SlotDispatchResult runSlotPerformerDispatchCheck(uint32_t minutes);
+
 #endif
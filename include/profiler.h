@@ -0,0 +1,101 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Profiler - per-task CPU and stack, per-section timings
+ *
+ * Sections are timed with ProfileScope, which reads the CPU cycle counter at
+ * both ends (a few cycles, no syscall). Calls, total and longest time add up
+ * over one-second windows; profilerService() publishes the last complete
+ * window and samples every FreeRTOS task: stack high-water mark and, when
+ * the build has run-time stats, its share of CPU over the same window.
+ *
+ * Sections nest (render runs inside flush), so their load figures overlap.
+ * A sample whose scope ended on another core than it started is dropped: the
+ * two cores' cycle counters are not in step.
+ *
+ * While a trace is armed each scope is also written to a trace buffer (allocated
+ * on first use), read out as Chrome trace events for chrome://tracing or
+ * ui.perfetto.dev.
+ */
+
+enum class ProfileSection : uint8_t {
+  RENDER = 0,      // Mode draw callback, once per LVGL band
+  FLUSH,           // Whole frame: render and panel flush
+  HANDLE,          // Foreground mode's handle()
+  CLOCK_DISPATCH,  // Clock runtime modules for one tick
+  TRANSPORT_SEND,  // One MIDI event to every transport (MidiOut task)
+  QUEUE_SEND,      // One BLE or WiFi batch (transport sender tasks)
+  COUNT
+};
+
+static constexpr uint32_t kProfileWindowMs = 1000;
+static constexpr size_t kProfileMaxTasks = 24;
+static constexpr size_t kProfileTraceEvents = 256;
+static constexpr size_t kProfileTaskNameLen = 16;
+
+struct ProfileSectionStats {
+  uint32_t calls;      // Over the last window
+  uint32_t totalUs;
+  uint32_t maxUs;
+  uint32_t dropped;    // Samples lost to a core switch, since reset
+  uint32_t peakMaxUs;  // Longest since reset
+};
+
+struct ProfileTaskStats {
+  char name[kProfileTaskNameLen];
+  uint8_t priority;
+  int8_t core;          // -1: not pinned
+  uint32_t stackFree;   // Bytes never used since the task started
+  int16_t cpuPermille;  // Over the last window; -1 without run-time stats
+};
+
+struct ProfileTraceEvent {
+  uint32_t startUs;
+  uint32_t durationUs;
+  ProfileSection section;
+  uint8_t core;
+  char task[kProfileTaskNameLen];
+};
+
+const char *profileSectionName(ProfileSection section);
+
+// Called by ProfileScope; startCycles and startCore from the scope's start
+void profilerRecord(ProfileSection section, uint32_t startCycles, uint8_t startCore);
+
+class ProfileScope {
+public:
+  explicit ProfileScope(ProfileSection section);
+  ~ProfileScope();
+
+private:
+  ProfileSection section_;
+  uint8_t core_;
+  uint32_t startCycles_;
+};
+
+// Publishes the window and samples the tasks once per kProfileWindowMs; call
+// from the UI loop
+void profilerService(uint32_t nowMs);
+
+ProfileSectionStats profilerGetSection(ProfileSection section);
+
+// Copies the tasks seen at the last sample to out; returns how many. Only
+// the first kProfileMaxTasks are kept; profilerTaskTotal() counts them all.
+size_t profilerGetTasks(ProfileTaskStats *out, size_t maxTasks);
+size_t profilerTaskTotal();
+uint32_t profilerWindowMs();  // Length of the published window
+bool profilerHasRunTimeStats();
+void profilerResetStats();
+
+// Records scopes for up to durationMs, or until the buffer is full; returns
+// false if the buffer could not be allocated
+bool profilerTraceStart(uint32_t durationMs);
+bool profilerTraceArmed();
+size_t profilerTraceCount();
+bool profilerTraceEvent(size_t index, ProfileTraceEvent &out);
+
+#endif // PROFILER_H
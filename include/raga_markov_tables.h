@@ -0,0 +1,444 @@
+// Generated by scripts/gen_raga_tables.py - do not edit by hand.
+#ifndef RAGA_MARKOV_TABLES_H
+#define RAGA_MARKOV_TABLES_H
+
+#include <stdint.h>
+
+// Cumulative transition weights, read straight from flash.
+// order2Cdf:  [prevPrev * degrees + prev][next]
+// order3Keys: sorted (a * 7 + b) * 7 + c context keys; order3Cdf rows follow the same order
+struct RagaMarkovTable {
+  uint8_t degrees;
+  uint8_t order3Count;
+  const uint16_t (*order2Cdf)[7];
+  const uint16_t *order3Keys;
+  const uint16_t (*order3Cdf)[7];
+};
+
+static constexpr uint8_t kRagaMarkovMaxDegrees = 7;
+
+static const uint16_t kBhairaviOrder2Cdf[49][7] = {
+    { 40,  70,  85, 110, 120, 125, 130},
+    { 20,  40,  80, 115, 125, 130, 135},
+    { 15,  40,  60, 110, 120, 125, 130},
+    { 30,  50,  80, 110, 125, 135, 140},
+    { 25,  40,  60, 100, 120, 135, 145},
+    { 20,  35,  45,  70,  85, 105, 135},
+    { 50,  70,  80,  95, 105, 115, 130},
+    { 40,  70,  90, 110, 120, 125, 130},
+    { 25,  60,  90, 110, 120, 125, 130},
+    { 15,  35,  60, 105, 120, 125, 130},
+    { 25,  45,  80, 110, 125, 135, 140},
+    { 20,  45,  65, 100, 120, 130, 135},
+    { 15,  35,  50,  75,  90, 115, 135},
+    { 45,  70,  85, 100, 110, 120, 130},
+    { 35,  65,  85, 110, 120, 125, 130},
+    { 35,  60,  85, 110, 120, 125, 130},
+    { 20,  45,  70, 105, 120, 130, 135},
+    { 20,  35,  55,  95, 115, 135, 145},
+    { 15,  35,  60, 100, 120, 135, 145},
+    { 10,  25,  40,  70,  85, 110, 135},
+    { 40,  65,  80,  95, 105, 115, 130},
+    { 45,  75,  95, 115, 125, 130, 135},
+    { 30,  55,  85, 110, 120, 125, 130},
+    { 25,  60,  85, 110, 120, 125, 130},
+    { 25,  45,  70, 110, 130, 145, 155},
+    { 20,  35,  55,  95, 120, 135, 145},
+    { 10,  20,  35,  65,  80, 105, 140},
+    { 50,  70,  85, 105, 115, 125, 135},
+    { 40,  65,  85, 110, 125, 130, 135},
+    { 25,  50,  75, 105, 120, 130, 135},
+    { 20,  45,  70, 110, 125, 135, 140},
+    { 20,  40,  65, 105, 125, 140, 150},
+    { 25,  40,  60, 100, 125, 145, 155},
+    { 15,  30,  45,  75,  90, 120, 145},
+    { 45,  65,  80, 100, 115, 125, 135},
+    { 40,  65,  85, 105, 120, 130, 140},
+    { 25,  55,  80, 105, 120, 135, 145},
+    { 20,  45,  70, 105, 120, 135, 145},
+    { 20,  40,  65, 100, 120, 140, 155},
+    { 20,  40,  60,  95, 120, 140, 155},
+    { 15,  30,  45,  70,  85, 115, 145},
+    { 45,  65,  80, 100, 115, 130, 145},
+    { 50,  75,  90, 110, 120, 130, 140},
+    { 30,  60,  85, 110, 125, 135, 140},
+    { 25,  50,  75, 105, 120, 130, 140},
+    { 25,  45,  70, 105, 120, 135, 145},
+    { 25,  45,  65, 100, 120, 135, 145},
+    { 20,  40,  55,  80,  95, 120, 145},
+    { 45,  70,  85, 105, 115, 125, 140},
+};
+static const uint16_t kBhairaviOrder3Keys[4] = {9, 124, 162, 188};
+static const uint16_t kBhairaviOrder3Cdf[4][7] = {
+    { 15,  35,  60, 165, 180, 185, 190},
+    { 10,  20,  35,  65,  80, 105, 200},
+    { 95, 120, 145, 170, 180, 185, 190},
+    {105, 125, 140, 160, 175, 190, 205},
+};
+
+static const uint16_t kLalitOrder2Cdf[49][7] = {
+    { 18,  48,  62,  73,  76,  79,  82},
+    { 39,  53, 107, 134, 142, 146, 150},
+    { 18,  48,  62, 148, 165, 173, 177},
+    {  9,  23,  68,  90, 144, 161, 169},
+    {  4,  11,  25,  97, 111, 165, 190},
+    {  4,   7,  14,  36,  81,  95, 131},
+    {  6,  10,  13,  24,  38,  68,  82},
+    { 18,  48,  62,  73,  76,  79,  82},
+    { 39,  53,  98, 120, 127, 130, 133},
+    { 18,  48,  62, 188, 205, 213, 217},
+    {  9,  23,  68,  90, 144, 161, 169},
+    {  4,  11,  25,  97, 111, 165, 190},
+    {  4,   7,  14,  36,  81,  95, 131},
+    {  6,  10,  13,  24,  38,  68,  82},
+    { 18,  48,  62,  73,  76,  79,  82},
+    { 47,  61, 106, 128, 135, 138, 141},
+    { 18,  48,  62, 134, 148, 155, 158},
+    {  9,  23,  68,  90, 144, 161, 169},
+    {  4,  11,  25,  97, 111, 165, 190},
+    {  4,   7,  14,  36,  81,  95, 131},
+    {  6,  10,  13,  24,  38,  68,  82},
+    { 18,  48,  62,  73,  76,  79,  82},
+    { 47,  61, 106, 128, 135, 138, 141},
+    { 22,  58,  72, 144, 158, 165, 168},
+    {  9,  23,  68,  90, 135, 149, 156},
+    {  4,  11,  25, 137, 151, 245, 270},
+    {  4,   7,  14,  36,  81,  95, 131},
+    {  6,  10,  13,  24,  38,  68,  82},
+    { 18,  48,  62,  73,  76,  79,  82},
+    { 47,  61, 106, 128, 135, 138, 141},
+    { 22,  58,  72, 144, 158, 165, 168},
+    { 11,  28, 122, 144, 189, 203, 210},
+    {  4,  11,  25,  97, 111, 156, 177},
+    {  4,   7,  14,  36, 121, 135, 171},
+    { 46,  50,  53,  64,  78, 108, 122},
+    { 18,  48,  62,  73,  76,  79,  82},
+    { 47,  61, 106, 128, 135, 138, 141},
+    { 22,  58,  72, 144, 158, 165, 168},
+    { 11,  28,  82, 104, 149, 163, 170},
+    {  5,  13,  30, 116, 130, 175, 236},
+    {  4,   7,  14,  36,  81,  95, 125},
+    {  6,  10,  13,  24,  38,  68,  82},
+    { 18,  48,  62,  73,  76,  79,  82},
+    { 47,  61, 146, 168, 175, 178, 181},
+    { 22,  58,  72, 144, 158, 165, 168},
+    { 11,  28,  82, 104, 149, 163, 170},
+    {  5,  13,  30, 116, 130, 175, 196},
+    {  5,   9,  17,  44,  98, 112, 142},
+    {  6,  10,  13,  24,  38,  68,  82},
+};
+static const uint16_t kLalitOrder3Keys[5] = {178, 180, 235, 279, 303};
+static const uint16_t kLalitOrder3Cdf[5][7] = {
+    { 11,  28, 182, 204, 249, 263, 270},
+    {  4,   7,  14,  36, 181, 195, 231},
+    {  5,  13,  30, 116, 130, 175, 296},
+    {106, 110, 113, 124, 138, 168, 182},
+    { 18,  48,  62, 248, 265, 273, 277},
+};
+
+static const uint16_t kBhupaliOrder2Cdf[25][7] = {
+    { 14,  59,  81,  88,  94,  94,  94},
+    { 45,  59, 185, 202, 213, 213, 213},
+    { 14,  59,  81, 117, 150, 150, 150},
+    {  7,  21,  93, 107, 154, 154, 154},
+    { 44,  51,  73, 118, 136, 136, 136},
+    { 14,  59,  81,  88, 134, 134, 134},
+    { 45,  59, 131, 145, 154, 154, 154},
+    { 14,  59,  81, 117, 150, 150, 150},
+    {  7,  21,  93, 107, 154, 154, 154},
+    {  4,  11,  33,  78,  96,  96,  96},
+    { 14,  59,  81,  88,  94,  94,  94},
+    { 94, 108, 180, 194, 203, 203, 203},
+    { 14,  59,  81, 111, 138, 138, 138},
+    {  7,  21,  93, 107, 154, 154, 154},
+    {  4,  11,  33, 118, 136, 136, 136},
+    { 14,  59,  81,  88,  94,  94,  94},
+    { 54,  68, 140, 154, 163, 163, 163},
+    { 17, 111, 133, 163, 230, 230, 230},
+    {  7,  21,  93, 107, 146, 146, 146},
+    {  4,  11,  33,  78,  96,  96,  96},
+    { 14,  99, 121, 128, 134, 134, 134},
+    { 54,  68, 140, 154, 163, 163, 163},
+    { 17,  71,  93, 123, 150, 150, 150},
+    {  8,  25, 151, 165, 204, 204, 204},
+    {  4,  11,  33,  78,  96,  96,  96},
+};
+static const uint16_t kBhupaliOrder3Keys[8] = {28, 53, 105, 129, 162, 165, 197, 219};
+static const uint16_t kBhupaliOrder3Cdf[8][7] = {
+    { 14, 159, 181, 188, 194, 194, 194},
+    {104, 111, 133, 178, 196, 196, 196},
+    { 14,  59,  81,  88, 194, 194, 194},
+    {  8,  25, 211, 225, 264, 264, 264},
+    {154, 168, 240, 254, 263, 263, 263},
+    {  4,  11,  33, 178, 196, 196, 196},
+    { 45,  59, 245, 262, 273, 273, 273},
+    { 17, 171, 193, 223, 290, 290, 290},
+};
+
+static const uint16_t kTodiOrder2Cdf[49][7] = {
+    { 14,  59,  77,  84,  84,  89,  92},
+    { 45,  59, 169, 186, 186, 192, 196},
+    { 14,  59,  77, 113, 113, 126, 130},
+    {  7,  21,  79,  93,  93, 120, 128},
+    {  3,  10,  28,  58,  72, 130, 147},
+    {  3,   6,  15,  29,  59,  81, 135},
+    {  4,   7,  11,  18,  32,  80,  94},
+    { 14,  59,  77,  84,  84,  89,  92},
+    { 45,  59, 117, 131, 131, 136, 139},
+    { 14,  99, 117, 153, 153, 166, 170},
+    {  7,  21,  79,  93,  93, 120, 128},
+    {  3,  10,  28,  58,  72, 130, 147},
+    {  3,   6,  15,  29,  59,  81, 135},
+    {  4,   7,  11,  18,  32,  80,  94},
+    { 14,  59,  77,  84,  84,  89,  92},
+    { 94, 108, 206, 220, 220, 225, 228},
+    { 14,  59,  77, 107, 107, 118, 121},
+    {  7,  21,  79,  93,  93, 120, 128},
+    {  3,  10,  28,  58,  72, 130, 147},
+    {  3,   6,  15,  29,  59,  81, 135},
+    {  4,   7,  11,  18,  32,  80,  94},
+    { 14,  59,  77,  84,  84,  89,  92},
+    { 54,  68, 126, 140, 140, 145, 148},
+    { 17, 111, 129, 159, 159, 170, 173},
+    {  7,  21,  79,  93,  93, 115, 122},
+    {  3,  10,  28,  58,  72, 130, 147},
+    {  3,   6,  15,  29,  59,  81, 135},
+    {  4,   7,  11,  18,  32,  80,  94},
+    { 14,  59,  77,  84,  84,  89,  92},
+    { 54,  68, 126, 140, 140, 145, 148},
+    { 17,  71,  89, 119, 119, 130, 133},
+    {  8,  25,  95, 109, 109, 131, 138},
+    {  3,  10,  28,  58,  72, 120, 134},
+    {  3,   6,  15,  29,  59,  81, 135},
+    {  4,   7,  11,  18,  32,  80,  94},
+    { 14,  59,  77,  84,  84,  89,  92},
+    { 54,  68, 126, 140, 140, 145, 148},
+    { 17,  71,  89, 119, 119, 130, 133},
+    {  8,  25,  95, 109, 109, 131, 138},
+    {  4,  12,  34,  70,  84, 132, 146},
+    {  3,   6,  15,  29,  59,  81, 126},
+    { 44,  47,  51,  58,  72, 120, 134},
+    { 14,  99, 117, 124, 124, 129, 132},
+    { 54,  68, 126, 140, 140, 145, 148},
+    { 17,  71,  89, 119, 119, 130, 133},
+    {  8,  25,  95, 109, 109, 131, 138},
+    {  4,  12,  34,  70,  84, 132, 146},
+    {  4,   8,  19,  36,  72,  94, 139},
+    {  4,   7,  11,  18,  32,  80,  94},
+};
+static const uint16_t kTodiOrder3Keys[5] = {64, 107, 162, 287, 295};
+static const uint16_t kTodiOrder3Cdf[5][7] = {
+    {214, 228, 326, 340, 340, 345, 348},
+    { 14, 159, 177, 213, 213, 226, 230},
+    { 94, 108, 266, 280, 280, 285, 288},
+    { 14, 159, 177, 184, 184, 189, 192},
+    { 45,  59, 229, 246, 246, 252, 256},
+};
+
+static const uint16_t kMadhuvantiOrder2Cdf[49][7] = {
+    { 18,  18,  39,  46,  51,  51,  54},
+    { 58,  72, 108, 125, 138, 138, 142},
+    { 18,  63,  77, 171, 198, 198, 202},
+    {  9,  23,  68,  82, 168, 168, 176},
+    {  4,  11,  25,  55,  77,  77, 102},
+    {  4,   7,  14,  28, 100, 114, 150},
+    {  6,   9,  12,  19,  41,  86, 100},
+    { 18,  18,  39,  46,  51,  51,  54},
+    { 58,  72, 102, 116, 127, 127, 130},
+    { 18,  63,  77, 131, 158, 158, 162},
+    {  9,  23,  68,  82, 168, 168, 176},
+    {  4,  11,  25,  55,  77,  77, 102},
+    {  4,   7,  14,  28, 100, 114, 150},
+    {  6,   9,  12,  19,  41,  86, 100},
+    { 18,  18,  39,  46,  51,  51,  54},
+    {110, 124, 154, 168, 179, 179, 182},
+    { 18,  63,  77, 122, 144, 144, 147},
+    {  9,  23,  68,  82, 208, 208, 216},
+    {  4,  11,  25,  55,  77,  77, 102},
+    {  4,   7,  14,  28, 100, 114, 150},
+    {  6,   9,  12,  19,  41,  86, 100},
+    { 18,  18,  39,  46,  51,  51,  54},
+    { 70,  84, 114, 128, 139, 139, 142},
+    { 22, 116, 130, 175, 197, 197, 200},
+    {  9,  23,  68,  82, 154, 154, 161},
+    {  4,  11,  25,  55,  77,  77, 142},
+    {  4,   7,  14,  28, 100, 114, 150},
+    {  6,   9,  12,  19,  41,  86, 100},
+    { 18,  18,  39,  46,  51,  51,  54},
+    { 70,  84, 114, 128, 139, 139, 142},
+    { 22,  76,  90, 135, 157, 157, 160},
+    { 11,  28,  82,  96, 168, 168, 175},
+    {  4,  11,  25,  55,  77,  77,  98},
+    {  4,   7,  14,  28, 100, 114, 150},
+    {  6,   9,  12,  19,  41, 126, 140},
+    { 18,  18,  39,  46,  51,  51,  54},
+    { 70,  84, 114, 128, 139, 139, 142},
+    { 22,  76,  90, 135, 157, 157, 160},
+    { 11,  28,  82,  96, 168, 168, 175},
+    {  5,  13,  30,  66,  88,  88, 109},
+    {  4,   7,  14,  28, 100, 114, 144},
+    {  6,   9,  12,  19,  41,  86, 100},
+    { 18,  18,  79,  86,  91,  91,  94},
+    { 70,  84, 114, 128, 139, 139, 142},
+    { 22,  76,  90, 135, 157, 157, 160},
+    { 11,  28,  82,  96, 168, 168, 175},
+    {  5,  13,  30,  66,  88,  88, 109},
+    {  5,   9,  17,  34, 160, 174, 204},
+    {  6,   9,  12,  19,  41,  86, 100},
+};
+static const uint16_t kMadhuvantiOrder3Keys[5] = {17, 162, 181, 243, 296};
+static const uint16_t kMadhuvantiOrder3Cdf[5][7] = {
+    {  9,  23,  68,  82, 268, 268, 276},
+    {170, 184, 214, 228, 239, 239, 242},
+    {  6,   9,  12,  19,  41, 186, 200},
+    {  5,   9,  17,  34, 220, 234, 264},
+    { 18,  63,  77, 231, 258, 258, 262},
+};
+
+static const uint16_t kMeghmalharOrder2Cdf[25][7] = {
+    { 22,  52,  66,  75,  78,  78,  78},
+    { 72,  86, 140, 173, 181, 181, 181},
+    { 22,  67,  81, 128, 145, 145, 145},
+    { 11,  25,  70,  88, 124, 124, 124},
+    {  5,  12,  26,  84,  98,  98,  98},
+    { 22,  52,  66,  75,  78,  78,  78},
+    { 72,  86, 131, 158, 165, 165, 165},
+    { 22, 107, 121, 168, 185, 185, 185},
+    { 11,  25, 110, 128, 164, 164, 164},
+    {  5,  12,  26,  84,  98,  98,  98},
+    { 22,  52,  66,  75,  78,  78,  78},
+    {126, 140, 185, 252, 259, 259, 259},
+    { 22,  67,  81, 120, 134, 134, 134},
+    { 11,  25,  70,  88, 124, 124, 124},
+    {  5,  12,  26,  84,  98,  98,  98},
+    { 22,  52,  66,  75,  78,  78,  78},
+    { 86, 100, 145, 172, 179, 179, 179},
+    { 27, 121, 135, 174, 188, 188, 188},
+    { 11,  25,  70,  88, 118, 118, 118},
+    {  5,  12,  26,  84,  98,  98,  98},
+    { 22,  52,  66,  75,  78,  78,  78},
+    { 86, 100, 145, 172, 179, 179, 179},
+    { 27,  81,  95, 134, 148, 148, 148},
+    { 13,  30, 124, 142, 172, 172, 172},
+    {  5,  12,  26,  84,  98,  98,  98},
+};
+static const uint16_t kMeghmalharOrder3Keys[5] = {64, 72, 108, 162, 219};
+static const uint16_t kMeghmalharOrder3Cdf[5][7] = {
+    {126, 140, 185, 312, 319, 319, 319},
+    { 27, 181, 195, 234, 248, 248, 248},
+    { 11,  25, 170, 188, 224, 224, 224},
+    {186, 200, 245, 312, 319, 319, 319},
+    { 27, 181, 195, 234, 248, 248, 248},
+};
+
+static const uint16_t kYamanOrder2Cdf[49][7] = {
+    { 14,  44,  66,  73,  73,  76,  80},
+    { 45,  59, 145, 162, 162, 166, 171},
+    { 14,  59,  81, 117, 117, 125, 130},
+    {  7,  21,  93, 107, 107, 124, 135},
+    {  3,  10,  32,  77,  91, 127, 149},
+    {  3,   6,  17,  31,  76,  90, 137},
+    {  3,   7,  12,  19,  33,  78,  96},
+    { 14,  44,  66,  73,  73,  76,  80},
+    { 45,  59, 131, 145, 145, 148, 152},
+    { 14,  99, 121, 157, 157, 165, 170},
+    {  7,  21,  93, 107, 107, 124, 135},
+    {  3,  10,  32,  77,  91, 127, 149},
+    {  3,   6,  17,  31,  76,  90, 137},
+    {  3,   7,  12,  19,  33,  78,  96},
+    { 14,  44,  66,  73,  73,  76,  80},
+    { 94, 108, 180, 194, 194, 197, 201},
+    { 14,  59,  81, 111, 111, 118, 122},
+    {  7,  21,  93, 107, 107, 124, 135},
+    {  3,  10,  32,  77,  91, 127, 149},
+    {  3,   6,  17,  31,  76,  90, 137},
+    {  3,   7,  12,  19,  33,  78,  96},
+    { 14,  44,  66,  73,  73,  76,  80},
+    { 54,  68, 140, 154, 154, 157, 161},
+    { 17, 111, 133, 163, 163, 170, 174},
+    {  7,  21,  93, 107, 107, 121, 130},
+    {  3,  10,  32,  77,  91, 127, 149},
+    {  3,   6,  17,  31,  76,  90, 137},
+    {  3,   7,  12,  19,  33,  78,  96},
+    { 14,  44,  66,  73,  73,  76,  80},
+    { 54,  68, 140, 154, 154, 157, 161},
+    { 17,  71,  93, 123, 123, 130, 134},
+    {  8,  25, 151, 165, 165, 179, 188},
+    {  3,  10,  32,  77,  91, 121, 139},
+    {  3,   6,  17,  31,  76,  90, 137},
+    {  3,   7,  12,  19,  33,  78,  96},
+    { 14,  44,  66,  73,  73,  76,  80},
+    { 54,  68, 140, 154, 154, 157, 161},
+    { 17,  71,  93, 123, 123, 130, 134},
+    {  8,  25, 111, 125, 125, 139, 148},
+    {  4,  12,  39, 133, 147, 177, 195},
+    {  3,   6,  17,  31,  76,  90, 129},
+    {  3,   7,  12,  19,  33,  78,  96},
+    { 14,  44,  66,  73,  73,  76,  80},
+    { 54,  68, 180, 194, 194, 197, 201},
+    { 17,  71,  93, 123, 123, 130, 134},
+    {  8,  25, 111, 125, 125, 139, 148},
+    {  4,  12,  39,  93, 107, 137, 155},
+    {  4,   8,  21,  38, 132, 146, 185},
+    {  3,   7,  12,  19,  33,  78,  96},
+};
+static const uint16_t kYamanOrder3Keys[6] = {64, 162, 219, 276, 303, 333};
+static const uint16_t kYamanOrder3Cdf[6][7] = {
+    {154, 168, 240, 254, 254, 257, 261},
+    {154, 168, 240, 254, 254, 257, 261},
+    { 17, 171, 193, 223, 223, 230, 234},
+    {  8,  25, 211, 225, 225, 239, 248},
+    { 14, 159, 181, 217, 217, 225, 230},
+    {  4,  12,  39, 193, 207, 237, 255},
+};
+
+static const uint16_t kMalkaunsOrder2Cdf[25][7] = {
+    { 18,  48,  70,  77,  80,  80,  80},
+    { 58,  72, 158, 175, 183, 183, 183},
+    { 18,  63,  85, 139, 156, 156, 156},
+    {  9,  23,  95, 109, 163, 163, 163},
+    {  4,  11,  33,  78,  92,  92,  92},
+    { 18,  48,  70,  77,  80,  80,  80},
+    { 58,  72, 144, 158, 165, 165, 165},
+    { 18,  63,  85, 179, 196, 196, 196},
+    {  9,  23,  95, 109, 163, 163, 163},
+    {  4,  11,  33,  78,  92,  92,  92},
+    { 18,  48,  70,  77,  80,  80,  80},
+    {110, 124, 236, 250, 257, 257, 257},
+    { 18,  63,  85, 130, 144, 144, 144},
+    {  9,  23, 135, 149, 243, 243, 243},
+    {  4,  11,  33,  78,  92,  92,  92},
+    { 18,  48,  70,  77,  80,  80,  80},
+    { 70,  84, 156, 170, 177, 177, 177},
+    { 22, 116, 138, 183, 197, 197, 197},
+    {  9,  23,  95, 109, 154, 154, 154},
+    {  4,  11,  33, 118, 132, 132, 132},
+    { 18,  48,  70,  77,  80,  80,  80},
+    { 70,  84, 156, 170, 177, 177, 177},
+    { 22,  76,  98, 143, 157, 157, 157},
+    { 11,  28, 154, 168, 213, 213, 213},
+    {  4,  11,  33,  78,  92,  92,  92},
+};
+static const uint16_t kMalkaunsOrder3Keys[7] = {66, 107, 121, 123, 162, 178, 219};
+static const uint16_t kMalkaunsOrder3Cdf[7][7] = {
+    {  9,  23, 195, 209, 363, 363, 363},
+    { 18,  63,  85, 239, 256, 256, 256},
+    { 22, 176, 198, 243, 257, 257, 257},
+    {  4,  11,  33, 178, 192, 192, 192},
+    {230, 244, 356, 370, 377, 377, 377},
+    { 11,  28, 214, 228, 273, 273, 273},
+    { 22, 176, 198, 243, 257, 257, 257},
+};
+
+static const RagaMarkovTable kRagaMarkovTables[8] = {
+    {7, 4, kBhairaviOrder2Cdf, kBhairaviOrder3Keys, kBhairaviOrder3Cdf},
+    {7, 5, kLalitOrder2Cdf, kLalitOrder3Keys, kLalitOrder3Cdf},
+    {5, 8, kBhupaliOrder2Cdf, kBhupaliOrder3Keys, kBhupaliOrder3Cdf},
+    {7, 5, kTodiOrder2Cdf, kTodiOrder3Keys, kTodiOrder3Cdf},
+    {7, 5, kMadhuvantiOrder2Cdf, kMadhuvantiOrder3Keys, kMadhuvantiOrder3Cdf},
+    {5, 5, kMeghmalharOrder2Cdf, kMeghmalharOrder3Keys, kMeghmalharOrder3Cdf},
+    {7, 6, kYamanOrder2Cdf, kYamanOrder3Keys, kYamanOrder3Cdf},
+    {5, 7, kMalkaunsOrder2Cdf, kMalkaunsOrder3Keys, kMalkaunsOrder3Cdf},
+};
+
+#endif // RAGA_MARKOV_TABLES_H
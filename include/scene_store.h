@@ -0,0 +1,169 @@
+#ifndef SCENE_STORE_H
+#define SCENE_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class ClockedModule;
+
+/**
+ * Scene store - versioned binary snapshots of module state on LittleFS
+ *
+ * A scene is one blob: a header (magic, format version, generation, CRC32)
+ * followed by one tagged, versioned section per participating module. Each
+ * scene number owns two files (A/B); a save goes to the older or damaged one,
+ * and a load picks the newest copy whose CRC checks out, so a save cut short
+ * by power loss never costs the previous scene.
+ *
+ * Saving serialises in the caller's task into a scratch buffer and hands it to
+ * a low-priority writer task, so neither the UI nor the clock waits on flash.
+ * Loading validates the blob and stages it; each module applies its own
+ * section the next time it initialises (sceneApplyPending), so a load only
+ * costs the modules that are actually opened.
+ */
+
+#define SCENE_TAG(a, b, c, d)                                                              \
+  ((static_cast<uint32_t>(a) << 24) | (static_cast<uint32_t>(b) << 16) |                  \
+   (static_cast<uint32_t>(c) << 8) | static_cast<uint32_t>(d))
+
+static constexpr uint8_t kSceneCount = 8;
+
+enum class SceneResult : uint8_t {
+  OK = 0,
+  BUSY,       // A save is still being written
+  NOT_READY,  // Filesystem not mounted (yet)
+  NO_MEMORY,
+  NOT_FOUND,  // Neither copy of the scene exists
+  CORRUPT,    // Copies exist but none passes its CRC
+  IO_ERROR,
+  BAD_ARGUMENT
+};
+
+const char *sceneResultName(SceneResult result);
+
+// Little-endian field writer; with a null buffer (or past capacity) it only counts bytes
+class SceneWriter {
+public:
+  SceneWriter(uint8_t *buffer, size_t capacity) : buffer_(buffer), capacity_(capacity) {}
+  void u8(uint8_t value);
+  void u16(uint16_t value);
+  void u32(uint32_t value);
+  void bytes(const void *data, size_t length);
+  size_t size() const { return size_; }
+  bool ok() const { return !overflow_; }
+
+private:
+  uint8_t *buffer_;
+  size_t capacity_;
+  size_t size_ = 0;
+  bool overflow_ = false;
+};
+
+// Reads past the end return 0 and clear ok(), so loaders check once at the end
+class SceneReader {
+public:
+  SceneReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+  uint8_t u8();
+  uint16_t u16();
+  uint32_t u32();
+  bool bytes(void *out, size_t length);
+  size_t remaining() const { return size_ - offset_; }
+  bool ok() const { return !underflow_; }
+
+private:
+  const uint8_t *data_;
+  size_t size_;
+  size_t offset_ = 0;
+  bool underflow_ = false;
+};
+
+// Optional live switching: prepare() decodes a section into module-owned
+// shadow state outside the clock task; commit() installs it from the clock
+// task on a bar, so it must be short, must not allocate and must not send
+// MIDI itself (queue releases on midiOutBuffer). commit() returns the number
+// of note-offs it queued.
+struct SceneHotSwap {
+  bool (*prepare)(SceneReader &in, uint16_t version);
+  uint16_t (*commit)();
+};
+
+// One module's part of a scene. save() must emit at most maxBytes; load()
+// gets sections of any version and rejects the ones it cannot read.
+struct SceneSection {
+  uint32_t tag;
+  uint16_t version;
+  const char *name;
+  size_t maxBytes;
+  void (*save)(SceneWriter &out);
+  bool (*load)(SceneReader &in, uint16_t version);
+  const SceneHotSwap *hotSwap;  // nullptr: applied lazily only
+};
+
+// Sections are registered during static initialisation and never removed
+void sceneRegisterSection(const SceneSection *section);
+
+// Persists a ClockedModule through its serialize()/deserialize() overrides
+void sceneRegisterClockedModule(uint32_t tag, const char *name, ClockedModule *module,
+                                size_t maxBytes, const SceneHotSwap *hotSwap = nullptr);
+
+#define REGISTER_SCENE_SECTION(Section) \
+  namespace { \
+    struct Section##SceneRegistrar { \
+      Section##SceneRegistrar() { sceneRegisterSection(&Section); } \
+    }; \
+    static Section##SceneRegistrar g_##Section##SceneRegistrar; \
+  }
+
+// Mounts LittleFS and starts the writer task; call once at boot
+void initSceneStore();
+
+// Snapshots every section now and queues the write; returns BUSY while a
+// previous save is still in flight
+SceneResult sceneSave(uint8_t scene);
+
+// Validates and stages the newest good copy; sections apply lazily
+SceneResult sceneLoad(uint8_t scene);
+
+// Called at the end of a module's initialise: applies its staged section, if any
+void sceneApplyPending(uint32_t tag);
+
+// Live scene change: loads scene n, prepares every hot-swappable section now and
+// commits them together at the next bar of the running transport (immediately
+// when stopped). Other sections stay staged and apply when their mode opens.
+SceneResult sceneScheduleSwitch(uint8_t scene);
+bool sceneSwitchPending();
+
+struct SceneSectionStats {
+  const char *name;
+  uint32_t tag;
+  uint32_t bytes;   // Size in the last saved or loaded blob
+  uint32_t saveUs;  // Serialise time of the last save
+  uint32_t loadUs;  // Apply time of the last load
+  bool pending;     // Staged and not yet applied
+};
+
+struct SceneStoreStats {
+  bool mounted;
+  bool writing;
+  uint8_t sectionCount;
+  uint8_t lastScene;
+  uint32_t lastGeneration;
+  uint32_t blobBytes;
+  uint32_t snapshotUs;  // Whole save in the caller's task
+  uint32_t writeUs;     // Flash write in the writer task
+  uint32_t readUs;      // File read and CRC check in sceneLoad
+  SceneResult lastWriteResult;
+
+  // Last live switch
+  uint8_t switchScene;
+  uint32_t switchPrepareUs;  // Load plus prepare, in the caller's task
+  uint32_t switchWaitUs;     // Request to commit, including the wait for the bar
+  uint32_t switchCommitUs;   // Commit in the clock task
+  uint16_t switchNoteOffs;   // Note-offs queued by the commits
+  uint32_t switchesCancelled;  // Armed switches dropped because the transport stopped first
+};
+
+SceneStoreStats sceneGetStats();
+bool sceneGetSectionStats(uint8_t index, SceneSectionStats &out);
+
+#endif // SCENE_STORE_H
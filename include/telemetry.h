@@ -0,0 +1,112 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Binary telemetry - timestamped events for the debug console
+ *
+ * Hot paths (clock ticks, MIDI in and out, transport sends) record fixed-size
+ * events with telemetryEmit() instead of printing text. Emitting is a few
+ * atomic operations on a bounded lock-free queue, safe from any task or ISR;
+ * when the queue is full the event is counted as dropped.
+ *
+ * A low-priority task on core 0 drains the queue and writes each event to
+ * Serial as a COBS frame between two zero bytes, one Serial.write() per batch,
+ * so frames never interleave with the text log. Text never contains a zero
+ * byte, so a reader splits the stream on them: see debug-console/src/telemetry.ts
+ * and scripts/decode_telemetry.py.
+ *
+ * Frame payload before COBS (little endian, kTelemetryPayloadBytes):
+ *   [0] event id  [1] arg8  [2..3] arg16  [4..7] timestamp us  [8..11] value
+ *   [12] checksum: 0xFF minus the low byte of the sum of bytes 0-11
+ *
+ * Output is off until TELEMETRY ON (serial CLI) and never starts in builds
+ * where Serial carries MIDI.
+ */
+
+static constexpr uint8_t kTelemetryProtocolVersion = 1;
+static constexpr size_t kTelemetryPayloadBytes = 13;
+static constexpr size_t kTelemetryMaxFrameBytes = kTelemetryPayloadBytes + 3;  // COBS overhead and two delimiters
+static constexpr size_t kTelemetryQueueSize = 256;  // Power of two
+static constexpr uint32_t kTelemetrySyncIntervalMs = 1000;
+
+enum class TelemetryEventId : uint8_t {
+  SYNC = 0,        // Once a second: arg16 protocol version, value events dropped since boot
+  CLOCK_TICK,      // Clock manager tick: value tick
+  CLOCK_OUT,       // 0xF8 handed to the transports: arg16 tick, value us since the tick
+  CLOCK_DISPATCH,  // Clock runtime modules for one tick: arg16 tick, value us
+  CLOCK_CATCHUP,   // A module consumed several steps at once: arg16 steps, value ticks
+  EXT_CLOCK,       // External 0xF8 accepted by the follower: arg8 source
+  TRANSPORT,       // arg8 0 stop, 1 start; value tick
+  MIDI_OUT,        // Channel message to the transports: arg8 status, arg16 data1 << 8 | data2
+  MIDI_IN,         // Channel message received: arg8 status, arg16 data, value DIN latency us (0 elsewhere)
+  QUEUE_SEND,      // BLE or WiFi batch: arg8 messages left queued, arg16 messages sent, value us
+  FRAME,           // UI frame rendered and flushed: arg8 mode, value us
+  COUNT
+};
+
+struct TelemetryEvent {
+  uint32_t timestampUs;
+  uint32_t value;
+  uint16_t arg16;
+  TelemetryEventId id;
+  uint8_t arg8;
+};
+
+struct TelemetryStats {
+  uint32_t emitted;
+  uint32_t dropped;  // Queue full
+  uint32_t frames;
+  uint32_t bytes;
+  uint16_t maxDepth;
+  bool enabled;
+};
+
+// Bounded multi-producer queue (one sequence number per cell), single consumer
+class TelemetryQueue {
+public:
+  TelemetryQueue();
+  bool push(const TelemetryEvent &event);
+  bool pop(TelemetryEvent &event);
+  size_t depth() const;
+
+private:
+  struct Cell {
+    std::atomic<uint32_t> sequence;
+    TelemetryEvent event;
+  };
+
+  Cell cells_[kTelemetryQueueSize];
+  std::atomic<uint32_t> enqueuePos_{0};
+  uint32_t dequeuePos_ = 0;
+};
+
+// COBS; out needs length + length / 254 + 1 bytes. Returns the encoded length.
+size_t cobsEncode(const uint8_t *data, size_t length, uint8_t *out);
+// Returns the decoded length, or 0 if the frame is malformed
+size_t cobsDecode(const uint8_t *data, size_t length, uint8_t *out);
+
+// Writes 0x00, the COBS frame and 0x00 to out (kTelemetryMaxFrameBytes);
+// returns the bytes written
+size_t telemetryEncodeFrame(const TelemetryEvent &event, uint8_t *out);
+bool telemetryDecodePayload(const uint8_t *payload, size_t length, TelemetryEvent &event);
+
+// Starts the sender task; output stays off until telemetrySetEnabled(true)
+void initTelemetry();
+
+void telemetryEmit(TelemetryEventId id, uint8_t arg8, uint16_t arg16, uint32_t value, uint32_t timestampUs);
+void telemetryEmit(TelemetryEventId id, uint8_t arg8, uint16_t arg16, uint32_t value);  // Timestamped now
+
+void telemetrySetEnabled(bool enabled);
+bool telemetryEnabled();
+TelemetryStats telemetryGetStats();
+void telemetryResetStats();
+
+// Encodes and decodes n random events through the queue and the framing;
+// returns the number that did not come back identical
+uint32_t telemetrySelfTest(uint32_t events);
+
+#endif // TELEMETRY_H
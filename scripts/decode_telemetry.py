@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+"""
+Decode the firmware's binary telemetry stream (see include/telemetry.h).
+
+The firmware writes COBS frames between zero bytes on the same serial port as
+its text log. This script separates the two, decodes the events and prints a
+summary with latency histograms. It can also write the events as CSV and as a
+Chrome trace timeline (chrome://tracing, ui.perfetto.dev).
+
+Requirements:
+- Python 3.8+
+- pyserial (pip install pyserial), only for --port
+
+Usage:
+  ./scripts/decode_telemetry.py --port /dev/cu.wchusbserial110 --duration 30 --raw-out logs/telemetry.bin
+  ./scripts/decode_telemetry.py --file logs/telemetry.bin --csv logs/telemetry.csv --timeline logs/timeline.json
+
+With --port the script sends TELEMETRY ON first and TELEMETRY OFF at the end
+(the firmware must be built with the serial CLI, HARDWARE_MIDI_UART=2).
+"""
+import argparse
+import json
+import struct
+import sys
+import time
+
+PROTOCOL_VERSION = 1
+PAYLOAD_BYTES = 13
+MAX_ENCODED_BYTES = PAYLOAD_BYTES + 1  # COBS adds one byte to a short frame
+
+# TelemetryEventId, in order
+EVENT_NAMES = [
+    'SYNC', 'CLOCK_TICK', 'CLOCK_OUT', 'CLOCK_DISPATCH', 'CLOCK_CATCHUP', 'EXT_CLOCK',
+    'TRANSPORT', 'MIDI_OUT', 'MIDI_IN', 'QUEUE_SEND', 'FRAME',
+]
+# Events whose value is a duration in microseconds
+DURATION_EVENTS = {'CLOCK_DISPATCH', 'QUEUE_SEND', 'FRAME'}
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code != 0xFF and i != len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def decode_payload(payload):
+    if payload is None or len(payload) != PAYLOAD_BYTES:
+        return None
+    if (0xFF - (sum(payload[:12]) & 0xFF)) != payload[12] or payload[0] >= len(EVENT_NAMES):
+        return None
+    event_id, arg8, arg16, timestamp_us, value = struct.unpack('<BBHII', payload[:12])
+    return {'event': EVENT_NAMES[event_id], 'arg8': arg8, 'arg16': arg16, 'ts': timestamp_us, 'value': value}
+
+
+class StreamSplitter:
+    """Splits serial bytes into text lines and telemetry events.
+
+    Text never contains a zero byte; frames are 0x00 <COBS> 0x00. A frame that
+    does not decode (e.g. the capture started mid-frame) is handed back as text
+    and the zero that closed it is taken as the start of the next frame.
+    """
+
+    def __init__(self):
+        self.in_frame = False
+        self.frame = bytearray()
+        self.text = bytearray()
+        self.bad_frames = 0
+
+    def feed(self, data):
+        lines, events = [], []
+        for byte in data:
+            if not self.in_frame:
+                if byte == 0:
+                    self.in_frame = True
+                    self.frame.clear()
+                else:
+                    self.text.append(byte)
+                    if byte == 0x0A:
+                        lines.append(self.text.decode('utf-8', errors='replace').rstrip('\r\n'))
+                        self.text.clear()
+                continue
+            if byte != 0:
+                self.frame.append(byte)
+                if len(self.frame) > MAX_ENCODED_BYTES:
+                    self.text += self.frame  # Too long for a frame: it was text
+                    self.frame.clear()
+                    self.in_frame = False
+                continue
+            if not self.frame:
+                continue  # Zero after zero: the next frame starts here
+            event = decode_payload(cobs_decode(bytes(self.frame)))
+            if event is not None:
+                events.append(event)
+                self.in_frame = False
+            else:
+                self.bad_frames += 1
+                self.text += self.frame
+            self.frame.clear()
+        return lines, events
+
+
+class Unwrapper:
+    """Extends the firmware's 32-bit microsecond timestamps across wraps."""
+
+    def __init__(self):
+        self.offset = 0
+        self.last = None
+
+    def __call__(self, ts):
+        if self.last is not None and ts < self.last and self.last - ts > 0x80000000:
+            self.offset += 1 << 32
+        self.last = ts
+        return ts + self.offset
+
+
+def histogram(values, title, unit='us'):
+    if not values:
+        return
+    values = sorted(values)
+    n = len(values)
+    pct = lambda p: values[min(n - 1, int(p * n))]
+    print(f'\n{title}: n={n} min={values[0]} p50={pct(0.5)} p99={pct(0.99)} max={values[-1]} {unit}')
+    buckets = {}
+    for v in values:
+        bucket = 0 if v <= 0 else 1 << (int(v).bit_length() - 1)
+        buckets[bucket] = buckets.get(bucket, 0) + 1
+    peak = max(buckets.values())
+    for bucket in sorted(buckets):
+        upper = bucket * 2 - 1 if bucket else 0
+        bar = '#' * max(1, buckets[bucket] * 50 // peak)
+        print(f'  {bucket:>8}-{upper:<8} {buckets[bucket]:>7} {bar}')
+
+
+def summarize(events, splitter):
+    counts = {}
+    for e in events:
+        counts[e['event']] = counts.get(e['event'], 0) + 1
+    print('Events:')
+    for name in EVENT_NAMES:
+        if name in counts:
+            print(f'  {name:<15} {counts[name]}')
+    syncs = [e for e in events if e['event'] == 'SYNC']
+    if syncs:
+        version = syncs[-1]['arg16']
+        if version != PROTOCOL_VERSION:
+            print(f'WARNING: firmware protocol {version}, decoder {PROTOCOL_VERSION}')
+        print(f'Dropped on the device: {syncs[-1]["value"]} (since boot)')
+    if splitter.bad_frames:
+        print(f'Undecodable frames: {splitter.bad_frames}')
+
+    ticks = [e['t'] for e in events if e['event'] == 'CLOCK_TICK']
+    histogram([b - a for a, b in zip(ticks, ticks[1:]) if b - a < 1000000], 'Clock tick interval')
+    ext = [e['t'] for e in events if e['event'] == 'EXT_CLOCK']
+    histogram([b - a for a, b in zip(ext, ext[1:]) if b - a < 1000000], 'External clock interval')
+    histogram([e['value'] for e in events if e['event'] == 'CLOCK_OUT'], 'Clock tick to 0xF8 sent')
+    histogram([e['value'] for e in events if e['event'] == 'CLOCK_DISPATCH'], 'Clock module dispatch')
+    histogram([e['value'] for e in events if e['event'] == 'QUEUE_SEND'], 'BLE/WiFi batch send')
+    histogram([e['value'] for e in events if e['event'] == 'MIDI_IN' and e['value']], 'DIN input latency')
+    histogram([e['value'] for e in events if e['event'] == 'FRAME'], 'UI frame')
+
+
+def write_csv(events, path):
+    with open(path, 'w') as f:
+        f.write('t_us,event,arg8,arg16,value\n')
+        for e in events:
+            f.write(f'{e["t"]},{e["event"]},{e["arg8"]},{e["arg16"]},{e["value"]}\n')
+
+
+def write_timeline(events, path):
+    trace = []
+    for e in events:
+        name = e['event']
+        if name == 'SYNC':
+            continue
+        args = {'arg8': e['arg8'], 'arg16': e['arg16'], 'value': e['value']}
+        if name in DURATION_EVENTS:
+            trace.append({'name': name, 'ph': 'X', 'ts': e['t'], 'dur': e['value'], 'pid': 0, 'tid': name,
+                          'args': args})
+        else:
+            trace.append({'name': name, 'ph': 'i', 's': 't', 'ts': e['t'], 'pid': 0, 'tid': name, 'args': args})
+    with open(path, 'w') as f:
+        json.dump({'traceEvents': trace, 'displayTimeUnit': 'ms'}, f)
+
+
+def read_port(args, on_data):
+    try:
+        import serial
+    except ImportError:
+        print("Missing dependency 'pyserial'. Install with: pip install pyserial")
+        raise
+    with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+        if not args.no_enable:
+            port.write(b'TELEMETRY ON\n')
+        end = time.monotonic() + args.duration
+        try:
+            while time.monotonic() < end:
+                data = port.read(4096)
+                if data:
+                    on_data(data)
+        except KeyboardInterrupt:
+            pass
+        finally:
+            if not args.no_enable:
+                port.write(b'TELEMETRY OFF\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--port', help='serial port to read from')
+    source.add_argument('--file', help='raw capture to decode (see --raw-out)')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--duration', type=float, default=10.0, help='seconds to read from --port')
+    parser.add_argument('--no-enable', action='store_true', help='do not send TELEMETRY ON/OFF')
+    parser.add_argument('--raw-out', help='save the raw bytes read from --port')
+    parser.add_argument('--csv', help='write the events as CSV')
+    parser.add_argument('--timeline', help='write the events as a Chrome trace')
+    parser.add_argument('--text', action='store_true', help='print the text log lines')
+    args = parser.parse_args()
+
+    splitter = StreamSplitter()
+    unwrap = Unwrapper()
+    events = []
+    raw = open(args.raw_out, 'wb') if args.raw_out else None
+
+    def on_data(data):
+        if raw:
+            raw.write(data)
+        lines, decoded = splitter.feed(data)
+        if args.text:
+            for line in lines:
+                print(line)
+        for e in decoded:
+            e['t'] = unwrap(e['ts'])
+            events.append(e)
+
+    if args.port:
+        read_port(args, on_data)
+    else:
+        with open(args.file, 'rb') as f:
+            on_data(f.read())
+    if raw:
+        raw.close()
+
+    summarize(events, splitter)
+    if args.csv:
+        write_csv(events, args.csv)
+    if args.timeline:
+        write_timeline(events, args.timeline)
+    return 0 if events else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""Generate include/euclidean_tables.h: every Euclidean rhythm E(k, n), n <= 64.
+
+Patterns are 64-bit masks with bit i set when step i fires, produced by the
+same bucket algorithm Euclid mode has always used, so existing patterns keep
+their exact phase. Entries are stored triangularly: E(k, n) lives at
+n * (n + 1) / 2 + k, giving 2145 masks (about 17 KB of flash).
+
+Usage:
+  python3 scripts/gen_euclid_tables.py           # regenerate if stale
+  python3 scripts/gen_euclid_tables.py --force   # always regenerate
+  python3 scripts/gen_euclid_tables.py --check   # compare against Bjorklund
+"""
+
+import os
+import sys
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+    RUN_FROM_PIO = True
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    RUN_FROM_PIO = False
+
+SCRIPT = os.path.join(PROJECT_DIR, "scripts", "gen_euclid_tables.py")
+OUTPUT = os.path.join(PROJECT_DIR, "include", "euclidean_tables.h")
+
+MAX_STEPS = 64
+
+
+def bucket(k, n):
+    mask = 0
+    acc = 0
+    for i in range(n):
+        acc += k
+        if acc >= n:
+            acc -= n
+            mask |= 1 << i
+    return mask
+
+
+def bjorklund(k, n):
+    """Reference Bjorklund: repeatedly pair remainders onto the front groups."""
+    if k == 0:
+        return [0] * n
+    groups = [[1] for _ in range(k)]
+    rest = [[0] for _ in range(n - k)]
+    while len(rest) > 1:
+        pairs = min(len(groups), len(rest))
+        merged = [groups[i] + rest[i] for i in range(pairs)]
+        leftover = groups[pairs:] if len(groups) > pairs else rest[pairs:]
+        groups, rest = merged, leftover
+    return [bit for g in groups + rest for bit in g]
+
+
+def rotations(mask, n):
+    full = (1 << n) - 1
+    return {((mask << r) | (mask >> (n - r))) & full for r in range(n)} if n else {0}
+
+
+def check():
+    count = 0
+    for n in range(1, MAX_STEPS + 1):
+        for k in range(n + 1):
+            mask = bucket(k, n)
+            if bin(mask).count("1") != k:
+                raise SystemExit("E(%d,%d): %d onsets" % (k, n, bin(mask).count("1")))
+            ref = sum(bit << i for i, bit in enumerate(bjorklund(k, n)))
+            if ref not in rotations(mask, n):
+                raise SystemExit("E(%d,%d) is not a rotation of Bjorklund's pattern" % (k, n))
+            count += 1
+    print("%d patterns match Bjorklund up to rotation" % count)
+
+
+def render():
+    out = []
+    out.append("// Generated by scripts/gen_euclid_tables.py - do not edit by hand.")
+    out.append("#ifndef EUCLIDEAN_TABLES_H")
+    out.append("#define EUCLIDEAN_TABLES_H")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("#define EUCLIDEAN_TABLE_MAX_STEPS %d" % MAX_STEPS)
+    out.append("#define EUCLIDEAN_TABLE_INDEX(k, n) ((n) * ((n) + 1) / 2 + (k))")
+    out.append("")
+    total = (MAX_STEPS + 1) * (MAX_STEPS + 2) // 2
+    out.append("// E(k, n) at EUCLIDEAN_TABLE_INDEX(k, n); bit i = step i fires")
+    out.append("static const uint64_t kEuclideanTable[%d] = {" % total)
+    for n in range(MAX_STEPS + 1):
+        row = ["0x%016XULL" % bucket(k, n) for k in range(n + 1)]
+        out.append("    // n = %d" % n)
+        for i in range(0, len(row), 4):
+            out.append("    " + ", ".join(row[i:i + 4]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("#endif // EUCLIDEAN_TABLES_H")
+    return "\n".join(out) + "\n"
+
+
+def main(argv):
+    if "--check" in argv:
+        check()
+        return
+    stale = (not os.path.isfile(OUTPUT) or
+             os.path.getmtime(OUTPUT) < os.path.getmtime(SCRIPT))
+    if not stale and "--force" not in argv:
+        return
+    with open(OUTPUT, "w", encoding="utf-8") as f:
+        f.write(render())
+    print("Generated %s" % os.path.relpath(OUTPUT, PROJECT_DIR))
+
+
+if RUN_FROM_PIO:
+    main([])
+elif __name__ == "__main__":
+    main(sys.argv[1:])
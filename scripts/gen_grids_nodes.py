@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Generate include/grids_node_map.h: the 5x5 node map used by Grids mode.
+
+Each node holds 32 steps of trigger levels for kick, snare and hi-hat. A step
+fires when its level exceeds 255 - density, so the level is the step's
+priority: 255 hits survive at any density, low levels only appear when the
+density slider is pushed up. Levels above the accent threshold play accented.
+
+The X axis moves from straight four-on-the-floor (left) to broken, syncopated
+patterns (right). The Y axis moves from sparse (top) to busy with ghost notes
+and 16th hats (bottom). Patterns are derived from rules rather than copied
+from the Mutable Instruments tables so the firmware stays MIT licensed.
+
+The header also carries golden checksums of interpolated patterns, computed
+here with a Python mirror of regenerateGridsPattern(). The firmware's
+`GRIDS CHECK` serial command compares against them.
+
+Usage:
+  python3 scripts/gen_grids_nodes.py           # regenerate if stale
+  python3 scripts/gen_grids_nodes.py --force   # always regenerate
+"""
+
+import os
+import random
+import sys
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+    RUN_FROM_PIO = True
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    RUN_FROM_PIO = False
+
+SCRIPT = os.path.join(PROJECT_DIR, "scripts", "gen_grids_nodes.py")
+OUTPUT = os.path.join(PROJECT_DIR, "include", "grids_node_map.h")
+
+NODES = 5
+STEPS = 32
+INSTRUMENTS = 3
+QUANT_SHIFT = 3  # Pad coordinates are quantised to 32 levels per axis
+
+# Syncopated kick positions in order of priority (16th steps within two bars)
+KICK_SYNCOPATION = [10, 27, 3, 22, 14, 30, 6, 19, 11, 25]
+SNARE_GHOSTS = [15, 31, 7, 10, 26, 18, 2, 23]
+
+
+def clamp(v):
+    return max(0, min(255, int(round(v))))
+
+
+def make_node(i, j):
+    rng = random.Random(i * NODES + j)
+    sync = i / (NODES - 1.0)   # 0 = straight, 1 = broken
+    busy = j / (NODES - 1.0)   # 0 = sparse, 1 = busy
+    kick = [0.0] * STEPS
+    snare = [0.0] * STEPS
+    hat = [0.0] * STEPS
+
+    # Kick: downbeats always, quarter notes fade out as syncopation takes over
+    for s in range(0, STEPS, 4):
+        kick[s] = 230 - 150 * sync
+    kick[0] = kick[16] = 255
+    for rank, s in enumerate(KICK_SYNCOPATION):
+        kick[s] = max(kick[s], sync * (235 - rank * 18))
+    for s in range(1, STEPS, 2):
+        kick[s] = max(kick[s], busy * rng.randint(20, 90))
+
+    # Snare: backbeats, the last one drifts late on broken patterns
+    for s in (4, 12, 20, 28):
+        snare[s] = 255
+    if sync > 0.5:
+        snare[28] = 170
+        snare[30] = 240
+        snare[13] = 120 + 60 * sync
+    for rank, s in enumerate(SNARE_GHOSTS):
+        snare[s] = max(snare[s], busy * (200 - rank * 16) + rng.randint(-12, 12))
+
+    # Hats: 8ths, offbeat emphasis on the straight side, 16ths fill in with busy
+    for s in range(0, STEPS, 2):
+        offbeat = (s % 4) == 2
+        hat[s] = (210 if offbeat else 150) - (40 * sync if offbeat else 0) + rng.randint(-10, 10)
+    for s in range(1, STEPS, 2):
+        hat[s] = 40 + 150 * busy + 30 * sync + rng.randint(-15, 15)
+
+    return [clamp(v) for v in kick] + [clamp(v) for v in snare] + [clamp(v) for v in hat]
+
+
+def build_nodes():
+    return [[make_node(i, j) for j in range(NODES)] for i in range(NODES)]
+
+
+def mix(a, b, balance):
+    return a + (((b - a) * balance) >> 8)
+
+
+def node_position(coord):
+    """Quantised coordinate to 1/256 node steps; the top level is the last node."""
+    top = 0xFF >> QUANT_SHIFT
+    return (coord >> QUANT_SHIFT) * ((NODES - 1) << 8) // top
+
+
+def interpolate(nodes, x, y):
+    """Mirror of the firmware's interpolation for quantised (x, y)."""
+    px = node_position(x)
+    py = node_position(y)
+    i = px >> 8
+    j = py >> 8
+    i1 = min(i + 1, NODES - 1)
+    j1 = min(j + 1, NODES - 1)
+    xf = px & 0xFF
+    yf = py & 0xFF
+    a, b = nodes[i][j], nodes[i1][j]
+    c, d = nodes[i][j1], nodes[i1][j1]
+    return [mix(mix(a[k], b[k], xf), mix(c[k], d[k], xf), yf) for k in range(STEPS * INSTRUMENTS)]
+
+
+def fnv1a(data):
+    h = 0x811C9DC5
+    for b in data:
+        h ^= b
+        h = (h * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+GOLDEN_POINTS = [(0, 0), (255, 0), (0, 255), (255, 255), (128, 128),
+                 (64, 192), (200, 40), (17, 99), (99, 17), (248, 248)]
+
+
+def render(nodes):
+    out = []
+    out.append("// Generated by scripts/gen_grids_nodes.py - do not edit by hand.")
+    out.append("#ifndef GRIDS_NODE_MAP_H")
+    out.append("#define GRIDS_NODE_MAP_H")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("#include <pgmspace.h>")
+    out.append("")
+    out.append("#define GRIDS_NODES %d" % NODES)
+    out.append("#define GRIDS_NODE_STEPS %d" % STEPS)
+    out.append("#define GRIDS_NODE_INSTRUMENTS %d" % INSTRUMENTS)
+    out.append("#define GRIDS_NODE_BYTES (GRIDS_NODE_STEPS * GRIDS_NODE_INSTRUMENTS)")
+    out.append("#define GRIDS_COORD_QUANT_SHIFT %d" % QUANT_SHIFT)
+    out.append("")
+    out.append("// [x node][y node][kick 0-31, snare 32-63, hat 64-95]")
+    out.append("static const uint8_t PROGMEM kGridsNodeMap[GRIDS_NODES][GRIDS_NODES][GRIDS_NODE_BYTES] = {")
+    for i in range(NODES):
+        out.append("  {")
+        for j in range(NODES):
+            node = nodes[i][j]
+            out.append("    {")
+            for k in range(INSTRUMENTS):
+                row = node[k * STEPS:(k + 1) * STEPS]
+                out.append("      " + ", ".join("%3d" % v for v in row) + ",")
+            out.append("    },")
+        out.append("  },")
+    out.append("};")
+    out.append("")
+    out.append("struct GridsGoldenPattern {")
+    out.append("  uint8_t x;")
+    out.append("  uint8_t y;")
+    out.append("  uint32_t fnv1a;")
+    out.append("};")
+    out.append("")
+    out.append("// FNV-1a over the 96 interpolated levels at each (x, y)")
+    out.append("static const GridsGoldenPattern kGridsGoldenPatterns[%d] = {" % len(GOLDEN_POINTS))
+    for x, y in GOLDEN_POINTS:
+        out.append("    {%d, %d, 0x%08Xu}," % (x, y, fnv1a(interpolate(nodes, x, y))))
+    out.append("};")
+    out.append("")
+    out.append("#endif // GRIDS_NODE_MAP_H")
+    return "\n".join(out) + "\n"
+
+
+def main(argv):
+    stale = (not os.path.isfile(OUTPUT) or
+             os.path.getmtime(OUTPUT) < os.path.getmtime(SCRIPT))
+    if not stale and "--force" not in argv:
+        return
+    with open(OUTPUT, "w", encoding="utf-8") as f:
+        f.write(render(build_nodes()))
+    print("Generated %s" % os.path.relpath(OUTPUT, PROJECT_DIR))
+
+
+if RUN_FROM_PIO:
+    main([])
+elif __name__ == "__main__":
+    main(sys.argv[1:])
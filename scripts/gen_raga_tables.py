@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+"""Generate include/raga_markov_tables.h from the raga definitions below.
+
+Each raga gets a 2nd-order transition table P(next | prev_prev, prev) over its
+scale degrees, plus sparse 3rd-order overrides P(next | a, b, c) for contexts
+that start a pakad phrase. Rows are emitted as cumulative weights so the
+firmware samples with a binary search instead of summing weights per note.
+
+Bhairavi keeps its hand-tuned 2nd-order matrix verbatim. The other ragas are
+derived from rules: stepwise motion, vadi/samvadi emphasis, pakad n-grams,
+and aroha/avaroha constraints (an upward move may only land on an aroha
+degree, a downward move only on an avaroha degree).
+
+Usage:
+  python3 scripts/gen_raga_tables.py           # regenerate if stale
+  python3 scripts/gen_raga_tables.py --force   # always regenerate
+  python3 scripts/gen_raga_tables.py --check   # verify tables, sample distributions
+
+Also runs as a PlatformIO pre: script so the header is rebuilt whenever this
+file changes.
+"""
+
+import os
+import random
+import sys
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+    RUN_FROM_PIO = True
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    RUN_FROM_PIO = False
+
+SCRIPT = os.path.join(PROJECT_DIR, "scripts", "gen_raga_tables.py")
+OUTPUT = os.path.join(PROJECT_DIR, "include", "raga_markov_tables.h")
+
+# Bhairavi: S r g m P d n, vadi m, samvadi S (see docs/RAGA_MODE_MARKOV_CHAIN.md)
+BHAIRAVI_WEIGHTS = [
+    [[40, 30, 15, 25, 10, 5, 5], [20, 20, 40, 35, 10, 5, 5], [15, 25, 20, 50, 10, 5, 5],
+     [30, 20, 30, 30, 15, 10, 5], [25, 15, 20, 40, 20, 15, 10], [20, 15, 10, 25, 15, 20, 30],
+     [50, 20, 10, 15, 10, 10, 15]],
+    [[40, 30, 20, 20, 10, 5, 5], [25, 35, 30, 20, 10, 5, 5], [15, 20, 25, 45, 15, 5, 5],
+     [25, 20, 35, 30, 15, 10, 5], [20, 25, 20, 35, 20, 10, 5], [15, 20, 15, 25, 15, 25, 20],
+     [45, 25, 15, 15, 10, 10, 10]],
+    [[35, 30, 20, 25, 10, 5, 5], [35, 25, 25, 25, 10, 5, 5], [20, 25, 25, 35, 15, 10, 5],
+     [20, 15, 20, 40, 20, 20, 10], [15, 20, 25, 40, 20, 15, 10], [10, 15, 15, 30, 15, 25, 25],
+     [40, 25, 15, 15, 10, 10, 15]],
+    [[45, 30, 20, 20, 10, 5, 5], [30, 25, 30, 25, 10, 5, 5], [25, 35, 25, 25, 10, 5, 5],
+     [25, 20, 25, 40, 20, 15, 10], [20, 15, 20, 40, 25, 15, 10], [10, 10, 15, 30, 15, 25, 35],
+     [50, 20, 15, 20, 10, 10, 10]],
+    [[40, 25, 20, 25, 15, 5, 5], [25, 25, 25, 30, 15, 10, 5], [20, 25, 25, 40, 15, 10, 5],
+     [20, 20, 25, 40, 20, 15, 10], [25, 15, 20, 40, 25, 20, 10], [15, 15, 15, 30, 15, 30, 25],
+     [45, 20, 15, 20, 15, 10, 10]],
+    [[40, 25, 20, 20, 15, 10, 10], [25, 30, 25, 25, 15, 15, 10], [20, 25, 25, 35, 15, 15, 10],
+     [20, 20, 25, 35, 20, 20, 15], [20, 20, 20, 35, 25, 20, 15], [15, 15, 15, 25, 15, 30, 30],
+     [45, 20, 15, 20, 15, 15, 15]],
+    [[50, 25, 15, 20, 10, 10, 10], [30, 30, 25, 25, 15, 10, 5], [25, 25, 25, 30, 15, 10, 10],
+     [25, 20, 25, 35, 15, 15, 10], [25, 20, 20, 35, 20, 15, 10], [20, 20, 15, 25, 15, 25, 25],
+     [45, 25, 15, 20, 10, 10, 15]],
+]
+
+# Order matches RagaType in include/module_raga_mode.h. Degrees index the
+# raga's own scale (kRagaIntervals); pakad phrases are written in degrees,
+# with upper/lower octave Sa folded onto degree 0.
+RAGAS = [
+    {
+        "name": "Bhairavi",
+        "scale": [0, 1, 3, 5, 7, 8, 10],
+        "vadi": 3, "samvadi": 0,
+        "aroha": [0, 1, 2, 3, 4, 5, 6], "avaroha": [0, 1, 2, 3, 4, 5, 6],
+        "pakad": [[0, 1, 2, 3], [3, 2, 1, 0], [2, 3, 5, 6, 0]],
+        "weights": BHAIRAVI_WEIGHTS,
+    },
+    {
+        "name": "Lalit",
+        "scale": [0, 1, 4, 5, 6, 9, 11],  # S r G m M D N
+        "vadi": 3, "samvadi": 0,
+        "aroha": [0, 1, 2, 3, 4, 5, 6], "avaroha": [0, 1, 2, 3, 4, 5, 6],
+        "pakad": [[6, 1, 2, 3], [3, 4, 3, 2], [3, 4, 5, 4, 6, 0]],
+    },
+    {
+        "name": "Bhupali",
+        "scale": [0, 2, 4, 7, 9],  # S R G P D
+        "vadi": 2, "samvadi": 4,
+        "aroha": [0, 1, 2, 3, 4], "avaroha": [0, 1, 2, 3, 4],
+        "pakad": [[2, 1, 0, 4, 0, 1, 2], [3, 2, 4, 3, 2, 1, 0]],
+    },
+    {
+        "name": "Todi",
+        "scale": [0, 1, 3, 6, 7, 8, 11],  # S r g M P d N
+        "vadi": 5, "samvadi": 2,
+        "aroha": [0, 1, 2, 3, 5, 6], "avaroha": [0, 1, 2, 3, 4, 5, 6],  # P skipped going up
+        "pakad": [[5, 6, 0, 1, 2], [1, 2, 1, 0], [3, 2, 1, 2, 1, 0]],
+    },
+    {
+        "name": "Madhuvanti",
+        "scale": [0, 2, 3, 6, 7, 9, 11],  # S R g M P D N
+        "vadi": 4, "samvadi": 0,
+        "aroha": [0, 2, 3, 4, 6], "avaroha": [0, 1, 2, 3, 4, 5, 6],  # R, D skipped going up
+        "pakad": [[3, 2, 1, 0], [6, 0, 2, 3, 4], [3, 4, 6, 5, 4]],
+    },
+    {
+        "name": "Meghmalhar",
+        "scale": [0, 2, 5, 7, 10],  # S R m P n
+        "vadi": 0, "samvadi": 3,
+        "aroha": [0, 1, 2, 3, 4], "avaroha": [0, 1, 2, 3, 4],
+        "pakad": [[1, 2, 1, 3, 2, 1, 0], [4, 3, 2, 1]],
+    },
+    {
+        "name": "Yaman",
+        "scale": [0, 2, 4, 6, 7, 9, 11],  # S R G M P D N
+        "vadi": 2, "samvadi": 6,
+        "aroha": [0, 1, 2, 3, 5, 6], "avaroha": [0, 1, 2, 3, 4, 5, 6],  # P skipped going up
+        "pakad": [[6, 1, 2, 1, 0], [4, 3, 2, 1, 0], [6, 5, 4, 3, 2]],
+    },
+    {
+        "name": "Malkauns",
+        "scale": [0, 3, 5, 8, 10],  # S g m d n
+        "vadi": 2, "samvadi": 0,
+        "aroha": [0, 1, 2, 3, 4], "avaroha": [0, 1, 2, 3, 4],
+        "pakad": [[2, 1, 2, 3, 2, 1, 0], [1, 2, 3, 4, 3, 2], [4, 3, 2, 1, 0]],
+    },
+]
+
+MAX_DEGREES = 7
+ORDER3_BOOST = 60  # Extra weight for the phrase continuation after a 3-note pakad prefix
+
+
+def derive_weights(raga):
+    """Rule-based 2nd-order weights for ragas without a hand-tuned matrix."""
+    n = len(raga["scale"])
+    step_weight = {0: 14, 1: 30, 2: 14, 3: 7}
+    pakad_pairs = set()
+    pakad_triples = set()
+    for phrase in raga["pakad"]:
+        for i in range(len(phrase) - 1):
+            pakad_pairs.add((phrase[i], phrase[i + 1]))
+        for i in range(len(phrase) - 2):
+            pakad_triples.add((phrase[i], phrase[i + 1], phrase[i + 2]))
+
+    weights = []
+    for a in range(n):
+        plane = []
+        for b in range(n):
+            row = []
+            for c in range(n):
+                w = float(step_weight.get(abs(c - b), 3))
+                # Melodic momentum: continuing in the same direction reads as a phrase
+                if (c - b) * (b - a) > 0:
+                    w *= 1.2
+                if c == raga["vadi"]:
+                    w *= 1.6
+                elif c == raga["samvadi"]:
+                    w *= 1.3
+                if (b, c) in pakad_pairs:
+                    w *= 1.5
+                if (a, b, c) in pakad_triples:
+                    w += 40
+                if c > b and c not in raga["aroha"]:
+                    w = 0
+                if c < b and c not in raga["avaroha"]:
+                    w = 0
+                row.append(int(round(w)))
+            if sum(row) == 0:
+                row[b] = 1  # Dead end under aroha/avaroha: hold the note
+            plane.append(row)
+        weights.append(plane)
+    return weights
+
+
+def order3_overrides(raga, weights):
+    """Context (a, b, c) -> row, for every 3-note window that continues a pakad."""
+    overrides = {}
+    for phrase in raga["pakad"]:
+        for i in range(len(phrase) - 3):
+            a, b, c, d = phrase[i:i + 4]
+            row = overrides.get((a, b, c), list(weights[b][c]))
+            row[d] += ORDER3_BOOST
+            overrides[(a, b, c)] = row
+    return overrides
+
+
+def cumulative(row):
+    out = []
+    total = 0
+    for w in row:
+        total += w
+        out.append(total)
+    return out
+
+
+def context_key(a, b, c):
+    return (a * MAX_DEGREES + b) * MAX_DEGREES + c
+
+
+def build():
+    tables = []
+    for raga in RAGAS:
+        n = len(raga["scale"])
+        weights = raga.get("weights") or derive_weights(raga)
+        assert len(weights) == n and all(len(p) == n and all(len(r) == n for r in p) for p in weights)
+        overrides = order3_overrides(raga, weights)
+        keys = sorted(overrides, key=lambda k: context_key(*k))
+        tables.append({
+            "raga": raga,
+            "n": n,
+            "weights": weights,
+            "order2": [cumulative(weights[a][b]) for a in range(n) for b in range(n)],
+            "order3_keys": [context_key(*k) for k in keys],
+            "order3_weights": [overrides[k] for k in keys],
+            "order3": [cumulative(overrides[k]) for k in keys],
+        })
+    return tables
+
+
+def sample_row(cdf, r):
+    """Mirror of sampleCdfRow() in src/module_raga_mode.cpp."""
+    lo, hi = 0, len(cdf) - 1
+    while lo < hi:
+        mid = (lo + hi) // 2
+        if cdf[mid] > r:
+            hi = mid
+        else:
+            lo = mid + 1
+    return lo
+
+
+def check(tables, samples=20000):
+    rng = random.Random(1)
+    worst = 0.0
+    for t in tables:
+        rows = list(zip(t["order2"], (t["weights"][a][b] for a in range(t["n"]) for b in range(t["n"]))))
+        rows += list(zip(t["order3"], t["order3_weights"]))
+        for cdf, weights in rows:
+            # Exact: the CDF must invert back to the source weights
+            diffs = [cdf[0]] + [cdf[i] - cdf[i - 1] for i in range(1, len(cdf))]
+            if diffs != list(weights):
+                raise SystemExit("CDF mismatch in %s: %s vs %s" % (t["raga"]["name"], diffs, weights))
+            if cdf[-1] > 0xFFFF:
+                raise SystemExit("Row total overflows uint16 in %s" % t["raga"]["name"])
+        # Statistical: sampling the first few rows must match the weights
+        for cdf, weights in rows[:8]:
+            counts = [0] * len(cdf)
+            for _ in range(samples):
+                counts[sample_row(cdf, rng.randrange(cdf[-1]))] += 1
+            total = float(sum(weights))
+            for c, w in zip(counts, weights):
+                worst = max(worst, abs(c / samples - w / total))
+        print("%-11s degrees=%d order2 rows=%d order3 rows=%d" % (
+            t["raga"]["name"], t["n"], len(t["order2"]), len(t["order3"])))
+    print("max |sampled - expected| probability: %.4f" % worst)
+    if worst > 0.02:
+        raise SystemExit("Sampled distribution deviates from source weights")
+
+
+def fmt_rows(rows, indent="    "):
+    return "\n".join(indent + "{" + ", ".join("%3d" % v for v in r) + "}," for r in rows)
+
+
+def render(tables):
+    out = []
+    out.append("// Generated by scripts/gen_raga_tables.py - do not edit by hand.")
+    out.append("#ifndef RAGA_MARKOV_TABLES_H")
+    out.append("#define RAGA_MARKOV_TABLES_H")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("// Cumulative transition weights, read straight from flash.")
+    out.append("// order2Cdf:  [prevPrev * degrees + prev][next]")
+    out.append("// order3Keys: sorted (a * 7 + b) * 7 + c context keys; order3Cdf rows follow the same order")
+    out.append("struct RagaMarkovTable {")
+    out.append("  uint8_t degrees;")
+    out.append("  uint8_t order3Count;")
+    out.append("  const uint16_t (*order2Cdf)[%d];" % MAX_DEGREES)
+    out.append("  const uint16_t *order3Keys;")
+    out.append("  const uint16_t (*order3Cdf)[%d];" % MAX_DEGREES)
+    out.append("};")
+    out.append("")
+    out.append("static constexpr uint8_t kRagaMarkovMaxDegrees = %d;" % MAX_DEGREES)
+    out.append("")
+    for t in tables:
+        name = t["raga"]["name"]
+        pad = lambda r: r + [r[-1]] * (MAX_DEGREES - len(r))
+        out.append("static const uint16_t k%sOrder2Cdf[%d][%d] = {" % (name, len(t["order2"]), MAX_DEGREES))
+        out.append(fmt_rows([pad(r) for r in t["order2"]]))
+        out.append("};")
+        if t["order3"]:
+            out.append("static const uint16_t k%sOrder3Keys[%d] = {%s};" % (
+                name, len(t["order3_keys"]), ", ".join(str(k) for k in t["order3_keys"])))
+            out.append("static const uint16_t k%sOrder3Cdf[%d][%d] = {" % (name, len(t["order3"]), MAX_DEGREES))
+            out.append(fmt_rows([pad(r) for r in t["order3"]]))
+            out.append("};")
+        out.append("")
+    out.append("static const RagaMarkovTable kRagaMarkovTables[%d] = {" % len(tables))
+    for t in tables:
+        name = t["raga"]["name"]
+        if t["order3"]:
+            out.append("    {%d, %d, k%sOrder2Cdf, k%sOrder3Keys, k%sOrder3Cdf}," % (
+                t["n"], len(t["order3"]), name, name, name))
+        else:
+            out.append("    {%d, 0, k%sOrder2Cdf, nullptr, nullptr}," % (t["n"], name))
+    out.append("};")
+    out.append("")
+    out.append("#endif // RAGA_MARKOV_TABLES_H")
+    return "\n".join(out) + "\n"
+
+
+def main(argv):
+    tables = build()
+    if "--check" in argv:
+        check(tables)
+        return
+    stale = (not os.path.isfile(OUTPUT) or
+             os.path.getmtime(OUTPUT) < os.path.getmtime(SCRIPT))
+    if not stale and "--force" not in argv:
+        return
+    with open(OUTPUT, "w", encoding="utf-8") as f:
+        f.write(render(tables))
+    print("Generated %s" % os.path.relpath(OUTPUT, PROJECT_DIR))
+
+
+if RUN_FROM_PIO:
+    main([])
+elif __name__ == "__main__":
+    main(sys.argv[1:])
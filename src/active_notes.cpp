@@ -0,0 +1,176 @@
+#include "active_notes.h"
+
+#include "din_midi_out.h"
+#include "midi_utils.h"
+
+#include <Arduino.h>
+
+namespace {
+static constexpr uint8_t kMaxStuckLogs = 4;
+
+ActiveNoteMap liveMap;
+uint16_t stuckCount = 0;
+uint32_t lastSweepMs = 0;
+
+inline uint32_t load(const uint32_t *word) {
+  return __atomic_load_n(word, __ATOMIC_RELAXED);
+}
+
+inline void store(uint32_t *word, uint32_t value) {
+  __atomic_store_n(word, value, __ATOMIC_RELAXED);
+}
+
+uint32_t dinMessagesUs(uint32_t messages) {
+  return messages * 3 * kDinByteUs;
+}
+}  // namespace
+
+void activeNotesTrack(ActiveNoteMap &map, uint8_t status, uint8_t data1, uint8_t data2) {
+  uint8_t type = status & 0xF0;
+  uint8_t channel = status & 0x0F;
+  if (type == 0xB0) {
+    if (data1 == 120 || data1 == 123) {  // All sound off / all notes off
+      for (uint8_t w = 0; w < 4; ++w) {
+        store(&map.sounding[channel][w], 0);
+        store(&map.untouched[channel][w], 0);
+      }
+    }
+    return;
+  }
+  if (type != 0x80 && type != 0x90) {
+    return;
+  }
+  uint8_t w = (data1 >> 5) & 0x03;
+  uint32_t bit = 1u << (data1 & 31);
+  __atomic_fetch_and(&map.untouched[channel][w], ~bit, __ATOMIC_RELAXED);
+  if (type == 0x90 && data2 > 0) {
+    __atomic_fetch_or(&map.sounding[channel][w], bit, __ATOMIC_RELAXED);
+  } else {
+    __atomic_fetch_and(&map.sounding[channel][w], ~bit, __ATOMIC_RELAXED);
+  }
+}
+
+uint8_t activeNotesVoiceCount(const ActiveNoteMap &map, uint8_t channel) {
+  uint8_t count = 0;
+  for (uint8_t w = 0; w < 4; ++w) {
+    count = static_cast<uint8_t>(count + __builtin_popcount(load(&map.sounding[channel & 0x0F][w])));
+  }
+  return count;
+}
+
+void activeNotesTrack(uint8_t status, uint8_t data1, uint8_t data2) {
+  activeNotesTrack(liveMap, status, data1, data2);
+}
+
+bool activeNoteIsSounding(uint8_t channel, uint8_t note) {
+  return (load(&liveMap.sounding[channel & 0x0F][(note >> 5) & 0x03]) >> (note & 31)) & 1u;
+}
+
+uint8_t activeNotesVoiceCount(uint8_t channel) {
+  return activeNotesVoiceCount(liveMap, channel);
+}
+
+uint16_t activeNotesTotal() {
+  uint16_t total = 0;
+  for (uint8_t channel = 0; channel < 16; ++channel) {
+    total = static_cast<uint16_t>(total + activeNotesVoiceCount(liveMap, channel));
+  }
+  return total;
+}
+
+uint16_t activeNotesRelease(uint8_t channel) {
+  channel &= 0x0F;
+  uint16_t released = 0;
+  for (uint8_t w = 0; w < 4; ++w) {
+    uint32_t word = load(&liveMap.sounding[channel][w]);
+    while (word) {
+      uint8_t bit = static_cast<uint8_t>(__builtin_ctz(word));
+      word &= word - 1;
+      sendMIDI(0x80 | channel, static_cast<uint8_t>(w * 32 + bit), 0);
+      ++released;
+    }
+  }
+  return released;
+}
+
+uint16_t activeNotesReleaseAll() {
+  uint16_t released = 0;
+  for (uint8_t channel = 0; channel < 16; ++channel) {
+    released = static_cast<uint16_t>(released + activeNotesRelease(channel));
+  }
+  return released;
+}
+
+void activeNotesService(uint32_t nowMs) {
+  if (nowMs - lastSweepMs < kActiveNotesSweepMs) {
+    return;
+  }
+  lastSweepMs = nowMs;
+  uint16_t stuck = 0;
+  for (uint8_t channel = 0; channel < 16; ++channel) {
+    for (uint8_t w = 0; w < 4; ++w) {
+      uint32_t sounding = load(&liveMap.sounding[channel][w]);
+      uint32_t flagged = sounding & load(&liveMap.untouched[channel][w]);
+      while (flagged) {
+        uint8_t bit = static_cast<uint8_t>(__builtin_ctz(flagged));
+        flagged &= flagged - 1;
+        if (stuck < kMaxStuckLogs) {
+          Serial.printf("[NOTES] Possibly stuck: ch %u note %u\n", channel + 1u, w * 32u + bit);
+        }
+        ++stuck;
+      }
+      store(&liveMap.untouched[channel][w], sounding);
+    }
+  }
+  if (stuck > kMaxStuckLogs) {
+    Serial.printf("[NOTES] %u notes held without activity\n", stuck);
+  }
+  stuckCount = stuck;
+}
+
+uint16_t activeNotesStuckCount() {
+  return stuckCount;
+}
+
+ActiveNotesBurstResult activeNotesRunBurstCheck(uint8_t channels, uint8_t notesPerChannel) {
+  ActiveNotesBurstResult result = {};
+  channels = constrain(channels, 1, 16);
+  notesPerChannel = constrain(notesPerChannel, 1, 127);
+  ActiveNoteMap scratch = {};
+
+  // Stacked fifths per channel; every third note is released again, one of
+  // them through a velocity-0 note-on, so the map has to follow both forms
+  for (uint8_t channel = 0; channel < channels; ++channel) {
+    for (uint8_t k = 0; k < notesPerChannel; ++k) {
+      uint8_t note = static_cast<uint8_t>((24 + channel * 5 + k * 7) & 0x7F);
+      activeNotesTrack(scratch, 0x90 | channel, note, 100);
+      if (k % 3 == 2) {
+        activeNotesTrack(scratch, (k % 6 == 2 ? 0x90 : 0x80) | channel, note, 0);
+      }
+    }
+    result.sounding = static_cast<uint16_t>(result.sounding + activeNotesVoiceCount(scratch, channel));
+  }
+
+  for (uint8_t channel = 0; channel < channels; ++channel) {
+    for (uint8_t w = 0; w < 4; ++w) {
+      uint32_t word = scratch.sounding[channel][w];
+      while (word) {
+        uint8_t bit = static_cast<uint8_t>(__builtin_ctz(word));
+        word &= word - 1;
+        activeNotesTrack(scratch, 0x80 | channel, static_cast<uint8_t>(w * 32 + bit), 0);
+        ++result.softMessages;
+      }
+    }
+  }
+  result.ok = result.softMessages == result.sounding;
+  for (uint8_t channel = 0; channel < 16; ++channel) {
+    result.ok = result.ok && activeNotesVoiceCount(scratch, channel) == 0;
+  }
+
+  result.blindMessages = static_cast<uint16_t>(128 * channels);
+  result.hardMessages = 32;
+  result.blindDinUs = dinMessagesUs(result.blindMessages);
+  result.hardDinUs = dinMessagesUs(result.hardMessages);
+  result.softDinUs = dinMessagesUs(result.softMessages);
+  return result;
+}
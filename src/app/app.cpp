@@ -15,15 +15,26 @@
 #include "app/app_modes.h"
 #include "app/app_renderer.h"
 #include "app/app_serial_cli.h"
+#include "active_notes.h"
+#include "background_generator.h"
 #include "clock_manager.h"
 #include "clock_runtime.h"
 #include "midi_out_buffer.h"
 #include "header_capture.h"
+#include "lfo_engine.h"
+#include "memory_pools.h"
 #include "midi_clock_task.h"
 #include "midi_transport.h"
+#include "midi_utils.h"
 #include "module_bpm_settings_mode.h"
+#include "module_fractal_echo_mode.h"
+#include "module_slot_performer_mode.h"
+#include "profiler.h"
 #include "remote_display.h"
+#include "rng_service.h"
+#include "scene_store.h"
 #include "splash_screen.h"
+#include "telemetry.h"
 #include "ui_elements.h"
 #include "wifi_manager.h"
 
@@ -66,12 +77,15 @@ void appSetup() {
   Serial.println("ESP log level set to DEBUG for BT stack");
 #endif
 
+  initSlotPerformerMemory();  // Large mode buffers go to PSRAM before the display claims DMA memory
+
 #if DEBUG_ENABLED
   Serial.printf("Heap post-init: dma_free=%u dma_largest=%u int_free=%u int_largest=%u\n",
                 heap_caps_get_free_size(MALLOC_CAP_DMA),
                 heap_caps_get_largest_free_block(MALLOC_CAP_DMA),
                 heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
                 heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL));
+  poolPrintReport();
 #endif
 
   smartdisplay_init();
@@ -103,17 +117,24 @@ void appSetup() {
 
   showSplashScreen("Booting...", 400);
 
+  initRngService();  // Seed per-mode RNG streams before any mode can draw from them
   bleMidiBegin();
   initHardwareMIDI();  // Initialize hardware MIDI output
   // Initialize new framework components
   midiOutBuffer.init();
+  initMidiOutputQueues();
+  initTelemetry();  // Before the clock and transports start emitting
+  initLfoEngine();  // Synced LFOs take their ticks from the clock manager
   clockRuntime.init();
+  initBackgroundGenerators();  // Euclid, Grids and Raga play from the clock task, whatever is shown
   // Ensure all modules register uClock step callbacks before uClock is initialized
   registerAllStepCallbacks();
   initClockManager();
   initMidiClockTask();
   initWiFi();  // Prepare WiFi (used by remote display and clock master suppliers)
   initMidiTransports();
+  initFractalEchoService();  // Echo live MIDI input regardless of the foreground mode
+  initSceneStore();  // Mounts LittleFS in its writer task, off the boot path
 
 #if REMOTE_DISPLAY_ENABLED
   initRemoteDisplay();  // Initialize remote display capability
@@ -153,8 +174,13 @@ void appLoop() {
 #endif
 
   handleMidiTransports();
+  activeNotesService(now);
+  profilerService(now);
 
-  appHandleCurrentMode();
+  {
+    ProfileScope scope(ProfileSection::HANDLE);
+    appHandleCurrentMode();
+  }
 
   // Process any pending redraws after handling logic
   appRendererProcessRedraw();
@@ -162,5 +188,7 @@ void appLoop() {
 #if REMOTE_DISPLAY_ENABLED
   handleRemoteDisplay();  // Handle remote display updates
 #endif
+
+  appRendererIdle(touch.justPressed || touch.justReleased || Serial.available() > 0);
 }
 
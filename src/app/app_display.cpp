@@ -1,11 +1,16 @@
 #include "hardware_midi.h"
 
+#include "app/app_renderer.h"
 #include "common_definitions.h"
 
 #include <lvgl.h>
 
 void requestRedraw() {
-  needsRedraw = true;
+  appRendererRequest(REDRAW_PARAM);
+}
+
+void requestRedrawFor(uint8_t reasons) {
+  appRendererRequest(reasons);
 }
 
 void setDisplayInversion(bool invert) {
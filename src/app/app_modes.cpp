@@ -2,6 +2,7 @@
 
 #include "app/app_menu.h"
 
+#include "background_generator.h"
 #include "midi_utils.h"
 #include "module_arpeggiator_mode.h"
 #include "module_auto_chord_mode.h"
@@ -41,6 +42,7 @@ struct ModeEntry {
   ModeFn init;
   ModeFn draw;
   ModeFn handle;
+  uint8_t clockRedraw;  // RedrawReason clock bits that change what the mode shows
 };
 
 static void initMenuMode() {
@@ -60,36 +62,36 @@ static void initBPMSettingsMode() {
 }
 
 constexpr ModeEntry kModeTable[kModeCount] = {
-    /* MENU */ {initMenuMode, drawMenu, handleMenu},
-    /* SETTINGS */ {initSettingsMode, drawSettingsMode, handleSettingsMode},
-    /* BPM_SETTINGS */ {initBPMSettingsMode, drawBPMSettingsMode, handleBPMSettingsMode},
-    /* KEYBOARD */ {initializeKeyboardMode, drawKeyboardMode, handleKeyboardMode},
-    /* SEQUENCER */ {initializeSequencerMode, drawSequencerMode, handleSequencerMode},
-    /* BOUNCING_BALL */ {initializeBouncingBallMode, drawBouncingBallMode, handleBouncingBallMode},
-    /* PHYSICS_DROP */ {initializePhysicsDropMode, drawPhysicsDropMode, handlePhysicsDropMode},
-    /* RANDOM_GENERATOR */ {initializeRandomGeneratorMode, drawRandomGeneratorMode, handleRandomGeneratorMode},
-    /* XY_PAD */ {initializeXYPadMode, drawXYPadMode, handleXYPadMode},
-    /* ARPEGGIATOR */ {initializeArpeggiatorMode, drawArpeggiatorMode, handleArpeggiatorMode},
-    /* GRID_PIANO */ {initializeGridPianoMode, drawGridPianoMode, handleGridPianoMode},
-    /* AUTO_CHORD */ {initializeAutoChordMode, drawAutoChordMode, handleAutoChordMode},
-    /* LFO */ {initializeLFOMode, drawLFOMode, handleLFOMode},
-    /* SLINK */ {initializeSlinkMode, drawSlinkMode, handleSlinkMode},
-    /* TB3PO */ {initializeTB3POMode, drawTB3POMode, handleTB3POMode},
-    /* GRIDS */ {initializeGridsMode, drawGridsMode, handleGridsMode},
-    /* RAGA */ {initializeRagaMode, drawRagaMode, handleRagaMode},
-    /* EUCLID */ {initializeEuclideanMode, drawEuclideanMode, handleEuclideanMode},
-    /* MORPH */ {initializeMorphMode, drawMorphMode, handleMorphMode},
-    /* WAAAVE */ {initializeWaaaveMode, drawWaaaveMode, handleWaaaveMode},
+    /* MENU */ {initMenuMode, drawMenu, handleMenu, 0},
+    /* SETTINGS */ {initSettingsMode, drawSettingsMode, handleSettingsMode, REDRAW_BEAT},
+    /* BPM_SETTINGS */ {initBPMSettingsMode, drawBPMSettingsMode, handleBPMSettingsMode, REDRAW_BEAT},
+    /* KEYBOARD */ {initializeKeyboardMode, drawKeyboardMode, handleKeyboardMode, 0},
+    /* SEQUENCER */ {initializeSequencerMode, drawSequencerMode, handleSequencerMode, REDRAW_STEP},
+    /* BOUNCING_BALL */ {initializeBouncingBallMode, drawBouncingBallMode, handleBouncingBallMode, 0},
+    /* PHYSICS_DROP */ {initializePhysicsDropMode, drawPhysicsDropMode, handlePhysicsDropMode, 0},
+    /* RANDOM_GENERATOR */ {initializeRandomGeneratorMode, drawRandomGeneratorMode, handleRandomGeneratorMode, REDRAW_STEP},
+    /* XY_PAD */ {initializeXYPadMode, drawXYPadMode, handleXYPadMode, 0},
+    /* ARPEGGIATOR */ {initializeArpeggiatorMode, drawArpeggiatorMode, handleArpeggiatorMode, REDRAW_STEP},
+    /* GRID_PIANO */ {initializeGridPianoMode, drawGridPianoMode, handleGridPianoMode, 0},
+    /* AUTO_CHORD */ {initializeAutoChordMode, drawAutoChordMode, handleAutoChordMode, 0},
+    /* LFO */ {initializeLFOMode, drawLFOMode, handleLFOMode, 0},
+    /* SLINK */ {initializeSlinkMode, drawSlinkMode, handleSlinkMode, 0},
+    /* TB3PO */ {initializeTB3POMode, drawTB3POMode, handleTB3POMode, REDRAW_STEP},
+    /* GRIDS */ {initializeGridsMode, drawGridsMode, handleGridsMode, REDRAW_STEP},
+    /* RAGA */ {initializeRagaMode, drawRagaMode, handleRagaMode, REDRAW_STEP},
+    /* EUCLID */ {initializeEuclideanMode, drawEuclideanMode, handleEuclideanMode, REDRAW_STEP},
+    /* MORPH */ {initializeMorphMode, drawMorphMode, handleMorphMode, 0},
+    /* WAAAVE */ {initializeWaaaveMode, drawWaaaveMode, handleWaaaveMode, 0},
 #ifdef ENABLE_M5_8ENCODER
-    /* ENCODER_PANEL */ {initializeEncoderPanelMode, drawEncoderPanelMode, handleEncoderPanelMode},
+    /* ENCODER_PANEL */ {initializeEncoderPanelMode, drawEncoderPanelMode, handleEncoderPanelMode, 0},
 #endif
 #ifdef ENABLE_BABY8_EMU
-    /* BABY8 */ {initializeBaby8Mode, drawBaby8Mode, handleBaby8Mode},
+    /* BABY8 */ {initializeBaby8Mode, drawBaby8Mode, handleBaby8Mode, 0},
 #endif
-    /* FRACTAL_ECHO */ {initializeFractalEchoMode, drawFractalEchoMode, handleFractalEchoMode},
-    /* DIMENSIONS */ {initializeDimensionsMode, drawDimensionsMode, handleDimensionsMode},
-    /* ZYNTHIAN_PAD */ {initializeZynthianPadMode, drawZynthianPadMode, handleZynthianPadMode},
-    /* SLOT_PERFORMER */ {initializeSlotPerformerMode, drawSlotPerformerMode, handleSlotPerformerMode},
+    /* FRACTAL_ECHO */ {initializeFractalEchoMode, drawFractalEchoMode, handleFractalEchoMode, REDRAW_STEP},
+    /* DIMENSIONS */ {initializeDimensionsMode, drawDimensionsMode, handleDimensionsMode, REDRAW_STEP},
+    /* ZYNTHIAN_PAD */ {initializeZynthianPadMode, drawZynthianPadMode, handleZynthianPadMode, 0},
+    /* SLOT_PERFORMER */ {initializeSlotPerformerMode, drawSlotPerformerMode, handleSlotPerformerMode, REDRAW_STEP},
 };
 
 static_assert(sizeof(kModeTable) / sizeof(kModeTable[0]) == kModeCount,
@@ -119,8 +121,14 @@ void appDrawCurrentMode() {
   }
 }
 
+uint8_t appModeClockRedraw(AppMode mode) {
+  const ModeEntry *entry = getModeEntry(mode);
+  return entry ? entry->clockRedraw : 0;
+}
+
 void switchMode(AppMode mode) {
   currentMode = mode;
+  backgroundGeneratorsShowView(mode);  // Generators keep playing; only the shown one redraws
   const ModeEntry *entry = getModeEntry(mode);
   if (entry && entry->init) {
     entry->init();
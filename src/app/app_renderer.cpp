@@ -1,16 +1,76 @@
 #include "app/app_renderer.h"
 
 #include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <lvgl.h>
 
 #include "app/app_modes.h"
 #include "common_definitions.h"
+#include "profiler.h"
+#include "telemetry.h"
 
 namespace {
 
+static constexpr uint8_t kAlwaysRedraw = REDRAW_PARAM | REDRAW_TRANSPORT;
+static constexpr size_t kModeSlots = static_cast<size_t>(SLOT_PERFORMER) + 1;
+
 static uint32_t lv_last_tick = 0;
 static lv_obj_t *render_obj = nullptr;
 
+static std::atomic<uint8_t> pendingReasons{0};
+static uint8_t maxFps = kRendererDefaultFps;
+static uint32_t frameIntervalUs = 1000000UL / kRendererDefaultFps;
+static uint32_t lastFrameUs = 0;
+static bool waitingForSlot = false;
+
+struct ModeCounters {
+  RendererModeStats stats;
+  uint64_t idleRunTime;   // UI core IDLE task, run-time counter units
+  uint64_t totalRunTime;
+};
+
+static ModeCounters modeCounters[kModeSlots];
+static size_t statsMode = 0;
+static uint32_t statsSinceMs = 0;
+
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+// CPU idle on the UI core is what its IDLE task ran, not the loop's own sleep
+static TaskHandle_t uiIdleTask = nullptr;
+static uint32_t lastIdleRunTime = 0;
+static uint32_t lastRunTime = 0;
+
+static void sampleIdle(ModeCounters &counters) {
+  if (uiIdleTask == nullptr) {
+    uiIdleTask = xTaskGetIdleTaskHandleForCPU(xPortGetCoreID());
+  }
+  TaskStatus_t status;
+  vTaskGetInfo(uiIdleTask, &status, pdFALSE, eRunning);
+  uint32_t runTime = static_cast<uint32_t>(portGET_RUN_TIME_COUNTER_VALUE());
+  if (lastRunTime != 0) {
+    counters.idleRunTime += static_cast<uint32_t>(status.ulRunTimeCounter - lastIdleRunTime);
+    counters.totalRunTime += runTime - lastRunTime;
+  }
+  lastIdleRunTime = status.ulRunTimeCounter;
+  lastRunTime = runTime;
+}
+#else
+static void sampleIdle(ModeCounters &) {}
+#endif
+
+static ModeCounters &currentCounters() {
+  uint32_t now = millis();
+  size_t mode = static_cast<size_t>(currentMode);
+  if (mode >= kModeSlots) {
+    mode = 0;
+  }
+  modeCounters[statsMode].stats.activeMs += now - statsSinceMs;
+  statsSinceMs = now;
+  statsMode = mode;
+  return modeCounters[mode];
+}
+
 static void render_event(lv_event_t *event) {
   lv_layer_t *layer = lv_event_get_layer(event);
   lv_display_t *display = lv_display_get_default();
@@ -21,6 +81,7 @@ static void render_event(lv_event_t *event) {
   tft.setLayer(layer,
                lv_display_get_horizontal_resolution(display),
                lv_display_get_vertical_resolution(display));
+  ProfileScope scope(ProfileSection::RENDER);
   appDrawCurrentMode();
 }
 
@@ -57,10 +118,92 @@ void appRendererLoopTick(uint32_t now) {
   lv_timer_handler();
 }
 
+void appRendererRequest(uint8_t reasons) {
+  pendingReasons.fetch_or(reasons);
+}
+
 void appRendererProcessRedraw() {
-  if (needsRedraw && render_obj) {
+  uint8_t reasons = pendingReasons.load();
+  lv_display_t *display = lv_display_get_default();
+  if (reasons == 0 || !render_obj || !display) {
+    return;
+  }
+  ModeCounters &counters = currentCounters();
+  if ((reasons & (kAlwaysRedraw | appModeClockRedraw(currentMode))) == 0) {
+    pendingReasons.fetch_and(static_cast<uint8_t>(~reasons));
+    counters.stats.dropped++;
+    return;
+  }
+  uint32_t startUs = micros();
+  if (startUs - lastFrameUs < frameIntervalUs) {
+    if (!waitingForSlot) {
+      waitingForSlot = true;
+      counters.stats.coalesced++;
+    }
+    return;  // Everything requested until the slot opens goes into one frame
+  }
+  waitingForSlot = false;
+  pendingReasons.fetch_and(static_cast<uint8_t>(~reasons));
+  lastFrameUs = startUs;
+
+  // Render and flush now: the next frame cannot start before this one is on
+  // the panel, and LVGL's own refresh timer finds nothing left to draw
+  {
+    ProfileScope scope(ProfileSection::FLUSH);
     lv_obj_invalidate(render_obj);
-    needsRedraw = false;
+    lv_refr_now(display);
+  }
+
+  uint32_t renderUs = micros() - startUs;
+  counters.stats.frames++;
+  counters.stats.renderUs += renderUs;
+  if (renderUs > counters.stats.maxRenderUs) {
+    counters.stats.maxRenderUs = renderUs;
+  }
+  telemetryEmit(TelemetryEventId::FRAME, static_cast<uint8_t>(currentMode), 0, renderUs, startUs);
+}
+
+void appRendererIdle(bool inputPending) {
+  sampleIdle(currentCounters());
+  bool frameDue = pendingReasons.load() != 0 && micros() - lastFrameUs >= frameIntervalUs;
+  if (inputPending || frameDue) {
+    return;  // Run the next pass now
+  }
+  vTaskDelay(1);
+}
+
+void appRendererSetMaxFps(uint8_t fps) {
+  maxFps = constrain(fps, 1, kRendererMaxFps);
+  frameIntervalUs = 1000000UL / maxFps;
+}
+
+uint8_t appRendererGetMaxFps() {
+  return maxFps;
+}
+
+RendererModeStats appRendererGetModeStats(AppMode mode) {
+  size_t index = static_cast<size_t>(mode);
+  if (index >= kModeSlots) {
+    return RendererModeStats{};
+  }
+  currentCounters();  // Brings activeMs of the mode on screen up to date
+  RendererModeStats stats = modeCounters[index].stats;
+  const ModeCounters &counters = modeCounters[index];
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+  stats.idlePercent = counters.totalRunTime > 0
+                          ? static_cast<int8_t>(min<uint64_t>(counters.idleRunTime * 100 / counters.totalRunTime, 100))
+                          : 0;
+#else
+  (void)counters;
+  stats.idlePercent = -1;
+#endif
+  return stats;
+}
+
+void appRendererResetStats() {
+  for (ModeCounters &counters : modeCounters) {
+    counters = ModeCounters{};
   }
+  statsSinceMs = millis();
 }
 
@@ -4,13 +4,89 @@
 
 #include <Arduino.h>
 
+#include "active_notes.h"
 #include "app/app_modes.h"
+#include "app/app_renderer.h"
+#include "background_generator.h"
+#include "clock_follower.h"
+#include "clock_manager.h"
+#include "clock_runtime.h"
+#include "din_midi_out.h"
+#include "esp_now_frame.h"
+#include "esp_now_midi_module.h"
+#include "euclidean_patterns.h"
+#include "lfo_engine.h"
+#include "midi_control_coalescer.h"
+#include "midi_out_buffer.h"
+#include "midi_transport.h"
+#include "midi_transport_queue.h"
+#include "midi_utils.h"
+#include "module_euclidean_mode.h"
+#include "module_fractal_echo_mode.h"
+#include "module_grids_mode.h"
 #include "module_raga_mode.h"
+#include "module_slot_performer_mode.h"
+#include "profiler.h"
+#include "rng_service.h"
+#include "scene_store.h"
+#include "telemetry.h"
+
+// Indexed by MidiOutPort
+static const char *const kMidiOutPortNames[] = {"BLE", "DIN", "ESPNOW", "WIFI"};
 
 // Minimal serial CLI to support automated testing. Commands (case-insensitive):
 // MODE <name>         -> switch to mode (e.g., MODE RAGA)
 // MODULE START RAGA   -> switch to mode and start Raga (uses toggleRagaPlayback)
 // MODULE STOP RAGA    -> stop Raga
+// FECHO STATS         -> print Fractal Echo live-input counters and latencies
+// FECHO RESET         -> clear Fractal Echo counters
+// FECHO BENCH [n] [s] -> inject n notes/s (default 100) for s seconds (default 10)
+// GRIDS CHECK         -> compare interpolated patterns against generated golden checksums
+// GRIDS BENCH [n]     -> time n pattern regenerations (default 1000), uncached vs cached
+// EUCLID CHECK        -> verify every E(k, n), n <= 64, against the bucket algorithm
+// EUCLID BENCH [n]    -> time n pattern builds (default 10000), bucket loop vs table
+// EUCLID OP <v> <op> <src> -> combine voice v (1-8) with voice src using AND/OR/XOR/NONE
+// EUCLID INV <v> <0|1>     -> invert voice v's pattern
+// RNG CHECK           -> verify seeded streams reproduce the same values
+// RNG BENCH [n]       -> time n draws (default 100000): random() vs RNG service vs batch fill
+// SLOTS BENCH [bars]  -> play 12 full loopers for n bars (default 16), full scan vs play cursor
+// SLOTS DRIFT         -> compare Slot Performer ticks with the MIDI clock since PLAY
+// SLOTS DISPATCH [m]  -> feed m minutes (default 10) of ticks with MIDI muted and count what is processed
+// SCENE SAVE <n>      -> snapshot every module into scene n (0-7); the flash write runs in the background
+// SCENE LOAD <n>      -> stage scene n and re-enter the current mode so it applies its section
+// SCENE SWITCH <n>    -> prepare scene n now and swap it in on the next bar of the running transport
+// SCENE STATS         -> print store state, per-module bytes and save/load times, and the last switch
+// NOTES               -> print sounding voices per channel and the notes flagged as stuck
+// NOTES BURST [c] [n] -> hold n notes (default 8) on c channels (default 16), compare panic burst sizes
+// DIN STATS [RESET]   -> print DIN output counters: running-status savings, backlog, realtime lead
+// DIN SIM [bpm] [n] [bars] -> model clock jitter under n-note chord changes (default 120 16 16), old vs paced
+// CLOCK STATS         -> print the external clock follower: measured tempo, jitter, phase, lock
+// CLOCK SIM [bpm] [drop%] [beats] -> follow synthetic clocks with 0-4 ms jitter, input vs output jitter
+// CLOCK CSV <bpm> <jitterUs> [drop%] -> per-pulse and per-tick trace of one simulated run, for plotting
+// CLOCK TRACE START [quarters] -> count clock pulses per transport per quarter note while running
+// CLOCK TRACE          -> trace result: every transport 0 or 24 pulses a quarter, latency, lane drops
+// CC STATS [RESET]     -> coalesced controllers: updates, and bytes requested vs sent per transport
+// CC RATE <BLE|DIN|ESPNOW|WIFI> <hz> -> max controller flushes per second to one transport (0: every pass)
+// CC SIM [hz] [s]      -> LFOs and an XY sweep updated hz times a second for s seconds: bytes, max step, lag
+// LFO [RESET]          -> background LFO bank: per LFO target, rate or sync, phase, output; timer steps and gaps
+// LFO DRIFT [bars] [bpm] [jitterUs] -> run synced and free LFOs over bars of clock (default 10000 120 250): phase drift
+// RUNTIME LOAD [RESET] -> per clock module: us per tick over the last bar, longest step, budget deferrals
+// RUNTIME BUDGET <us>  -> background module time allowed per clock tick (default 2000)
+// MIDIQ [RESET]        -> BLE and WiFi output queues: depth, sent, batches, coalesced CCs, drops, slowest send
+// MIDIQ SLOW <BLE|WIFI> <ms> -> stall that queue's sender before every send (0 clears); compare CLOCK TRACE latency
+// MIDI RX STATS [RESET] -> print DIN input latency (UART arrival to handling), queue depth and drops
+// MIDI RX MODE <TASK|LOOP> -> read input on the RX task, or poll it from the UI loop as before
+// ESPNOW STATS [RESET] -> print frames sent and per-sender loss, reordering, recovery and latency
+// ESPNOW BATCH <ON|OFF> [r] -> one frame per clock tick with r (0-3) transport repeats, or one packet per message
+// ESPNOW SIM [loss%] [reorder%] [r] [s] -> loopback s seconds (default 60) of framed MIDI over a lossy link
+// RENDER STATS [RESET] -> per mode: frames per second, render time, dropped clock redraws, UI core idle %
+// RENDER FPS <n>      -> cap the frame rate (1-60, default 30)
+// PROFILE [RESET]     -> per task: priority, core, free stack, CPU; per section: calls, avg/max us, load over 1 s
+// PROFILE TRACE START [ms] -> record every profiled section for ms (default 1000) or 256 events
+// PROFILE TRACE       -> the recorded events as Chrome trace JSON, one event per line
+// TELEMETRY <ON|OFF>  -> binary event frames on this port, between the text lines (debug console, decode_telemetry.py)
+// TELEMETRY [RESET]   -> events emitted and dropped, frames and bytes sent, deepest queue
+// TELEMETRY CHECK [n] -> round-trip n random events (default 10000) through the queue and COBS framing
 // Any unknown command is ignored.
 void processSerialCommands() {
 #if !DEBUG_ENABLED
@@ -57,6 +133,519 @@ void processSerialCommands() {
             Serial.println("CLI: MODULE STOP RAGA");
           }
         }
+      } else if (cmd.startsWith("FECHO")) {
+        if (cmd.indexOf("BENCH") != -1) {
+          int rate = 100;
+          int seconds = 10;
+          sscanf(cmd.c_str(), "FECHO BENCH %d %d", &rate, &seconds);
+          startFractalEchoBench(static_cast<uint16_t>(constrain(rate, 1, 1000)),
+                                static_cast<uint16_t>(constrain(seconds, 1, 600)));
+        } else if (cmd.indexOf("RESET") != -1) {
+          resetFractalEchoStats();
+          Serial.println("CLI: FECHO RESET");
+        } else {
+          FractalEchoStats s = getFractalEchoStats();
+          Serial.printf("CLI: FECHO in=%u scheduled=%u sent=%u dropped=%u loops=%u queued=%u peak=%u\n",
+                        s.notesIn, s.echoesScheduled, s.echoesSent, s.dropped, s.loopsIgnored,
+                        s.queued, s.peakQueued);
+          Serial.printf("CLI: FECHO ingestMax=%uus latenessMax=%uus firstEcho last=%uus max=%uus\n",
+                        s.maxIngestUs, s.maxLatenessUs, s.lastFirstEchoUs, s.maxFirstEchoUs);
+        }
+      } else if (cmd.startsWith("GRIDS")) {
+        if (cmd.indexOf("BENCH") != -1) {
+          int iterations = 1000;
+          sscanf(cmd.c_str(), "GRIDS BENCH %d", &iterations);
+          GridsBenchResult r = runGridsBenchmark(static_cast<uint32_t>(constrain(iterations, 1, 100000)));
+          Serial.printf("CLI: GRIDS BENCH n=%u regenerate=%uus (%.2fus each) cached=%uus (%.2fus each) hits=%u misses=%u\n",
+                        r.iterations, r.regenerateUs, r.regenerateUs / (float)r.iterations, r.cachedUs,
+                        r.cachedUs / (float)r.iterations, r.cacheHits, r.cacheMisses);
+        } else {
+          int mismatches = checkGridsGoldenPatterns();
+          Serial.printf("CLI: GRIDS CHECK %s (%d mismatches)\n", mismatches == 0 ? "PASS" : "FAIL", mismatches);
+        }
+      } else if (cmd.startsWith("EUCLID")) {
+        if (cmd.indexOf("CHECK") != -1) {
+          EuclidCheckResult r = euclidRunExhaustiveCheck();
+          Serial.printf("CLI: EUCLID CHECK %s (%u patterns, %u failures)\n",
+                        r.failures == 0 ? "PASS" : "FAIL", r.checked, r.failures);
+        } else if (cmd.indexOf("BENCH") != -1) {
+          int iterations = 10000;
+          sscanf(cmd.c_str(), "EUCLID BENCH %d", &iterations);
+          EuclidBenchResult r = euclidRunBenchmark(static_cast<uint32_t>(constrain(iterations, 1, 1000000)));
+          Serial.printf("CLI: EUCLID BENCH n=%u bucket=%uus table=%uus\n", r.iterations, r.bucketUs, r.tableUs);
+        } else if (cmd.startsWith("EUCLID OP ")) {
+          int voice = 0;
+          int source = 0;
+          char opName[8] = {0};
+          if (sscanf(cmd.c_str(), "EUCLID OP %d %7s %d", &voice, opName, &source) >= 2) {
+            EuclidLogicOp op = EuclidLogicOp::NONE;
+            for (uint8_t i = 0; i < static_cast<uint8_t>(EuclidLogicOp::COUNT); ++i) {
+              if (strcmp(opName, euclidLogicOpName(static_cast<EuclidLogicOp>(i))) == 0) {
+                op = static_cast<EuclidLogicOp>(i);
+              }
+            }
+            setEuclideanVoiceLogic(voice - 1, op, source > 0 ? source - 1 : voice - 1);
+            Serial.printf("CLI: EUCLID OP V%d %s V%d\n", voice, euclidLogicOpName(op), source);
+          }
+        } else if (cmd.startsWith("EUCLID INV ")) {
+          int voice = 0;
+          int inverted = 1;
+          sscanf(cmd.c_str(), "EUCLID INV %d %d", &voice, &inverted);
+          setEuclideanVoiceInverted(voice - 1, inverted != 0);
+          Serial.printf("CLI: EUCLID INV V%d %d\n", voice, inverted != 0);
+        }
+      } else if (cmd.startsWith("RNG")) {
+        if (cmd.indexOf("BENCH") != -1) {
+          int iterations = 100000;
+          sscanf(cmd.c_str(), "RNG BENCH %d", &iterations);
+          RngBenchResult r = rngRunBenchmark(static_cast<uint32_t>(constrain(iterations, 1, 10000000)));
+          Serial.printf("CLI: RNG BENCH n=%u random=%uus service=%uus batch=%uus\n", r.iterations,
+                        r.arduinoUs, r.serviceUs, r.batchUs);
+        } else {
+          Serial.printf("CLI: RNG CHECK %s\n", rngRunReproducibilityCheck() ? "PASS" : "FAIL");
+        }
+      } else if (cmd.startsWith("SLOTS DRIFT")) {
+        SlotDriftResult r = measureSlotPerformerDrift();
+        if (!r.ran) {
+          Serial.println("CLI: SLOTS DRIFT unavailable (needs PLAY)");
+        } else {
+          Serial.printf("CLI: SLOTS DRIFT %s clock=%u slot=%u drift=%d steps=%u\n",
+                        r.drift == 0 ? "PASS" : "FAIL", r.clockTicks, r.slotTicks, r.drift, r.engineSteps);
+        }
+      } else if (cmd.startsWith("SLOTS DISPATCH")) {
+        int minutes = 10;
+        sscanf(cmd.c_str(), "SLOTS DISPATCH %d", &minutes);
+        SlotDispatchResult r = runSlotPerformerDispatchCheck(static_cast<uint32_t>(constrain(minutes, 1, 120)));
+        if (!r.ran) {
+          Serial.println("CLI: SLOTS DISPATCH unavailable (needs Slot Performer stopped and the clock idle)");
+        } else {
+          Serial.printf("CLI: SLOTS DISPATCH %s fed=%u processed=%u steps=%u expected=%u\n",
+                        r.processedTicks == r.fedTicks ? "PASS" : "FAIL", r.fedTicks, r.processedTicks,
+                        r.engineSteps, r.expectedEngineSteps);
+        }
+      } else if (cmd.startsWith("SLOTS BENCH")) {
+        int bars = 16;
+        sscanf(cmd.c_str(), "SLOTS BENCH %d", &bars);
+        SlotLooperBenchResult r = runSlotLooperBenchmark(static_cast<uint32_t>(constrain(bars, 1, 1000)));
+        Serial.printf("CLI: SLOTS BENCH bars=%u events=%u scan=%uus cursor=%uus played=%u\n", r.bars,
+                      r.events, r.scanUs, r.cursorUs, r.played);
+      } else if (cmd.startsWith("SCENE SAVE") || cmd.startsWith("SCENE LOAD")) {
+        bool save = cmd.startsWith("SCENE SAVE");
+        int scene = -1;
+        sscanf(cmd.c_str() + 10, "%d", &scene);
+        SceneResult result = SceneResult::BAD_ARGUMENT;
+        if (scene >= 0 && scene < kSceneCount) {
+          result = save ? sceneSave(static_cast<uint8_t>(scene)) : sceneLoad(static_cast<uint8_t>(scene));
+        }
+        if (!save && result == SceneResult::OK) {
+          switchMode(currentMode);  // Other modes pick up their sections when next opened
+        }
+        SceneStoreStats st = sceneGetStats();
+        Serial.printf("CLI: SCENE %s %d %s bytes=%u %s=%uus\n", save ? "SAVE" : "LOAD", scene,
+                      sceneResultName(result), st.blobBytes, save ? "snapshot" : "read",
+                      save ? st.snapshotUs : st.readUs);
+      } else if (cmd.startsWith("SCENE SWITCH")) {
+        int scene = -1;
+        sscanf(cmd.c_str(), "SCENE SWITCH %d", &scene);
+        SceneResult result = SceneResult::BAD_ARGUMENT;
+        if (scene >= 0 && scene < kSceneCount) {
+          result = sceneScheduleSwitch(static_cast<uint8_t>(scene));
+        }
+        Serial.printf("CLI: SCENE SWITCH %d %s prepare=%uus %s\n", scene, sceneResultName(result),
+                      sceneGetStats().switchPrepareUs, sceneSwitchPending() ? "armed" : "done");
+      } else if (cmd.startsWith("SCENE STATS")) {
+        SceneStoreStats st = sceneGetStats();
+        Serial.printf("CLI: SCENE STATS mounted=%d writing=%d scene=%d gen=%u bytes=%u snapshot=%uus "
+                      "write=%uus read=%uus last_write=%s\n",
+                      st.mounted, st.writing, st.lastScene == 0xFF ? -1 : st.lastScene, st.lastGeneration,
+                      st.blobBytes, st.snapshotUs, st.writeUs, st.readUs, sceneResultName(st.lastWriteResult));
+        Serial.printf("CLI: SCENE SWITCH scene=%d prepare=%uus wait=%uus commit=%uus note_offs=%u "
+                      "cancelled=%u%s\n",
+                      st.switchScene == 0xFF ? -1 : st.switchScene, st.switchPrepareUs, st.switchWaitUs,
+                      st.switchCommitUs, st.switchNoteOffs, st.switchesCancelled,
+                      sceneSwitchPending() ? " armed" : "");
+        SceneSectionStats section;
+        for (uint8_t i = 0; sceneGetSectionStats(i, section); ++i) {
+          Serial.printf("CLI: SCENE SECTION %-16s bytes=%u save=%uus load=%uus%s\n", section.name,
+                        section.bytes, section.saveUs, section.loadUs, section.pending ? " pending" : "");
+        }
+      } else if (cmd.startsWith("NOTES BURST")) {
+        int channels = 16;
+        int notes = 8;
+        sscanf(cmd.c_str(), "NOTES BURST %d %d", &channels, &notes);
+        ActiveNotesBurstResult r = activeNotesRunBurstCheck(static_cast<uint8_t>(constrain(channels, 1, 16)),
+                                                            static_cast<uint8_t>(constrain(notes, 1, 127)));
+        Serial.printf("CLI: NOTES BURST %s sounding=%u blind=%u/%uus hard=%u/%uus soft=%u/%uus\n",
+                      r.ok ? "PASS" : "FAIL", r.sounding, r.blindMessages, r.blindDinUs, r.hardMessages,
+                      r.hardDinUs, r.softMessages, r.softDinUs);
+      } else if (cmd.startsWith("NOTES")) {
+        String counts;
+        for (uint8_t channel = 0; channel < 16; ++channel) {
+          counts += ' ';
+          counts += activeNotesVoiceCount(channel);
+        }
+        Serial.printf("CLI: NOTES total=%u stuck=%u ch:%s\n", activeNotesTotal(), activeNotesStuckCount(),
+                      counts.c_str());
+      } else if (cmd.startsWith("RENDER FPS")) {
+        int fps = kRendererDefaultFps;
+        sscanf(cmd.c_str(), "RENDER FPS %d", &fps);
+        appRendererSetMaxFps(static_cast<uint8_t>(constrain(fps, 1, kRendererMaxFps)));
+        Serial.printf("CLI: RENDER FPS %u\n", appRendererGetMaxFps());
+      } else if (cmd.startsWith("RENDER")) {
+        if (cmd.indexOf("RESET") >= 0) {
+          appRendererResetStats();
+          Serial.println("CLI: RENDER STATS reset");
+        } else {
+          Serial.printf("CLI: RENDER STATS cap=%ufps current=%u\n", appRendererGetMaxFps(),
+                        static_cast<unsigned>(currentMode));
+          for (int mode = MENU; mode <= SLOT_PERFORMER; ++mode) {
+            RendererModeStats st = appRendererGetModeStats(static_cast<AppMode>(mode));
+            if (st.activeMs == 0) {
+              continue;
+            }
+            Serial.printf("CLI: RENDER mode=%d on=%ums fps=%.1f frames=%u render=%u/%uus dropped=%u coalesced=%u "
+                          "idle=%d%%\n",
+                          mode, st.activeMs, st.frames * 1000.0f / st.activeMs, st.frames,
+                          st.frames > 0 ? st.renderUs / st.frames : 0, st.maxRenderUs, st.dropped, st.coalesced,
+                          st.idlePercent);
+          }
+        }
+      } else if (cmd.startsWith("PROFILE TRACE START")) {
+        int ms = 1000;
+        sscanf(cmd.c_str(), "PROFILE TRACE START %d", &ms);
+        bool ok = profilerTraceStart(static_cast<uint32_t>(constrain(ms, 1, 60000)));
+        Serial.printf("CLI: PROF TRACE %s\n", ok ? "ARMED" : "FAILED no memory");
+      } else if (cmd.startsWith("PROFILE TRACE")) {
+        // Chrome trace events: pid is the core, tid indexes the task names
+        static constexpr size_t kMaxTraceTasks = 16;
+        char tasks[kMaxTraceTasks][kProfileTaskNameLen];
+        size_t taskCount = 0;
+        size_t count = profilerTraceCount();
+        Serial.printf("CLI: PROF TRACE BEGIN events=%u armed=%d\n", static_cast<unsigned>(count),
+                      profilerTraceArmed());
+        for (uint8_t core = 0; core < portNUM_PROCESSORS; ++core) {
+          Serial.printf("CLI: PROF TRACE {\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,"
+                        "\"args\":{\"name\":\"core %u\"}}\n",
+                        core, core);
+        }
+        for (size_t i = 0; i < count; ++i) {
+          ProfileTraceEvent event;
+          if (!profilerTraceEvent(i, event)) {
+            break;
+          }
+          size_t tid = 0;
+          while (tid < taskCount && strcmp(tasks[tid], event.task) != 0) {
+            ++tid;
+          }
+          if (tid == taskCount && taskCount < kMaxTraceTasks) {
+            memcpy(tasks[taskCount++], event.task, kProfileTaskNameLen);
+            for (uint8_t core = 0; core < portNUM_PROCESSORS; ++core) {
+              Serial.printf("CLI: PROF TRACE {\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,"
+                            "\"args\":{\"name\":\"%s\"}}\n",
+                            core, static_cast<unsigned>(tid), event.task);
+            }
+          }
+          Serial.printf("CLI: PROF TRACE {\"name\":\"%s\",\"ph\":\"X\",\"ts\":%u,\"dur\":%u,\"pid\":%u,"
+                        "\"tid\":%u}\n",
+                        profileSectionName(event.section), event.startUs, event.durationUs, event.core,
+                        static_cast<unsigned>(tid));
+        }
+        Serial.println("CLI: PROF TRACE END");
+      } else if (cmd.startsWith("PROFILE")) {
+        ProfileTaskStats tasks[kProfileMaxTasks];
+        size_t taskCount = profilerGetTasks(tasks, kProfileMaxTasks);
+        for (size_t i = 0; i < taskCount; ++i) {
+          const ProfileTaskStats &task = tasks[i];
+          String cpu = task.cpuPermille < 0 ? String("-") : String(task.cpuPermille / 10.0f, 1) + "%";
+          Serial.printf("CLI: PROF TASK %s prio=%u core=%d stack_free=%uB cpu=%s\n", task.name, task.priority,
+                        task.core, task.stackFree, cpu.c_str());
+        }
+        uint32_t windowUs = profilerWindowMs() * 1000;
+        for (uint8_t s = 0; s < static_cast<uint8_t>(ProfileSection::COUNT); ++s) {
+          ProfileSection section = static_cast<ProfileSection>(s);
+          ProfileSectionStats st = profilerGetSection(section);
+          Serial.printf("CLI: PROF SEC %s calls=%u avg=%uus max=%uus peak=%uus load=%.1f%% dropped=%u\n",
+                        profileSectionName(section), st.calls, st.calls > 0 ? st.totalUs / st.calls : 0, st.maxUs,
+                        st.peakMaxUs, windowUs > 0 ? st.totalUs * 100.0f / windowUs : 0.0f, st.dropped);
+        }
+        Serial.printf("CLI: PROF END window=%ums tasks=%u/%u runtime_stats=%d\n", profilerWindowMs(),
+                      static_cast<unsigned>(taskCount), static_cast<unsigned>(profilerTaskTotal()),
+                      profilerHasRunTimeStats());
+        if (cmd.indexOf("RESET") != -1) {
+          profilerResetStats();
+        }
+      } else if (cmd.startsWith("TELEMETRY ON") || cmd.startsWith("TELEMETRY OFF")) {
+        telemetrySetEnabled(cmd.startsWith("TELEMETRY ON"));
+        Serial.printf("CLI: TELEMETRY %s\n", telemetryEnabled() ? "ON" : "OFF");
+      } else if (cmd.startsWith("TELEMETRY CHECK")) {
+        int events = 10000;
+        sscanf(cmd.c_str(), "TELEMETRY CHECK %d", &events);
+        events = constrain(events, 1, 1000000);
+        uint32_t startMs = millis();
+        uint32_t failures = telemetrySelfTest(static_cast<uint32_t>(events));
+        Serial.printf("CLI: TELEMETRY CHECK %s events=%d failures=%u time=%ums\n", failures == 0 ? "PASS" : "FAIL",
+                      events, failures, millis() - startMs);
+      } else if (cmd.startsWith("TELEMETRY")) {
+        TelemetryStats st = telemetryGetStats();
+        Serial.printf("CLI: TELEMETRY STATS enabled=%d emitted=%u dropped=%u frames=%u bytes=%u max_depth=%u/%u\n",
+                      st.enabled, st.emitted, st.dropped, st.frames, st.bytes, st.maxDepth,
+                      static_cast<unsigned>(kTelemetryQueueSize));
+        if (cmd.indexOf("RESET") != -1) {
+          telemetryResetStats();
+        }
+      } else if (cmd.startsWith("CLOCK SIM")) {
+        int bpm = 120;
+        int drop = 0;
+        int beats = 64;
+        sscanf(cmd.c_str(), "CLOCK SIM %d %d %d", &bpm, &drop, &beats);
+        static const uint32_t kJitterSweepUs[] = {0, 250, 500, 1000, 2000, 4000};
+        for (uint32_t jitterUs : kJitterSweepUs) {
+          ClockFollowerSimResult r = clockFollowerRunSimulation(
+              static_cast<uint16_t>(constrain(bpm, 20, 300)), jitterUs, static_cast<uint8_t>(constrain(drop, 0, 50)),
+              static_cast<uint16_t>(constrain(beats, 4, 4000)), false);
+          Serial.printf("CLI: CLOCK SIM %s bpm=%d jitter=%uus in=%u/%uus out=%u/%uus phase=%uus lock=%u lost=%u "
+                        "tempo_err=%.3f\n",
+                        r.ok ? "PASS" : "FAIL", bpm, jitterUs, r.inJitterUs, r.inPeakUs, r.outJitterUs, r.outPeakUs,
+                        r.phasePeakUs, r.lockPulses, r.lostPulses, r.tempoErrorBpm);
+        }
+      } else if (cmd.startsWith("CLOCK CSV")) {
+        int bpm = 120;
+        int jitterUs = 1000;
+        int drop = 0;
+        sscanf(cmd.c_str(), "CLOCK CSV %d %d %d", &bpm, &jitterUs, &drop);
+        clockFollowerRunSimulation(static_cast<uint16_t>(constrain(bpm, 20, 300)),
+                                   static_cast<uint32_t>(constrain(jitterUs, 0, 100000)),
+                                   static_cast<uint8_t>(constrain(drop, 0, 50)), 8, true);
+      } else if (cmd.startsWith("CLOCK TRACE START")) {
+        int quarters = 16;
+        sscanf(cmd.c_str(), "CLOCK TRACE START %d", &quarters);
+        midiClockTraceStart(static_cast<uint16_t>(constrain(quarters, 1, 1000)));
+        Serial.printf("CLI: CLOCK TRACE armed quarters=%d\n", constrain(quarters, 1, 1000));
+      } else if (cmd.startsWith("CLOCK TRACE")) {
+        MidiClockTraceResult r = midiClockTraceResult();
+        const char *verdict = "IDLE";
+        if (r.running) {
+          verdict = "RUNNING";
+        } else if (r.target > 0) {
+          verdict = (r.quarters >= r.target && r.badQuarters == 0 && r.laneDrops == 0) ? "PASS" : "FAIL";
+        }
+        static const char *const kTransportNames[] = {"ble", "din", "espnow", "wifi"};
+        String counts;
+        for (uint8_t i = 0; i < static_cast<uint8_t>(MidiClockTransport::COUNT); ++i) {
+          counts += ' ';
+          counts += kTransportNames[i];
+          counts += '=';
+          counts += r.minPerQuarter[i];
+          counts += '-';
+          counts += r.maxPerQuarter[i];
+        }
+        Serial.printf("CLI: CLOCK TRACE %s quarters=%u/%u bad=%u clocks=%u latency=%u/%u/%uus jitter=%uus drops=%u%s\n",
+                      verdict, r.quarters, r.target, r.badQuarters, r.clocks, r.minLatencyUs, r.meanLatencyUs,
+                      r.maxLatencyUs, r.maxLatencyUs - r.minLatencyUs, r.laneDrops, counts.c_str());
+      } else if (cmd.startsWith("CLOCK")) {
+        ClockFollowerStatus st = clockManagerGetFollowerStatus();
+        Serial.printf("CLI: CLOCK STATS following=%d tracking=%d locked=%d tempo=%.2f out=%.2f jitter=%.0fus "
+                      "phase=%.0fus pulses=%u lost=%u\n",
+                      st.following, st.tracking, st.locked, st.tempoBpm, st.outputTempoBpm, st.jitterUs,
+                      st.phaseErrorUs, st.pulses, st.lostPulses);
+      } else if (cmd.startsWith("CC SIM")) {
+        int hz = 200;
+        int seconds = 20;
+        sscanf(cmd.c_str(), "CC SIM %d %d", &hz, &seconds);
+        MidiControlSimResult r = midiControlRunSimulation(static_cast<uint16_t>(constrain(hz, 1, 1000)),
+                                                          static_cast<uint16_t>(constrain(seconds, 1, 600)));
+        Serial.printf("CLI: CC SIM %s updates=%u requested=%uB bend_step_in=%u\n", r.ok ? "PASS" : "FAIL", r.updates,
+                      r.requestedBytes, r.inputMaxStep);
+        for (uint8_t d = 0; d < kMidiControlDestinations; ++d) {
+          uint32_t saved = r.requestedBytes > 0 ? 100 - r.sentBytes[d] * 100 / r.requestedBytes : 0;
+          Serial.printf("CLI: CC SIM %s rate=%uHz sent=%uB saved=%u%% bend_step=%u lag_max=%uus\n",
+                        kMidiOutPortNames[d], midiControlGetMaxRate(d), r.sentBytes[d], saved, r.maxStep[d],
+                        r.maxLagUs[d]);
+        }
+      } else if (cmd.startsWith("CC RATE")) {
+        char name[8] = {};
+        int hz = -1;
+        sscanf(cmd.c_str(), "CC RATE %7s %d", name, &hz);
+        for (uint8_t d = 0; d < kMidiControlDestinations; ++d) {
+          if (strcmp(name, kMidiOutPortNames[d]) == 0 && hz >= 0) {
+            midiControlSetMaxRate(d, static_cast<uint16_t>(constrain(hz, 0, 1000)));
+            Serial.printf("CLI: CC RATE %s %uHz\n", kMidiOutPortNames[d], midiControlGetMaxRate(d));
+          }
+        }
+      } else if (cmd.startsWith("CC STATS")) {
+        MidiControlStats st = midiControlGetStats();
+        Serial.printf("CLI: CC STATS updates=%u overflows=%u requested=%uB\n", st.updates, st.overflows,
+                      st.requestedBytes);
+        for (uint8_t d = 0; d < kMidiControlDestinations; ++d) {
+          Serial.printf("CLI: CC STATS %s rate=%uHz flushes=%u messages=%u sent=%uB\n", kMidiOutPortNames[d],
+                        midiControlGetMaxRate(d), st.flushes[d], st.sentMessages[d], st.sentBytes[d]);
+        }
+        if (cmd.indexOf("RESET") != -1) {
+          midiControlResetStats();
+        }
+      } else if (cmd.startsWith("LFO DRIFT")) {
+        int bars = 10000;
+        int bpm = 120;
+        int jitterUs = 250;
+        sscanf(cmd.c_str(), "LFO DRIFT %d %d %d", &bars, &bpm, &jitterUs);
+        Serial.println("CLI: LFO DRIFT running");
+        LfoDriftResult r = lfoRunDriftSimulation(static_cast<uint32_t>(constrain(bars, 1, 100000)),
+                                                 static_cast<uint16_t>(constrain(bpm, 20, 300)),
+                                                 static_cast<uint16_t>(constrain(jitterUs, 0, 5000)));
+        Serial.printf("CLI: LFO DRIFT %s bars=%u ticks=%u steps=%u bar_errors=%u reversals=%u tick_error=%.3f "
+                      "free_drift=%.5fdeg time=%ums\n",
+                      r.ok ? "PASS" : "FAIL", r.bars, r.ticks, r.steps, r.barStartErrors, r.reversals, r.maxTickError,
+                      r.freeDriftDeg, r.elapsedMs);
+      } else if (cmd.startsWith("LFO")) {
+        for (uint8_t i = 0; i < kLfoCount; ++i) {
+          LfoConfig c = lfoEngineGetConfig(i);
+          String rate = c.syncTicks > 0 ? String(c.syncTicks) + "ticks" : String(c.rateMilliHz / 1000.0f, 2) + "Hz";
+          String target = c.target == LfoTarget::PITCH_BEND ? String("bend") : "cc" + String(c.cc);
+          Serial.printf("CLI: LFO %u running=%d ch=%u target=%s wave=%u amount=%u rate=%s phase=%.3f out=%u\n", i,
+                        c.running, c.channel + 1, target.c_str(), static_cast<uint8_t>(c.waveform), c.amount,
+                        rate.c_str(), lfoEngineGetPhase(i) / 4294967296.0f, lfoEngineGetOutput(i));
+        }
+        LfoEngineStats st = lfoEngineGetStats();
+        Serial.printf("CLI: LFO STATS rate=%uHz steps=%u outputs=%u step_max=%uus gap_max=%uus\n", kLfoControlRateHz,
+                      st.steps, st.outputs, st.maxStepUs, st.maxGapUs);
+        if (cmd.indexOf("RESET") != -1) {
+          lfoEngineResetStats();
+        }
+      } else if (cmd.startsWith("RUNTIME BUDGET")) {
+        int us = static_cast<int>(clockRuntime.getBackgroundBudgetUs());
+        sscanf(cmd.c_str(), "RUNTIME BUDGET %d", &us);
+        clockRuntime.setBackgroundBudgetUs(static_cast<uint32_t>(constrain(us, 0, 20000)));
+        Serial.printf("CLI: RUNTIME BUDGET %uus\n", clockRuntime.getBackgroundBudgetUs());
+      } else if (cmd.startsWith("RUNTIME LOAD")) {
+        for (size_t i = 0; i < clockRuntime.getModuleCount(); ++i) {
+          ClockRuntime::ModuleLoad load;
+          if (!clockRuntime.getModuleLoad(static_cast<int>(i), load)) {
+            continue;
+          }
+          Serial.printf("CLI: RUNTIME SLOT %u %s%s us_per_tick=%.1f max=%uus steps=%u deferred=%u\n",
+                        static_cast<unsigned>(i), load.name, load.background ? " (bg)" : "",
+                        load.usPerTickX10 / 10.0f, load.maxUs, load.steps, load.deferred);
+        }
+        for (size_t i = 0; i < backgroundGeneratorCount(); ++i) {
+          BackgroundGenerator *generator = backgroundGenerator(i);
+          Serial.printf("CLI: RUNTIME GEN %s view=%d busy_skips=%u\n", generator->displayName(),
+                        generator->viewAttached(), generator->busySkips());
+        }
+        Serial.printf("CLI: RUNTIME LOAD background=%.1fus/tick budget=%uus state=%d\n",
+                      clockRuntime.getBackgroundUsPerTickX10() / 10.0f, clockRuntime.getBackgroundBudgetUs(),
+                      static_cast<int>(clockRuntime.getState()));
+        if (cmd.indexOf("RESET") != -1) {
+          clockRuntime.resetModuleLoad();
+        }
+      } else if (cmd.startsWith("MIDIQ SLOW")) {
+        char name[8] = {};
+        int ms = 0;
+        sscanf(cmd.c_str(), "MIDIQ SLOW %7s %d", name, &ms);
+        for (uint8_t i = 0; i < midiOutputQueueCount(); ++i) {
+          MidiTransportQueue *queue = midiOutputQueue(i);
+          String queueName = queue->name();
+          queueName.toUpperCase();
+          if (name[0] != '\0' && queueName.startsWith(name)) {
+            queue->setSendDelayMs(static_cast<uint16_t>(constrain(ms, 0, 1000)));
+            Serial.printf("CLI: MIDIQ SLOW %s %ums\n", queue->name(), queue->sendDelayMs());
+          }
+        }
+      } else if (cmd.startsWith("MIDIQ")) {
+        for (uint8_t i = 0; i < midiOutputQueueCount(); ++i) {
+          MidiTransportQueue *queue = midiOutputQueue(i);
+          MidiQueueStats st = queue->stats();
+          Serial.printf("CLI: MIDIQ %s depth=%u max=%u queued=%u sent=%u batches=%u coalesced=%u dropped=%u evicted=%u "
+                        "rt_drops=%u send_max=%uus slow=%ums\n",
+                        queue->name(), static_cast<unsigned>(queue->depth()), st.maxDepth, st.queued, st.sent,
+                        st.batches, st.coalesced, st.dropped, st.evicted, st.realtimeDrops, st.maxSendUs,
+                        queue->sendDelayMs());
+          if (cmd.indexOf("RESET") != -1) {
+            queue->resetStats();
+          }
+        }
+      } else if (cmd.startsWith("DIN SIM")) {
+        int bpm = 120;
+        int notes = 16;
+        int bars = 16;
+        sscanf(cmd.c_str(), "DIN SIM %d %d %d", &bpm, &notes, &bars);
+        DinJitterResult r = dinMidiRunJitterSimulation(static_cast<uint16_t>(constrain(bpm, 20, 300)),
+                                                       static_cast<uint8_t>(constrain(notes, 1, 64)),
+                                                       static_cast<uint16_t>(constrain(bars, 1, 1000)));
+        Serial.printf("CLI: DIN SIM %s clocks=%u old: bytes=%u max=%uus mean=%uus jitter=%uus "
+                      "paced: bytes=%u max=%uus mean=%uus jitter=%uus bound=%uus backlog=%uus\n",
+                      r.ok ? "PASS" : "FAIL", r.clocks, r.legacyBytes, r.legacyMaxUs, r.legacyMeanUs,
+                      r.legacyJitterUs, r.engineBytes, r.engineMaxUs, r.engineMeanUs, r.engineJitterUs, r.boundUs,
+                      r.maxBacklogUs);
+      } else if (cmd.startsWith("DIN")) {
+        DinMidiStats st = dinMidiGetStats();
+        Serial.printf("CLI: DIN STATS messages=%u bytes=%u rs_saved=%u realtime=%u rt_ahead_max=%u "
+                      "backlog_max=%uus warnings=%u drops=%u\n",
+                      st.messages, st.bytesWritten, st.runningStatusSaved, st.realtimeBytes, st.maxRealtimeAhead,
+                      st.maxBacklogUs, st.backlogWarnings, st.overflowDrops);
+        if (cmd.indexOf("RESET") != -1) {
+          dinMidiResetStats();
+        }
+      } else if (cmd.startsWith("ESPNOW SIM")) {
+        int loss = 5;
+        int reorder = 5;
+        int redundancy = 2;
+        int seconds = 60;
+        sscanf(cmd.c_str(), "ESPNOW SIM %d %d %d %d", &loss, &reorder, &redundancy, &seconds);
+        EspNowLoopbackResult r = espNowRunLoopbackSimulation(
+            static_cast<uint8_t>(constrain(loss, 0, 90)), static_cast<uint8_t>(constrain(reorder, 0, 90)),
+            static_cast<uint8_t>(constrain(redundancy, 0, kEspNowMaxRedundancy)),
+            static_cast<uint16_t>(constrain(seconds, 1, 600)));
+        Serial.printf("CLI: ESPNOW SIM %s messages=%u frames=%u dropped=%u delayed=%u lost=%u reordered=%u "
+                      "recovered=%u transport=%u/%u unrecoverable=%u clocks=%u/%u notes=%u/%u "
+                      "latency_mean=%uus latency_max=%uus\n",
+                      r.ok ? "PASS" : "FAIL", r.messages, r.frames, r.droppedFrames, r.delayedFrames,
+                      r.stats.lostFrames, r.stats.reordered, r.stats.recovered, r.transportDelivered, r.transportSent,
+                      r.transportUnrecoverable, r.clocksDelivered, r.clocksSent, r.notesDelivered, r.notesSent,
+                      r.meanLatencyUs, r.maxLatencyUs);
+#if ESP_NOW_ENABLED
+      } else if (cmd.startsWith("ESPNOW BATCH")) {
+        int redundancy = espNowState.redundancy;
+        sscanf(cmd.c_str(), "ESPNOW BATCH %*s %d", &redundancy);
+        setEspNowRedundancy(static_cast<uint8_t>(constrain(redundancy, 0, kEspNowMaxRedundancy)));
+        setEspNowBatching(cmd.indexOf("OFF") == -1);
+        Serial.printf("CLI: ESPNOW BATCH %s redundancy=%u\n", espNowState.batching ? "ON" : "OFF",
+                      espNowState.redundancy);
+      } else if (cmd.startsWith("ESPNOW")) {
+        Serial.printf("CLI: ESPNOW STATS batching=%d messages_sent=%u frames_sent=%u send_errors=%u received=%u\n",
+                      espNowState.batching, espNowState.messagesSent, espNowState.framesSent,
+                      espNowState.sendErrors, espNowState.messagesReceived);
+        uint8_t mac[6];
+        EspNowLinkStats st;
+        for (uint8_t i = 0; getEspNowLinkStats(i, mac, st); ++i) {
+          uint32_t meanUs = st.frames > 0 ? static_cast<uint32_t>(st.totalLatencyUs / st.frames) : 0;
+          Serial.printf("CLI: ESPNOW LINK %02X:%02X:%02X:%02X:%02X:%02X frames=%u messages=%u lost=%u "
+                        "reordered=%u dup=%u recovered=%u lost_clocks=%u resyncs=%u latency_mean=%uus "
+                        "latency_max=%uus\n",
+                        mac[0], mac[1], mac[2], mac[3], mac[4], mac[5], st.frames, st.messages, st.lostFrames,
+                        st.reordered, st.duplicates, st.recovered, st.lostClocks, st.resyncs, meanUs,
+                        st.maxLatencyUs);
+        }
+        if (cmd.indexOf("RESET") != -1) {
+          resetEspNowLinkStats();
+        }
+#endif
+      } else if (cmd.startsWith("MIDI RX MODE")) {
+        if (cmd.indexOf("LOOP") != -1) {
+          midiTransportSetRxMode(MidiRxMode::UI_LOOP);
+        } else if (cmd.indexOf("TASK") != -1) {
+          midiTransportSetRxMode(MidiRxMode::TASK);
+        }
+        midiTransportResetRxStats();
+        Serial.printf("CLI: MIDI RX MODE %s\n", midiTransportGetRxMode() == MidiRxMode::TASK ? "TASK" : "LOOP");
+      } else if (cmd.startsWith("MIDI RX")) {
+        MidiRxStats st = midiTransportGetRxStats();
+        uint32_t meanUs = st.events > 0 ? static_cast<uint32_t>(st.totalLatencyUs / st.events) : 0;
+        Serial.printf("CLI: MIDI RX STATS mode=%s events=%u mean=%uus max=%uus late=%u drops=%u queue_max=%u\n",
+                      midiTransportGetRxMode() == MidiRxMode::TASK ? "TASK" : "LOOP", st.events, meanUs,
+                      st.maxLatencyUs, st.lateEvents, st.drops, st.queueHighWater);
+        if (cmd.indexOf("RESET") != -1) {
+          midiTransportResetRxStats();
+        }
       } else {
         Serial.printf("CLI: unknown command '%s'\n", cmd.c_str());
       }
@@ -15,7 +15,6 @@ uint8_t midiPacket[] = {0x80, 0x80, 0, 0, 0};
 TouchState touch;
 AppMode currentMode = MENU;
 
-volatile bool needsRedraw = false;
 uint16_t sharedBPM = 120;
 MidiClockMaster midiClockMaster = CLOCK_INTERNAL;
 bool displayColorsInverted = false;
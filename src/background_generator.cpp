@@ -0,0 +1,70 @@
+#include "background_generator.h"
+#include "clock_runtime.h"
+
+#include <Arduino.h>
+
+namespace {
+static constexpr size_t kMaxBackgroundGenerators = 8;
+static BackgroundGenerator *generators[kMaxBackgroundGenerators];
+static size_t generatorCount = 0;
+} // namespace
+
+void BackgroundGenerator::onStep(const StepContext &ctx) {
+  (void)ctx;
+  if (mutex_ == nullptr || xSemaphoreTakeRecursive(mutex_, 0) != pdTRUE) {
+    busySkips_ = busySkips_ + 1;
+    return;
+  }
+  advance();
+  xSemaphoreGiveRecursive(mutex_);
+}
+
+void BackgroundGenerator::lock() {
+  if (mutex_) {
+    xSemaphoreTakeRecursive(mutex_, portMAX_DELAY);
+  }
+}
+
+void BackgroundGenerator::unlock() {
+  if (mutex_) {
+    xSemaphoreGiveRecursive(mutex_);
+  }
+}
+
+void registerBackgroundGenerator(BackgroundGenerator *generator) {
+  if (generator == nullptr || generatorCount >= kMaxBackgroundGenerators) {
+    return;
+  }
+  generators[generatorCount++] = generator;
+}
+
+void initBackgroundGenerators() {
+  for (size_t i = 0; i < generatorCount; ++i) {
+    BackgroundGenerator *generator = generators[i];
+    if (generator->mutex_ == nullptr) {
+      generator->mutex_ = xSemaphoreCreateRecursiveMutex();
+    }
+    if (clockRuntime.registerBackgroundModule(generator) < 0) {
+      Serial.printf("[Generators] '%s' not registered; it will not play\n",
+                    generator->displayName());
+    }
+  }
+}
+
+void backgroundGeneratorsShowView(AppMode mode) {
+  for (size_t i = 0; i < generatorCount; ++i) {
+    if (generators[i]->view() == mode) {
+      generators[i]->attachView();
+    } else {
+      generators[i]->detachView();
+    }
+  }
+}
+
+size_t backgroundGeneratorCount() {
+  return generatorCount;
+}
+
+BackgroundGenerator *backgroundGenerator(size_t index) {
+  return index < generatorCount ? generators[index] : nullptr;
+}
@@ -0,0 +1,257 @@
+#include "clock_follower.h"
+
+#include "rng_service.h"
+
+#include <Arduino.h>
+#include <math.h>
+
+namespace {
+static constexpr float kAlpha = 0.05f;       // Phase gain of the input filter
+static constexpr float kBeta = 0.0013f;      // Period gain, about alpha^2 / (2 - alpha): critically damped
+static constexpr float kPhaseGain = 1.0f / 24.0f;  // Local timer pulls out phase error over about a beat
+static constexpr float kMaxTrim = 0.05f;     // Local period stays within 5% of the estimate
+static constexpr float kJitterSmoothing = 1.0f / 16.0f;
+static constexpr float kMinPeriodUs = 60000000.0f / (300.0f * 24.0f);
+static constexpr float kMaxPeriodUs = 60000000.0f / (20.0f * 24.0f);
+static constexpr uint32_t kMaxInferredPulses = 96;  // Longer gaps restart the estimate
+static constexpr uint32_t kWarmupPulses = 24;  // Needs a longer gap to infer lost pulses until the period settles
+
+float clampf(float value, float low, float high) {
+  return value < low ? low : (value > high ? high : value);
+}
+
+float bpmFromPeriod(float periodUs) {
+  return periodUs > 0.0f ? 60000000.0f / (periodUs * 24.0f) : 0.0f;
+}
+}  // namespace
+
+void ClockFollower::reset() {
+  *this = ClockFollower();
+}
+
+float ClockFollower::tempoBpm() const {
+  return bpmFromPeriod(periodUs_);
+}
+
+float ClockFollower::outputTempoBpm() const {
+  return bpmFromPeriod(outPeriodUs_);
+}
+
+void ClockFollower::onPulse(uint32_t timestampUs, uint32_t outTicks, uint32_t outTickUs) {
+  if (stage_ == 0) {
+    stage_ = 1;
+    ++pulses_;
+    estUs_ = timestampUs;
+    estFracUs_ = 0.0f;
+    return;
+  }
+  if (stage_ == 1) {
+    periodUs_ = clampf(static_cast<float>(timestampUs - estUs_), kMinPeriodUs, kMaxPeriodUs);
+    outPeriodUs_ = periodUs_;
+    tracked_ = 2;
+    stage_ = 2;
+    ++pulses_;
+    estUs_ = timestampUs;
+    estFracUs_ = 0.0f;
+    return;
+  }
+
+  float sinceUs = static_cast<float>(static_cast<int32_t>(timestampUs - estUs_)) - estFracUs_;
+  uint32_t missing = 0;
+  float gapLimit = tracked_ >= kWarmupPulses ? 1.5f : 1.8f;
+  if (sinceUs > gapLimit * periodUs_) {
+    missing = static_cast<uint32_t>(sinceUs / periodUs_ + 0.5f) - 1;
+    if (missing > kMaxInferredPulses) {
+      // The source went quiet for bars; measure the period again from here
+      stage_ = 1;
+      lockCount_ = 0;
+      ++pulses_;
+      estUs_ = timestampUs;
+      estFracUs_ = 0.0f;
+      return;
+    }
+  }
+
+  // Growing-memory gains first (a least-squares fit over the pulses so far),
+  // settling to the fixed gains; a two-pulse period guess is too rough to
+  // start the fixed filter from under heavy jitter
+  float n = static_cast<float>(tracked_ < 1000 ? tracked_ + 1 : 1000);
+  float alpha = fmaxf(kAlpha, 2.0f * (2.0f * n - 1.0f) / (n * (n + 1.0f)));
+  float beta = fmaxf(kBeta, 6.0f / (n * (n + 1.0f)));
+
+  float predictedUs = static_cast<float>(missing + 1) * periodUs_;
+  float residual = clampf(sinceUs - predictedUs, -0.5f * periodUs_, 0.5f * periodUs_);
+  float stepUs = predictedUs + alpha * residual + estFracUs_;
+  uint32_t whole = static_cast<uint32_t>(floorf(stepUs));
+  estUs_ += whole;
+  estFracUs_ = stepUs - static_cast<float>(whole);
+  periodUs_ = clampf(periodUs_ + beta * residual / static_cast<float>(missing + 1), kMinPeriodUs,
+                     kMaxPeriodUs);
+  tracked_ += 1 + missing;
+  pulses_ += 1 + missing;
+  lostPulses_ += missing;
+
+  float magnitude = fabsf(residual);
+  jitterUs_ += (magnitude - jitterUs_) * kJitterSmoothing;
+  if (magnitude < periodUs_ * 0.3f) {
+    if (lockCount_ < kLockPulses) {
+      ++lockCount_;
+    }
+  } else if (magnitude >= periodUs_ * 0.45f) {
+    lockCount_ = 0;  // Near the clamp: probably a miscounted pulse
+  }
+
+  if (outTicks == 0) {
+    outPeriodUs_ = periodUs_;
+    phaseErrorUs_ = 0.0f;
+    return;
+  }
+  // Where the local timer puts tick number pulses_, relative to the filtered pulse
+  int32_t ticksAhead = static_cast<int32_t>(pulses_ - outTicks);
+  phaseErrorUs_ = static_cast<float>(static_cast<int32_t>(outTickUs - estUs_)) - estFracUs_ +
+                  static_cast<float>(ticksAhead) * outPeriodUs_;
+  float trim = clampf(kPhaseGain * phaseErrorUs_, -kMaxTrim * periodUs_, kMaxTrim * periodUs_);
+  outPeriodUs_ = periodUs_ - trim;
+}
+
+namespace {
+struct IntervalStats {
+  double sum = 0.0;
+  double sumSq = 0.0;
+  double peak = 0.0;
+  uint32_t count = 0;
+
+  void add(double intervalUs, double periodUs) {
+    double deviation = intervalUs - periodUs;
+    sum += deviation;
+    sumSq += deviation * deviation;
+    if (fabs(deviation) > peak) {
+      peak = fabs(deviation);
+    }
+    ++count;
+  }
+
+  uint32_t stddevUs() const {
+    if (count < 2) {
+      return 0;
+    }
+    double mean = sum / count;
+    double variance = sumSq / count - mean * mean;
+    return static_cast<uint32_t>(sqrt(variance > 0.0 ? variance : 0.0) + 0.5);
+  }
+};
+}  // namespace
+
+static constexpr uint32_t kSettleTicks = 96;
+
+ClockFollowerSimResult clockFollowerRunSimulation(uint16_t bpm, uint32_t jitterUs, uint8_t dropPercent,
+                                                  uint16_t beats, bool csv) {
+  ClockFollowerSimResult result = {};
+  bpm = constrain(bpm, 20, 300);
+  beats = constrain(beats, 4, 4000);
+  dropPercent = constrain(dropPercent, 0, 50);
+  const double periodUs = 60000000.0 / (bpm * 24.0);
+  if (jitterUs > periodUs * 0.45) {
+    jitterUs = static_cast<uint32_t>(periodUs * 0.45);  // Keep pulses in order
+  }
+
+  // Fixed seed so every run of the same arguments sees the same pulses
+  RngState rng = {{0x9E3779B9u, 0x243F6A88u, 0xB7E15162u, 0x6A09E667u}};
+  ClockFollower follower;
+  const uint32_t pulses = static_cast<uint32_t>(beats) * 24;
+  const double baseUs = 1000000.0;
+
+  // The local timer as the clock manager runs it: pulse-driven until the
+  // follower has a period, then free-running at outputPeriodUs(), limited to
+  // the flywheel lead and to at most one tick per half period
+  bool timerRunning = false;
+  double nextFireUs = 0.0;
+  uint32_t outTicks = 0;
+  double lastOutUs = 0.0;
+  uint32_t settledTick = 0;  // Output is measured from a bar after lock
+  double lastInUs = -1.0;
+  IntervalStats in;
+  IntervalStats out;
+  double phasePeak = 0.0;
+
+  auto emitTick = [&](double atUs) {
+    double interval = atUs - lastOutUs;
+    ++outTicks;
+    double phase = atUs - (baseUs + (outTicks - 1) * periodUs);
+    if (settledTick > 0 && outTicks > settledTick) {
+      out.add(interval, periodUs);
+      if (fabs(phase) > phasePeak) {
+        phasePeak = fabs(phase);
+      }
+    }
+    if (csv) {
+      Serial.printf("CLI: CLOCK CSV out,%u,%d,%d\n", outTicks, static_cast<int>(interval),
+                    static_cast<int>(phase));
+    }
+    lastOutUs = atUs;
+  };
+
+  if (csv) {
+    Serial.println("CLI: CLOCK CSV series,index,interval_us,offset_us");
+  }
+
+  for (uint32_t i = 1; i <= pulses; ++i) {
+    double idealUs = baseUs + (i - 1) * periodUs;
+    double jitter = jitterUs > 0 ? (static_cast<double>(rngNext(rng) % (2 * jitterUs + 1)) - jitterUs) : 0.0;
+    double atUs = idealUs + jitter;
+    bool dropped = i > 2 && (rngNext(rng) % 100) < dropPercent;
+
+    while (timerRunning && nextFireUs <= atUs) {
+      uint32_t limit = follower.pulses() + kClockFollowerFlywheelTicks;
+      if (outTicks < limit && nextFireUs - lastOutUs >= follower.outputPeriodUs() * 0.5) {
+        emitTick(nextFireUs);
+      }
+      nextFireUs += follower.outputPeriodUs();
+    }
+    if (dropped) {
+      lastInUs = -1.0;
+      continue;
+    }
+
+    if (lastInUs >= 0.0) {
+      in.add(atUs - lastInUs, periodUs);
+      if (csv) {
+        Serial.printf("CLI: CLOCK CSV in,%u,%d,%d\n", i, static_cast<int>(atUs - lastInUs),
+                      static_cast<int>(atUs - idealUs));
+      }
+    }
+    lastInUs = atUs;
+
+    uint32_t atWholeUs = static_cast<uint32_t>(atUs);
+    follower.onPulse(atWholeUs, outTicks, static_cast<uint32_t>(lastOutUs));
+    if (!timerRunning) {
+      while (outTicks < follower.pulses()) {
+        emitTick(atUs);
+      }
+      if (follower.hasEstimate()) {
+        timerRunning = true;
+        nextFireUs = atUs + follower.outputPeriodUs();
+      }
+    } else if (follower.pulses() >= outTicks + 2) {
+      while (outTicks < follower.pulses()) {  // More than a tick behind: catch up
+        emitTick(atUs);
+      }
+    }
+    if (settledTick == 0 && follower.locked()) {
+      settledTick = outTicks + kSettleTicks;
+      result.lockPulses = i;
+    }
+  }
+
+  result.pulses = pulses;
+  result.lostPulses = follower.lostPulses();
+  result.inJitterUs = in.stddevUs();
+  result.inPeakUs = static_cast<uint32_t>(in.peak + 0.5);
+  result.outJitterUs = out.stddevUs();
+  result.outPeakUs = static_cast<uint32_t>(out.peak + 0.5);
+  result.phasePeakUs = static_cast<uint32_t>(phasePeak + 0.5);
+  result.tempoErrorBpm = follower.tempoBpm() - bpm;
+  bool smoother = jitterUs == 0 ? result.outJitterUs <= 50 : result.outJitterUs < result.inJitterUs;
+  result.ok = follower.locked() && smoother && fabsf(result.tempoErrorBpm) < bpm * 0.001f;
+  return result;
+}
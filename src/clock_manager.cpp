@@ -1,9 +1,14 @@
 #include "clock_manager.h"
 #include <Arduino.h>
 
+#include "clock_follower.h"
 #include "common_definitions.h"
+#include "lfo_engine.h"
+#include "midi_out_buffer.h"
 #include "midi_utils.h"
 #include "clock_runtime.h"
+#include "profiler.h"
+#include "telemetry.h"
 
 #include <algorithm>
 #include <freertos/FreeRTOS.h>
@@ -30,6 +35,17 @@ static volatile bool uClockRunning = false;  // Track uClock running state
 static volatile bool tickCountersReset = false;  // Track when resetCounters() is called
 static volatile bool clockStarted = false;  // ISR flag for clock start
 static volatile bool clockStopped = false;  // ISR flag for clock stop
+// External clock following: uClock runs as the local timer at the follower's
+// output tempo; its ticks advance tickCount up to followerTickLimit.
+static ClockFollower follower;
+static uint32_t followerPulseBase = 0;  // tickCount when the follower was last reset
+static volatile bool followerTimer = false;
+static volatile uint32_t followerTickLimit = 0;
+static volatile uint32_t followerMinSpacingUs = 0;
+static volatile uint32_t lastOutTickUs = 0;
+// Last tick handed to midiOutBuffer as a clock pulse; every tickCount step is
+// sent exactly once, from where the tick happens (timer ISR or external pulse)
+static uint32_t emittedTick = 0;
 // Aggregated tick statistics (ISR-updated, main-loop printed)
 // (tick sampling moved to main-loop to avoid ISR work)
 static portMUX_TYPE clockManagerMux = portMUX_INITIALIZER_UNLOCKED;
@@ -41,18 +57,48 @@ static inline void unlockClockManager();
 static inline void lockClockManagerFromISR();
 static inline void unlockClockManagerFromISR();
 
+// Called with the lock held: claims the ticks tickCount advanced by since the
+// last call. A jump back (reset, Start) sends nothing.
+static inline uint32_t claimClockTicksLocked(uint32_t &first) {
+  if (tickCount < emittedTick) {
+    emittedTick = tickCount;
+  }
+  first = emittedTick + 1;
+  uint32_t count = tickCount - emittedTick;
+  emittedTick = tickCount;
+  return count;
+}
+
+static void emitClockTicks(uint32_t first, uint32_t count, uint32_t timestampUs) {
+  for (uint32_t i = 0; i < count; ++i) {
+    midiOutBuffer.clockTick(first + i, timestampUs);
+    lfoEngineClockTick(first + i, timestampUs);
+    telemetryEmit(TelemetryEventId::CLOCK_TICK, 0, 0, first + i, timestampUs);
+  }
+}
+
 // uClock callback function
 static void onClockTickCallback(uint32_t tick) {
   // Use the tick value provided by uClock to avoid double-counting
   // Minimal ISR: record tick and mark pending for main loop processing.
   lockClockManagerFromISR();
-  tickCount = tick;
-  tickPending = true;
+  if (followerTimer) {
+    // Following: count our own ticks, never more than the flywheel ahead of
+    // the last pulse, and skip a tick that lands right after a catch-up
+    uint32_t now = micros();
+    if (tickCount < followerTickLimit && now - lastOutTickUs >= followerMinSpacingUs) {
+      tickCount++;
+      lastOutTickUs = now;
+      tickPending = true;
+    }
+  } else {
+    tickCount = tick;
+    tickPending = true;
+  }
+  uint32_t first = 0;
+  uint32_t count = claimClockTicksLocked(first);
   unlockClockManagerFromISR();
-  
-  // Also notify ClockRuntime (pass tick from uClock)
-  // Note: ClockRuntime::processTick is designed to be ISR-safe for enqueueing
-  clockRuntime.processTick(tick);
+  emitClockTicks(first, count, micros());
 }
 
 static void onClockStartCallback() {
@@ -117,16 +163,20 @@ static RunningStateDelta updateRunningStateLocked() {
 
 static RunningStateDelta updateRunningState() {
   lockClockManager();
+  bool wasRunning = running;
   RunningStateDelta delta = updateRunningStateLocked();
   unlockClockManager();
+  if (delta.running != wasRunning) {
+    requestRedrawFor(REDRAW_TRANSPORT);  // Header run indicator
+  }
   if (delta.sendStart) {
     Serial.printf("[ClockManager] INTERNAL START – pending=%d active=%d\n", delta.pendingStarts,
                   delta.activeSequencers);
-    sendMIDIStart();
+    midiOutBuffer.midiStart();
   } else if (delta.sendStop) {
     Serial.printf("[ClockManager] INTERNAL STOP – pending=%d active=%d\n", delta.pendingStarts,
                   delta.activeSequencers);
-    sendMIDIStop();
+    midiOutBuffer.midiStop();
   }
   return delta;
 }
@@ -135,6 +185,7 @@ static RunningStateDelta updateRunningState() {
 void initClockManager() {
   lockClockManager();
   tickCount = 0;
+  emittedTick = 0;
   lastTickTime = 0;
   pendingStarts = 0;
   activeSequencers = 0;
@@ -193,17 +244,30 @@ void updateClockManager() {
     Serial.println("[uClock] Clock stopped");
   }
   
-  // Update uClock tempo if BPM has changed
-  uint16_t bpm = clampBpm(sharedBPM);
-  float currentTempo = uClock.getTempo();
-  if (fabsf(currentTempo - (float)bpm) > 0.1f) {
-    uClock.setTempo((float)bpm);
-  }
-  
   // Start or stop uClock based on running state.
   // Protect reading/writing of `uClockRunning` and calls to uClock
   // with the same clock manager lock to avoid TOCTOU races.
   if (midiClockMaster == CLOCK_INTERNAL) {
+    // Leaving external master: the follower no longer owns uClock
+    bool followerStop = false;
+    lockClockManager();
+    if (followerTimer) {
+      followerTimer = false;
+      uClockRunning = false;
+      followerStop = true;
+    }
+    unlockClockManager();
+    if (followerStop) {
+      uClock.stop();
+    }
+
+    // Update uClock tempo if BPM has changed
+    uint16_t bpm = clampBpm(sharedBPM);
+    float currentTempo = uClock.getTempo();
+    if (fabsf(currentTempo - (float)bpm) > 0.1f) {
+      uClock.setTempo((float)bpm);
+    }
+
     bool needStart = false;
     bool needStop = false;
     lockClockManager();
@@ -229,19 +293,49 @@ void updateClockManager() {
       uClock.stop();
     }
   } else {
-    // If master is external, ensure uClock is not left running (prevents
-    // internal uClock and external clock both advancing tick counters).
-    bool needStop = false;
+    // External master: uClock only runs as the follower's local timer, once
+    // the follower has a period. Until then pulses advance the tick directly.
     lockClockManager();
-    if (uClockRunning) {
+    bool wantTimer = running && follower.hasEstimate();
+    bool timerOn = followerTimer;
+    bool leftoverInternal = uClockRunning && !followerTimer;
+    float tempo = follower.outputTempoBpm();
+    bool locked = follower.locked();
+    float measured = follower.tempoBpm();
+    if (leftoverInternal) {
       uClockRunning = false;
-      needStop = true;
     }
     unlockClockManager();
-    if (needStop) {
+
+    if (leftoverInternal) {
+      // Never let the internal clock and the external pulses both advance ticks
       uClock.stop();
       Serial.println("[ClockManager] uClock stopped because master is not INTERNAL");
     }
+    if (wantTimer && !timerOn) {
+      uClock.setTempo(tempo);
+      lockClockManager();
+      followerTimer = true;
+      uClockRunning = true;
+      unlockClockManager();
+      uClock.start();
+      Serial.printf("[ClockManager] following external clock at %.2f BPM\n", measured);
+    } else if (!wantTimer && timerOn) {
+      lockClockManager();
+      followerTimer = false;
+      uClockRunning = false;
+      unlockClockManager();
+      uClock.stop();
+    } else if (timerOn && fabsf(uClock.getTempo() - tempo) > 0.001f) {
+      uClock.setTempo(tempo);
+    }
+    if (locked) {
+      uint16_t shown = static_cast<uint16_t>(measured + 0.5f);
+      if (shown != sharedBPM) {
+        sharedBPM = shown;  // Header shows the measured tempo while following
+        requestRedrawFor(REDRAW_TRANSPORT);
+      }
+    }
   }
   
   // Handle tick counter reset flag
@@ -297,10 +391,26 @@ void updateClockManager() {
       unlockClockManager();
     }
     
-    // If we processed a tick, send MIDI and request redraw, then continue loop
+    // If we processed a tick, run the modules and request redraw, then continue loop.
+    // The clock pulse for this tick already went to midiOutBuffer when the
+    // tick happened; ClockRuntime consumes the same tick numbers, so its
+    // modules cannot drift from the clock other gear follows.
     if (didProcessTick) {
-      sendMIDIClock();
-      requestRedraw();
+      uint32_t dispatchStartUs = micros();
+      {
+        ProfileScope scope(ProfileSection::CLOCK_DISPATCH);
+        clockRuntime.processTick(lastProcessedTick);
+      }
+      telemetryEmit(TelemetryEventId::CLOCK_DISPATCH, 0, static_cast<uint16_t>(lastProcessedTick),
+                    micros() - dispatchStartUs, dispatchStartUs);
+      uint8_t reasons = REDRAW_TICK;
+      if (clockManagerIsSixteenthTick(lastProcessedTick)) {
+        reasons |= REDRAW_STEP;
+      }
+      if (lastProcessedTick % CLOCK_TICKS_PER_QUARTER == 0) {
+        reasons |= REDRAW_BEAT;
+      }
+      requestRedrawFor(reasons);  // Modes redraw only on the reasons they show
     } else {
       break;
     }
@@ -380,6 +490,9 @@ void clockManagerExternalStart() {
   externalClockActive = true;
   tickCount = 0;
   lastTickTime = now;
+  follower.reset();
+  followerPulseBase = 0;
+  followerTickLimit = 0;
   unlockClockManager();
   Serial.println("[ClockManager] external Start");
   updateRunningState();
@@ -397,25 +510,51 @@ void clockManagerExternalContinue() {
   lockClockManager();
   // Continue should enable external clock without resetting tick counters
   externalClockActive = true;
+  follower.reset();
+  followerPulseBase = tickCount;
+  followerTickLimit = tickCount;
   unlockClockManager();
   Serial.println("[ClockManager] external Continue");
   updateRunningState();
 }
 
-void clockManagerExternalClock() {
+void clockManagerExternalClock(uint32_t timestampUs) {
   lockClockManager();
   if (!externalClockActive || midiClockMaster == CLOCK_INTERNAL) {
     unlockClockManager();
     return;
   }
-  tickCount++;
-  uint32_t currentTickCount = tickCount;
+  follower.onPulse(timestampUs, tickCount - followerPulseBase, lastOutTickUs);
+  uint32_t pulses = followerPulseBase + follower.pulses();
+  if (!followerTimer || pulses >= tickCount + 2) {
+    // Pulse-driven until the local timer runs, and catch-up when it is more
+    // than a tick behind (processed one by one in updateClockManager)
+    tickCount = pulses;
+    lastOutTickUs = timestampUs;
+  }
+  followerTickLimit = pulses + kClockFollowerFlywheelTicks;
+  followerMinSpacingUs = static_cast<uint32_t>(follower.outputPeriodUs() * 0.5f);
+  tickPending = true;
+  uint32_t first = 0;
+  uint32_t count = claimClockTicksLocked(first);
   unlockClockManager();
-  
-  // Notify ClockRuntime of external clock tick
-  clockRuntime.processTick(currentTickCount);
-  
-  requestRedraw();
+  emitClockTicks(first, count, timestampUs);
+}
+
+ClockFollowerStatus clockManagerGetFollowerStatus() {
+  ClockFollowerStatus status;
+  lockClockManager();
+  status.following = followerTimer;
+  status.tracking = follower.hasEstimate();
+  status.locked = follower.locked();
+  status.pulses = follower.pulses();
+  status.lostPulses = follower.lostPulses();
+  status.tempoBpm = follower.tempoBpm();
+  status.outputTempoBpm = follower.outputTempoBpm();
+  status.jitterUs = follower.jitterUs();
+  status.phaseErrorUs = follower.phaseErrorUs();
+  unlockClockManager();
+  return status;
 }
 
 uint32_t clockManagerGetTickCount() {
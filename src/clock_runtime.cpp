@@ -1,6 +1,7 @@
 #include "clock_runtime.h"
 #include "midi_out_buffer.h"
 #include "clock_manager.h"
+#include "telemetry.h"
 #include <Arduino.h>
 #include <algorithm>
 
@@ -8,12 +9,15 @@
 ClockRuntime clockRuntime;
 
 ClockRuntime::ClockRuntime()
-  : state_(TransportState::STOPPED), currentTick_(0), 
+  : state_(TransportState::STOPPED), currentTick_(0), dispatchedTick_(0), runStartTick_(0),
     startPendingAtTick_(0), stopPendingAtTick_(0),
     bpm_(120), swingPercent_(0),
     startQuantize_(QuantizeMode::NEXT_BAR),
     stopQuantize_(QuantizeMode::END_OF_BAR),
-    slotCount_(0), slotsMutex_(nullptr) {
+    barAction_(nullptr), barActionCancel_(nullptr), barActionArg_(nullptr), barActionPending_(false), startDeferred_(false),
+    slotCount_(0), slotsMutex_(nullptr),
+    backgroundBudgetUs_(kDefaultBackgroundBudgetUs), backgroundCursor_(0),
+    windowTicks_(0), backgroundWindowUs_(0), backgroundUsPerTickX10_(0) {
 }
 
 ClockRuntime::~ClockRuntime() {
@@ -84,6 +88,8 @@ void ClockRuntime::cancelStart() {
     Serial.println("[ClockRuntime] Cancel START");
     state_ = TransportState::STOPPED;
     startPendingAtTick_ = 0;
+    startDeferred_ = false;
+    cancelBarAction();
   }
 }
 
@@ -103,7 +109,7 @@ void ClockRuntime::reset() {
   // Reset all modules
   if (slotsMutex_ && xSemaphoreTake(slotsMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
     for (size_t i = 0; i < slotCount_; ++i) {
-      if (slots_[i].module != nullptr) {
+      if (slots_[i].module != nullptr && !slots_[i].background) {
         slots_[i].module->reset();
         slots_[i].stepIndex = 0;
         slots_[i].lastStepTick = 0;
@@ -112,8 +118,8 @@ void ClockRuntime::reset() {
     xSemaphoreGive(slotsMutex_);
   }
   
-  // Send panic
-  midiOutBuffer.panic();
+  // Release whatever is still sounding
+  midiOutBuffer.softPanic();
 }
 
 void ClockRuntime::requestTempo(uint16_t bpm) {
@@ -139,7 +145,78 @@ void ClockRuntime::setSwing(uint8_t percent) {
   }
 }
 
+void ClockRuntime::setModuleSwing(int slotId, uint8_t percent) {
+  if (slotId < 0 || slotId >= static_cast<int>(slotCount_)) {
+    return;
+  }
+  if (percent != kSwingFollowGlobal && percent > 50) percent = 50;
+  
+  if (callerHoldsSlots()) {
+    slots_[slotId].swing = percent;
+  } else if (slotsMutex_ && xSemaphoreTake(slotsMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
+    slots_[slotId].swing = percent;
+    xSemaphoreGive(slotsMutex_);
+  }
+}
+
+bool ClockRuntime::requestBarAction(BarAction action, void* arg, BarAction cancel) {
+  if (action == nullptr || barActionPending_) {
+    return false;
+  }
+  // Under the lock, so a stop either sees the action and cancels it or is seen here
+  bool held = callerHoldsSlots();
+  if (!held && (slotsMutex_ == nullptr || xSemaphoreTake(slotsMutex_, pdMS_TO_TICKS(10)) != pdTRUE)) {
+    return false;
+  }
+  bool armed = state_ != TransportState::STOPPED && !barActionPending_;
+  if (armed) {
+    barAction_ = action;
+    barActionCancel_ = cancel;
+    barActionArg_ = arg;
+    barActionPending_ = true;  // Published last; the clock task reads it first
+  }
+  if (!held) {
+    xSemaphoreGive(slotsMutex_);
+  }
+  return armed;
+}
+
+void ClockRuntime::cancelBarAction() {
+  if (!barActionPending_) {
+    return;
+  }
+  if (callerHoldsSlots()) {
+    dropBarActionLocked();
+  } else if (slotsMutex_ && xSemaphoreTake(slotsMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
+    dropBarActionLocked();
+    xSemaphoreGive(slotsMutex_);
+  }
+}
+
+// The action's bar will not come: run its cancel hook instead
+void ClockRuntime::dropBarActionLocked() {
+  if (barActionPending_) {
+    barActionPending_ = false;
+    if (barActionCancel_) {
+      barActionCancel_(barActionArg_);
+    }
+  }
+}
+
+// True inside a bar action, which runs on the clock task with the lock held
+bool ClockRuntime::callerHoldsSlots() const {
+  return slotsMutex_ != nullptr && xSemaphoreGetMutexHolder(slotsMutex_) == xTaskGetCurrentTaskHandle();
+}
+
 int ClockRuntime::registerModule(ClockedModule* module, uint8_t midiChannel) {
+  return addSlot(module, midiChannel, false);
+}
+
+int ClockRuntime::registerBackgroundModule(ClockedModule* module, uint8_t midiChannel) {
+  return addSlot(module, midiChannel, true);
+}
+
+int ClockRuntime::addSlot(ClockedModule* module, uint8_t midiChannel, bool background) {
   if (module == nullptr) {
     return -1;
   }
@@ -155,18 +232,16 @@ int ClockRuntime::registerModule(ClockedModule* module, uint8_t midiChannel) {
   }
   
   int slotId = static_cast<int>(slotCount_);
+  slots_[slotCount_] = Slot();
   slots_[slotCount_].module = module;
   slots_[slotCount_].midiChannel = midiChannel;
-  slots_[slotCount_].mute = false;
-  slots_[slotCount_].enabled = true;
-  slots_[slotCount_].lastStepTick = 0;
-  slots_[slotCount_].stepIndex = 0;
+  slots_[slotCount_].background = background;
   slotCount_++;
   
   xSemaphoreGive(slotsMutex_);
   
-  Serial.printf("[ClockRuntime] Registered module '%s' in slot %d (ch %d)\n",
-                module->displayName(), slotId, midiChannel);
+  Serial.printf("[ClockRuntime] Registered %smodule '%s' in slot %d (ch %d)\n",
+                background ? "background " : "", module->displayName(), slotId, midiChannel);
   
   // Initialize module
   module->init();
@@ -199,7 +274,9 @@ void ClockRuntime::setModuleMute(int slotId, bool mute) {
     return;
   }
   
-  if (slotsMutex_ && xSemaphoreTake(slotsMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
+  if (callerHoldsSlots()) {
+    slots_[slotId].mute = mute;
+  } else if (slotsMutex_ && xSemaphoreTake(slotsMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
     slots_[slotId].mute = mute;
     xSemaphoreGive(slotsMutex_);
   }
@@ -223,6 +300,34 @@ ClockedModule* ClockRuntime::getModule(int slotId) {
   return slots_[slotId].module;
 }
 
+bool ClockRuntime::getModuleLoad(int slotId, ModuleLoad& out) const {
+  if (slotId < 0 || slotId >= static_cast<int>(slotCount_)) {
+    return false;
+  }
+  const Slot& slot = slots_[slotId];
+  if (slot.module == nullptr) {
+    return false;
+  }
+  out.name = slot.module->displayName();
+  out.background = slot.background;
+  out.usPerTickX10 = slot.usPerTickX10;
+  out.maxUs = slot.maxUs;
+  out.steps = slot.steps;
+  out.deferred = slot.deferred;
+  return true;
+}
+
+void ClockRuntime::resetModuleLoad() {
+  if (slotsMutex_ && xSemaphoreTake(slotsMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
+    for (size_t i = 0; i < slotCount_; ++i) {
+      slots_[i].maxUs = 0;
+      slots_[i].steps = 0;
+      slots_[i].deferred = 0;
+    }
+    xSemaphoreGive(slotsMutex_);
+  }
+}
+
 void ClockRuntime::processTick(uint32_t tick) {
   // Auto-increment if tick is 0 (internal clock mode)
   if (tick == 0) {
@@ -231,15 +336,8 @@ void ClockRuntime::processTick(uint32_t tick) {
     currentTick_ = tick;
   }
   
-  // Send MIDI clock if running or pending
-  if (state_ == TransportState::RUNNING || 
-      state_ == TransportState::PENDING_START ||
-      state_ == TransportState::PENDING_STOP) {
-    midiOutBuffer.midiClock();
-  }
-  
-  // Check for pending start
-  if (state_ == TransportState::PENDING_START && shouldStartNow(currentTick_)) {
+  // Check for pending start; a start deferred by a busy lock retries at once
+  if (state_ == TransportState::PENDING_START && (startDeferred_ || shouldStartNow(currentTick_))) {
     transitionToRunning();
   }
   
@@ -248,51 +346,55 @@ void ClockRuntime::processTick(uint32_t tick) {
     transitionToStopped();
   }
   
-  // Dispatch steps to modules if running
-  if (state_ == TransportState::RUNNING) {
-    dispatchStepToModules(currentTick_);
-  }
+  // Transport modules step only while running; background modules always
+  dispatchStepToModules(currentTick_);
   
   // Update scheduled note-offs
   midiOutBuffer.updateScheduledNotes(currentTick_);
 }
 
 void ClockRuntime::transitionToRunning() {
+  // Every module must see the start: with the lock busy, stay pending and
+  // retry on the next tick rather than run without onTransportStart()
+  if (slotsMutex_ == nullptr || xSemaphoreTake(slotsMutex_, pdMS_TO_TICKS(10)) != pdTRUE) {
+    if (!startDeferred_) {
+      Serial.printf("[ClockRuntime] Start deferred at tick %u: module lock busy\n", currentTick_);
+    }
+    startDeferred_ = true;
+    return;
+  }
+  startDeferred_ = false;
+  
   Serial.printf("[ClockRuntime] Transport -> RUNNING (tick %u)\n", currentTick_);
+  telemetryEmit(TelemetryEventId::TRANSPORT, 1, 0, currentTick_);
   
   state_ = TransportState::RUNNING;
-  
-  // Send MIDI Start
-  sendTransportMessage(state_);
+  dispatchedTick_ = currentTick_ - 1;  // The start tick itself is dispatched
+  runStartTick_ = currentTick_;
   
   // Notify modules
-  if (slotsMutex_ && xSemaphoreTake(slotsMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
-    for (size_t i = 0; i < slotCount_; ++i) {
-      if (slots_[i].module != nullptr && slots_[i].enabled) {
-        slots_[i].module->onTransportStart();
-        slots_[i].lastStepTick = currentTick_;
-        slots_[i].stepIndex = 0;
-      }
+  for (size_t i = 0; i < slotCount_; ++i) {
+    if (slots_[i].module != nullptr && slots_[i].enabled && !slots_[i].background) {
+      slots_[i].module->onTransportStart();
+      slots_[i].lastStepTick = currentTick_;
+      slots_[i].stepIndex = 0;
     }
-    xSemaphoreGive(slotsMutex_);
   }
+  xSemaphoreGive(slotsMutex_);
 }
 
 void ClockRuntime::transitionToStopped() {
   Serial.printf("[ClockRuntime] Transport -> STOPPED (tick %u)\n", currentTick_);
+  telemetryEmit(TelemetryEventId::TRANSPORT, 0, 0, currentTick_);
   
-  TransportState oldState = state_;
   state_ = TransportState::STOPPED;
+  startDeferred_ = false;
   
-  // Send MIDI Stop (only if we were running)
-  if (oldState == TransportState::RUNNING || oldState == TransportState::PENDING_STOP) {
-    sendTransportMessage(state_);
-  }
-  
-  // Notify modules
+  // Notify modules; a bar action still waiting for its bar is cancelled
   if (slotsMutex_ && xSemaphoreTake(slotsMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
+    dropBarActionLocked();
     for (size_t i = 0; i < slotCount_; ++i) {
-      if (slots_[i].module != nullptr) {
+      if (slots_[i].module != nullptr && !slots_[i].background) {
         slots_[i].module->onTransportStop();
       }
     }
@@ -300,7 +402,7 @@ void ClockRuntime::transitionToStopped() {
   }
   
   // All notes off
-  midiOutBuffer.panic();
+  midiOutBuffer.softPanic();
 }
 
 bool ClockRuntime::shouldStartNow(uint32_t tick) {
@@ -345,65 +447,131 @@ bool ClockRuntime::shouldStopNow(uint32_t tick) {
 
 void ClockRuntime::dispatchStepToModules(uint32_t tick) {
   if (slotsMutex_ == nullptr || xSemaphoreTake(slotsMutex_, 0) != pdTRUE) {
-    return;  // Skip if can't acquire lock immediately
+    return;  // Lock busy: this tick is replayed on the next one
   }
   
-  for (size_t i = 0; i < slotCount_; ++i) {
-    Slot& slot = slots_[i];
+  // Replay any ticks skipped while the lock was busy so modules never drift
+  // from the clock; a jump larger than a bar is a reset, not a miss
+  uint32_t first = tick;
+  uint32_t behind = tick - dispatchedTick_;
+  if (behind > 1 && behind <= kMaxCatchUpTicks) {
+    first = dispatchedTick_ + 1;
+  }
+  bool running = state_ == TransportState::RUNNING;
+  for (uint32_t t = first; t != tick + 1; ++t) {
+    dispatchTickLocked(t, running);
+  }
+  dispatchedTick_ = tick;
+  
+  xSemaphoreGive(slotsMutex_);
+}
+
+void ClockRuntime::dispatchTickLocked(uint32_t tick, bool running) {
+  if (running) {
+    if (barActionPending_ && ((tick - runStartTick_) % getTicksPerBar()) == 0) {
+      barActionPending_ = false;
+      barAction_(barActionArg_);
+    }
     
-    if (slot.module == nullptr || !slot.enabled) {
+    for (size_t i = 0; i < slotCount_; ++i) {
+      Slot& slot = slots_[i];
+      if (slot.module == nullptr || !slot.enabled || slot.background) {
+        continue;
+      }
+      if (stepSlotLocked(slot, tick)) {
+        slot.lastStepTick = tick;
+      }
+    }
+  }
+  
+  dispatchBackgroundLocked(tick);
+  
+  if (++windowTicks_ >= kLoadWindowTicks) {
+    publishLoadLocked();
+  }
+}
+
+void ClockRuntime::dispatchBackgroundLocked(uint32_t tick) {
+  if (slotCount_ == 0) {
+    return;
+  }
+  
+  // The first turn moves to the next background module every tick, so a
+  // deferral does not always land on the same one
+  uint32_t startUs = micros();
+  size_t first = backgroundCursor_ % slotCount_;
+  size_t nextFirst = first;
+  bool visited = false;
+  for (size_t n = 0; n < slotCount_; ++n) {
+    size_t index = (first + n) % slotCount_;
+    Slot& slot = slots_[index];
+    if (slot.module == nullptr || !slot.enabled || !slot.background) {
       continue;
     }
-    
-    uint16_t ticksPerStep = slot.module->ticksPerStep();
-    
-    // Check if we're at a step boundary for this module
-    if (!isStepBoundary(tick, ticksPerStep)) {
+    if (!visited) {
+      visited = true;
+    } else if (nextFirst == first) {
+      nextFirst = index;
+    }
+    if (micros() - startUs >= backgroundBudgetUs_) {
+      slot.deferred++;
       continue;
     }
-    
-    // Build step context
-    StepContext ctx;
-    ctx.tick = tick;
-    ctx.bpm_x10 = bpm_ * 10;
-    ctx.ppqn = kPPQN;
-    ctx.barIndex = tick / getTicksPerBar();
-    ctx.tickInBar = tick % getTicksPerBar();
-    ctx.stepIndex = slot.stepIndex++;
-    ctx.ticksPerStep = ticksPerStep;
-    ctx.stepInBar = static_cast<uint16_t>(ctx.tickInBar / ticksPerStep);
-    ctx.isBarStart = isBarStart(tick);
-    
-    // Call module (skip MIDI output if muted)
-    if (!slot.mute) {
-      slot.module->onStep(ctx);
-    } else if (slot.module->advanceWhileMuted()) {
-      // Module advances playhead even when muted
-      // (call with context but module knows it's muted)
-      slot.module->onStep(ctx);
+    uint32_t before = slot.windowUs;
+    if (stepSlotLocked(slot, tick)) {
+      slot.lastStepTick = tick;
     }
-    
-    slot.lastStepTick = tick;
+    backgroundWindowUs_ += slot.windowUs - before;
   }
-  
-  xSemaphoreGive(slotsMutex_);
+  backgroundCursor_ = nextFirst;
 }
 
-void ClockRuntime::sendTransportMessage(TransportState newState) {
-  switch (newState) {
-    case TransportState::RUNNING:
-      midiOutBuffer.midiStart();
-      Serial.println("[ClockRuntime] MIDI START sent");
-      break;
-      
-    case TransportState::STOPPED:
-      midiOutBuffer.midiStop();
-      Serial.println("[ClockRuntime] MIDI STOP sent");
-      break;
-      
-    default:
-      break;
+bool ClockRuntime::stepSlotLocked(Slot& slot, uint32_t tick) {
+  uint16_t ticksPerStep = slot.module->ticksPerStep();
+  uint8_t swing = (slot.swing == kSwingFollowGlobal) ? swingPercent_ : slot.swing;
+  
+  // Check if a (possibly swung) step of this module falls on this tick
+  uint32_t stepTick = 0;
+  if (!stepDueAt(tick, ticksPerStep, swing, stepTick)) {
+    return false;
+  }
+  
+  // Build step context from the unswung grid position
+  StepContext ctx;
+  ctx.tick = tick;
+  ctx.bpm_x10 = bpm_ * 10;
+  ctx.ppqn = kPPQN;
+  ctx.barIndex = stepTick / getTicksPerBar();
+  ctx.tickInBar = stepTick % getTicksPerBar();
+  ctx.stepIndex = slot.stepIndex++;
+  ctx.ticksPerStep = ticksPerStep;
+  ctx.stepInBar = static_cast<uint16_t>(ctx.tickInBar / ticksPerStep);
+  ctx.isBarStart = isBarStart(stepTick);
+  ctx.muted = slot.mute;
+  
+  // Muted modules only advance if they ask to (and see ctx.muted)
+  if (!slot.mute || slot.module->advanceWhileMuted()) {
+    uint32_t startUs = micros();
+    slot.module->onStep(ctx);
+    uint32_t elapsedUs = micros() - startUs;
+    slot.windowUs += elapsedUs;
+    slot.steps++;
+    if (elapsedUs > slot.maxUs) {
+      slot.maxUs = elapsedUs;
+    }
+  }
+  return true;
+}
+
+// Per-tick means over the last window, so the Settings table reads steady values
+void ClockRuntime::publishLoadLocked() {
+  for (size_t i = 0; i < slotCount_; ++i) {
+    slots_[i].usPerTickX10 = (slots_[i].windowUs * 10) / windowTicks_;
+    slots_[i].windowUs = 0;
   }
+  backgroundUsPerTickX10_ = (backgroundWindowUs_ * 10) / windowTicks_;
+  backgroundWindowUs_ = 0;
+  windowTicks_ = 0;
 }
 
 uint32_t ClockRuntime::getTicksPerBar() const {
@@ -420,9 +588,16 @@ bool ClockRuntime::isStepBoundary(uint32_t tick, uint16_t ticksPerStep) const {
   return (tick % ticksPerStep) == 0;
 }
 
-uint32_t ClockRuntime::applySwing(uint32_t tick, uint16_t ticksPerStep) const {
-  // TODO: Implement swing timing
-  // For now, return unmodified
-  (void)ticksPerStep;
-  return tick;
+bool ClockRuntime::stepDueAt(uint32_t tick, uint16_t ticksPerStep, uint8_t swing,
+                             uint32_t &stepTick) const {
+  if (ticksPerStep == 0) return false;
+  // Odd steps land late by a fraction of a step; even steps stay on the grid
+  uint32_t offset = (static_cast<uint32_t>(ticksPerStep) * swing) / 100;
+  uint32_t gridTick = tick - (tick % ticksPerStep);
+  bool oddStep = ((gridTick / ticksPerStep) & 1U) != 0;
+  if (tick - gridTick != (oddStep ? offset : 0)) {
+    return false;
+  }
+  stepTick = gridTick;
+  return true;
 }
@@ -0,0 +1,362 @@
+#include "din_midi_out.h"
+
+#include "hardware_midi.h"
+#include "midi_out_buffer.h"
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+namespace {
+static constexpr const char *kTaskName = "DinMidiOut";
+static constexpr UBaseType_t kTaskPriority = configMAX_PRIORITIES - 1;
+static constexpr uint16_t kStackDepth = 2048;
+static constexpr TickType_t kPumpDelay = pdMS_TO_TICKS(1);
+static constexpr uint32_t kPumpPeriodUs = 1000;
+
+static constexpr size_t kUartFifoBytes = 128;  // ESP32 UART TX FIFO; the driver runs without a TX ring
+// Enough to keep the wire busy across one pump period (4 x 320 us > 1 ms),
+// and the most a realtime byte waits behind
+static constexpr size_t kFifoLeadBytes = 4;
+static constexpr uint32_t kRunningStatusIdleMs = 1000;  // Resend status after a quiet spell
+static constexpr uint32_t kWarnIntervalMs = 1000;
+
+uint8_t messageLength(uint8_t status, uint8_t fallback) {
+  switch (status & 0xF0) {
+    case 0xC0:  // Program change
+    case 0xD0:  // Channel pressure
+      return 2;
+    case 0xF0:
+      return fallback;
+    default:
+      return 3;
+  }
+}
+
+// Byte ring with running-status encoding; no locking, no I/O, so the jitter
+// simulation drives the same code as the UART
+class DinScheduler {
+public:
+  static constexpr size_t kRingBytes = 512;
+
+  bool push(uint8_t status, uint8_t data1, uint8_t data2, uint8_t length) {
+    if ((status & 0xF0) == 0x80 && length == 3 && data2 == 0) {
+      status = static_cast<uint8_t>(0x90 | (status & 0x0F));  // Same meaning, shares the note-on status
+    }
+    bool sendStatus = status >= 0xF0 || status != runningStatus_;
+    size_t needed = sendStatus ? length : static_cast<size_t>(length - 1);
+    if (kRingBytes - count_ < needed) {
+      return false;
+    }
+    if (sendStatus) {
+      put(status);
+    } else {
+      ++runningStatusSaved;
+    }
+    runningStatus_ = status < 0xF0 ? status : 0;  // System common cancels running status
+    if (length > 1) {
+      put(data1);
+    }
+    if (length > 2) {
+      put(data2);
+    }
+    return true;
+  }
+
+  bool pop(uint8_t &byte) {
+    if (count_ == 0) {
+      return false;
+    }
+    byte = ring_[tail_];
+    tail_ = (tail_ + 1) % kRingBytes;
+    --count_;
+    return true;
+  }
+
+  void forgetRunningStatus() { runningStatus_ = 0; }
+  size_t size() const { return count_; }
+
+  uint32_t runningStatusSaved = 0;
+
+private:
+  void put(uint8_t byte) {
+    ring_[(tail_ + count_) % kRingBytes] = byte;
+    ++count_;
+  }
+
+  uint8_t ring_[kRingBytes];
+  size_t tail_ = 0;
+  size_t count_ = 0;
+  uint8_t runningStatus_ = 0;
+};
+
+DinScheduler scheduler;
+SemaphoreHandle_t mutex = nullptr;
+TaskHandle_t pumpTask = nullptr;
+DinMidiStats stats = {};
+uint32_t lastSendMs = 0;
+uint32_t lastWarnMs = 0;
+
+size_t fifoQueued() {
+  int free = MIDI_SERIAL.availableForWrite();
+  if (free < 0) {
+    free = 0;
+  }
+  return static_cast<size_t>(free) >= kUartFifoBytes ? 0 : kUartFifoBytes - static_cast<size_t>(free);
+}
+
+// Caller holds the mutex; returns the backlog in bytes (ring plus FIFO)
+size_t pumpLocked() {
+  size_t queued = fifoQueued();
+  uint8_t byte;
+  while (queued < kFifoLeadBytes && scheduler.pop(byte)) {
+    MIDI_SERIAL.write(byte);
+    ++queued;
+    ++stats.bytesWritten;
+  }
+  return scheduler.size() + queued;
+}
+
+void dinPumpTask(void * /*unused*/) {
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    bool pending = true;
+    while (pending) {
+      xSemaphoreTake(mutex, portMAX_DELAY);
+      pumpLocked();
+      pending = scheduler.size() > 0;
+      xSemaphoreGive(mutex);
+      if (pending) {
+        vTaskDelay(kPumpDelay);
+      }
+    }
+  }
+}
+}  // namespace
+
+void initDinMidiOut() {
+  if (mutex != nullptr) {
+    return;
+  }
+  mutex = xSemaphoreCreateMutex();
+  if (mutex == nullptr) {
+    Serial.println("[DIN] Failed to create mutex, writing unpaced");
+    return;
+  }
+  BaseType_t result = xTaskCreatePinnedToCore(dinPumpTask, kTaskName, kStackDepth, nullptr,
+                                              kTaskPriority, &pumpTask, 1);
+  if (result != pdPASS) {
+    Serial.println("[DIN] Failed to create pump task");
+    pumpTask = nullptr;
+  }
+}
+
+void dinMidiSend(uint8_t status, uint8_t data1, uint8_t data2, uint8_t length) {
+  if (status >= 0xF8) {
+    dinMidiSendRealtime(status);
+    return;
+  }
+  length = messageLength(status, length);
+  if (mutex == nullptr || pumpTask == nullptr) {
+    MIDI_SERIAL.write(status);
+    if (length > 1) MIDI_SERIAL.write(data1);
+    if (length > 2) MIDI_SERIAL.write(data2);
+    return;
+  }
+
+  uint32_t now = millis();
+  bool warn = false;
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  if (now - lastSendMs > kRunningStatusIdleMs) {
+    scheduler.forgetRunningStatus();
+  }
+  lastSendMs = now;
+  ++stats.messages;
+  if (!scheduler.push(status, data1, data2, length)) {
+    ++stats.overflowDrops;
+  }
+  stats.runningStatusSaved = scheduler.runningStatusSaved;
+  uint32_t backlogUs = static_cast<uint32_t>(pumpLocked()) * kDinByteUs;
+  if (backlogUs > stats.maxBacklogUs) {
+    stats.maxBacklogUs = backlogUs;
+  }
+  if (backlogUs > kDinBacklogWarnUs) {
+    ++stats.backlogWarnings;
+    warn = now - lastWarnMs >= kWarnIntervalMs;
+    if (warn) {
+      lastWarnMs = now;
+    }
+  }
+  bool pending = scheduler.size() > 0;
+  xSemaphoreGive(mutex);
+
+  if (pending) {
+    xTaskNotifyGive(pumpTask);
+  }
+  if (warn) {
+    Serial.printf("[DIN] Backlog %u us on the wire (%u drops so far)\n", backlogUs, stats.overflowDrops);
+  }
+}
+
+void dinMidiSendRealtime(uint8_t message) {
+  if (message == 0xF8) {
+    midiClockTraceCount(MidiClockTransport::DIN);
+  }
+  if (mutex == nullptr) {
+    MIDI_SERIAL.write(message);
+    return;
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  size_t ahead = fifoQueued();
+  if (ahead > stats.maxRealtimeAhead) {
+    stats.maxRealtimeAhead = static_cast<uint8_t>(ahead > 255 ? 255 : ahead);
+  }
+  MIDI_SERIAL.write(message);
+  ++stats.realtimeBytes;
+  xSemaphoreGive(mutex);
+}
+
+DinMidiStats dinMidiGetStats() {
+  if (mutex == nullptr) {
+    return stats;
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  DinMidiStats copy = stats;
+  xSemaphoreGive(mutex);
+  return copy;
+}
+
+void dinMidiResetStats() {
+  if (mutex != nullptr) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+  }
+  stats = {};
+  scheduler.runningStatusSaved = 0;
+  if (mutex != nullptr) {
+    xSemaphoreGive(mutex);
+  }
+}
+
+namespace {
+struct DelayStats {
+  uint32_t maxUs = 0;
+  uint32_t minUs = UINT32_MAX;
+  uint64_t sumUs = 0;
+
+  void add(uint32_t us) {
+    if (us > maxUs) maxUs = us;
+    if (us < minUs) minUs = us;
+    sumUs += us;
+  }
+};
+
+// A byte written at nowUs leaves the wire at the returned time
+uint64_t wireWrite(uint64_t &busyUntilUs, uint64_t nowUs) {
+  busyUntilUs = (busyUntilUs > nowUs ? busyUntilUs : nowUs) + kDinByteUs;
+  return busyUntilUs;
+}
+
+size_t wireQueued(uint64_t busyUntilUs, uint64_t nowUs) {
+  return busyUntilUs > nowUs ? static_cast<size_t>((busyUntilUs - nowUs + kDinByteUs - 1) / kDinByteUs) : 0;
+}
+
+void simPump(DinScheduler &sched, uint64_t &busyUntilUs, uint64_t nowUs, uint32_t &bytes) {
+  size_t queued = wireQueued(busyUntilUs, nowUs);
+  uint8_t byte;
+  while (queued < kFifoLeadBytes && sched.pop(byte)) {
+    wireWrite(busyUntilUs, nowUs);
+    ++queued;
+    ++bytes;
+  }
+}
+}  // namespace
+
+DinJitterResult dinMidiRunJitterSimulation(uint16_t bpm, uint8_t chordNotes, uint16_t bars) {
+  DinJitterResult result = {};
+  bpm = constrain(bpm, 20, 300);
+  chordNotes = constrain(chordNotes, 1, 64);
+  bars = constrain(bars, 1, 1000);
+
+  // The scheduler is half a kilobyte; keep it off the caller's stack
+  static DinScheduler simScheduler;
+  simScheduler = DinScheduler();
+  DinScheduler *sched = &simScheduler;
+
+  const uint64_t tickPeriodNum = 60000000ull;  // Tick n starts at n * 60e6 / (bpm * 24) us
+  const uint32_t tickPeriodDen = static_cast<uint32_t>(bpm) * 24;
+  const uint32_t ticks = static_cast<uint32_t>(bars) * 96;
+  uint64_t legacyBusy = 0;
+  uint64_t engineBusy = 0;
+  uint64_t nextPumpUs = 0;
+  DelayStats legacy;
+  DelayStats engine;
+  uint8_t previousRoot = 0;
+  bool chordHeld = false;
+
+  for (uint32_t tick = 0; tick < ticks; ++tick) {
+    uint64_t tickUs = tick * tickPeriodNum / tickPeriodDen;
+
+    // Periodic pumps between ticks
+    while (nextPumpUs < tickUs) {
+      simPump(*sched, engineBusy, nextPumpUs, result.engineBytes);
+      nextPumpUs += kPumpPeriodUs;
+    }
+
+    // Chord change on every eighth note: release the held chord, play the next
+    if (tick % 12 == 0) {
+      uint8_t root = static_cast<uint8_t>(36 + (tick / 12) % 12);
+      for (uint8_t pass = 0; pass < 2; ++pass) {
+        if (pass == 0 && !chordHeld) {
+          continue;
+        }
+        uint8_t base = pass == 0 ? previousRoot : root;
+        for (uint8_t i = 0; i < chordNotes; ++i) {
+          uint8_t note = static_cast<uint8_t>((base + i * 5) & 0x7F);
+          uint8_t status = pass == 0 ? 0x80 : 0x90;
+          uint8_t velocity = pass == 0 ? 0 : 100;
+          for (uint8_t b = 0; b < 3; ++b) {
+            wireWrite(legacyBusy, tickUs);
+          }
+          result.legacyBytes += 3;
+          sched->push(status, note, velocity, 3);
+        }
+      }
+      previousRoot = root;
+      chordHeld = true;
+    }
+    simPump(*sched, engineBusy, tickUs, result.engineBytes);  // Opportunistic pump on send
+
+    // Clock byte of this tick, after the notes: in order on the old path,
+    // straight into the FIFO behind at most kFifoLeadBytes on the engine
+    uint64_t legacyDone = wireWrite(legacyBusy, tickUs);
+    uint64_t engineDone = wireWrite(engineBusy, tickUs);
+    legacy.add(static_cast<uint32_t>(legacyDone - kDinByteUs - tickUs));
+    engine.add(static_cast<uint32_t>(engineDone - kDinByteUs - tickUs));
+    ++result.legacyBytes;
+    ++result.engineBytes;
+
+    uint32_t backlogUs = static_cast<uint32_t>(sched->size() + wireQueued(engineBusy, tickUs)) * kDinByteUs;
+    if (backlogUs > result.maxBacklogUs) {
+      result.maxBacklogUs = backlogUs;
+    }
+  }
+
+  // Drain what is left so both byte counts cover the whole pattern
+  uint64_t drainUs = nextPumpUs;
+  while (sched->size() > 0) {
+    simPump(*sched, engineBusy, drainUs, result.engineBytes);
+    drainUs += kPumpPeriodUs;
+  }
+
+  result.clocks = ticks;
+  result.legacyMaxUs = legacy.maxUs;
+  result.legacyMeanUs = static_cast<uint32_t>(legacy.sumUs / ticks);
+  result.legacyJitterUs = legacy.maxUs - legacy.minUs;
+  result.engineMaxUs = engine.maxUs;
+  result.engineMeanUs = static_cast<uint32_t>(engine.sumUs / ticks);
+  result.engineJitterUs = engine.maxUs - engine.minUs;
+  result.boundUs = static_cast<uint32_t>(kFifoLeadBytes) * kDinByteUs;
+  result.ok = result.engineJitterUs <= result.boundUs;
+  return result;
+}
@@ -0,0 +1,477 @@
+#include "esp_now_frame.h"
+
+#include "rng_service.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+namespace {
+static constexpr uint8_t kMaxTransportPerFrame = 2;  // Copies kept per frame for redundancy
+static constexpr uint16_t kLatencyWindowFrames = 256;  // Transit baseline follows clock drift
+static constexpr int16_t kResyncDistance = 512;
+
+inline bool isTransport(uint8_t status) {
+  return status == 0xFA || status == 0xFB || status == 0xFC;
+}
+
+inline void put16(uint8_t *out, uint16_t value) {
+  out[0] = static_cast<uint8_t>(value);
+  out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+inline void put32(uint8_t *out, uint32_t value) {
+  put16(out, static_cast<uint16_t>(value));
+  put16(out + 2, static_cast<uint16_t>(value >> 16));
+}
+
+inline uint16_t get16(const uint8_t *in) {
+  return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+inline uint32_t get32(const uint8_t *in) {
+  return get16(in) | (static_cast<uint32_t>(get16(in + 2)) << 16);
+}
+
+inline uint32_t lowBits(uint32_t count) {
+  return count >= 32 ? 0xFFFFFFFFu : (1u << count) - 1;
+}
+}  // namespace
+
+uint8_t espNowMessageLength(uint8_t status) {
+  if (status >= 0xF8) {
+    return 1;
+  }
+  switch (status & 0xF0) {
+    case 0x80:
+    case 0x90:
+    case 0xA0:
+    case 0xB0:
+    case 0xE0:
+      return 3;
+    case 0xC0:
+    case 0xD0:
+      return 2;
+    default:
+      return 0;  // Data bytes and system common/exclusive are not carried
+  }
+}
+
+// --- Writer ---
+
+void EspNowFrameWriter::setRedundancy(uint8_t frames) {
+  redundancy_ = frames > kEspNowMaxRedundancy ? kEspNowMaxRedundancy : frames;
+}
+
+void EspNowFrameWriter::reset() {
+  length_ = kEspNowFrameHeaderBytes;
+  clocks_ = 0;
+  pending_ = {};
+}
+
+bool EspNowFrameWriter::append(uint8_t status, uint8_t data1, uint8_t data2, uint32_t nowUs) {
+  uint8_t length = espNowMessageLength(status);
+  if (length == 0) {
+    return true;  // Nothing to carry
+  }
+  size_t reserved = static_cast<size_t>(redundancy_) * kMaxTransportPerFrame * 2;
+  if (length_ + length + reserved > kEspNowFrameMaxBytes) {
+    return false;
+  }
+  if (empty()) {
+    openedUs_ = nowUs;
+  }
+  frame_[length_++] = status;
+  if (length > 1) {
+    frame_[length_++] = data1 & 0x7F;
+  }
+  if (length > 2) {
+    frame_[length_++] = data2 & 0x7F;
+  }
+  if (status == 0xF8) {
+    if (clocks_ == 0) {
+      clockQueuedUs_ = nowUs;
+    }
+    ++clocks_;
+  } else if (isTransport(status) && pending_.count < kMaxTransportPerFrame) {
+    pending_.status[pending_.count++] = status;
+  }
+  return true;
+}
+
+size_t EspNowFrameWriter::finish(uint32_t nowUs) {
+  size_t length = length_;
+  uint8_t entries = 0;
+  for (uint8_t back = 1; back <= redundancy_; ++back) {
+    const TransportHistory &past = history_[back - 1];
+    if (static_cast<uint16_t>(sequence_ - past.sequence) != back) {
+      continue;  // Slot not filled yet
+    }
+    for (uint8_t i = 0; i < past.count; ++i) {
+      frame_[length++] = back;
+      frame_[length++] = past.status[i];
+      ++entries;
+    }
+  }
+
+  uint32_t clockAgeUs = clocks_ > 0 ? nowUs - clockQueuedUs_ : 0;
+  frame_[0] = kEspNowFrameMagic;
+  frame_[1] = kEspNowFrameVersion;
+  put16(frame_ + 2, sequence_);
+  put32(frame_ + 4, tick_);
+  put32(frame_ + 8, nowUs);
+  put16(frame_ + 12, static_cast<uint16_t>(clockAgeUs > 0xFFFF ? 0xFFFF : clockAgeUs));
+  frame_[14] = static_cast<uint8_t>(length_ - kEspNowFrameHeaderBytes);
+  frame_[15] = entries;
+
+  for (uint8_t i = kEspNowMaxRedundancy - 1; i > 0; --i) {
+    history_[i] = history_[i - 1];
+  }
+  history_[0] = pending_;
+  history_[0].sequence = sequence_;
+  tick_ += clocks_;
+  ++sequence_;
+  reset();
+  return length;
+}
+
+// --- Reader ---
+
+void EspNowFrameReader::reset() {
+  *this = EspNowFrameReader();
+}
+
+void EspNowFrameReader::trackLatency(uint32_t offsetUs) {
+  // Sender and receiver clocks are unrelated, so latency is measured over the
+  // quickest transit seen recently; the window lets the baseline follow drift
+  if (windowFrames_ == 0 || static_cast<int32_t>(offsetUs - windowMinUs_) < 0) {
+    windowMinUs_ = offsetUs;
+  }
+  if (++windowFrames_ >= kLatencyWindowFrames) {
+    minOffsetUs_ = windowMinUs_;
+    windowFrames_ = 0;
+  }
+  if (stats_.frames == 1 || static_cast<int32_t>(offsetUs - minOffsetUs_) < 0) {
+    minOffsetUs_ = offsetUs;
+  }
+  uint32_t latencyUs = offsetUs - minOffsetUs_;
+  stats_.totalLatencyUs += latencyUs;
+  if (latencyUs > stats_.maxLatencyUs) {
+    stats_.maxLatencyUs = latencyUs;
+  }
+}
+
+bool EspNowFrameReader::onFrame(const uint8_t *data, size_t length, uint32_t rxUs, EspNowMessageSink sink) {
+  if (data == nullptr || length < kEspNowFrameHeaderBytes || data[0] != kEspNowFrameMagic ||
+      data[1] != kEspNowFrameVersion) {
+    return false;
+  }
+  uint16_t sequence = get16(data + 2);
+  uint32_t tick = get32(data + 4);
+  uint32_t sendUs = get32(data + 8);
+  uint16_t clockAgeUs = get16(data + 12);
+  size_t messageEnd = kEspNowFrameHeaderBytes + data[14];
+  uint8_t entries = data[15];
+  if (messageEnd + entries * 2u > length) {
+    return false;
+  }
+
+  int16_t distance = static_cast<int16_t>(sequence - lastSequence_);
+  if (known_ && (distance > kResyncDistance || distance < -kResyncDistance)) {
+    ++stats_.resyncs;  // Sender restarted or we were away for a long time
+    known_ = false;
+  }
+
+  bool inOrder = true;
+  bool transportDone = false;
+  bool beforeSync = false;
+  if (!known_) {
+    // Frames sent before this one may still be in flight: keep the window
+    // open for them, without counting them as lost
+    known_ = true;
+    lastSequence_ = sequence;
+    missing_ = 0xFFFFFFFFu;
+    unsynced_ = 0xFFFFFFFFu;
+    transportDone_ = 0;
+    nextTick_ = tick;
+  } else if (distance == 0) {
+    ++stats_.duplicates;
+    return true;
+  } else if (distance > 0) {
+    uint32_t shift = static_cast<uint32_t>(distance);
+    missing_ = (shift >= 32 ? 0 : missing_ << shift) | lowBits(shift - 1);
+    unsynced_ = shift >= 32 ? 0 : unsynced_ << shift;
+    transportDone_ = shift >= 32 ? 0 : transportDone_ << shift;
+    stats_.lostFrames += shift - 1;
+    lastSequence_ = sequence;
+  } else {
+    uint32_t index = static_cast<uint32_t>(-distance) - 1;
+    if (index >= 32) {
+      return true;  // Older than the window; already counted as lost
+    }
+    uint32_t bit = 1u << index;
+    if ((missing_ & bit) == 0) {
+      ++stats_.duplicates;
+      return true;
+    }
+    missing_ &= ~bit;
+    transportDone = (transportDone_ & bit) != 0;
+    transportDone_ |= bit;
+    beforeSync = (unsynced_ & bit) != 0;
+    if (beforeSync) {
+      unsynced_ &= ~bit;  // Its pulses were never part of a counted gap
+    } else {
+      --stats_.lostFrames;
+    }
+    ++stats_.reordered;
+    inOrder = false;
+  }
+  ++stats_.frames;
+  trackLatency(rxUs - sendUs);
+
+  // Transport repeated from frames we never got, oldest first: they happened
+  // before anything in this frame
+  uint32_t recoveredMask = 0;
+  for (uint8_t back = kEspNowMaxRedundancy; back >= 1; --back) {
+    int32_t age = static_cast<int16_t>(lastSequence_ - static_cast<uint16_t>(sequence - back));
+    if (age < 1 || age > 32) {
+      continue;
+    }
+    uint32_t bit = 1u << (age - 1);
+    if ((missing_ & bit) == 0 || (transportDone_ & bit) != 0) {
+      continue;
+    }
+    for (uint8_t i = 0; i < entries; ++i) {
+      const uint8_t *entry = data + messageEnd + i * 2;
+      if (entry[0] == back && isTransport(entry[1])) {
+        sink(entry[1], 0, 0, rxUs);
+        ++stats_.recovered;
+        recoveredMask |= bit;
+      }
+    }
+  }
+  transportDone_ |= recoveredMask;
+
+  uint32_t clocks = 0;
+  size_t pos = kEspNowFrameHeaderBytes;
+  while (pos < messageEnd) {
+    uint8_t status = data[pos];
+    uint8_t messageLength = espNowMessageLength(status);
+    if (messageLength == 0 || pos + messageLength > messageEnd) {
+      break;
+    }
+    uint8_t data1 = messageLength > 1 ? data[pos + 1] : 0;
+    uint8_t data2 = messageLength > 2 ? data[pos + 2] : 0;
+    pos += messageLength;
+    if (status == 0xF8) {
+      ++clocks;
+      if (!inOrder) {
+        continue;  // A late pulse would only confuse the clock follower
+      }
+      sink(status, 0, 0, rxUs - clockAgeUs);  // When it was due at the sender
+    } else if (isTransport(status)) {
+      if (transportDone) {
+        continue;  // Already delivered from a redundant copy
+      }
+      sink(status, 0, 0, rxUs);
+    } else {
+      sink(status, data1, data2, rxUs);
+    }
+    ++stats_.messages;
+  }
+
+  if (inOrder) {
+    uint32_t skipped = tick - nextTick_;
+    if (skipped < 0x10000) {
+      stats_.lostClocks += skipped;
+    }
+    nextTick_ = tick + clocks;
+  } else if (beforeSync) {
+    stats_.lostClocks += clocks;  // Too late to feed the clock, and no gap counted them
+  }
+  return true;
+}
+
+// --- Loopback simulation ---
+
+namespace {
+struct SimCounters {
+  uint32_t clocks;
+  uint32_t notes;
+  uint32_t transport;
+};
+
+SimCounters simCounters;
+
+void simSink(uint8_t status, uint8_t /*data1*/, uint8_t /*data2*/, uint32_t /*timestampUs*/) {
+  if (status == 0xF8) {
+    ++simCounters.clocks;
+  } else if (isTransport(status)) {
+    ++simCounters.transport;
+  } else if ((status & 0xF0) == 0x90 || (status & 0xF0) == 0x80) {
+    ++simCounters.notes;
+  }
+}
+
+struct SimFrame {
+  uint8_t data[kEspNowFrameMaxBytes];
+  size_t length;
+  uint32_t rxUs;
+  uint8_t clocks;
+  uint8_t notes;
+  uint8_t transport;
+};
+}  // namespace
+
+EspNowLoopbackResult espNowRunLoopbackSimulation(uint8_t lossPercent, uint8_t reorderPercent, uint8_t redundancy,
+                                                 uint16_t seconds) {
+  EspNowLoopbackResult result = {};
+  lossPercent = constrain(lossPercent, 0, 90);
+  reorderPercent = constrain(reorderPercent, 0, 90);
+  seconds = constrain(seconds, 1, 600);
+  simCounters = {};
+
+  static EspNowFrameWriter writer;  // About 300 bytes each; keep them off the CLI stack
+  static EspNowFrameReader reader;
+  static SimFrame current;
+  static SimFrame held;
+  writer = EspNowFrameWriter();
+  writer.setRedundancy(redundancy);
+  reader.reset();
+  bool holding = false;
+
+  // Fixed seed so every run of the same arguments sees the same link
+  RngState rng = {{0x85EBCA6Bu, 0xC2B2AE35u, 0x27D4EB2Fu, 0x165667B1u}};
+  const double periodUs = 60000000.0 / (120.0 * 24.0);
+  const uint32_t ticks = static_cast<uint32_t>(seconds) * 48;
+  const uint32_t kHoldUs = 1000;
+
+  // Fate of the last few frames, to tell which transport messages had every
+  // redundant copy dropped as well
+  uint8_t recentTransport[kEspNowMaxRedundancy + 1] = {};
+  bool recentDropped[kEspNowMaxRedundancy + 1] = {};
+  uint32_t trailingDropped = 0;
+  uint32_t lateClocks = 0;
+  uint32_t reordered = 0;
+  uint32_t droppedNotes = 0;
+  uint8_t window = writer.redundancy() + 1;
+
+  auto settle = [&](uint8_t transport, bool dropped) {
+    // Frame n leaves the window: its transport was lost if it and its copies all were
+    if (recentTransport[0] > 0 && recentDropped[0]) {
+      bool copyArrived = false;
+      for (uint8_t k = 1; k < window; ++k) {
+        copyArrived = copyArrived || !recentDropped[k];
+      }
+      if (!copyArrived) {
+        result.transportUnrecoverable += recentTransport[0];
+      }
+    }
+    for (uint8_t k = 0; k + 1 < window; ++k) {
+      recentTransport[k] = recentTransport[k + 1];
+      recentDropped[k] = recentDropped[k + 1];
+    }
+    recentTransport[window - 1] = transport;
+    recentDropped[window - 1] = dropped;
+  };
+
+  auto deliver = [&](const SimFrame &frame) {
+    reader.onFrame(frame.data, frame.length, frame.rxUs, simSink);
+  };
+
+  for (uint32_t t = 0; t < ticks; ++t) {
+    uint32_t tickUs = static_cast<uint32_t>(t * periodUs);
+    uint8_t notes = 0;
+    uint8_t transport = 0;
+    auto add = [&](uint8_t status, uint8_t data1, uint8_t data2) {
+      writer.append(status, data1, data2, tickUs);
+      ++result.messages;
+    };
+
+    if (t == 0) {
+      add(0xFA, 0, 0);
+      ++transport;
+    } else if (t % 96 == 0) {
+      add(0xFC, 0, 0);
+      ++transport;
+    } else if (t % 96 == 1 && t > 1) {
+      add(0xFB, 0, 0);
+      ++transport;
+    }
+    add(0xF8, 0, 0);
+    if (t % 6 == 0) {
+      uint8_t root = static_cast<uint8_t>(48 + (t / 6) % 12);
+      uint8_t previousRoot = static_cast<uint8_t>(48 + (t / 6 + 11) % 12);
+      for (uint8_t i = 0; i < 4; ++i) {
+        if (t > 0) {
+          add(0x80, static_cast<uint8_t>(previousRoot + i * 4), 0);
+          ++notes;
+        }
+        add(0x90, static_cast<uint8_t>(root + i * 4), 100);
+        ++notes;
+      }
+    }
+    if (t % 3 == 0) {
+      add(0xB0, 1, static_cast<uint8_t>(t & 0x7F));
+    }
+
+    uint32_t sendUs = tickUs + kHoldUs;
+    current.length = writer.finish(sendUs);
+    memcpy(current.data, writer.data(), current.length);
+    current.rxUs = sendUs + 1500 + rngNext(rng) % 1000;
+    current.clocks = 1;
+    current.notes = notes;
+    current.transport = transport;
+    ++result.frames;
+    result.clocksSent += 1;
+    result.notesSent += notes;
+    result.transportSent += transport;
+
+    bool dropped = rngNext(rng) % 100 < lossPercent;
+    settle(transport, dropped);
+    if (dropped) {
+      ++result.droppedFrames;
+      ++trailingDropped;
+      droppedNotes += notes;
+      lateClocks += 1;
+      continue;
+    }
+    trailingDropped = 0;
+    if (!holding && rngNext(rng) % 100 < reorderPercent) {
+      held = current;
+      held.rxUs += static_cast<uint32_t>(periodUs);  // Overtaken by the next frame
+      holding = true;
+      ++result.delayedFrames;
+      continue;
+    }
+    deliver(current);
+    if (holding) {
+      deliver(held);
+      holding = false;
+      ++reordered;
+      lateClocks += held.clocks;
+    }
+  }
+  if (holding) {
+    deliver(held);  // Nothing overtook it
+  }
+  for (uint8_t k = 0; k < window; ++k) {
+    settle(0, false);
+  }
+  // Drops at the very end leave no gap for the receiver to see
+  lateClocks -= trailingDropped;
+
+  result.stats = reader.stats();
+  result.clocksDelivered = simCounters.clocks;
+  result.notesDelivered = simCounters.notes;
+  result.transportDelivered = simCounters.transport;
+  result.meanLatencyUs =
+      result.stats.frames > 0 ? static_cast<uint32_t>(result.stats.totalLatencyUs / result.stats.frames) : 0;
+  result.maxLatencyUs = result.stats.maxLatencyUs;
+  result.ok = result.stats.lostFrames == result.droppedFrames - trailingDropped &&
+              result.stats.reordered == reordered && result.stats.duplicates == 0 &&
+              result.stats.lostClocks == lateClocks &&
+              result.clocksDelivered == result.clocksSent - lateClocks - trailingDropped &&
+              result.notesDelivered == result.notesSent - droppedNotes &&
+              result.transportDelivered + result.transportUnrecoverable == result.transportSent;
+  return result;
+}
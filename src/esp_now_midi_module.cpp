@@ -3,19 +3,131 @@
 #if ESP_NOW_ENABLED
 
 #include <esp_now_midi.h>
+#include <esp_now.h>
+#include <esp_timer.h>
 #include <esp_wifi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <string.h>
 #include "hardware_midi.h"
 #include "clock_manager.h"
-
-// External declarations for BLE MIDI
-extern BLECharacteristic *pCharacteristic;
-extern bool deviceConnected;
-extern uint8_t midiPacket[];
+#include "midi_out_buffer.h"
+#include "midi_transport.h"
+#include "midi_utils.h"
 
 // Global ESP-NOW MIDI instance
 esp_now_midi espNowMIDI;
 EspNowMidiState espNowState;
 
+namespace {
+static constexpr uint32_t kEspNowFrameHoldUs = 1000;
+static const uint8_t kBroadcastMac[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+struct EspNowLink {
+  bool used;
+  uint8_t mac[6];
+  EspNowFrameReader reader;
+};
+
+// The writer is shared by every task that sends MIDI; links are only touched
+// by the WiFi task's receive callback (stats are read without locking)
+static SemaphoreHandle_t frameMutex = nullptr;
+static EspNowFrameWriter frameWriter;
+static EspNowLink links[kEspNowMaxLinks];
+
+static inline uint32_t nowUs() {
+  return static_cast<uint32_t>(esp_timer_get_time());
+}
+
+// esp_now_send(nullptr, ...) reaches every registered peer, so the broadcast
+// address may only be a peer in broadcast mode or peer mode would broadcast too
+static void applyBroadcastPeer(EspNowMode mode) {
+  bool exists = esp_now_is_peer_exist(kBroadcastMac);
+  if (mode != ESP_NOW_BROADCAST) {
+    if (exists && esp_now_del_peer(kBroadcastMac) != ESP_OK) {
+      Serial.println("[ESP-NOW] Failed to remove broadcast peer");
+    }
+    return;
+  }
+  if (exists) {
+    return;
+  }
+  esp_now_peer_info_t peer = {};
+  memcpy(peer.peer_addr, kBroadcastMac, sizeof(kBroadcastMac));
+  peer.ifidx = WIFI_IF_STA;
+  peer.encrypt = false;
+  if (esp_now_add_peer(&peer) != ESP_OK) {
+    Serial.println("[ESP-NOW] Failed to add broadcast peer");
+  }
+}
+
+// Caller holds frameMutex
+static void sendFrameLocked(uint32_t timeUs) {
+  if (frameWriter.empty()) {
+    return;
+  }
+  size_t length = frameWriter.finish(timeUs);
+  // Broadcast reaches every listener once; peer mode sends to each added peer
+  const uint8_t *destination = espNowState.mode == ESP_NOW_BROADCAST ? kBroadcastMac : nullptr;
+  if (esp_now_send(destination, frameWriter.data(), length) == ESP_OK) {
+    espNowState.framesSent++;
+  } else {
+    espNowState.sendErrors++;
+  }
+}
+
+static void deliverEspNowMessage(uint8_t status, uint8_t data1, uint8_t data2, uint32_t timestampUs);
+static void handleEspNowClock(uint32_t timestampUs);
+
+static EspNowLink *findLink(const uint8_t *mac) {
+  EspNowLink *freeLink = nullptr;
+  for (EspNowLink &link : links) {
+    if (link.used && memcmp(link.mac, mac, 6) == 0) {
+      return &link;
+    }
+    if (!link.used && freeLink == nullptr) {
+      freeLink = &link;
+    }
+  }
+  if (freeLink == nullptr) {
+    return nullptr;
+  }
+  freeLink->reader.reset();
+  memcpy(freeLink->mac, mac, 6);
+  freeLink->used = true;
+  // Receiving replaces the library's callback, so discovery happens here
+  if (espNowState.mode == ESP_NOW_BROADCAST && !esp_now_is_peer_exist(mac)) {
+    espNowMIDI.addPeer(mac);
+  }
+  return freeLink;
+}
+
+static void onEspNowReceive(const uint8_t *mac, const uint8_t *data, int length) {
+  uint32_t timestampUs = nowUs();  // Before any forwarding
+  if (mac == nullptr || data == nullptr || length <= 0) {
+    return;
+  }
+  if (data[0] == kEspNowFrameMagic) {
+    EspNowLink *link = findLink(mac);
+    if (link != nullptr) {
+      link->reader.onFrame(data, static_cast<size_t>(length), timestampUs, deliverEspNowMessage);
+    }
+    return;
+  }
+  // Plain MIDI messages from senders with batching off or other ESP-NOW MIDI devices
+  int pos = 0;
+  while (pos < length) {
+    uint8_t messageLength = espNowMessageLength(data[pos]);
+    if (messageLength == 0 || pos + messageLength > length) {
+      break;
+    }
+    deliverEspNowMessage(data[pos], messageLength > 1 ? data[pos + 1] : 0, messageLength > 2 ? data[pos + 2] : 0,
+                         timestampUs);
+    pos += messageLength;
+  }
+}
+}  // namespace
+
 void initEspNowMidi() {
   if (espNowState.initialized) {
     Serial.println("[ESP-NOW] Already initialized");
@@ -40,10 +152,21 @@ void initEspNowMidi() {
   espNowMIDI.setHandleStop(onEspNowStop);
   espNowMIDI.setHandleContinue(onEspNowContinue);
   
+  // Frames carry batches the library cannot parse, so receive them directly
+  esp_now_register_recv_cb(onEspNowReceive);
+  applyBroadcastPeer(espNowState.mode);
+  if (frameMutex == nullptr) {
+    frameMutex = xSemaphoreCreateMutex();
+  }
+  frameWriter.setRedundancy(espNowState.redundancy);
+  resetEspNowLinkStats();
+
   espNowState.initialized = true;
   // Note: mode is set by caller (setEspNowMode)
   espNowState.messagesSent = 0;
   espNowState.messagesReceived = 0;
+  espNowState.framesSent = 0;
+  espNowState.sendErrors = 0;
   
   Serial.println("[ESP-NOW] Initialization complete");
   Serial.print("[ESP-NOW] MAC Address: ");
@@ -68,6 +191,8 @@ void setEspNowMode(EspNowMode mode) {
     deinitEspNowMidi();
   } else if (!espNowState.initialized) {
     initEspNowMidi();
+  } else {
+    applyBroadcastPeer(mode);
   }
   
   Serial.print("[ESP-NOW] Mode changed to: ");
@@ -128,6 +253,7 @@ void clearEspNowPeers() {
   }
   
   espNowMIDI.clearPeers();
+  applyBroadcastPeer(espNowState.mode);
   Serial.println("[ESP-NOW] All peers cleared");
 }
 
@@ -143,7 +269,25 @@ void sendEspNowMidi(uint8_t status, uint8_t data1, uint8_t data2) {
   if (!espNowState.initialized || espNowState.mode == ESP_NOW_OFF) {
     return;
   }
-  
+  if (status == 0xF8) {
+    midiClockTraceCount(MidiClockTransport::ESP_NOW);
+  }
+
+  if (espNowState.batching && frameMutex != nullptr) {
+    uint32_t timeUs = nowUs();
+    xSemaphoreTake(frameMutex, portMAX_DELAY);
+    if (status == 0xF8 && frameWriter.holdsClock()) {
+      sendFrameLocked(timeUs);  // One clock pulse per frame
+    }
+    if (!frameWriter.append(status, data1, data2, timeUs)) {
+      sendFrameLocked(timeUs);
+      frameWriter.append(status, data1, data2, timeUs);
+    }
+    xSemaphoreGive(frameMutex);
+    espNowState.messagesSent++;
+    return;
+  }
+
   esp_err_t result = ESP_OK;
 
   /* Real-time system messages (0xF8 and above) are single-byte and
@@ -203,21 +347,121 @@ void sendEspNowMidi(uint8_t status, uint8_t data1, uint8_t data2) {
   }
 }
 
+void espNowMidiService() {
+  if (!espNowState.initialized || !espNowState.batching || frameMutex == nullptr) {
+    return;
+  }
+  uint32_t timeUs = nowUs();
+  if (frameWriter.empty() || timeUs - frameWriter.openedUs() < kEspNowFrameHoldUs) {
+    return;  // Unlocked peek; rechecked below
+  }
+  xSemaphoreTake(frameMutex, portMAX_DELAY);
+  if (!frameWriter.empty() && timeUs - frameWriter.openedUs() >= kEspNowFrameHoldUs) {
+    sendFrameLocked(timeUs);
+  }
+  xSemaphoreGive(frameMutex);
+}
+
+void setEspNowBatching(bool enabled) {
+  if (!enabled && frameMutex != nullptr) {
+    xSemaphoreTake(frameMutex, portMAX_DELAY);
+    sendFrameLocked(nowUs());
+    xSemaphoreGive(frameMutex);
+  }
+  espNowState.batching = enabled;
+}
+
+void setEspNowRedundancy(uint8_t frames) {
+  espNowState.redundancy = frames > kEspNowMaxRedundancy ? kEspNowMaxRedundancy : frames;
+  if (frameMutex != nullptr) {
+    xSemaphoreTake(frameMutex, portMAX_DELAY);
+    frameWriter.setRedundancy(espNowState.redundancy);
+    xSemaphoreGive(frameMutex);
+  }
+}
+
+uint8_t getEspNowLinkCount() {
+  uint8_t count = 0;
+  for (const EspNowLink &link : links) {
+    count += link.used ? 1 : 0;
+  }
+  return count;
+}
+
+bool getEspNowLinkStats(uint8_t index, uint8_t mac[6], EspNowLinkStats &stats) {
+  for (const EspNowLink &link : links) {
+    if (!link.used) {
+      continue;
+    }
+    if (index-- == 0) {
+      memcpy(mac, link.mac, 6);
+      stats = link.reader.stats();
+      return true;
+    }
+  }
+  return false;
+}
+
+void resetEspNowLinkStats() {
+  for (EspNowLink &link : links) {
+    link.reader.resetStats();
+  }
+}
+
+namespace {
+// Routes one received message the way the library callbacks did
+static void deliverEspNowMessage(uint8_t status, uint8_t data1, uint8_t data2, uint32_t timestampUs) {
+  uint8_t channel = status & 0x0F;
+  switch (status >= 0xF0 ? status : (status & 0xF0)) {
+    case 0x90:
+      onEspNowNoteOn(channel, data1, data2);
+      break;
+    case 0x80:
+      onEspNowNoteOff(channel, data1, data2);
+      break;
+    case 0xB0:
+      onEspNowControlChange(channel, data1, data2);
+      break;
+    case 0xF8:
+      handleEspNowClock(timestampUs);
+      break;
+    case 0xFA:
+      onEspNowStart();
+      break;
+    case 0xFB:
+      onEspNowContinue();
+      break;
+    case 0xFC:
+      onEspNowStop();
+      break;
+    case 0xA0:
+    case 0xC0:
+    case 0xD0:
+    case 0xE0:
+      espNowState.messagesReceived++;
+      midiTransportProcessChannelMessage(status, data1, data2, CLOCK_ESP_NOW);
+      if (espNowMessageLength(status) == 2) {
+        sendHardwareMIDI(status, data1);
+      } else {
+        sendHardwareMIDI(status, data1, data2);
+      }
+      break;
+    default:
+      break;
+  }
+}
+}  // namespace
+
 // MIDI message handlers (route to internal MIDI system)
 void onEspNowNoteOn(byte channel, byte note, byte velocity) {
   espNowState.messagesReceived++;
   
   uint8_t status = 0x90 | channel;
+  midiTransportProcessChannelMessage(status, note, velocity, CLOCK_ESP_NOW);
   
-  // Route to BLE MIDI
-  if (deviceConnected && pCharacteristic) {
-    uint8_t packet[5] = {0x80, 0x80, status, note, velocity};
-    pCharacteristic->setValue(packet, 5);
-    pCharacteristic->notify();
-  }
-  
-  // Route to Hardware MIDI
+  // DIN in place, BLE through its sender queue
   sendHardwareMIDI(status, note, velocity);
+  sendMIDITo(MidiOutPort::BLE, status, note, velocity);
   
   Serial.printf("[ESP-NOW RX] Note On: Ch=%d, Note=%d, Vel=%d\n", channel, note, velocity);
 }
@@ -226,16 +470,11 @@ void onEspNowNoteOff(byte channel, byte note, byte velocity) {
   espNowState.messagesReceived++;
   
   uint8_t status = 0x80 | channel;
+  midiTransportProcessChannelMessage(status, note, velocity, CLOCK_ESP_NOW);
   
-  // Route to BLE MIDI
-  if (deviceConnected && pCharacteristic) {
-    uint8_t packet[5] = {0x80, 0x80, status, note, velocity};
-    pCharacteristic->setValue(packet, 5);
-    pCharacteristic->notify();
-  }
-  
-  // Route to Hardware MIDI
+  // DIN in place, BLE through its sender queue
   sendHardwareMIDI(status, note, velocity);
+  sendMIDITo(MidiOutPort::BLE, status, note, velocity);
   Serial.printf("[ESP-NOW RX] Note Off: Ch=%d, Note=%d, Vel=%d\n", channel, note, velocity);
 }
 
@@ -243,56 +482,37 @@ void onEspNowControlChange(byte channel, byte control, byte value) {
   espNowState.messagesReceived++;
   
   uint8_t status = 0xB0 | channel;
+  midiTransportProcessChannelMessage(status, control, value, CLOCK_ESP_NOW);
   
-  // Route to BLE MIDI
-  if (deviceConnected && pCharacteristic) {
-    midiPacket[2] = status;
-    midiPacket[3] = control;
-    midiPacket[4] = value;
-    pCharacteristic->setValue(midiPacket, 5);
-    pCharacteristic->notify();
-  }
-  // Route to Hardware MIDI
+  // DIN in place, BLE through its sender queue
   sendHardwareMIDI(status, control, value);
+  sendMIDITo(MidiOutPort::BLE, status, control, value);
   
   Serial.printf("[ESP-NOW RX] CC: Ch=%d, CC=%d, Val=%d\n", channel, control, value);
 }
 
 void onEspNowClock() {
+  handleEspNowClock(micros());  // Before the BLE and DIN forwarding
+}
+
+namespace {
+static void handleEspNowClock(uint32_t timestampUs) {
   espNowState.messagesReceived++;
   
-  // Only process if ESP-NOW is the clock master
+  // Only process if ESP-NOW is the clock master. No thru: the clock manager
+  // sends one pulse per followed tick to every output.
   if (midiClockMaster == CLOCK_ESP_NOW) {
-    // Route to BLE MIDI
-    if (deviceConnected && pCharacteristic) {
-      midiPacket[2] = 0xF8;
-      midiPacket[3] = 0;
-      midiPacket[4] = 0;
-      pCharacteristic->setValue(midiPacket, 5);
-      pCharacteristic->notify();
-    }
-    
-    // Route to Hardware MIDI
-    sendHardwareMIDI(0xF8, 0);
-    
-    clockManagerExternalClock();
+    clockManagerExternalClock(timestampUs);
   }
 }
+}  // namespace
 
 void onEspNowStart() {
   espNowState.messagesReceived++;
   
-  // Route to BLE MIDI
-  if (deviceConnected && pCharacteristic) {
-    midiPacket[2] = 0xFA;
-    midiPacket[3] = 0;
-    midiPacket[4] = 0;
-    pCharacteristic->setValue(midiPacket, 5);
-    pCharacteristic->notify();
-  }
-  
-  // Route to Hardware MIDI
+  // DIN in place, BLE through its sender queue
   sendHardwareMIDI(0xFA, 0);
+  sendMIDITo(MidiOutPort::BLE, 0xFA, 0, 0);
   if (midiClockMaster == CLOCK_ESP_NOW) {
     clockManagerExternalStart();
   }
@@ -303,17 +523,9 @@ void onEspNowStart() {
 void onEspNowStop() {
   espNowState.messagesReceived++;
   
-  // Route to BLE MIDI
-  if (deviceConnected && pCharacteristic) {
-    midiPacket[2] = 0xFC;
-    midiPacket[3] = 0;
-    midiPacket[4] = 0;
-    pCharacteristic->setValue(midiPacket, 5);
-    pCharacteristic->notify();
-  }
-  
-  // Route to Hardware MIDI
+  // DIN in place, BLE through its sender queue
   sendHardwareMIDI(0xFC, 0);
+  sendMIDITo(MidiOutPort::BLE, 0xFC, 0, 0);
   if (midiClockMaster == CLOCK_ESP_NOW) {
     clockManagerExternalStop();
   }
@@ -324,17 +536,9 @@ void onEspNowStop() {
 void onEspNowContinue() {
   espNowState.messagesReceived++;
   
-  // Route to BLE MIDI
-  if (deviceConnected && pCharacteristic) {
-    midiPacket[2] = 0xFB;
-    midiPacket[3] = 0;
-    midiPacket[4] = 0;
-    pCharacteristic->setValue(midiPacket, 5);
-    pCharacteristic->notify();
-  }
-  
-  // Route to Hardware MIDI
+  // DIN in place, BLE through its sender queue
   sendHardwareMIDI(0xFB, 0);
+  sendMIDITo(MidiOutPort::BLE, 0xFB, 0, 0);
   
   if (midiClockMaster == CLOCK_ESP_NOW) {
     clockManagerExternalContinue();
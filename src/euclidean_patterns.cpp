@@ -0,0 +1,118 @@
+#include "euclidean_patterns.h"
+#include "euclidean_tables.h"
+
+#include <Arduino.h>
+#include <algorithm>
+#include <cstring>
+
+uint64_t euclidPattern(uint8_t events, uint8_t length) {
+  length = std::min<uint8_t>(length, EUCLIDEAN_PATTERN_MAX_STEPS);
+  events = std::min(events, length);
+  return kEuclideanTable[EUCLIDEAN_TABLE_INDEX(events, length)];
+}
+
+uint64_t euclidRotate(uint64_t mask, uint8_t length, int rotation) {
+  if (length == 0) {
+    return 0;
+  }
+  length = std::min<uint8_t>(length, EUCLIDEAN_PATTERN_MAX_STEPS);
+  int shift = rotation % length;
+  if (shift < 0) {
+    shift += length;
+  }
+  mask &= euclidLengthMask(length);
+  if (shift == 0) {
+    return mask;
+  }
+  return ((mask << shift) | (mask >> (length - shift))) & euclidLengthMask(length);
+}
+
+uint64_t euclidPatternBucket(uint8_t events, uint8_t length) {
+  uint64_t mask = 0;
+  int bucket = 0;
+  for (int i = 0; i < length; ++i) {
+    bucket += events;
+    if (bucket >= length) {
+      bucket -= length;
+      mask |= 1ULL << i;
+    }
+  }
+  return mask;
+}
+
+const char *euclidLogicOpName(EuclidLogicOp op) {
+  switch (op) {
+    case EuclidLogicOp::AND: return "AND";
+    case EuclidLogicOp::OR:  return "OR";
+    case EuclidLogicOp::XOR: return "XOR";
+    default:                 return "NONE";
+  }
+}
+
+static int countOnsets(uint64_t mask) {
+  return __builtin_popcountll(mask);
+}
+
+EuclidCheckResult euclidRunExhaustiveCheck() {
+  EuclidCheckResult result = {0, 0};
+  for (int n = 1; n <= EUCLIDEAN_PATTERN_MAX_STEPS; ++n) {
+    for (int k = 0; k <= n; ++k) {
+      uint64_t mask = euclidPattern(k, n);
+      bool ok = mask == euclidPatternBucket(k, n) &&
+                countOnsets(mask) == k &&
+                (mask & ~euclidLengthMask(n)) == 0;
+      // Rotating by r then by n - r must restore the pattern
+      for (int r = 1; ok && r < n; ++r) {
+        uint64_t rotated = euclidRotate(mask, n, r);
+        ok = countOnsets(rotated) == k && euclidRotate(rotated, n, n - r) == mask &&
+             euclidRotate(mask, n, r - n) == rotated;
+      }
+      ++result.checked;
+      if (!ok) {
+        ++result.failures;
+        if (result.failures <= 8) {
+          Serial.printf("[EUCLID] Check failed for E(%d,%d): %08lX%08lX\n", k, n,
+                        static_cast<unsigned long>(mask >> 32), static_cast<unsigned long>(mask));
+        }
+      }
+    }
+  }
+  return result;
+}
+
+EuclidBenchResult euclidRunBenchmark(uint32_t iterations) {
+  EuclidBenchResult result = {iterations, 0, 0};
+  bool pattern[EUCLIDEAN_PATTERN_MAX_STEPS];
+  volatile uint32_t sink = 0;
+
+  // Previous approach: bucket loop writing a bool per step
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < iterations; ++i) {
+    int steps = 1 + (i % EUCLIDEAN_PATTERN_MAX_STEPS);
+    int events = (i * 7) % (steps + 1);
+    int rotation = i % 5;
+    std::memset(pattern, 0, sizeof(pattern));
+    int bucket = 0;
+    for (int s = 0; s < steps; ++s) {
+      bucket += events;
+      if (bucket >= steps) {
+        bucket -= steps;
+        pattern[(s + rotation) % steps] = true;
+      }
+    }
+    sink += pattern[i % steps];
+  }
+  result.bucketUs = micros() - start;
+
+  start = micros();
+  for (uint32_t i = 0; i < iterations; ++i) {
+    int steps = 1 + (i % EUCLIDEAN_PATTERN_MAX_STEPS);
+    int events = (i * 7) % (steps + 1);
+    int rotation = i % 5;
+    uint64_t mask = euclidRotate(euclidPattern(events, steps), steps, rotation);
+    sink += (mask >> (i % steps)) & 1u;
+  }
+  result.tableUs = micros() - start;
+  (void)sink;
+  return result;
+}
@@ -0,0 +1,335 @@
+#include "headless_router.h"
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <string.h>
+
+namespace {
+static constexpr uint8_t kNoRouteType = 0xFF;
+static constexpr uint8_t kStoredVersion = 1;
+static const char *const kPrefsNamespace = "midirouter";
+static const char *const kPrefsKey = "routes";
+static const char *const kPortNames[] = {"USB", "BLE", "DIN", "ESPNOW"};
+
+struct StoredRoutes {
+  uint8_t version;
+  MidiRoute routes[kMidiPortCount][kMidiPortCount];
+};
+
+uint8_t statusLength(uint8_t status) {
+  if (status < 0x80) {
+    return 0;
+  }
+  if (status < 0xF0) {
+    uint8_t kind = status & 0xF0;
+    return (kind == 0xC0 || kind == 0xD0) ? 2 : 3;
+  }
+  switch (status) {
+    case 0xF0:
+      return 0;  // Variable: up to F7
+    case 0xF1:
+    case 0xF3:
+      return 2;
+    case 0xF2:
+      return 3;
+    default:
+      return 1;
+  }
+}
+
+uint8_t routeTypeIndex(uint8_t status) {
+  if (status < 0x80) {
+    return kNoRouteType;
+  }
+  switch (status & 0xF0) {
+    case 0x80:
+    case 0x90:
+      return 0;
+    case 0xA0:
+    case 0xD0:
+      return 1;
+    case 0xB0:
+      return 2;
+    case 0xC0:
+      return 3;
+    case 0xE0:
+      return 4;
+    default:
+      break;
+  }
+  if (status == 0xF8) {
+    return 5;
+  }
+  if (status == 0xFA || status == 0xFB || status == 0xFC) {
+    return 6;
+  }
+  if (status <= 0xF7) {
+    return 7;
+  }
+  return kNoRouteType;  // Active sensing, reset, undefined realtime
+}
+}  // namespace
+
+size_t midiMessageLength(const uint8_t *data, size_t available) {
+  if (data == nullptr || available == 0) {
+    return 0;
+  }
+  if (data[0] == 0xF0) {
+    for (size_t i = 1; i < available; ++i) {
+      if (data[i] == 0xF7) {
+        return i + 1;
+      }
+    }
+    return 0;
+  }
+  uint8_t length = statusLength(data[0]);
+  return length <= available ? length : 0;
+}
+
+const char *midiPortName(MidiPort port) {
+  uint8_t index = static_cast<uint8_t>(port);
+  return index < kMidiPortCount ? kPortNames[index] : "?";
+}
+
+bool MidiStreamParser::feed(uint8_t byte) {
+  if (byte >= 0xF8) {
+    realtime_ = byte;  // Leaves a message in progress untouched
+    message_ = &realtime_;
+    length_ = 1;
+    return true;
+  }
+  if (byte == 0xF0) {
+    status_ = 0xF0;
+    buffer_[0] = byte;
+    count_ = 1;
+    sysExOverflow_ = false;
+    return false;
+  }
+  if (byte == 0xF7) {
+    if (status_ != 0xF0) {
+      return false;
+    }
+    status_ = 0;
+    if (sysExOverflow_ || count_ >= kMidiSysExMaxBytes) {
+      count_ = 0;
+      return false;
+    }
+    buffer_[count_++] = byte;
+    message_ = buffer_;
+    length_ = count_;
+    count_ = 0;
+    return true;
+  }
+  if (byte & 0x80) {
+    status_ = byte;
+    expected_ = statusLength(byte);
+    buffer_[0] = byte;
+    count_ = 1;
+    if (expected_ == 1) {
+      status_ = 0;  // Tune request; system common ends running status
+      count_ = 0;
+      message_ = buffer_;
+      length_ = 1;
+      return true;
+    }
+    return false;
+  }
+
+  // Data byte
+  if (status_ == 0) {
+    return false;
+  }
+  if (status_ == 0xF0) {
+    if (count_ < kMidiSysExMaxBytes - 1) {
+      buffer_[count_++] = byte;
+    } else {
+      sysExOverflow_ = true;
+    }
+    return false;
+  }
+  if (count_ == 0) {
+    buffer_[count_++] = status_;  // Running status
+  }
+  buffer_[count_++] = byte;
+  if (count_ < expected_) {
+    return false;
+  }
+  message_ = buffer_;
+  length_ = count_;
+  count_ = 0;
+  if (status_ >= 0xF0) {
+    status_ = 0;
+  }
+  return true;
+}
+
+void MidiRouter::setDefaults() {
+  for (uint8_t source = 0; source < kMidiPortCount; ++source) {
+    for (uint8_t destination = 0; destination < kMidiPortCount; ++destination) {
+      MidiRoute route = {0, 0};
+      if (source != destination) {
+        route = {kRouteAllChannels, static_cast<uint8_t>(kRouteAllTypes & ~ROUTE_CLOCK)};
+      }
+      routes_[source][destination] = route;
+    }
+  }
+  compile();
+}
+
+void MidiRouter::setRoute(MidiPort source, MidiPort destination, MidiRoute route) {
+  uint8_t s = static_cast<uint8_t>(source);
+  uint8_t d = static_cast<uint8_t>(destination);
+  if (s >= kMidiPortCount || d >= kMidiPortCount || s == d) {
+    return;  // No loopback to the port a message came from
+  }
+  flush();  // Batches were routed under the old table
+  routes_[s][d] = route;
+  compile();
+}
+
+MidiRoute MidiRouter::getRoute(MidiPort source, MidiPort destination) const {
+  uint8_t s = static_cast<uint8_t>(source);
+  uint8_t d = static_cast<uint8_t>(destination);
+  if (s >= kMidiPortCount || d >= kMidiPortCount) {
+    return MidiRoute{0, 0};
+  }
+  return routes_[s][d];
+}
+
+void MidiRouter::compile() {
+  for (uint8_t source = 0; source < kMidiPortCount; ++source) {
+    for (uint8_t type = 0; type < kMidiRouteTypeCount; ++type) {
+      bool channelType = type < 5;
+      for (uint8_t channel = 0; channel < 16; ++channel) {
+        uint8_t mask = 0;
+        for (uint8_t destination = 0; destination < kMidiPortCount; ++destination) {
+          const MidiRoute &route = routes_[source][destination];
+          if (destination == source || !(route.types & (1 << type))) {
+            continue;
+          }
+          bool channelAllowed = channelType ? (route.channels & (1 << channel)) != 0 : route.channels != 0;
+          if (channelAllowed) {
+            mask |= 1 << destination;
+          }
+        }
+        table_[source][type][channel] = mask;
+      }
+    }
+  }
+}
+
+uint8_t MidiRouter::routeMessage(MidiPort source, const uint8_t *message, size_t length, uint32_t rxUs) {
+  uint8_t s = static_cast<uint8_t>(source);
+  if (s >= kMidiPortCount || message == nullptr || length == 0) {
+    return 0;
+  }
+  uint8_t type = routeTypeIndex(message[0]);
+  uint8_t mask = 0;
+  if (type != kNoRouteType) {
+    uint8_t channel = message[0] < 0xF0 ? (message[0] & 0x0F) : 0;
+    mask = table_[s][type][channel];
+  }
+  if (mask == 0) {
+    ++unrouted_[s];
+    return 0;
+  }
+
+  for (uint8_t d = 0; d < kMidiPortCount; ++d) {
+    if (!(mask & (1 << d))) {
+      continue;
+    }
+    if (length > kRouteBatchBytes) {
+      // Long SysEx goes out on its own, after what is already queued
+      flushPort(d);
+      writer_(static_cast<MidiPort>(d), message, length);
+      MidiRouteStats &st = stats_[s][d];
+      uint32_t latencyUs = micros() - rxUs;
+      ++st.messages;
+      st.totalLatencyUs += latencyUs;
+      st.maxLatencyUs = max(st.maxLatencyUs, latencyUs);
+      continue;
+    }
+    Batch &batch = batches_[d];
+    if (batch.length + length > kRouteBatchBytes || batch.count >= kRouteBatchMessages) {
+      flushPort(d);
+    }
+    memcpy(batch.bytes + batch.length, message, length);
+    batch.length += length;
+    batch.source[batch.count] = s;
+    batch.rxUs[batch.count] = rxUs;
+    ++batch.count;
+  }
+  return mask;
+}
+
+void MidiRouter::flushPort(uint8_t destination) {
+  Batch &batch = batches_[destination];
+  if (batch.length == 0) {
+    return;
+  }
+  writer_(static_cast<MidiPort>(destination), batch.bytes, batch.length);
+  uint32_t now = micros();
+  for (uint8_t i = 0; i < batch.count; ++i) {
+    MidiRouteStats &st = stats_[batch.source[i]][destination];
+    uint32_t latencyUs = now - batch.rxUs[i];
+    ++st.messages;
+    st.totalLatencyUs += latencyUs;
+    st.maxLatencyUs = max(st.maxLatencyUs, latencyUs);
+  }
+  batch.length = 0;
+  batch.count = 0;
+}
+
+void MidiRouter::flush() {
+  for (uint8_t d = 0; d < kMidiPortCount; ++d) {
+    flushPort(d);
+  }
+}
+
+MidiRouteStats MidiRouter::stats(MidiPort source, MidiPort destination) const {
+  uint8_t s = static_cast<uint8_t>(source);
+  uint8_t d = static_cast<uint8_t>(destination);
+  if (s >= kMidiPortCount || d >= kMidiPortCount) {
+    return MidiRouteStats{};
+  }
+  return stats_[s][d];
+}
+
+void MidiRouter::resetStats() {
+  memset(stats_, 0, sizeof(stats_));
+  memset(unrouted_, 0, sizeof(unrouted_));
+}
+
+bool MidiRouter::load() {
+  Preferences prefs;
+  if (!prefs.begin(kPrefsNamespace, true)) {  // true = read-only
+    return false;
+  }
+  StoredRoutes stored = {};
+  bool loaded = prefs.getBytesLength(kPrefsKey) == sizeof(stored) &&
+                prefs.getBytes(kPrefsKey, &stored, sizeof(stored)) == sizeof(stored) &&
+                stored.version == kStoredVersion;
+  prefs.end();
+  if (!loaded) {
+    return false;
+  }
+  memcpy(routes_, stored.routes, sizeof(routes_));
+  for (uint8_t port = 0; port < kMidiPortCount; ++port) {
+    routes_[port][port] = MidiRoute{0, 0};
+  }
+  compile();
+  return true;
+}
+
+bool MidiRouter::save() const {
+  Preferences prefs;
+  if (!prefs.begin(kPrefsNamespace, false)) {  // false = read-write
+    return false;
+  }
+  StoredRoutes stored = {};
+  stored.version = kStoredVersion;
+  memcpy(stored.routes, routes_, sizeof(routes_));
+  bool saved = prefs.putBytes(kPrefsKey, &stored, sizeof(stored)) == sizeof(stored);
+  prefs.end();
+  return saved;
+}
@@ -0,0 +1,408 @@
+#include "lfo_engine.h"
+
+#include "midi_control_coalescer.h"
+#include "rng_service.h"
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <math.h>
+
+namespace {
+static constexpr uint32_t kStepPeriodUs = 1000000UL / kLfoControlRateHz;
+static constexpr uint32_t kMaxTickIntervalUs = 250000;  // 10 BPM; longer gaps are a stopped clock
+static constexpr uint32_t kTicksPerBar = 96;
+
+// One sine cycle, plus the first entry again so interpolation needs no wrap
+static const int16_t kSineTable[257] = {
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739,
+    9512, 10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279, 24811,
+    25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521,
+    32609, 32678, 32728, 32757, 32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285,
+    32137, 31971, 31785, 31580, 31356, 31113, 30852, 30571, 30273, 29956, 29621, 29268,
+    28898, 28510, 28105, 27683, 27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731,
+    23170, 22594, 22005, 21403, 20787, 20159, 19519, 18868, 18204, 17530, 16846, 16151,
+    15446, 14732, 14010, 13279, 12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179,
+    6393, 5602, 4808, 4011, 3212, 2410, 1608, 804, 0, -804, -1608, -2410,
+    -3212, -4011, -4808, -5602, -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159,
+    -20787, -21403, -22005, -22594, -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+    -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956, -30273, -30571, -30852, -31113,
+    -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580,
+    -31356, -31113, -30852, -30571, -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+    -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731, -23170, -22594, -22005, -21403,
+    -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278, -9512, -8739, -7962, -7179, -6393, -5602, -4808, -4011,
+    -3212, -2410, -1608, -804, 0,
+};
+
+int16_t clampSample(int32_t value) {
+  return static_cast<int16_t>(value < -32767 ? -32767 : (value > 32767 ? 32767 : value));
+}
+
+// Phase per step in 32.32 fixed point: a whole-LSB increment alone would be
+// off the nominal rate by up to half an LSB per step, a third of a degree an
+// hour at 1 Hz
+uint64_t incrementFor(uint16_t rateMilliHz) {
+  uint64_t scaled = static_cast<uint64_t>(rateMilliHz) << 32;
+  uint64_t perStep = static_cast<uint64_t>(kLfoControlRateHz) * 1000ULL;
+  uint64_t whole = scaled / perStep;
+  uint64_t fraction = ((scaled % perStep) << 32) / perStep;
+  return (whole << 32) | fraction;
+}
+
+// Phase of tick position within a syncTicks cycle; 2^32 for position == syncTicks
+uint64_t syncPhaseAt(uint32_t position, uint16_t syncTicks) {
+  return (static_cast<uint64_t>(position) << 32) / syncTicks;
+}
+
+uint16_t scaleOutput(const LfoConfig &config, int16_t sample) {
+  int32_t value;
+  if (config.target == LfoTarget::PITCH_BEND) {
+    value = 8192 + (static_cast<int32_t>(sample) * config.amount * 64) / 32767;
+    return static_cast<uint16_t>(constrain(value, 0, 16383));
+  }
+  value = 64 + (static_cast<int32_t>(sample) * config.amount) / (2 * 32767);
+  return static_cast<uint16_t>(constrain(value, 0, 127));
+}
+
+LfoBank bank;
+portMUX_TYPE lfoMux = portMUX_INITIALIZER_UNLOCKED;
+esp_timer_handle_t lfoTimer = nullptr;
+LfoEngineStats stats = {};
+uint32_t lastStepUs = 0;
+
+void onLfoTimer(void *) {
+  uint32_t startUs = micros();
+  LfoOutput outputs[kLfoCount];
+  portENTER_CRITICAL(&lfoMux);
+  size_t count = bank.step(startUs, outputs);
+  portEXIT_CRITICAL(&lfoMux);
+
+  // Coalesced: the output task sends the latest value at each transport's max rate
+  for (size_t i = 0; i < count; ++i) {
+    if (outputs[i].target == LfoTarget::PITCH_BEND) {
+      sendMIDIPitchBend(outputs[i].channel, outputs[i].value);
+    } else {
+      sendMIDIControl(outputs[i].channel, outputs[i].cc, static_cast<uint8_t>(outputs[i].value));
+    }
+  }
+
+  uint32_t endUs = micros();
+  portENTER_CRITICAL(&lfoMux);
+  if (stats.steps > 0 && startUs - lastStepUs > stats.maxGapUs) {
+    stats.maxGapUs = startUs - lastStepUs;
+  }
+  lastStepUs = startUs;
+  ++stats.steps;
+  stats.outputs += count;
+  if (endUs - startUs > stats.maxStepUs) {
+    stats.maxStepUs = endUs - startUs;
+  }
+  portEXIT_CRITICAL(&lfoMux);
+}
+}  // namespace
+
+int16_t lfoWaveSample(LfoWaveform waveform, uint32_t phase) {
+  switch (waveform) {
+    case LfoWaveform::SINE: {
+      uint32_t index = phase >> 24;
+      int32_t fraction = static_cast<int32_t>((phase >> 8) & 0xFFFF);
+      int32_t a = kSineTable[index];
+      int32_t b = kSineTable[index + 1];
+      return static_cast<int16_t>(a + (((b - a) * fraction) >> 16));
+    }
+    case LfoWaveform::TRIANGLE:
+      if (phase < 0x80000000UL) {
+        return clampSample(static_cast<int32_t>(phase >> 15) - 32768);
+      }
+      return clampSample(32767 - static_cast<int32_t>((phase - 0x80000000UL) >> 15));
+    case LfoWaveform::SQUARE:
+      return phase < 0x80000000UL ? 32767 : -32767;
+    case LfoWaveform::SAW:
+      return clampSample(static_cast<int32_t>(phase >> 16) - 32768);
+    default:
+      return 0;
+  }
+}
+
+void LfoBank::configure(uint8_t index, const LfoConfig &config) {
+  if (index >= kLfoCount) {
+    return;
+  }
+  Voice &voice = voices_[index];
+  bool starting = config.running && !voice.config.running;
+  bool retarget = config.target != voice.config.target || config.channel != voice.config.channel ||
+                  config.cc != voice.config.cc;
+  voice.config = config;
+  voice.config.waveform = config.waveform < LfoWaveform::COUNT ? config.waveform : LfoWaveform::SINE;
+  voice.config.channel &= 0x0F;
+  voice.config.cc &= 0x7F;
+  voice.config.amount = min<uint8_t>(config.amount, 127);
+  voice.config.rateMilliHz = constrain(config.rateMilliHz, kLfoMinRateMilliHz, kLfoMaxRateMilliHz);
+  voice.increment = incrementFor(voice.config.rateMilliHz);
+  if (starting && voice.config.syncTicks == 0) {
+    voice.phase = 0;
+    voice.phaseFraction = 0;
+  }
+  if (starting || retarget) {
+    voice.emitted = false;  // The new destination gets the current value at once
+  }
+  updateSync(voice);
+}
+
+LfoConfig LfoBank::config(uint8_t index) const {
+  return index < kLfoCount ? voices_[index].config : LfoConfig{};
+}
+
+void LfoBank::resetPhase(uint8_t index) {
+  if (index < kLfoCount) {
+    voices_[index].phase = 0;
+    voices_[index].phaseFraction = 0;
+  }
+}
+
+void LfoBank::updateSync(Voice &voice) {
+  uint16_t syncTicks = voice.config.syncTicks;
+  if (syncTicks == 0) {
+    return;
+  }
+  uint32_t position = haveTick_ ? tick_ % syncTicks : 0;
+  uint64_t base = syncPhaseAt(position, syncTicks);
+  uint64_t span = syncPhaseAt(position + 1, syncTicks) - base;
+  voice.syncBase = static_cast<uint32_t>(base);
+  // Per tick rather than per step: keeps the 64-bit division off the timer path
+  voice.syncRatio = tickIntervalUs_ > 0 ? (span << 16) / tickIntervalUs_ : 0;
+}
+
+void LfoBank::clockTick(uint32_t tick, uint32_t timestampUs) {
+  if (haveTick_ && tick == tick_ + 1) {
+    uint32_t interval = timestampUs - tickUs_;
+    if (interval > 0 && interval < kMaxTickIntervalUs) {
+      tickIntervalUs_ = interval;  // Catch-up ticks share a timestamp and keep the last interval
+    }
+  }
+  tick_ = tick;
+  tickUs_ = timestampUs;
+  haveTick_ = true;
+  for (uint8_t i = 0; i < kLfoCount; ++i) {
+    updateSync(voices_[i]);
+  }
+}
+
+uint32_t LfoBank::syncPhase(const Voice &voice, uint32_t nowUs) const {
+  if (!haveTick_ || tickIntervalUs_ == 0 || static_cast<int32_t>(nowUs - tickUs_) <= 0) {
+    return voice.syncBase;
+  }
+  uint32_t elapsed = nowUs - tickUs_;
+  if (elapsed >= tickIntervalUs_) {
+    elapsed = tickIntervalUs_ - 1;  // Never past the next tick's phase: hold for it
+  }
+  return voice.syncBase + static_cast<uint32_t>((elapsed * voice.syncRatio) >> 16);
+}
+
+size_t LfoBank::step(uint32_t nowUs, LfoOutput *out) {
+  size_t count = 0;
+  for (uint8_t i = 0; i < kLfoCount; ++i) {
+    Voice &voice = voices_[i];
+    if (!voice.config.running) {
+      continue;
+    }
+    bool synced = voice.config.syncTicks > 0;
+    if (synced) {
+      voice.phase = syncPhase(voice, nowUs);
+    }
+    uint16_t value = scaleOutput(voice.config, lfoWaveSample(voice.config.waveform, voice.phase));
+    if (!voice.emitted || value != voice.output) {
+      voice.output = value;
+      voice.emitted = true;
+      out[count++] = {i, voice.config.target, voice.config.channel, voice.config.cc, value};
+    }
+    if (!synced) {
+      uint64_t accumulator = ((static_cast<uint64_t>(voice.phase) << 32) | voice.phaseFraction) + voice.increment;
+      voice.phase = static_cast<uint32_t>(accumulator >> 32);
+      voice.phaseFraction = static_cast<uint32_t>(accumulator);
+    }
+  }
+  return count;
+}
+
+uint32_t LfoBank::phase(uint8_t index) const {
+  return index < kLfoCount ? voices_[index].phase : 0;
+}
+
+uint16_t LfoBank::output(uint8_t index) const {
+  return index < kLfoCount ? voices_[index].output : 0;
+}
+
+void initLfoEngine() {
+  if (lfoTimer != nullptr) {
+    return;
+  }
+  LfoConfig defaults = {};
+  defaults.waveform = LfoWaveform::SINE;
+  defaults.target = LfoTarget::CC;
+  defaults.cc = 1;  // Modulation wheel
+  defaults.amount = 64;
+  defaults.rateMilliHz = 1000;
+  portENTER_CRITICAL(&lfoMux);
+  for (uint8_t i = 0; i < kLfoCount; ++i) {
+    bank.configure(i, defaults);
+  }
+  portEXIT_CRITICAL(&lfoMux);
+
+  esp_timer_create_args_t args = {};
+  args.callback = onLfoTimer;
+  args.name = "lfo_bank";
+  if (esp_timer_create(&args, &lfoTimer) != ESP_OK) {
+    lfoTimer = nullptr;
+    Serial.println("[LFO] esp_timer_create failed");
+    return;
+  }
+  esp_timer_start_periodic(lfoTimer, kStepPeriodUs);
+  Serial.printf("[LFO] %u LFOs at %u Hz\n", kLfoCount, kLfoControlRateHz);
+}
+
+void lfoEngineClockTick(uint32_t tick, uint32_t timestampUs) {
+  portENTER_CRITICAL_SAFE(&lfoMux);
+  bank.clockTick(tick, timestampUs);
+  portEXIT_CRITICAL_SAFE(&lfoMux);
+}
+
+void lfoEngineConfigure(uint8_t index, const LfoConfig &config) {
+  portENTER_CRITICAL(&lfoMux);
+  bank.configure(index, config);
+  portEXIT_CRITICAL(&lfoMux);
+}
+
+LfoConfig lfoEngineGetConfig(uint8_t index) {
+  portENTER_CRITICAL(&lfoMux);
+  LfoConfig config = bank.config(index);
+  portEXIT_CRITICAL(&lfoMux);
+  return config;
+}
+
+uint32_t lfoEngineGetPhase(uint8_t index) {
+  portENTER_CRITICAL(&lfoMux);
+  uint32_t phase = bank.phase(index);
+  portEXIT_CRITICAL(&lfoMux);
+  return phase;
+}
+
+uint16_t lfoEngineGetOutput(uint8_t index) {
+  portENTER_CRITICAL(&lfoMux);
+  uint16_t output = bank.output(index);
+  portEXIT_CRITICAL(&lfoMux);
+  return output;
+}
+
+LfoEngineStats lfoEngineGetStats() {
+  portENTER_CRITICAL(&lfoMux);
+  LfoEngineStats copy = stats;
+  portEXIT_CRITICAL(&lfoMux);
+  return copy;
+}
+
+void lfoEngineResetStats() {
+  portENTER_CRITICAL(&lfoMux);
+  stats = {};
+  portEXIT_CRITICAL(&lfoMux);
+}
+
+LfoDriftResult lfoRunDriftSimulation(uint32_t bars, uint16_t bpm, uint16_t jitterUs) {
+  LfoDriftResult result = {};
+  static LfoBank simBank;
+  simBank = LfoBank();
+
+  LfoConfig config = {};
+  config.running = true;
+  config.waveform = LfoWaveform::SAW;
+  config.amount = 127;
+  config.rateMilliHz = 1000;
+  config.syncTicks = kTicksPerBar;
+  simBank.configure(0, config);
+  config.target = LfoTarget::PITCH_BEND;
+  config.syncTicks = kTicksPerBar / 4;
+  simBank.configure(1, config);
+  config.waveform = LfoWaveform::SINE;
+  config.syncTicks = 0;
+  simBank.configure(2, config);
+
+  uint32_t startMs = millis();
+  // Tick k is due at k * tickPeriod, kept in nanoseconds so the schedule
+  // itself does not drift; microseconds start near the wrap to cross it
+  uint64_t tickPeriodNs = 60000000000ULL / (static_cast<uint64_t>(bpm) * 24);
+  uint32_t baseUs = 0xFFFFFFFFUL - 5000000UL;
+  uint32_t totalTicks = bars * kTicksPerBar;
+  RngState rng = {{0x2545F491u, 0x9E3779B9u, 0x7F4A7C15u, 0x94D049BBu}};
+  uint64_t stepNs = 0;
+  uint32_t lastPhase[2] = {0, 0};
+  LfoOutput outputs[kLfoCount];
+
+  for (uint32_t tick = 1; tick <= totalTicks; ++tick) {
+    uint64_t dueNs = tick * tickPeriodNs;
+    // Control steps up to the tick; the last one is furthest from a timestamp
+    while (stepNs < dueNs) {
+      uint32_t nowUs = baseUs + static_cast<uint32_t>(stepNs / 1000);
+      simBank.step(nowUs, outputs);
+      ++result.steps;
+      for (uint8_t v = 0; v < 2; ++v) {
+        uint32_t phase = simBank.phase(v);
+        uint32_t fromLast = phase - lastPhase[v];
+        if (fromLast > 0x80000000UL) {
+          ++result.reversals;
+        }
+        lastPhase[v] = phase;
+      }
+      stepNs += kStepPeriodUs * 1000ULL;
+      if (stepNs >= dueNs && tick > 2) {
+        // Bar LFO against where the jitter-free clock is: (tick - 1) plus the
+        // part of a tick since it. From the third tick: the first two give
+        // the bank its interval
+        float idealInBar = static_cast<float>((tick - 1) % kTicksPerBar) +
+                           static_cast<float>((stepNs - kStepPeriodUs * 1000ULL) - (dueNs - tickPeriodNs)) /
+                               static_cast<float>(tickPeriodNs);
+        float actualInBar = static_cast<float>(simBank.phase(0)) / 4294967296.0f * kTicksPerBar;
+        float error = fabsf(actualInBar - idealInBar);
+        if (error > kTicksPerBar / 2) {
+          error = kTicksPerBar - error;
+        }
+        result.maxTickError = max(result.maxTickError, error);
+      }
+    }
+
+    int32_t jitter =
+        jitterUs > 0 ? static_cast<int32_t>(rngNext(rng) % (2 * jitterUs + 1)) - jitterUs : 0;
+    uint32_t timestampUs = baseUs + static_cast<uint32_t>(dueNs / 1000) + jitter;
+    simBank.clockTick(tick, timestampUs);
+    if (tick % kTicksPerBar == 0) {
+      // A step at the tick itself must land on the bar exactly
+      simBank.step(timestampUs, outputs);
+      ++result.steps;
+      if (simBank.phase(0) != 0 || simBank.phase(1) != 0) {
+        ++result.barStartErrors;
+      }
+      lastPhase[0] = simBank.phase(0);
+      lastPhase[1] = simBank.phase(1);
+      ++result.bars;
+      if (result.bars % 1000 == 0) {
+        delay(1);  // Long runs: let the idle task feed the watchdog
+      }
+    }
+  }
+  result.ticks = totalTicks;
+
+  // Free running: the accumulator after every step against rate * time
+  double idealCycles = static_cast<double>(result.steps) * config.rateMilliHz / (kLfoControlRateHz * 1000.0);
+  double actualCycles = static_cast<double>(simBank.phase(2)) / 4294967296.0;
+  double drift = actualCycles - (idealCycles - floor(idealCycles));
+  drift -= floor(drift + 0.5);
+  result.freeDriftDeg = static_cast<float>(fabs(drift) * 360.0);
+  result.elapsedMs = millis() - startMs;
+  result.ok = result.bars == bars && result.barStartErrors == 0 && result.reversals == 0 &&
+              result.maxTickError < 0.5f && result.freeDriftDeg < 0.01f;
+  return result;
+}
@@ -10,6 +10,15 @@
 #include <BLEUtils.h>
 #include <BLESecurity.h>
 #include <BLE2902.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/message_buffer.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <string>
+
+#include "headless_router.h"
+#include "midi_transport_queue.h"
 
 // USB MIDI only available on ESP32-S3 with native USB support
 #if USB_MIDI_DEVICE && defined(ARDUINO_USB_MODE)
@@ -68,22 +77,589 @@ void sendHardwareMIDI3(uint8_t byte1, uint8_t byte2, uint8_t byte3) {
   MIDISerial.write(byte3);
 }
 
+#ifndef MIDI_BPM
+#define MIDI_BPM 120  // Tempo at power-up; change it at runtime over MIDI or serial
+#endif
+
+// Clock generator: an esp_timer one-shot re-armed for every pulse against an
+// absolute schedule (fractional microseconds carried), so neither loop()
+// timing nor rounding of the 24 PPQN period adds to the pulse error. The
+// callback runs in the esp_timer task, the highest priority task, and writes
+// the DIN byte itself; BLE, USB and ESP-NOW can block, so the clock sender
+// task it wakes sends those.
+//
+// Tempo control (any channel, from any input port; the CCs are routed too):
+//   CC 20 value v        -> 40 + 2v BPM, ramped over one beat
+//   CC 21 value >= 64    -> tap; the average of the last four taps sets the tempo
+//   F0 7D 01 hi lo n F7  -> (hi << 7 | lo) / 10 BPM, ramped over n beats
+static constexpr float kMinBpm = 20.0f;
+static constexpr float kMaxBpm = 300.0f;
+static constexpr uint8_t kTempoCC = 20;
+static constexpr uint8_t kTapCC = 21;
+static constexpr uint8_t kSysExManufacturer = 0x7D;  // Non-commercial ID
+static constexpr uint8_t kSysExSetTempo = 0x01;
+static constexpr uint8_t kSysExSetRoute = 0x02;
+static constexpr uint8_t kSysExSaveRoutes = 0x03;
+static constexpr uint8_t kSysExDefaultRoutes = 0x04;
+static constexpr uint32_t kTapTimeoutMs = 2000;
+static constexpr uint8_t kTapAverage = 4;
+static constexpr uint16_t kJitterLogSize = 256;
+static constexpr uint32_t kClockStartDelayUs = 1000;
+
+struct ClockPulse {
+  uint32_t index;
+  int64_t atUs;     // Timer callback entry
+  int32_t errorUs;  // Against the schedule
+};
+
+static esp_timer_handle_t clockTimer = nullptr;
+static TaskHandle_t clockSenderTask = nullptr;
+static portMUX_TYPE tempoMux = portMUX_INITIALIZER_UNLOCKED;
+static float currentBpm = MIDI_BPM;
+static float targetBpm = MIDI_BPM;
+static float rampStepBpm = 0.0f;  // Per pulse, 0 when not ramping
+static int64_t nextPulseUs = 0;
+static float nextPulseFracUs = 0.0f;
+static volatile uint32_t clockTick = 0;
+
+// Jitter log: filled by the timer callback, printed by loop()
+static volatile bool jitterLogging = false;
+static ClockPulse jitterLog[kJitterLogSize];
+static volatile uint16_t jitterHead = 0;
+static volatile uint16_t jitterTail = 0;
+static volatile uint32_t jitterOverruns = 0;
+
+void sendMidiClock();
+void sendMidiStart();
+void sendMidiStop();
+
+static void onClockTimer(void *) {
+  int64_t now = esp_timer_get_time();
+  sendHardwareMIDISingle(0xF8);  // DIN first, straight from the timer
+  uint32_t tick = ++clockTick;
+
+  if (jitterLogging) {
+    uint16_t next = (jitterHead + 1) % kJitterLogSize;
+    if (next == jitterTail) {
+      ++jitterOverruns;
+    } else {
+      jitterLog[jitterHead] = {tick, now, static_cast<int32_t>(now - nextPulseUs)};
+      jitterHead = next;
+    }
+  }
+
+  portENTER_CRITICAL(&tempoMux);
+  if (rampStepBpm != 0.0f) {
+    currentBpm += rampStepBpm;
+    if ((rampStepBpm > 0.0f && currentBpm >= targetBpm) || (rampStepBpm < 0.0f && currentBpm <= targetBpm)) {
+      currentBpm = targetBpm;
+      rampStepBpm = 0.0f;
+    }
+  }
+  float periodUs = 60000000.0f / (currentBpm * 24.0f);
+  portEXIT_CRITICAL(&tempoMux);
+
+  float stepUs = periodUs + nextPulseFracUs;
+  int64_t whole = static_cast<int64_t>(stepUs);
+  nextPulseUs += whole;
+  nextPulseFracUs = stepUs - static_cast<float>(whole);
+  int64_t delayUs = nextPulseUs - esp_timer_get_time();
+  if (delayUs < -static_cast<int64_t>(periodUs)) {
+    // More than a pulse behind (flash write, debugger): restart the schedule
+    // rather than bursting the missed pulses
+    nextPulseUs = esp_timer_get_time() + whole;
+    delayUs = whole;
+  }
+  esp_timer_start_once(clockTimer, delayUs > 0 ? static_cast<uint64_t>(delayUs) : 1);
+
+  if (clockSenderTask != nullptr) {
+    xTaskNotifyGive(clockSenderTask);
+  }
+}
+
+static void clockSenderTaskFn(void *) {
+  bool started = false;
+  for (;;) {
+    ulTaskNotifyTake(pdFALSE, portMAX_DELAY);  // One per pulse
+    sendMidiClock();
+    if (!started) {
+      // Start follows the first pulse, as before
+      sendMidiStart();
+      started = true;
+    }
+  }
+}
 
+static void startClockGenerator() {
+  xTaskCreatePinnedToCore(clockSenderTaskFn, "ClockSend", 4096, nullptr, configMAX_PRIORITIES - 2,
+                          &clockSenderTask, 1);
+  esp_timer_create_args_t args = {};
+  args.callback = onClockTimer;
+  args.name = "midi_clock";
+  if (esp_timer_create(&args, &clockTimer) != ESP_OK) {
+    Serial.println("[Clock] esp_timer_create failed");
+    return;
+  }
+  nextPulseUs = esp_timer_get_time() + kClockStartDelayUs;
+  esp_timer_start_once(clockTimer, kClockStartDelayUs);
+  Serial.printf("[Clock] generator running at %.1f BPM\n", currentBpm);
+}
+
+static float getTempo() {
+  portENTER_CRITICAL(&tempoMux);
+  float bpm = currentBpm;
+  portEXIT_CRITICAL(&tempoMux);
+  return bpm;
+}
 
+// Moves to bpm linearly over rampBeats beats (0: at the next pulse)
+static void setTempo(float bpm, float rampBeats) {
+  bpm = constrain(bpm, kMinBpm, kMaxBpm);
+  portENTER_CRITICAL(&tempoMux);
+  targetBpm = bpm;
+  if (rampBeats <= 0.0f || bpm == currentBpm) {
+    currentBpm = bpm;
+    rampStepBpm = 0.0f;
+  } else {
+    rampStepBpm = (bpm - currentBpm) / (rampBeats * 24.0f);
+  }
+  portEXIT_CRITICAL(&tempoMux);
+  Serial.printf("[Clock] tempo %.1f BPM over %.0f beats\n", bpm, rampBeats);
+}
+
+static void tapTempo() {
+  static uint32_t lastTapMs = 0;
+  static uint32_t intervals[kTapAverage] = {};
+  static uint8_t taps = 0;
+  static uint8_t nextInterval = 0;
+  uint32_t now = millis();
+  uint32_t totalMs = 0;
+  uint8_t count = 0;
+  portENTER_CRITICAL(&tempoMux);
+  if (lastTapMs != 0 && now - lastTapMs < kTapTimeoutMs) {
+    intervals[nextInterval] = now - lastTapMs;
+    nextInterval = (nextInterval + 1) % kTapAverage;
+    if (taps < kTapAverage) {
+      ++taps;
+    }
+  } else {
+    taps = 0;
+  }
+  lastTapMs = now;
+  count = taps;
+  for (uint8_t i = 0; i < count; ++i) {
+    totalMs += intervals[i];
+  }
+  portEXIT_CRITICAL(&tempoMux);
+  if (count > 0) {
+    setTempo(60000.0f * count / totalMs, 1.0f);
+  }
+}
+
+static void handleTempoControl(uint8_t control, uint8_t value) {
+  if (control == kTempoCC) {
+    setTempo(40.0f + 2.0f * value, 1.0f);
+  } else if (control == kTapCC && value >= 64) {
+    tapTempo();
+  }
+}
 
 // BLE MIDI setup (minimal, no display dependencies)
 BLECharacteristic *pCharacteristic = nullptr;
 volatile bool deviceConnected = false;
 uint8_t midiPacket[5] = {0x80, 0x80, 0, 0, 0};
-// Transport running state for reliable Start/Stop transitions
-static bool transportRunning = false;
+
+// Routing: every input port goes through the matrix (headless_router.h).
+// midiOutMutex serialises the router and all output writes (routed messages
+// and the clock sender task); the timer callback's DIN byte does not take it.
+// Only loop() routes: the radio callbacks (BLE writes on the BT stack task,
+// ESP-NOW on the Wi-Fi task) copy their input into a message buffer and
+// never wait for the lock or an output write.
+//
+// Routing SysEx (consumed, not forwarded):
+//   F0 7D 02 src dst t0 t1 c0 c1 c2 F7 -> route src to dst (ports: 0 USB, 1 BLE, 2 DIN,
+//                                         3 ESP-NOW), types t0 | t1 << 7, channels
+//                                         c0 | c1 << 7 | c2 << 14
+//   F0 7D 03 F7                        -> save the routes to NVS
+//   F0 7D 04 F7                        -> restore the default routes
+static constexpr size_t kBlePacketBytes = 20;  // Default ATT MTU minus the header
+
+static SemaphoreHandle_t midiOutMutex = nullptr;
+
+static void lockMidiOut() {
+  if (midiOutMutex != nullptr) {
+    xSemaphoreTake(midiOutMutex, portMAX_DELAY);
+  }
+}
+
+static void unlockMidiOut() {
+  if (midiOutMutex != nullptr) {
+    xSemaphoreGive(midiOutMutex);
+  }
+}
+
+// BLE MIDI packets of at most kBlePacketBytes: a timestamp byte before every
+// message; SysEx runs on in continuation packets, with a timestamp before F7
+static void writeBleMidi(const uint8_t *bytes, size_t length) {
+  if (!deviceConnected || !pCharacteristic) {
+    return;
+  }
+  uint16_t timestamp = millis() & 0x1FFF;
+  uint8_t header = 0x80 | (timestamp >> 7);
+  uint8_t stamp = 0x80 | (timestamp & 0x7F);
+  uint8_t packet[kBlePacketBytes];
+  size_t used = 0;
+  auto send = [&]() {
+    if (used > 1) {
+      pCharacteristic->setValue(packet, used);
+      pCharacteristic->notify();
+    }
+    used = 0;
+  };
+  auto reserve = [&](size_t bytesNeeded) {
+    if (used + bytesNeeded > kBlePacketBytes) {
+      send();
+    }
+    if (used == 0) {
+      packet[used++] = header;
+    }
+  };
+
+  size_t pos = 0;
+  while (pos < length) {
+    size_t messageLength = midiMessageLength(bytes + pos, length - pos);
+    if (messageLength == 0) {
+      break;
+    }
+    if (bytes[pos] == 0xF0) {
+      reserve(2);
+      packet[used++] = stamp;
+      for (size_t i = pos; i < pos + messageLength; ++i) {
+        if (bytes[i] == 0xF7) {
+          reserve(2);
+          packet[used++] = stamp;
+        } else {
+          reserve(1);
+        }
+        packet[used++] = bytes[i];
+      }
+    } else {
+      reserve(1 + messageLength);
+      packet[used++] = stamp;
+      memcpy(packet + used, bytes + pos, messageLength);
+      used += messageLength;
+    }
+    pos += messageLength;
+  }
+  send();
+}
+
+// BLE notify() blocks on a congested link, so BLE output has its own queue
+// and sender task (midi_transport_queue.h); clock and routed messages only
+// queue. SysEx does not fit a queue entry and is written in place.
+static constexpr UBaseType_t kBleSenderPriority = 5;  // Below the clock sender and the BLE stack
+static SemaphoreHandle_t bleWriteMutex = nullptr;
+
+static void sendBleBatch(const MidiQueuedMessage *messages, size_t count) {
+  uint8_t bytes[MidiTransportQueue::kBatch * 3];
+  size_t length = 0;
+  for (size_t i = 0; i < count; ++i) {
+    bytes[length++] = messages[i].status;
+    if (messages[i].length > 1) {
+      bytes[length++] = messages[i].data1;
+    }
+    if (messages[i].length > 2) {
+      bytes[length++] = messages[i].data2;
+    }
+  }
+  xSemaphoreTake(bleWriteMutex, portMAX_DELAY);
+  writeBleMidi(bytes, length);
+  xSemaphoreGive(bleWriteMutex);
+}
+
+static MidiTransportQueue bleQueue("BleMidiOut", sendBleBatch, MIDI_QUEUE_KEEP_REALTIME | MIDI_QUEUE_COALESCE_CC);
+
+static void queueBleMidi(const uint8_t *bytes, size_t length) {
+  if (!deviceConnected) {
+    return;
+  }
+  size_t pos = 0;
+  while (pos < length) {
+    size_t messageLength = midiMessageLength(bytes + pos, length - pos);
+    if (messageLength == 0) {
+      break;
+    }
+    if (messageLength <= 3) {
+      bleQueue.push(bytes[pos], messageLength > 1 ? bytes[pos + 1] : 0, messageLength > 2 ? bytes[pos + 2] : 0,
+                    static_cast<uint8_t>(messageLength));
+    } else {
+      xSemaphoreTake(bleWriteMutex, portMAX_DELAY);
+      writeBleMidi(bytes + pos, messageLength);
+      xSemaphoreGive(bleWriteMutex);
+    }
+    pos += messageLength;
+  }
+}
+
+#if ESP_NOW_ENABLED
+// The ESP-NOW MIDI library sends one message per packet
+static void writeEspNowMidi(const uint8_t *bytes, size_t length) {
+  size_t pos = 0;
+  while (pos < length) {
+    size_t messageLength = midiMessageLength(bytes + pos, length - pos);
+    if (messageLength == 0) {
+      break;
+    }
+    uint8_t status = bytes[pos];
+    uint8_t data1 = messageLength > 1 ? bytes[pos + 1] : 0;
+    uint8_t data2 = messageLength > 2 ? bytes[pos + 2] : 0;
+    uint8_t channel = status & 0x0F;
+    switch (status < 0xF0 ? (status & 0xF0) : status) {
+      case 0x80:
+        espNowMIDI.sendNoteOff(data1, data2, channel);
+        break;
+      case 0x90:
+        espNowMIDI.sendNoteOn(data1, data2, channel);
+        break;
+      case 0xB0:
+        espNowMIDI.sendControlChange(data1, data2, channel);
+        break;
+      case 0xC0:
+        espNowMIDI.sendProgramChange(data1, channel);
+        break;
+      case 0xE0:
+        espNowMIDI.sendPitchBend(static_cast<int16_t>(((data2 << 7) | data1) - 8192), channel);
+        break;
+      case 0xF8:
+        espNowMIDI.sendClock();
+        break;
+      case 0xFA:
+        espNowMIDI.sendStart();
+        break;
+      case 0xFB:
+        espNowMIDI.sendContinue();
+        break;
+      case 0xFC:
+        espNowMIDI.sendStop();
+        break;
+      default:
+        break;  // Not carried by the library
+    }
+    pos += messageLength;
+  }
+}
+#endif
+
+// BLE only queues here, so the router's latency for a BLE destination ends
+// when the message is queued; MIDIQ send_max covers the notify itself
+static void writeMidiPort(MidiPort port, const uint8_t *bytes, size_t length) {
+  switch (port) {
+    case MidiPort::DIN:
+      if (HARDWARE_MIDI_ENABLED) {
+        MIDISerial.write(bytes, length);
+      }
+      break;
+    case MidiPort::BLE:
+      queueBleMidi(bytes, length);
+      break;
+    case MidiPort::USB:
+#if USB_MIDI_ENABLED
+      usbMIDI.write(bytes, length);
+#endif
+      break;
+    case MidiPort::ESP_NOW:
+#if ESP_NOW_ENABLED
+      writeEspNowMidi(bytes, length);
+#endif
+      break;
+    default:
+      break;
+  }
+}
+
+static MidiRouter router(writeMidiPort);
+
+// data starts at the manufacturer byte, without F0/F7
+static void handleDongleSysEx(const uint8_t *data, size_t length) {
+  if (length < 2 || data[0] != kSysExManufacturer) {
+    return;
+  }
+  switch (data[1]) {
+    case kSysExSetTempo:
+      if (length >= 5) {
+        uint16_t tenths = static_cast<uint16_t>((data[2] & 0x7F) << 7 | (data[3] & 0x7F));
+        setTempo(tenths / 10.0f, data[4]);
+      }
+      break;
+    case kSysExSetRoute:
+      if (length >= 9 && data[2] < kMidiPortCount && data[3] < kMidiPortCount) {
+        MidiRoute route;
+        route.types = static_cast<uint8_t>(data[4] | (data[5] & 0x01) << 7);
+        route.channels = static_cast<uint16_t>(data[6] | data[7] << 7 | (data[8] & 0x03) << 14);
+        router.setRoute(static_cast<MidiPort>(data[2]), static_cast<MidiPort>(data[3]), route);
+        Serial.printf("[Router] %s -> %s types=0x%02X channels=0x%04X\n", midiPortName(static_cast<MidiPort>(data[2])),
+                      midiPortName(static_cast<MidiPort>(data[3])), route.types, route.channels);
+      }
+      break;
+    case kSysExSaveRoutes:
+      Serial.println(router.save() ? "[Router] routes saved" : "[Router] saving routes failed");
+      break;
+    case kSysExDefaultRoutes:
+      router.setDefaults();
+      Serial.println("[Router] default routes");
+      break;
+    default:
+      break;
+  }
+}
+
+// One complete input message. Called with midiOutMutex held.
+static void handleInputMessage(MidiPort source, const uint8_t *message, size_t length, uint32_t rxUs) {
+  if (message[0] == 0xF0 && length >= 3 && message[1] == kSysExManufacturer) {
+    handleDongleSysEx(message + 1, length - 2);
+    return;
+  }
+  if ((message[0] & 0xF0) == 0xB0 && length == 3) {
+    handleTempoControl(message[1], message[2]);
+  }
+  router.routeMessage(source, message, length, rxUs);
+}
+
+// Radio input records: the receive time (micros()) followed by the payload.
+// One buffer per radio, so each has a single writer and loop() is the reader.
+static constexpr size_t kRadioInputBufferBytes = 2048;
+static constexpr size_t kBleInputMaxBytes = 256;  // Longer writes are dropped
+static MessageBufferHandle_t bleInput = nullptr;
+static uint32_t bleInputDrops = 0;  // Written only on the BT stack task
+
+static bool pushRadioInput(MessageBufferHandle_t buffer, const uint8_t *bytes, size_t length) {
+  uint8_t record[sizeof(uint32_t) + kBleInputMaxBytes];
+  if (buffer == nullptr || length > kBleInputMaxBytes) {
+    return false;
+  }
+  uint32_t rxUs = micros();
+  memcpy(record, &rxUs, sizeof(rxUs));
+  memcpy(record + sizeof(rxUs), bytes, length);
+  return xMessageBufferSend(buffer, record, sizeof(rxUs) + length, 0) > 0;
+}
+
+static MidiStreamParser bleParser;
+
+// BLE MIDI packet: header, then a timestamp byte before every status byte
+// (both have bit 7 set); data bytes and running status in between. Called
+// from loop() with midiOutMutex held.
+static void handleBleMidiPacket(const uint8_t *packet, size_t length, uint32_t rxUs) {
+  if (length < 2 || !(packet[0] & 0x80)) {
+    return;
+  }
+  bool timestampNext = true;
+  for (size_t i = 1; i < length; ++i) {
+    uint8_t byte = packet[i];
+    if (byte & 0x80) {
+      if (timestampNext) {
+        timestampNext = false;
+        continue;
+      }
+      timestampNext = true;
+    }
+    if (bleParser.feed(byte)) {
+      handleInputMessage(MidiPort::BLE, bleParser.message(), bleParser.length(), rxUs);
+    }
+  }
+}
+
+static void drainBleInput() {
+  uint8_t record[sizeof(uint32_t) + kBleInputMaxBytes];
+  size_t length;
+  while ((length = xMessageBufferReceive(bleInput, record, sizeof(record), 0)) > sizeof(uint32_t)) {
+    uint32_t rxUs;
+    memcpy(&rxUs, record, sizeof(rxUs));
+    handleBleMidiPacket(record + sizeof(rxUs), length - sizeof(rxUs), rxUs);
+  }
+}
+
+#if ESP_NOW_ENABLED
+static MessageBufferHandle_t espNowInput = nullptr;
+static uint32_t espNowInputDrops = 0;  // Written only on the Wi-Fi task
+
+static void queueEspNowMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+  uint8_t message[3] = {status, data1, data2};
+  if (!pushRadioInput(espNowInput, message, midiMessageLength(message, sizeof(message)))) {
+    ++espNowInputDrops;
+  }
+}
+
+static void drainEspNowInput() {
+  uint8_t record[sizeof(uint32_t) + 3];
+  size_t length;
+  while ((length = xMessageBufferReceive(espNowInput, record, sizeof(record), 0)) > sizeof(uint32_t)) {
+    uint32_t rxUs;
+    memcpy(&rxUs, record, sizeof(rxUs));
+    handleInputMessage(MidiPort::ESP_NOW, record + sizeof(rxUs), length - sizeof(rxUs), rxUs);
+  }
+}
+#endif
+
+// DIN and USB input arrive as plain byte streams, polled from loop()
+static MidiStreamParser dinParser;
+#if USB_MIDI_ENABLED
+static MidiStreamParser usbParser;
+#endif
+
+static void pollMidiInputs() {
+  bool pending = (HARDWARE_MIDI_ENABLED && MIDISerial.available() > 0) ||
+                 (bleInput != nullptr && !xMessageBufferIsEmpty(bleInput));
+#if USB_MIDI_ENABLED
+  pending = pending || usbMIDI.available() > 0;
+#endif
+#if ESP_NOW_ENABLED
+  pending = pending || (espNowInput != nullptr && !xMessageBufferIsEmpty(espNowInput));
+#endif
+  if (!pending) {
+    return;
+  }
+  lockMidiOut();
+  if (HARDWARE_MIDI_ENABLED && MIDISerial.available() > 0) {
+    uint32_t rxUs = micros();
+    while (MIDISerial.available() > 0) {
+      if (dinParser.feed(static_cast<uint8_t>(MIDISerial.read()))) {
+        handleInputMessage(MidiPort::DIN, dinParser.message(), dinParser.length(), rxUs);
+      }
+    }
+  }
+#if USB_MIDI_ENABLED
+  if (usbMIDI.available() > 0) {
+    uint32_t rxUs = micros();
+    while (usbMIDI.available() > 0) {
+      if (usbParser.feed(static_cast<uint8_t>(usbMIDI.read()))) {
+        handleInputMessage(MidiPort::USB, usbParser.message(), usbParser.length(), rxUs);
+      }
+    }
+  }
+#endif
+  if (bleInput != nullptr) {
+    drainBleInput();
+  }
+#if ESP_NOW_ENABLED
+  if (espNowInput != nullptr) {
+    drainEspNowInput();
+  }
+#endif
+  router.flush();
+  unlockMidiOut();
+}
 
 class MIDICallbacks : public BLEServerCallbacks {
   void onConnect(BLEServer *server) override { deviceConnected = true; }
   void onDisconnect(BLEServer *server) override { deviceConnected = false; BLEDevice::startAdvertising(); }
 };
 class MidiCharacteristicCallbacks : public BLECharacteristicCallbacks {
-  void onWrite(BLECharacteristic *characteristic) override {}
+  void onWrite(BLECharacteristic *characteristic) override {
+    std::string value = characteristic->getValue();
+    if (!pushRadioInput(bleInput, reinterpret_cast<const uint8_t *>(value.data()), value.size())) {
+      ++bleInputDrops;
+    }
+  }
 };
 void setupBLE() {
   BLEDevice::init("aCYD-HEADLESS");
@@ -118,16 +694,6 @@ void setupBLE() {
   BLEDevice::startAdvertising();
 }
 
-#define MIDI_BPM 120
-/* MIDI clock runs at 24 ticks per quarter note. Compute interval in microseconds
- * to avoid millisecond truncation and improve timing precision. */
-#define MIDI_CLOCK_INTERVAL_US (60000000UL / (MIDI_BPM * 24UL))
-
-
-
-unsigned long lastClock = 0;
-uint32_t clockTick = 0;
-
 #if ESP_NOW_ENABLED
 // ESP-NOW message handlers
 void onEspNowReceive(const uint8_t* mac, const uint8_t* data, int len) {
@@ -141,9 +707,22 @@ void setup() {
   Serial.println("aCYD-HEADLESS starting...");
   Serial.flush();
 
+  midiOutMutex = xSemaphoreCreateMutex();
+  bleWriteMutex = xSemaphoreCreateMutex();
+  bleInput = xMessageBufferCreate(kRadioInputBufferBytes);
+#if ESP_NOW_ENABLED
+  espNowInput = xMessageBufferCreate(kRadioInputBufferBytes);
+#endif
+  if (router.load()) {
+    Serial.println("[Router] routes loaded from NVS");
+  } else {
+    router.setDefaults();
+  }
+
 #if USB_MIDI_ENABLED
   Serial.println("Step 1: Initializing USB MIDI");
   MIDI_USB.begin(MIDI_CHANNEL_OMNI);
+  MIDI_USB.turnThruOff();  // Input is read raw from usbMIDI and routed
   Serial.println("USB MIDI initialized");
 #endif
 
@@ -152,6 +731,7 @@ void setup() {
   
   Serial.println("Step 3: setupBLE()");
   setupBLE();
+  bleQueue.begin(kBleSenderPriority, 0);
   
   Serial.println("Step 4: initializing hardware MIDI");
   initHardwareMIDI();
@@ -160,95 +740,25 @@ void setup() {
   // Initialize ESP-NOW MIDI with auto-peer discovery enabled and low latency
   espNowMIDI.begin(false, true);  // (encryption=false, low_latency=true)
 
-  // Register ESP-NOW MIDI handlers for routing received messages
-  espNowMIDI.setHandleNoteOn([](byte channel, byte note, byte velocity) {
-    Serial.printf("[ESP-NOW RX] Note On: Ch=%d, Note=%d, Vel=%d\n", channel, note, velocity);
-    if (deviceConnected && pCharacteristic) {
-      uint8_t packet[5] = {0x80, 0x80, static_cast<uint8_t>(0x90 | channel), note, velocity};
-      pCharacteristic->setValue(packet, 5);
-      pCharacteristic->notify();
-    }
-    sendHardwareMIDI3(0x90 | channel, note, velocity);
-#if USB_MIDI_ENABLED
-    MIDI_USB.sendNoteOn(note, velocity, channel + 1);
-#endif
-  });
-
-  espNowMIDI.setHandleNoteOff([](byte channel, byte note, byte velocity) {
-    Serial.printf("[ESP-NOW RX] Note Off: Ch=%d, Note=%d, Vel=%d\n", channel, note, velocity);
-    if (deviceConnected && pCharacteristic) {
-      uint8_t packet[5] = {0x80, 0x80, static_cast<uint8_t>(0x80 | channel), note, velocity};
-      pCharacteristic->setValue(packet, 5);
-      pCharacteristic->notify();
-    }
-    sendHardwareMIDI3(0x80 | channel, note, velocity);
-#if USB_MIDI_ENABLED
-    MIDI_USB.sendNoteOff(note, velocity, channel + 1);
-#endif
-  });
-
-  espNowMIDI.setHandleControlChange([](byte channel, byte control, byte value) {
-    Serial.printf("[ESP-NOW RX] CC: Ch=%d, CC=%d, Val=%d\n", channel, control, value);
-    if (deviceConnected && pCharacteristic) {
-      uint8_t packet[5] = {0x80, 0x80, static_cast<uint8_t>(0xB0 | channel), control, value};
-      pCharacteristic->setValue(packet, 5);
-      pCharacteristic->notify();
-    }
-    sendHardwareMIDI3(0xB0 | channel, control, value);
-#if USB_MIDI_ENABLED
-    MIDI_USB.sendControlChange(control, value, channel + 1);
-#endif
-  });
-
-  espNowMIDI.setHandleClock([]() {
-    if (deviceConnected && pCharacteristic) {
-      uint8_t packet[5] = {0x80, 0x80, 0xF8, 0x00, 0x00};
-      pCharacteristic->setValue(packet, 5);
-      pCharacteristic->notify();
-    }
-    sendHardwareMIDISingle(0xF8);
-#if USB_MIDI_ENABLED
-    MIDI_USB.sendRealTime(midi::Clock);
-#endif
-  });
-
+  // Received messages are queued for loop(), which routes them
+  espNowMIDI.setHandleNoteOn(
+      [](byte channel, byte note, byte velocity) { queueEspNowMessage(0x90 | channel, note, velocity); });
+  espNowMIDI.setHandleNoteOff(
+      [](byte channel, byte note, byte velocity) { queueEspNowMessage(0x80 | channel, note, velocity); });
+  espNowMIDI.setHandleControlChange(
+      [](byte channel, byte control, byte value) { queueEspNowMessage(0xB0 | channel, control, value); });
+  espNowMIDI.setHandleClock([]() { queueEspNowMessage(0xF8, 0, 0); });
   espNowMIDI.setHandleStart([]() {
     Serial.println("[ESP-NOW RX] Start");
-    if (deviceConnected && pCharacteristic) {
-      uint8_t packet[5] = {0x80, 0x80, 0xFA, 0x00, 0x00};
-      pCharacteristic->setValue(packet, 5);
-      pCharacteristic->notify();
-    }
-    sendHardwareMIDISingle(0xFA);
-#if USB_MIDI_ENABLED
-    MIDI_USB.sendRealTime(midi::Start);
-#endif
+    queueEspNowMessage(0xFA, 0, 0);
   });
-
   espNowMIDI.setHandleStop([]() {
     Serial.println("[ESP-NOW RX] Stop");
-    if (deviceConnected && pCharacteristic) {
-      uint8_t packet[5] = {0x80, 0x80, 0xFC, 0x00, 0x00};
-      pCharacteristic->setValue(packet, 5);
-      pCharacteristic->notify();
-    }
-    sendHardwareMIDISingle(0xFC);
-#if USB_MIDI_ENABLED
-    MIDI_USB.sendRealTime(midi::Stop);
-#endif
+    queueEspNowMessage(0xFC, 0, 0);
   });
-
   espNowMIDI.setHandleContinue([]() {
     Serial.println("[ESP-NOW RX] Continue");
-    if (deviceConnected && pCharacteristic) {
-      uint8_t packet[5] = {0x80, 0x80, 0xFB, 0x00, 0x00};
-      pCharacteristic->setValue(packet, 5);
-      pCharacteristic->notify();
-    }
-    sendHardwareMIDISingle(0xFB);
-#if USB_MIDI_ENABLED
-    MIDI_USB.sendRealTime(midi::Continue);
-#endif
+    queueEspNowMessage(0xFB, 0, 0);
   });
 
   Serial.println("ESP-NOW MIDI master initialized");
@@ -258,6 +768,7 @@ void setup() {
   Serial.println("Step 5: ESP-NOW disabled in build");
 #endif
   
+  startClockGenerator();
   Serial.println("Setup complete - Headless MIDI master ready");
 }
 
@@ -265,15 +776,14 @@ void setup() {
 
 
 
-// Unified MIDI clock/start/stop for BLE, hardware, USB, and ESP-NOW
+// Unified MIDI clock/start/stop for BLE, hardware, USB, and ESP-NOW.
+// The clock's DIN byte is written by the timer callback; BLE only queues.
 void sendMidiClock() {
+  lockMidiOut();
   // BLE MIDI
-  if (deviceConnected && pCharacteristic) {
-    uint8_t packet[5] = {0x80, 0x80, 0xF8, 0x00, 0x00};
-    pCharacteristic->setValue(packet, 5);
+  if (deviceConnected) {
+    bleQueue.push(0xF8, 0, 0, 1);
   }
-  // Hardware MIDI
-  sendHardwareMIDISingle(0xF8);
 #if USB_MIDI_ENABLED
   // USB MIDI
   MIDI_USB.sendRealTime(midi::Clock);
@@ -285,13 +795,13 @@ void sendMidiClock() {
   // USB Serial debug (only when enabled for debugging to avoid jitter)
 #ifdef DEBUG_MIDI_CLOCK
 #endif
+  unlockMidiOut();
 }
 
 void sendMidiStart() {
-  if (deviceConnected && pCharacteristic) {
-    uint8_t packet[5] = {0x80, 0x80, 0xFA, 0x00, 0x00};
-    pCharacteristic->setValue(packet, 5);
-    pCharacteristic->notify();
+  lockMidiOut();
+  if (deviceConnected) {
+    bleQueue.push(0xFA, 0, 0, 1);
   }
   sendHardwareMIDISingle(0xFA);
 #if USB_MIDI_ENABLED
@@ -300,14 +810,14 @@ void sendMidiStart() {
 #if ESP_NOW_ENABLED
   espNowMIDI.sendStart();
 #endif
+  unlockMidiOut();
   Serial.println("MIDI Start");
 }
 
 void sendMidiStop() {
-  if (deviceConnected && pCharacteristic) {
-    uint8_t packet[5] = {0x80, 0x80, 0xFC, 0x00, 0x00};
-    pCharacteristic->setValue(packet, 5);
-    pCharacteristic->notify();
+  lockMidiOut();
+  if (deviceConnected) {
+    bleQueue.push(0xFC, 0, 0, 1);
   }
   sendHardwareMIDISingle(0xFC);
 #if USB_MIDI_ENABLED
@@ -316,26 +826,185 @@ void sendMidiStop() {
 #if ESP_NOW_ENABLED
   espNowMIDI.sendStop();
 #endif
+  unlockMidiOut();
   Serial.println("MIDI Stop");
 }
 
-void loop() {
-#if USB_MIDI_ENABLED
-  // Process USB MIDI input
-  MIDI_USB.read();
+// Jitter log lines: CLK,<pulse>,<time us>,<interval us>,<error us>. The
+// summary is printed when logging is switched off.
+struct JitterSummary {
+  uint32_t pulses = 0;
+  int64_t lastUs = 0;
+  int32_t minErrorUs = 0;
+  int32_t maxErrorUs = 0;
+  double sumSq = 0.0;
+};
+
+static JitterSummary jitterSummary;
+
+static void drainJitterLog() {
+  while (jitterTail != jitterHead) {
+    ClockPulse pulse = jitterLog[jitterTail];
+    jitterTail = (jitterTail + 1) % kJitterLogSize;
+    int32_t intervalUs = jitterSummary.pulses > 0 ? static_cast<int32_t>(pulse.atUs - jitterSummary.lastUs) : 0;
+    Serial.printf("CLK,%u,%lld,%d,%d\n", pulse.index, static_cast<long long>(pulse.atUs), intervalUs,
+                  pulse.errorUs);
+    if (jitterSummary.pulses == 0 || pulse.errorUs < jitterSummary.minErrorUs) {
+      jitterSummary.minErrorUs = pulse.errorUs;
+    }
+    if (jitterSummary.pulses == 0 || pulse.errorUs > jitterSummary.maxErrorUs) {
+      jitterSummary.maxErrorUs = pulse.errorUs;
+    }
+    jitterSummary.sumSq += static_cast<double>(pulse.errorUs) * pulse.errorUs;
+    jitterSummary.lastUs = pulse.atUs;
+    ++jitterSummary.pulses;
+  }
+}
+
+static void printRoutes() {
+  Serial.println("CLI: ROUTES src->dst types channels messages avg_us max_us (->BLE: until queued, see MIDIQ)");
+  for (uint8_t s = 0; s < kMidiPortCount; ++s) {
+    for (uint8_t d = 0; d < kMidiPortCount; ++d) {
+      if (s == d) {
+        continue;
+      }
+      MidiPort source = static_cast<MidiPort>(s);
+      MidiPort destination = static_cast<MidiPort>(d);
+      lockMidiOut();
+      MidiRoute route = router.getRoute(source, destination);
+      MidiRouteStats st = router.stats(source, destination);
+      unlockMidiOut();
+      uint32_t avgUs = st.messages > 0 ? static_cast<uint32_t>(st.totalLatencyUs / st.messages) : 0;
+      Serial.printf("CLI: ROUTE %s->%s 0x%02X 0x%04X %u %u %u\n", midiPortName(source), midiPortName(destination),
+                    route.types, route.channels, st.messages, avgUs, st.maxLatencyUs);
+    }
+  }
+  for (uint8_t s = 0; s < kMidiPortCount; ++s) {
+    Serial.printf("CLI: UNROUTED %s %u\n", midiPortName(static_cast<MidiPort>(s)),
+                  router.unrouted(static_cast<MidiPort>(s)));
+  }
+#if ESP_NOW_ENABLED
+  Serial.printf("CLI: INPUT_DROPS BLE %u ESPNOW %u\n", bleInputDrops, espNowInputDrops);
+#else
+  Serial.printf("CLI: INPUT_DROPS BLE %u\n", bleInputDrops);
 #endif
+}
 
-  unsigned long now = micros();
-  if (now - lastClock >= MIDI_CLOCK_INTERVAL_US) {
-    lastClock += MIDI_CLOCK_INTERVAL_US;
-    sendMidiClock();
-    clockTick++;
-    // Transport start/stop handling: send Start on transition to running
-    if (clockTick == 1 && !transportRunning) {
+static bool parsePort(const char *name, MidiPort &port) {
+  for (uint8_t i = 0; i < kMidiPortCount; ++i) {
+    if (strcmp(name, midiPortName(static_cast<MidiPort>(i))) == 0) {
+      port = static_cast<MidiPort>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Serial commands: BPM <bpm> [beats], TAP, START, STOP, JITTER ON|OFF,
+// ROUTES [SAVE|DEFAULT|RESET], ROUTE <src> <dst> <types hex> <channels hex>
+// (ports USB, BLE, DIN, ESPNOW), MIDIQ [RESET], MIDIQ SLOW <ms> (stalls the
+// BLE sender before every send, to check that the jitter log does not move)
+static void processSerialCommands() {
+  static String line;
+  while (Serial.available()) {
+    int c = Serial.read();
+    if (c == '\r') {
+      continue;
+    }
+    if (c != '\n') {
+      if (line.length() < 64) {
+        line += static_cast<char>(c);
+      }
+      continue;
+    }
+    String cmd = line;
+    line = "";
+    cmd.trim();
+    cmd.toUpperCase();
+    if (cmd.startsWith("BPM")) {
+      float bpm = getTempo();
+      float beats = 0.0f;
+      sscanf(cmd.c_str(), "BPM %f %f", &bpm, &beats);
+      setTempo(bpm, beats);
+    } else if (cmd == "TAP") {
+      tapTempo();
+    } else if (cmd == "START") {
       sendMidiStart();
-      transportRunning = true;
+    } else if (cmd == "STOP") {
+      sendMidiStop();
+    } else if (cmd == "ROUTES") {
+      printRoutes();
+    } else if (cmd == "ROUTES SAVE") {
+      lockMidiOut();
+      bool saved = router.save();
+      unlockMidiOut();
+      Serial.println(saved ? "CLI: ROUTES SAVED" : "CLI: ROUTES SAVE FAILED");
+    } else if (cmd == "ROUTES DEFAULT") {
+      lockMidiOut();
+      router.setDefaults();
+      unlockMidiOut();
+      Serial.println("CLI: ROUTES DEFAULT");
+    } else if (cmd == "ROUTES RESET") {
+      lockMidiOut();
+      router.resetStats();
+      unlockMidiOut();
+      Serial.println("CLI: ROUTES STATS RESET");
+    } else if (cmd.startsWith("ROUTE ")) {
+      char sourceName[8] = {};
+      char destinationName[8] = {};
+      unsigned types = 0;
+      unsigned channels = 0;
+      MidiPort source;
+      MidiPort destination;
+      if (sscanf(cmd.c_str(), "ROUTE %7s %7s %x %x", sourceName, destinationName, &types, &channels) == 4 &&
+          parsePort(sourceName, source) && parsePort(destinationName, destination) && source != destination) {
+        MidiRoute route;
+        route.types = static_cast<uint8_t>(types);
+        route.channels = static_cast<uint16_t>(channels);
+        lockMidiOut();
+        router.setRoute(source, destination, route);
+        unlockMidiOut();
+        Serial.printf("CLI: ROUTE %s->%s 0x%02X 0x%04X\n", midiPortName(source), midiPortName(destination),
+                      route.types, route.channels);
+      } else {
+        Serial.println("CLI: ROUTE usage: ROUTE <src> <dst> <types hex> <channels hex>");
+      }
+    } else if (cmd.startsWith("MIDIQ SLOW")) {
+      int ms = 0;
+      sscanf(cmd.c_str(), "MIDIQ SLOW %d", &ms);
+      bleQueue.setSendDelayMs(static_cast<uint16_t>(constrain(ms, 0, 1000)));
+      Serial.printf("CLI: MIDIQ SLOW %s %ums\n", bleQueue.name(), bleQueue.sendDelayMs());
+    } else if (cmd.startsWith("MIDIQ")) {
+      MidiQueueStats st = bleQueue.stats();
+      Serial.printf("CLI: MIDIQ %s depth=%u max=%u queued=%u sent=%u batches=%u coalesced=%u dropped=%u evicted=%u "
+                    "rt_drops=%u send_max=%uus slow=%ums\n",
+                    bleQueue.name(), static_cast<unsigned>(bleQueue.depth()), st.maxDepth, st.queued, st.sent,
+                    st.batches, st.coalesced, st.dropped, st.evicted, st.realtimeDrops, st.maxSendUs,
+                    bleQueue.sendDelayMs());
+      if (cmd.indexOf("RESET") != -1) {
+        bleQueue.resetStats();
+      }
+    } else if (cmd == "JITTER ON") {
+      jitterSummary = JitterSummary();
+      jitterOverruns = 0;
+      jitterTail = jitterHead;
+      jitterLogging = true;
+      Serial.println("CLK,pulse,time_us,interval_us,error_us");
+    } else if (cmd == "JITTER OFF") {
+      jitterLogging = false;
+      drainJitterLog();
+      uint32_t n = jitterSummary.pulses;
+      Serial.printf("CLI: JITTER pulses=%u error=%d..%dus rms=%.1fus overruns=%u bpm=%.1f\n", n,
+                    jitterSummary.minErrorUs, jitterSummary.maxErrorUs,
+                    n > 0 ? sqrt(jitterSummary.sumSq / n) : 0.0, jitterOverruns, getTempo());
     }
   }
+}
+
+void loop() {
+  pollMidiInputs();
+  processSerialCommands();
+  drainJitterLog();
   delay(1); // Yield to watchdog
 }
 
@@ -0,0 +1,74 @@
+#include "memory_pools.h"
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+
+namespace {
+struct PoolEntry {
+  const char *name;
+  uint32_t bytes;
+  PoolPlacement placement;
+  bool failed;
+};
+
+static constexpr uint8_t kMaxPoolEntries = 16;
+static PoolEntry poolEntries[kMaxPoolEntries];
+static uint8_t poolEntryCount = 0;
+
+static void recordEntry(const char *name, size_t bytes, PoolPlacement placement, bool failed) {
+  for (uint8_t i = 0; i < poolEntryCount; ++i) {
+    PoolEntry &entry = poolEntries[i];
+    if (strcmp(entry.name, name) == 0) {
+      if (bytes >= entry.bytes) {
+        entry = {name, static_cast<uint32_t>(bytes), placement, failed};
+      }
+      return;
+    }
+  }
+  if (poolEntryCount >= kMaxPoolEntries) {
+    return;
+  }
+  poolEntries[poolEntryCount++] = {name, static_cast<uint32_t>(bytes), placement, failed};
+}
+
+static const char *placementName(PoolPlacement placement) {
+  switch (placement) {
+    case PoolPlacement::PSRAM:    return "psram";
+    case PoolPlacement::INTERNAL: return "internal";
+    default:                      return "static";
+  }
+}
+}  // namespace
+
+void *poolAllocatePreferPsram(const char *name, size_t bytes) {
+  void *block = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  PoolPlacement placement = PoolPlacement::PSRAM;
+  if (!block) {
+    block = heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    placement = PoolPlacement::INTERNAL;
+  }
+  recordEntry(name, bytes, placement, block == nullptr);
+  if (!block) {
+    Serial.printf("[MEM] Unable to allocate %u bytes for %s\n", static_cast<unsigned>(bytes), name);
+  }
+  return block;
+}
+
+void poolNoteStatic(const char *name, size_t bytes) {
+  recordEntry(name, bytes, PoolPlacement::STATIC, false);
+}
+
+void poolPrintReport() {
+  uint32_t totals[3] = {0, 0, 0};
+  Serial.println("Memory pools:");
+  for (uint8_t i = 0; i < poolEntryCount; ++i) {
+    const PoolEntry &entry = poolEntries[i];
+    Serial.printf("  %-24s %6u B %s%s\n", entry.name, entry.bytes, placementName(entry.placement),
+                  entry.failed ? " (FAILED)" : "");
+    if (!entry.failed) {
+      totals[static_cast<uint8_t>(entry.placement)] += entry.bytes;
+    }
+  }
+  Serial.printf("  total: psram=%u internal=%u static=%u\n", totals[0], totals[1], totals[2]);
+}
@@ -1,6 +1,9 @@
 #include "midi_clock_task.h"
 
 #include "clock_manager.h"
+#include "esp_now_midi_module.h"
+#include "midi_transport.h"
+#include "module_fractal_echo_mode.h"
 
 #include <Arduino.h>
 #include <freertos/FreeRTOS.h>
@@ -14,7 +17,12 @@ static constexpr uint16_t kStackDepth = 4096;
 
 static void midiClockTask(void * /*unused*/) {
   while (true) {
+    midiTransportProcessInput();  // Pulses first, so the clock update sees them
     updateClockManager();
+    processFractalEcho();
+#if ESP_NOW_ENABLED
+    espNowMidiService();  // Sends the tick's frame once the notes that follow its pulse are in
+#endif
     vTaskDelay(kClockTaskDelay);
   }
 }
@@ -0,0 +1,369 @@
+#include "midi_control_coalescer.h"
+
+#include "midi_utils.h"
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+
+namespace {
+static constexpr uint8_t kCcNrpnMsb = 99;
+static constexpr uint8_t kCcNrpnLsb = 98;
+static constexpr uint8_t kCcDataMsb = 6;
+static constexpr uint8_t kCcDataLsb = 38;
+static constexpr uint8_t kCc14LsbOffset = 32;
+
+// DIN and ESP-NOW carry a value in a few hundred us; BLE and WiFi batch per
+// connection event or packet, so more than one update per window is wasted
+static constexpr uint16_t kDefaultMaxRateHz[kMidiControlDestinations] = {
+    50,   // BLE
+    100,  // DIN
+    100,  // ESP-NOW
+    50,   // WiFi
+};
+
+uint8_t bytesFor(MidiControlKind kind) {
+  switch (kind) {
+    case MidiControlKind::CC14:
+      return 6;
+    case MidiControlKind::NRPN:
+      return 12;
+    default:
+      return 3;
+  }
+}
+
+MidiControlCoalescer coalescer;
+portMUX_TYPE coalescerMux = portMUX_INITIALIZER_UNLOCKED;
+uint16_t maxRateHz[kMidiControlDestinations] = {kDefaultMaxRateHz[0], kDefaultMaxRateHz[1], kDefaultMaxRateHz[2],
+                                                kDefaultMaxRateHz[3]};
+uint32_t lastFlushUs[kMidiControlDestinations] = {};
+MidiControlStats stats = {};
+
+// Filled under the lock by flush(), sent after it (output task only)
+struct PendingMessage {
+  uint8_t status;
+  uint8_t data1;
+  uint8_t data2;
+};
+PendingMessage outgoing[kMidiControlMaxMessages];
+size_t outgoingCount = 0;
+
+void collect(uint8_t, uint8_t status, uint8_t data1, uint8_t data2) {
+  if (outgoingCount < kMidiControlMaxMessages) {
+    outgoing[outgoingCount++] = {status, data1, data2};
+  }
+}
+
+void record(MidiControlKind kind, uint8_t channel, uint16_t controller, uint16_t value) {
+  channel &= 0x0F;
+  portENTER_CRITICAL(&coalescerMux);
+  bool stored = coalescer.update(kind, channel, controller, value);
+  ++stats.updates;
+  stats.requestedBytes += bytesFor(kind);
+  if (!stored) {
+    ++stats.overflows;
+  }
+  portEXIT_CRITICAL(&coalescerMux);
+  if (stored) {
+    return;
+  }
+  // Table full: straight out, unthrottled
+  uint8_t cc = 0xB0 | channel;
+  switch (kind) {
+    case MidiControlKind::CC7:
+      sendMIDI(cc, controller, value);
+      break;
+    case MidiControlKind::CC14:
+      sendMIDI(cc, controller, value >> 7);
+      sendMIDI(cc, controller + kCc14LsbOffset, value & 0x7F);
+      break;
+    case MidiControlKind::NRPN:
+      sendMIDI(cc, kCcNrpnMsb, controller >> 7);
+      sendMIDI(cc, kCcNrpnLsb, controller & 0x7F);
+      sendMIDI(cc, kCcDataMsb, value >> 7);
+      sendMIDI(cc, kCcDataLsb, value & 0x7F);
+      break;
+    case MidiControlKind::PITCH_BEND:
+      sendMIDI(0xE0 | channel, value & 0x7F, value >> 7);
+      break;
+  }
+}
+}  // namespace
+
+bool MidiControlCoalescer::update(MidiControlKind kind, uint8_t channel, uint16_t controller, uint16_t value) {
+  if (kind == MidiControlKind::PITCH_BEND) {
+    controller = 0;
+  }
+  Slot *slot = nullptr;
+  Slot *free = nullptr;
+  Slot *settled = nullptr;
+  for (Slot &candidate : slots_) {
+    if (!candidate.used) {
+      free = free != nullptr ? free : &candidate;
+      continue;
+    }
+    if (candidate.pending == 0 && settled == nullptr) {
+      settled = &candidate;
+    }
+    if (candidate.kind == kind && candidate.channel == channel && candidate.controller == controller) {
+      slot = &candidate;
+      break;
+    }
+  }
+  if (slot == nullptr) {
+    free = free != nullptr ? free : settled;  // Every destination has that one's value
+    if (free == nullptr) {
+      return false;
+    }
+    slot = free;
+    *slot = {};
+    slot->used = true;
+    slot->kind = kind;
+    slot->channel = channel;
+    slot->controller = controller;
+  }
+  slot->value = value;
+  slot->pending = 0;
+  // A destination that already holds the value has nothing to send
+  for (uint8_t d = 0; d < kMidiControlDestinations; ++d) {
+    if (!(slot->known & (1 << d)) || slot->sent[d] != value) {
+      slot->pending |= 1 << d;
+    }
+  }
+  return true;
+}
+
+size_t MidiControlCoalescer::flush(uint8_t destination, MidiControlEmit emit) {
+  if (destination >= kMidiControlDestinations) {
+    return 0;
+  }
+  uint8_t bit = 1 << destination;
+  size_t messages = 0;
+  for (Slot &slot : slots_) {
+    if (!slot.used || !(slot.pending & bit)) {
+      continue;
+    }
+    uint8_t cc = 0xB0 | slot.channel;
+    uint8_t msb = slot.value >> 7;
+    uint8_t lsb = slot.value & 0x7F;
+    bool msbChanged = !(slot.known & bit) || (slot.sent[destination] >> 7) != msb;
+    switch (slot.kind) {
+      case MidiControlKind::CC7:
+        emit(destination, cc, slot.controller, slot.value);
+        ++messages;
+        break;
+      case MidiControlKind::CC14:
+        if (msbChanged) {
+          emit(destination, cc, slot.controller, msb);  // Receivers reset the LSB on an MSB
+          ++messages;
+        }
+        emit(destination, cc, slot.controller + kCc14LsbOffset, lsb);
+        ++messages;
+        break;
+      case MidiControlKind::NRPN: {
+        bool &selectedKnown = nrpnKnown_[destination][slot.channel];
+        uint16_t &selected = nrpnSelected_[destination][slot.channel];
+        if (!selectedKnown || selected != slot.controller) {
+          emit(destination, cc, kCcNrpnMsb, slot.controller >> 7);
+          emit(destination, cc, kCcNrpnLsb, slot.controller & 0x7F);
+          messages += 2;
+          selected = slot.controller;
+          selectedKnown = true;
+          msbChanged = true;  // Data entry starts over on a new parameter
+        }
+        if (msbChanged) {
+          emit(destination, cc, kCcDataMsb, msb);
+          ++messages;
+        }
+        emit(destination, cc, kCcDataLsb, lsb);
+        ++messages;
+        break;
+      }
+      case MidiControlKind::PITCH_BEND:
+        emit(destination, 0xE0 | slot.channel, lsb, msb);
+        ++messages;
+        break;
+    }
+    slot.sent[destination] = slot.value;
+    slot.known |= bit;
+    slot.pending &= ~bit;
+  }
+  return messages;
+}
+
+void sendMIDIControl(uint8_t channel, uint8_t controller, uint8_t value) {
+  record(MidiControlKind::CC7, channel, controller & 0x7F, value & 0x7F);
+}
+
+void sendMIDIControl14(uint8_t channel, uint8_t controller, uint16_t value) {
+  record(MidiControlKind::CC14, channel, controller & 0x1F, value & 0x3FFF);
+}
+
+void sendMIDINrpn(uint8_t channel, uint16_t parameter, uint16_t value) {
+  record(MidiControlKind::NRPN, channel, parameter & 0x3FFF, value & 0x3FFF);
+}
+
+void sendMIDIPitchBend(uint8_t channel, uint16_t value) {
+  record(MidiControlKind::PITCH_BEND, channel, 0, value > 0x3FFF ? 0x3FFF : value);
+}
+
+void midiControlService(uint32_t nowUs) {
+  for (uint8_t d = 0; d < kMidiControlDestinations; ++d) {
+    uint16_t hz = maxRateHz[d];
+    if (hz > 0 && nowUs - lastFlushUs[d] < 1000000UL / hz) {
+      continue;
+    }
+    outgoingCount = 0;
+    portENTER_CRITICAL(&coalescerMux);
+    coalescer.flush(d, collect);
+    portEXIT_CRITICAL(&coalescerMux);
+    if (outgoingCount == 0) {
+      continue;  // An idle destination sends the next change at once
+    }
+    lastFlushUs[d] = nowUs;
+    for (size_t i = 0; i < outgoingCount; ++i) {
+      sendMIDITo(static_cast<MidiOutPort>(d), outgoing[i].status, outgoing[i].data1, outgoing[i].data2);
+    }
+    portENTER_CRITICAL(&coalescerMux);
+    ++stats.flushes[d];
+    stats.sentMessages[d] += outgoingCount;
+    stats.sentBytes[d] += outgoingCount * 3;
+    portEXIT_CRITICAL(&coalescerMux);
+  }
+}
+
+void midiControlSetMaxRate(uint8_t destination, uint16_t hz) {
+  if (destination < kMidiControlDestinations) {
+    maxRateHz[destination] = hz;
+  }
+}
+
+uint16_t midiControlGetMaxRate(uint8_t destination) {
+  return destination < kMidiControlDestinations ? maxRateHz[destination] : 0;
+}
+
+MidiControlStats midiControlGetStats() {
+  portENTER_CRITICAL(&coalescerMux);
+  MidiControlStats copy = stats;
+  portEXIT_CRITICAL(&coalescerMux);
+  return copy;
+}
+
+void midiControlResetStats() {
+  portENTER_CRITICAL(&coalescerMux);
+  stats = {};
+  portEXIT_CRITICAL(&coalescerMux);
+}
+
+// Simulation ----------------------------------------------------------------
+
+namespace {
+struct SimState {
+  uint32_t nowUs;
+  uint32_t sentBytes[kMidiControlDestinations];
+  uint32_t firstPendingUs[kMidiControlDestinations];
+  bool pending[kMidiControlDestinations];
+  uint32_t maxLagUs[kMidiControlDestinations];
+  int32_t lastBend[kMidiControlDestinations];
+  uint16_t maxStep[kMidiControlDestinations];
+  // Last value each destination holds: bend, CC 74, XY CC 16 and 17
+  int32_t finalValue[kMidiControlDestinations][4];
+};
+
+SimState sim;
+
+void simEmit(uint8_t destination, uint8_t status, uint8_t data1, uint8_t data2) {
+  sim.sentBytes[destination] += 3;
+  if ((status & 0xF0) == 0xE0) {
+    int32_t bend = data1 | (data2 << 7);
+    if (sim.lastBend[destination] >= 0) {
+      uint16_t step = static_cast<uint16_t>(abs(bend - sim.lastBend[destination]));
+      sim.maxStep[destination] = max(sim.maxStep[destination], step);
+    }
+    sim.lastBend[destination] = bend;
+    sim.finalValue[destination][0] = bend;
+  } else if (data1 == 74) {
+    sim.finalValue[destination][1] = data2;
+  } else if (data1 == 16 || data1 == 17) {
+    sim.finalValue[destination][2 + (data1 - 16)] = data2;
+  }
+}
+}  // namespace
+
+MidiControlSimResult midiControlRunSimulation(uint16_t updateHz, uint16_t seconds) {
+  MidiControlSimResult result = {};
+  static MidiControlCoalescer simCoalescer;  // Too large for the CLI stack
+  simCoalescer = MidiControlCoalescer();
+  sim = {};
+  for (uint8_t d = 0; d < kMidiControlDestinations; ++d) {
+    sim.lastBend[d] = -1;
+    for (uint8_t v = 0; v < 4; ++v) {
+      sim.finalValue[d][v] = -1;
+    }
+  }
+  uint32_t lastFlush[kMidiControlDestinations] = {};
+  int32_t target[4] = {-1, -1, -1, -1};
+  int32_t lastInputBend = -1;
+
+  uint32_t updatePeriodUs = 1000000UL / (updateHz > 0 ? updateHz : 1);
+  uint64_t endUs = static_cast<uint64_t>(seconds) * 1000000ULL;
+  for (uint64_t t = 0; t <= endUs + 1000000ULL; t += 1000) {  // Output task pass every 1 ms, plus a second to drain
+    sim.nowUs = static_cast<uint32_t>(t);
+    if (t <= endUs && t % updatePeriodUs < 1000) {
+      double phase = static_cast<double>(t) / 1000000.0;
+      int32_t values[4] = {
+          static_cast<int32_t>(8192 + 8191 * sin(2 * PI * 0.5 * phase)),     // Pitch bend LFO
+          static_cast<int32_t>(63.5 + 63.5 * sin(2 * PI * 0.25 * phase)),    // CC LFO
+          static_cast<int32_t>((t / 4000) % 128),                            // XY sweep
+          static_cast<int32_t>(127 - (t / 6000) % 128),
+      };
+      for (uint8_t v = 0; v < 4; ++v) {
+        if (values[v] == target[v]) {
+          continue;  // The modes only send on a change
+        }
+        target[v] = values[v];
+        ++result.updates;
+        result.requestedBytes += 3;
+        if (v == 0) {
+          simCoalescer.update(MidiControlKind::PITCH_BEND, 0, 0, values[v]);
+          if (lastInputBend >= 0) {
+            result.inputMaxStep = max(result.inputMaxStep, static_cast<uint16_t>(abs(values[v] - lastInputBend)));
+          }
+          lastInputBend = values[v];
+        } else {
+          simCoalescer.update(MidiControlKind::CC7, 0, v == 1 ? 74 : 15 + v - 1, values[v]);
+        }
+        for (uint8_t d = 0; d < kMidiControlDestinations; ++d) {
+          if (!sim.pending[d]) {
+            sim.pending[d] = true;
+            sim.firstPendingUs[d] = sim.nowUs;
+          }
+        }
+      }
+    }
+    for (uint8_t d = 0; d < kMidiControlDestinations; ++d) {
+      uint16_t hz = maxRateHz[d];
+      if (hz > 0 && sim.nowUs - lastFlush[d] < 1000000UL / hz) {
+        continue;
+      }
+      if (simCoalescer.flush(d, simEmit) > 0) {
+        lastFlush[d] = sim.nowUs;
+        if (sim.pending[d]) {
+          sim.maxLagUs[d] = max(sim.maxLagUs[d], sim.nowUs - sim.firstPendingUs[d]);
+        }
+      }
+      sim.pending[d] = false;
+    }
+  }
+
+  result.ok = true;
+  for (uint8_t d = 0; d < kMidiControlDestinations; ++d) {
+    result.sentBytes[d] = sim.sentBytes[d];
+    result.maxStep[d] = sim.maxStep[d];
+    result.maxLagUs[d] = sim.maxLagUs[d];
+    for (uint8_t v = 0; v < 4; ++v) {
+      result.ok = result.ok && sim.finalValue[d][v] == target[v];
+    }
+  }
+  return result;
+}
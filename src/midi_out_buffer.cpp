@@ -1,8 +1,14 @@
 #include "midi_out_buffer.h"
+#include "midi_control_coalescer.h"
 #include "midi_utils.h"
+#include "active_notes.h"
 #include "common_definitions.h"
+#include "profiler.h"
+#include "telemetry.h"
 #include <Arduino.h>
 #include <algorithm>
+#include <atomic>
+#include <freertos/portmacro.h>
 
 // Global instance
 MidiOutBuffer midiOutBuffer;
@@ -12,11 +18,126 @@ namespace {
   static constexpr const char* kTaskName = "MidiOut";
   static constexpr UBaseType_t kTaskPriority = configMAX_PRIORITIES - 1;  // High priority
   static constexpr uint16_t kStackDepth = 4096;
+  static constexpr uint8_t kAllChannels = 0xFF;
+  static constexpr size_t kRealtimeLaneSize = 128;  // Room for an external catch-up burst
+  static constexpr uint8_t kClockTransports = static_cast<uint8_t>(MidiClockTransport::COUNT);
+
+  // Realtime lane: clock ticks (from the timer ISR) and Start/Continue/Stop,
+  // drained by the output task before channel events
+  struct RealtimeEvent {
+    uint8_t status;
+    uint32_t tick;
+    uint32_t timestampUs;
+  };
+
+  RealtimeEvent realtimeLane[kRealtimeLaneSize];
+  size_t realtimeHead = 0;
+  size_t realtimeTail = 0;
+  uint32_t realtimeDrops = 0;
+  portMUX_TYPE realtimeMux = portMUX_INITIALIZER_UNLOCKED;
+
+  // Clock trace: transports count into transportClocks from whichever task
+  // sends; the window is evaluated by the output task on each quarter tick
+  std::atomic<uint16_t> transportClocks[kClockTransports];
+  std::atomic<uint16_t> traceRequest{0};
+  MidiClockTraceResult trace = {};
+  uint64_t traceLatencyTotalUs = 0;
+  uint32_t lastTraceTick = 0;
+  bool traceWindowOpen = false;
+
+  // Every F8 sent, for comparing against what the clock task processed
+  uint32_t clocksSent = 0;
+  uint32_t lastClockSentTick = 0;
+  portMUX_TYPE clockSentMux = portMUX_INITIALIZER_UNLOCKED;
+
+  void traceClock(uint32_t tick, uint32_t timestampUs) {
+    uint16_t requested = traceRequest.exchange(0);
+    if (requested > 0) {
+      trace = {};
+      trace.running = true;
+      trace.target = requested;
+      for (uint8_t i = 0; i < kClockTransports; ++i) {
+        trace.minPerQuarter[i] = UINT16_MAX;
+      }
+      traceLatencyTotalUs = 0;
+      traceWindowOpen = false;
+    }
+    if (!trace.running) {
+      return;
+    }
+    trace.laneDrops = realtimeDrops;
+
+    if (tick != lastTraceTick + 1) {
+      traceWindowOpen = false;  // Transport reset or jump: start a fresh quarter
+    }
+    lastTraceTick = tick;
+    if (tick % 24 != 0) {
+      return;
+    }
+    // This tick's F8 has not been sent yet: the counts cover exactly the
+    // quarter that ends here
+    bool bad = false;
+    for (uint8_t i = 0; i < kClockTransports; ++i) {
+      uint16_t count = transportClocks[i].exchange(0);
+      if (!traceWindowOpen) {
+        continue;
+      }
+      trace.minPerQuarter[i] = std::min(trace.minPerQuarter[i], count);
+      trace.maxPerQuarter[i] = std::max(trace.maxPerQuarter[i], count);
+      bad = bad || (count != 0 && count != 24);  // 0: transport idle (BLE not connected...)
+    }
+    if (traceWindowOpen) {
+      trace.quarters++;
+      trace.badQuarters += bad ? 1 : 0;
+      trace.running = trace.quarters < trace.target;
+    }
+    traceWindowOpen = true;
+  }
+
+  // After the send: the time until every transport had the pulse, written in
+  // place (DIN, ESP-NOW) or queued (BLE, WiFi)
+  void traceClockSent(uint32_t timestampUs) {
+    if (!trace.running) {
+      return;
+    }
+    uint32_t latencyUs = micros() - timestampUs;
+    traceLatencyTotalUs += latencyUs;
+    trace.minLatencyUs = trace.clocks == 0 ? latencyUs : std::min(trace.minLatencyUs, latencyUs);
+    trace.maxLatencyUs = std::max(trace.maxLatencyUs, latencyUs);
+    trace.clocks++;
+    trace.meanLatencyUs = static_cast<uint32_t>(traceLatencyTotalUs / trace.clocks);
+  }
+}
+
+void midiClockTraceCount(MidiClockTransport transport) {
+  transportClocks[static_cast<uint8_t>(transport)].fetch_add(1);
+}
+
+void midiClockTraceStart(uint16_t quarters) {
+  traceRequest.store(quarters > 0 ? quarters : 1);
+}
+
+MidiClockTraceResult midiClockTraceResult() {
+  MidiClockTraceResult result = trace;
+  result.running = result.running || traceRequest.load() > 0;
+  for (uint8_t i = 0; i < kClockTransports; ++i) {
+    if (result.minPerQuarter[i] == UINT16_MAX) {
+      result.minPerQuarter[i] = 0;
+    }
+  }
+  return result;
+}
+
+void midiClockSentCount(uint32_t &count, uint32_t &lastTick) {
+  portENTER_CRITICAL(&clockSentMux);
+  count = clocksSent;
+  lastTick = lastClockSentTick;
+  portEXIT_CRITICAL(&clockSentMux);
 }
 
 MidiOutBuffer::MidiOutBuffer() 
-  : writeIndex_(0), readIndex_(0), mutex_(nullptr), notesMutex_(nullptr),
-    taskHandle_(nullptr), running_(false) {
+  : writeIndex_(0), readIndex_(0), mutex_(nullptr), releaseTicket_(0), releasesDone_(0),
+    notesMutex_(nullptr), taskHandle_(nullptr), running_(false) {
 }
 
 MidiOutBuffer::~MidiOutBuffer() {
@@ -135,28 +256,77 @@ bool MidiOutBuffer::note(uint8_t channel, uint8_t note, uint8_t velocity, uint16
   return enqueue(event);
 }
 
-bool MidiOutBuffer::midiClock() {
-  MidiEvent event;
-  event.type = MidiEventType::CLOCK;
-  return enqueue(event);
+bool MidiOutBuffer::pushRealtime(uint8_t status, uint32_t tick, uint32_t timestampUs) {
+  portENTER_CRITICAL_SAFE(&realtimeMux);
+  size_t next = (realtimeHead + 1) % kRealtimeLaneSize;
+  bool queued = next != realtimeTail;
+  if (queued) {
+    realtimeLane[realtimeHead] = {status, tick, timestampUs};
+    realtimeHead = next;
+  } else {
+    realtimeDrops++;
+  }
+  portEXIT_CRITICAL_SAFE(&realtimeMux);
+
+  if (!running_ || taskHandle_ == nullptr) {
+    return queued;  // Sent once the output task starts
+  }
+  if (xPortInIsrContext()) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(taskHandle_, &woken);
+    if (woken == pdTRUE) {
+      portYIELD_FROM_ISR();
+    }
+  } else {
+    xTaskNotifyGive(taskHandle_);
+  }
+  return queued;
+}
+
+void MidiOutBuffer::emitRealtime() {
+  while (true) {
+    RealtimeEvent event;
+    portENTER_CRITICAL_SAFE(&realtimeMux);
+    bool pending = realtimeTail != realtimeHead;
+    if (pending) {
+      event = realtimeLane[realtimeTail];
+      realtimeTail = (realtimeTail + 1) % kRealtimeLaneSize;
+    }
+    portEXIT_CRITICAL_SAFE(&realtimeMux);
+    if (!pending) {
+      return;
+    }
+    if (event.status == 0xF8) {
+      traceClock(event.tick, event.timestampUs);
+    }
+    sendSystemRealtime(event.status);
+    if (event.status == 0xF8) {
+      portENTER_CRITICAL(&clockSentMux);
+      clocksSent++;
+      lastClockSentTick = event.tick;
+      portEXIT_CRITICAL(&clockSentMux);
+      traceClockSent(event.timestampUs);
+      uint32_t sentUs = micros();
+      telemetryEmit(TelemetryEventId::CLOCK_OUT, 0, static_cast<uint16_t>(event.tick), sentUs - event.timestampUs,
+                    sentUs);
+    }
+  }
+}
+
+bool MidiOutBuffer::clockTick(uint32_t tick, uint32_t timestampUs) {
+  return pushRealtime(0xF8, tick, timestampUs);
 }
 
 bool MidiOutBuffer::midiStart() {
-  MidiEvent event;
-  event.type = MidiEventType::START;
-  return enqueue(event);
+  return pushRealtime(0xFA, 0, micros());
 }
 
 bool MidiOutBuffer::midiContinue() {
-  MidiEvent event;
-  event.type = MidiEventType::CONTINUE;
-  return enqueue(event);
+  return pushRealtime(0xFB, 0, micros());
 }
 
 bool MidiOutBuffer::midiStop() {
-  MidiEvent event;
-  event.type = MidiEventType::STOP;
-  return enqueue(event);
+  return pushRealtime(0xFC, 0, micros());
 }
 
 void MidiOutBuffer::updateScheduledNotes(uint32_t currentTick) {
@@ -192,6 +362,50 @@ void MidiOutBuffer::panic() {
   }
 }
 
+void MidiOutBuffer::softPanic() {
+  MidiEvent event;
+  event.type = MidiEventType::RELEASE_SOUNDING;
+  event.channel = kAllChannels;
+  if (!enqueue(event)) {
+    panic();
+    return;
+  }
+  
+  // The release covers notes whose note-off was still scheduled
+  if (notesMutex_ != nullptr && xSemaphoreTake(notesMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
+    for (size_t i = 0; i < kMaxScheduledNotes; ++i) {
+      scheduledNotes_[i].active = false;
+    }
+    xSemaphoreGive(notesMutex_);
+  }
+}
+
+uint32_t MidiOutBuffer::releaseSounding(uint8_t channel) {
+  MidiEvent event;
+  event.type = MidiEventType::RELEASE_SOUNDING;
+  event.channel = channel & 0x0F;
+  uint32_t ticket = 0;
+  if (!enqueue(event, &ticket)) {
+    allNotesOff(event.channel);
+    return 0;
+  }
+  
+  if (notesMutex_ != nullptr && xSemaphoreTake(notesMutex_, pdMS_TO_TICKS(10)) == pdTRUE) {
+    for (size_t i = 0; i < kMaxScheduledNotes; ++i) {
+      if (scheduledNotes_[i].active && scheduledNotes_[i].channel == event.channel) {
+        scheduledNotes_[i].active = false;
+      }
+    }
+    xSemaphoreGive(notesMutex_);
+  }
+  return ticket;
+}
+
+bool MidiOutBuffer::releaseDone(uint32_t ticket) const {
+  // Markers run in queue order, so every ticket up to the last one run is done
+  return ticket == 0 || static_cast<int32_t>(releasesDone_.load() - ticket) >= 0;
+}
+
 void MidiOutBuffer::allNotesOff(uint8_t channel) {
   // Send CC 123 (All Notes Off)
   controlChange(channel, 123, 0);
@@ -228,7 +442,7 @@ bool MidiOutBuffer::isEmpty() const {
   return getQueuedCount() == 0;
 }
 
-bool MidiOutBuffer::enqueue(const MidiEvent& event) {
+bool MidiOutBuffer::enqueue(const MidiEvent& event, uint32_t* releaseTicket) {
   if (mutex_ == nullptr || !running_) {
     return false;
   }
@@ -246,6 +460,14 @@ bool MidiOutBuffer::enqueue(const MidiEvent& event) {
   }
   
   buffer_[writeIndex_] = event;
+  if (releaseTicket != nullptr) {
+    // Numbered under the lock so tickets follow queue order; 0 means done
+    if (++releaseTicket_ == 0) {
+      ++releaseTicket_;
+    }
+    buffer_[writeIndex_].timestamp = releaseTicket_;
+    *releaseTicket = releaseTicket_;
+  }
   writeIndex_ = nextWrite;
   
   xSemaphoreGive(mutex_);
@@ -310,12 +532,24 @@ void MidiOutBuffer::processEvent(const MidiEvent& event) {
     case MidiEventType::STOP:
       sendSystemRealtime(0xFC);
       break;
+      
+    case MidiEventType::RELEASE_SOUNDING:
+      if (event.channel == kAllChannels) {
+        activeNotesReleaseAll();
+      } else {
+        activeNotesRelease(event.channel);
+      }
+      if (event.timestamp != 0) {
+        releasesDone_.store(event.timestamp);
+      }
+      break;
   }
 }
 
 void MidiOutBuffer::sendMidiMessage(uint8_t status, uint8_t data1, uint8_t data2) {
   // Use existing MIDI send infrastructure
   sendMIDI(status, data1, data2);
+  telemetryEmit(TelemetryEventId::MIDI_OUT, status, static_cast<uint16_t>((data1 << 8) | data2), 0);
 }
 
 void MidiOutBuffer::sendSystemRealtime(uint8_t message) {
@@ -325,10 +559,11 @@ void MidiOutBuffer::sendSystemRealtime(uint8_t message) {
     sendMIDIClock();
   } else if (message == 0xFA) {
     sendMIDIStart();
+  } else if (message == 0xFB) {
+    sendMIDIContinue();
   } else if (message == 0xFC) {
     sendMIDIStop();
   }
-  // Note: 0xFB (Continue) currently not in midi_utils.h, would need to add
 }
 
 bool MidiOutBuffer::addScheduledNoteOff(uint8_t channel, uint8_t note, uint32_t offTick) {
@@ -384,12 +619,19 @@ void MidiOutBuffer::taskLoop() {
   Serial.println("[MidiOutBuffer] Task started");
   
   while (running_) {
+    emitRealtime();
     MidiEvent event;
     while (dequeue(event)) {
-      processEvent(event);
+      {
+        ProfileScope scope(ProfileSection::TRANSPORT_SEND);
+        processEvent(event);
+      }
+      emitRealtime();  // A tick that fires mid-burst goes out before the rest
     }
+    midiControlService(micros());  // Coalesced controllers, after the notes queued with them
     
-    vTaskDelay(kTaskDelay);
+    // Woken early by clockTick() and the transport messages
+    ulTaskNotifyTake(pdTRUE, kTaskDelay);
   }
   
   Serial.println("[MidiOutBuffer] Task stopped");
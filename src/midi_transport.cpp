@@ -2,11 +2,17 @@
 
 #include "clock_manager.h"
 #include "common_definitions.h"
+#include "midi_out_buffer.h"
 #include "hardware_midi.h"
+#include "telemetry.h"
 #include "wifi_manager.h"
 
 #include <Arduino.h>
 #include <atomic>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 #if WIFI_ENABLED
 #include <WiFiUdp.h>
 #endif
@@ -21,15 +27,88 @@ static const IPAddress kWifiMidiRemoteIP = IPAddress(255, 255, 255, 255);
 #endif
 
 static constexpr uint32_t kStartStopDebounceMs = 100;
-static constexpr uint32_t kClockLogIntervalMs = 500;
 static std::atomic<uint32_t> lastStartMs{0};
 static std::atomic<uint32_t> lastStopMs{0};
-static std::atomic<uint32_t> lastClockLogMs{0};
 static std::atomic<bool> pendingExternalStart{false};
 static std::atomic<bool> externalRunning{false};
 static std::atomic<bool> clockPulseState{false};
+static std::atomic<MidiChannelInputHandler> channelInputHandler{nullptr};
 
-static void processTransportByte(uint8_t byte) {
+// Per-transport channel-message assembler. Keeps running status so bursts
+// from DIN keyboards (which drop repeated status bytes) decode correctly.
+struct MidiInputParser {
+  uint8_t runningStatus = 0;
+  uint8_t data[2] = {0, 0};
+  uint8_t count = 0;
+};
+
+static MidiInputParser hardwareParser;
+static MidiInputParser wifiParser;
+static MidiInputParser bleParser;
+
+// One parsed input: a realtime byte (status >= 0xF8) or a channel message
+struct MidiInputEvent {
+  uint32_t timestampUs;
+  uint8_t source;  // MidiClockMaster
+  uint8_t status;
+  uint8_t data1;
+  uint8_t data2;
+};
+
+using MidiInputSink = void (*)(const MidiInputEvent &event);
+
+// RX task: reads DIN and UDP input off the UI loop and queues parsed events
+// for the clock task, which drains them every millisecond
+static constexpr const char *kRxTaskName = "MidiRx";
+static constexpr UBaseType_t kRxTaskPriority = 10;  // Above the UI loop, below the BLE and WiFi stacks
+static constexpr uint16_t kRxStackDepth = 4096;
+#if WIFI_ENABLED
+static constexpr TickType_t kRxWaitTicks = pdMS_TO_TICKS(1);  // WiFiUDP has no readiness event; poll it
+#else
+static constexpr TickType_t kRxWaitTicks = portMAX_DELAY;
+#endif
+static constexpr uint32_t kLateInputUs = 2000;
+
+// Single producer (RX task), single consumer (clock task)
+static constexpr uint32_t kInputQueueSize = 256;
+static MidiInputEvent inputQueue[kInputQueueSize];
+static std::atomic<uint32_t> inputHead{0};
+static std::atomic<uint32_t> inputTail{0};
+
+static TaskHandle_t rxTask = nullptr;
+static std::atomic<MidiRxMode> rxMode{MidiRxMode::TASK};
+static std::atomic<uint32_t> uartArrivalUs{0};
+// Held for every read of MIDI_SERIAL, the UDP socket and their parsers. The
+// reader checks rxMode under it, so after a mode switch the new reader
+// cannot start while the old one is still inside a read.
+static SemaphoreHandle_t rxReadMutex = nullptr;
+// Updated on the RX task and the input handler's task, read and reset from
+// the UI loop
+static MidiRxStats rxStats = {};
+static portMUX_TYPE rxStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+static inline uint32_t nowUs() {
+  return static_cast<uint32_t>(esp_timer_get_time());
+}
+
+static void recordInputLatency(const MidiInputEvent &event) {
+  if (event.source != CLOCK_HARDWARE) {
+    return;  // Only DIN bytes carry an arrival stamp from the UART driver
+  }
+  uint32_t latencyUs = nowUs() - event.timestampUs;
+  portENTER_CRITICAL(&rxStatsMux);
+  rxStats.events++;
+  rxStats.totalLatencyUs += latencyUs;
+  if (latencyUs > rxStats.maxLatencyUs) {
+    rxStats.maxLatencyUs = latencyUs;
+  }
+  if (latencyUs > kLateInputUs) {
+    rxStats.lateEvents++;
+  }
+  portEXIT_CRITICAL(&rxStatsMux);
+}
+
+static void processTransportByte(uint8_t byte, uint32_t timestampUs) {
   switch (byte) {
     case 0xFA: {
       uint32_t now = millis();
@@ -56,7 +135,6 @@ static void processTransportByte(uint8_t byte) {
       break;
     }
     case 0xF8: {
-      uint32_t now = millis();
       if (!externalRunning.load() && pendingExternalStart.load()) {
         externalRunning.store(true);
         pendingExternalStart.store(false);
@@ -64,12 +142,7 @@ static void processTransportByte(uint8_t byte) {
         clockManagerExternalStart();
       }
       if (externalRunning.load()) {
-        uint32_t lastLog = lastClockLogMs.load();
-        if (now - lastLog >= kClockLogIntervalMs) {
-          Serial.println("[MidiTransport] Received MIDI Clock (0xF8)");
-          lastClockLogMs.store(now);
-        }
-        clockManagerExternalClock();
+        clockManagerExternalClock(timestampUs);
         clockPulseState.store(!clockPulseState.load());
       }
       break;
@@ -79,71 +152,259 @@ static void processTransportByte(uint8_t byte) {
   }
 }
 
-}  // namespace
+static void dispatchChannelMessage(uint8_t status, uint8_t data1, uint8_t data2,
+                                   uint32_t timestampUs, uint8_t source) {
+  MidiChannelInputHandler handler = channelInputHandler.load();
+  if (handler != nullptr) {
+    handler(status, data1, data2, timestampUs, source);
+  }
+}
 
-#if HARDWARE_MIDI_ENABLED
-static void handleHardwareMidiInput() {
-  if (midiClockMaster != CLOCK_HARDWARE) {
+// Realtime bytes only drive the clock when their source is the selected
+// master; channel messages are always delivered.
+static void handleInputEvent(const MidiInputEvent &event) {
+  if (event.status >= 0xF8) {
+    if (midiClockMaster == event.source) {
+      if (event.status == 0xF8) {
+        telemetryEmit(TelemetryEventId::EXT_CLOCK, event.source, 0, 0, event.timestampUs);
+      }
+      processTransportByte(event.status, event.timestampUs);
+    }
     return;
   }
-#if HARDWARE_MIDI_UART == 0
-  while (Serial.available() > 0) {
-    uint8_t byte = static_cast<uint8_t>(Serial.read());
-    processTransportByte(byte);
+  uint32_t latencyUs = event.source == CLOCK_HARDWARE ? nowUs() - event.timestampUs : 0;
+  telemetryEmit(TelemetryEventId::MIDI_IN, event.status, static_cast<uint16_t>((event.data1 << 8) | event.data2),
+                latencyUs, event.timestampUs);
+  dispatchChannelMessage(event.status, event.data1, event.data2, event.timestampUs, event.source);
+}
+
+static void queueInputEvent(const MidiInputEvent &event) {
+  uint32_t head = inputHead.load(std::memory_order_relaxed);
+  if (head - inputTail.load(std::memory_order_acquire) >= kInputQueueSize) {
+    portENTER_CRITICAL(&rxStatsMux);
+    rxStats.drops++;
+    portEXIT_CRITICAL(&rxStatsMux);
+    return;
   }
-#elif HARDWARE_MIDI_UART == 2
-  while (MIDISerial.available() > 0) {
-    uint8_t byte = static_cast<uint8_t>(MIDISerial.read());
-    processTransportByte(byte);
+  inputQueue[head % kInputQueueSize] = event;
+  inputHead.store(head + 1, std::memory_order_release);
+  uint32_t depth = head + 1 - inputTail.load(std::memory_order_relaxed);
+  portENTER_CRITICAL(&rxStatsMux);
+  if (depth > rxStats.queueHighWater) {
+    rxStats.queueHighWater = depth;
+  }
+  portEXIT_CRITICAL(&rxStatsMux);
+}
+
+// The pre-task path, kept for comparison: handled right where it is read
+static void handleLoopInputEvent(const MidiInputEvent &event) {
+  recordInputLatency(event);
+  handleInputEvent(event);
+}
+
+// Feed one wire byte from `source` and emit every completed event to `sink`
+static void processInputByte(MidiInputParser &parser, uint8_t byte, MidiClockMaster source,
+                             uint32_t timestampUs, MidiInputSink sink) {
+  if (byte >= 0xF8) {
+    // Realtime may appear between any two bytes and never cancels running status
+    sink({timestampUs, static_cast<uint8_t>(source), byte, 0, 0});
+    return;
+  }
+  if (byte >= 0xF0) {
+    // System common / SysEx: not forwarded, and cancels running status
+    parser.runningStatus = 0;
+    parser.count = 0;
+    return;
+  }
+  if (byte & 0x80) {
+    parser.runningStatus = byte;
+    parser.count = 0;
+    return;
+  }
+  if (parser.runningStatus == 0) {
+    return;
+  }
+  parser.data[parser.count++] = byte;
+  uint8_t type = parser.runningStatus & 0xF0;
+  uint8_t needed = (type == 0xC0 || type == 0xD0) ? 1 : 2;
+  if (parser.count < needed) {
+    return;
+  }
+  parser.count = 0;
+  sink({timestampUs, static_cast<uint8_t>(source), parser.runningStatus, parser.data[0],
+        static_cast<uint8_t>(needed == 2 ? parser.data[1] : 0)});
+}
+
+#if HARDWARE_MIDI_ENABLED
+// UART driver event task: bytes arrived (RX timeout after a burst, or FIFO
+// threshold). Stamps the arrival and wakes the RX task.
+static void onUartReceive() {
+  uartArrivalUs.store(nowUs());
+  if (rxTask != nullptr && rxMode.load() == MidiRxMode::TASK) {
+    xTaskNotifyGive(rxTask);
+  }
+}
+
+static void readHardwareMidiInput(MidiInputSink sink) {
+  uint32_t timestampUs = uartArrivalUs.load();
+  while (MIDI_SERIAL.available() > 0) {
+    uint8_t byte = static_cast<uint8_t>(MIDI_SERIAL.read());
+    processInputByte(hardwareParser, byte, CLOCK_HARDWARE, timestampUs, sink);
   }
-#endif
 }
 #else
-static void handleHardwareMidiInput() {}
+static void readHardwareMidiInput(MidiInputSink) {}
 #endif
 
 #if WIFI_ENABLED
-static void handleWiFiMidiInput() {
-  if (midiClockMaster != CLOCK_WIFI || !isWiFiConnected()) {
+static void readWiFiMidiInput(MidiInputSink sink) {
+  if (!isWiFiConnected()) {
     return;
   }
   int packetSize = wifiMidiUdp.parsePacket();
   while (packetSize > 0) {
     static uint8_t buffer[256];
+    uint32_t timestampUs = nowUs();
     int len = wifiMidiUdp.read(buffer, sizeof(buffer));
-    if (len > 0) {
+    // Our own output is broadcast on the same port; never feed it back in
+    if (len > 0 && wifiMidiUdp.remoteIP() != WiFi.localIP()) {
       for (int i = 0; i < len; ++i) {
-        processTransportByte(buffer[i]);
+        processInputByte(wifiParser, buffer[i], CLOCK_WIFI, timestampUs, sink);
       }
     }
     packetSize = wifiMidiUdp.parsePacket();
   }
 }
 #else
-static void handleWiFiMidiInput() {}
+static void readWiFiMidiInput(MidiInputSink) {}
 #endif
 
+// Reads every input with `sink` if `mode` is still the selected reader
+static void readInputsAs(MidiRxMode mode, MidiInputSink sink) {
+  if (rxReadMutex != nullptr) {
+    xSemaphoreTake(rxReadMutex, portMAX_DELAY);
+  }
+  if (rxMode.load() == mode) {
+    readHardwareMidiInput(sink);
+    readWiFiMidiInput(sink);
+  }
+  if (rxReadMutex != nullptr) {
+    xSemaphoreGive(rxReadMutex);
+  }
+}
+
+static void midiRxTask(void * /*unused*/) {
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, kRxWaitTicks);
+    if (rxMode.load() == MidiRxMode::TASK) {
+      readInputsAs(MidiRxMode::TASK, queueInputEvent);
+    }
+  }
+}
+
+}  // namespace
+
 void initMidiTransports() {
+  rxReadMutex = xSemaphoreCreateMutex();
 #if WIFI_ENABLED
   wifiMidiUdp.begin(kWifiMidiListenPort);
 #endif
+#if HARDWARE_MIDI_ENABLED
+  MIDI_SERIAL.setRxTimeout(1);  // Report a burst one byte time after it ends
+  MIDI_SERIAL.onReceive(onUartReceive, false);
+#endif
+  BaseType_t result = xTaskCreatePinnedToCore(midiRxTask, kRxTaskName, kRxStackDepth, nullptr,
+                                              kRxTaskPriority, &rxTask, 0);
+  if (result != pdPASS) {
+    Serial.println("[MidiTransport] Failed to create RX task, polling from the UI loop");
+    rxTask = nullptr;
+    rxMode.store(MidiRxMode::UI_LOOP);
+  }
 }
 
 void handleMidiTransports() {
-  handleHardwareMidiInput();
-  handleWiFiMidiInput();
+  if (rxMode.load() != MidiRxMode::UI_LOOP) {
+    return;
+  }
+  readInputsAs(MidiRxMode::UI_LOOP, handleLoopInputEvent);
 }
 
-void midiTransportProcessIncomingBytes(const uint8_t *data, size_t length) {
-  if (midiClockMaster != CLOCK_BLE) {
+void midiTransportProcessInput() {
+  uint32_t tail = inputTail.load(std::memory_order_relaxed);
+  uint32_t head = inputHead.load(std::memory_order_acquire);
+  while (tail != head) {
+    MidiInputEvent event = inputQueue[tail % kInputQueueSize];
+    inputTail.store(++tail, std::memory_order_release);
+    recordInputLatency(event);
+    handleInputEvent(event);
+  }
+}
+
+// Switched under the read lock: a read in progress on the old reader ends
+// before the new reader can start
+void midiTransportSetRxMode(MidiRxMode mode) {
+  if (mode == MidiRxMode::TASK && rxTask == nullptr) {
     return;
   }
-  if (data == nullptr || length == 0) {
+  if (rxReadMutex != nullptr) {
+    xSemaphoreTake(rxReadMutex, portMAX_DELAY);
+  }
+  rxMode.store(mode);
+  if (rxReadMutex != nullptr) {
+    xSemaphoreGive(rxReadMutex);
+  }
+  if (rxTask != nullptr) {
+    xTaskNotifyGive(rxTask);
+  }
+}
+
+MidiRxMode midiTransportGetRxMode() {
+  return rxMode.load();
+}
+
+MidiRxStats midiTransportGetRxStats() {
+  portENTER_CRITICAL(&rxStatsMux);
+  MidiRxStats snapshot = rxStats;
+  portEXIT_CRITICAL(&rxStatsMux);
+  return snapshot;
+}
+
+void midiTransportResetRxStats() {
+  portENTER_CRITICAL(&rxStatsMux);
+  rxStats = {};
+  portEXIT_CRITICAL(&rxStatsMux);
+}
+
+// BLE-MIDI packet: [header] then ([timestamp] status data...)* where a
+// status may be omitted (running status). A byte with the top bit set is a
+// timestamp unless it directly follows one, in which case it is a status.
+void midiTransportProcessIncomingBytes(const uint8_t *data, size_t length) {
+  if (data == nullptr || length < 2 || (data[0] & 0x80) == 0) {
     return;
   }
-  for (size_t i = 0; i < length; ++i) {
-    processTransportByte(data[i]);
+  uint32_t timestampUs = static_cast<uint32_t>(esp_timer_get_time());
+  bool prevWasTimestamp = false;
+  for (size_t i = 1; i < length; ++i) {
+    uint8_t byte = data[i];
+    if ((byte & 0x80) && !prevWasTimestamp) {
+      prevWasTimestamp = true;
+      continue;
+    }
+    prevWasTimestamp = false;
+    processInputByte(bleParser, byte, CLOCK_BLE, timestampUs, handleInputEvent);
+  }
+}
+
+void midiTransportProcessChannelMessage(uint8_t status, uint8_t data1, uint8_t data2,
+                                        uint8_t source) {
+  if (status < 0x80 || status >= 0xF0) {
+    return;
   }
+  dispatchChannelMessage(status, data1, data2, micros(), source);
+}
+
+void midiTransportSetChannelInputHandler(MidiChannelInputHandler handler) {
+  channelInputHandler.store(handler);
 }
 
 void sendWiFiMidiMessage(const uint8_t *data, size_t length) {
@@ -151,6 +412,11 @@ void sendWiFiMidiMessage(const uint8_t *data, size_t length) {
   if (!isWiFiConnected() || data == nullptr || length == 0) {
     return;
   }
+  for (size_t i = 0; i < length; ++i) {
+    if (data[i] == 0xF8) {  // Data bytes are below 0x80
+      midiClockTraceCount(MidiClockTransport::WIFI);
+    }
+  }
   wifiMidiUdp.beginPacket(kWifiMidiRemoteIP, kWifiMidiRemotePort);
   wifiMidiUdp.write(data, static_cast<int>(length));
   wifiMidiUdp.endPacket();
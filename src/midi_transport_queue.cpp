@@ -0,0 +1,147 @@
+#include "midi_transport_queue.h"
+#include "profiler.h"
+#include "telemetry.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+namespace {
+static constexpr uint16_t kStackDepth = 3072;  // BLE notify and WiFi UDP run on this stack
+static constexpr TickType_t kIdleWait = pdMS_TO_TICKS(100);
+
+bool isRealtime(uint8_t status) {
+  return status >= 0xF8;
+}
+}  // namespace
+
+MidiTransportQueue::MidiTransportQueue(const char *name, MidiQueueSender sender, uint8_t policy)
+    : name_(name), sender_(sender), policy_(policy) {}
+
+bool MidiTransportQueue::begin(UBaseType_t priority, BaseType_t core) {
+  if (task_ != nullptr) {
+    return true;
+  }
+  if (xTaskCreatePinnedToCore(senderTask, name_, kStackDepth, this, priority, &task_, core) != pdPASS) {
+    task_ = nullptr;
+    Serial.printf("[MidiQueue] Failed to create %s sender\n", name_);
+    return false;
+  }
+  return true;
+}
+
+bool MidiTransportQueue::evictOldestChannelLocked() {
+  for (size_t i = 0; i < count_; ++i) {
+    if (!isRealtime(entries_[i].status)) {
+      memmove(&entries_[i], &entries_[i + 1], (count_ - i - 1) * sizeof(MidiQueuedMessage));
+      --count_;
+      ++stats_.evicted;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MidiTransportQueue::push(uint8_t status, uint8_t data1, uint8_t data2, uint8_t length) {
+  bool realtime = isRealtime(status);
+  bool keepRealtime = (policy_ & MIDI_QUEUE_KEEP_REALTIME) != 0;
+  bool queued = false;
+  portENTER_CRITICAL(&mux_);
+  if ((policy_ & MIDI_QUEUE_COALESCE_CC) && (status & 0xF0) == 0xB0) {
+    // Only the channel's last queued message can be replaced: any later one,
+    // another CC included, fixes the order (RPN/NRPN select then data entry)
+    for (size_t i = count_; i-- > 0;) {
+      if (isRealtime(entries_[i].status) || (entries_[i].status & 0x0F) != (status & 0x0F)) {
+        continue;
+      }
+      if (entries_[i].status == status && entries_[i].data1 == data1) {
+        entries_[i].data2 = data2;  // Still waiting: send the latest value in its place
+        ++stats_.coalesced;
+        portEXIT_CRITICAL(&mux_);
+        return true;
+      }
+      break;
+    }
+  }
+  size_t limit = keepRealtime && !realtime ? kCapacity - kRealtimeReserve : kCapacity;
+  if (count_ < limit || (realtime && keepRealtime && evictOldestChannelLocked())) {
+    entries_[count_++] = {status, data1, data2, length};
+    ++stats_.queued;
+    if (count_ > stats_.maxDepth) {
+      stats_.maxDepth = static_cast<uint16_t>(count_);
+    }
+    queued = true;
+  } else if (realtime) {
+    ++stats_.realtimeDrops;
+  } else {
+    ++stats_.dropped;
+  }
+  portEXIT_CRITICAL(&mux_);
+
+  if (queued && task_ != nullptr) {
+    xTaskNotifyGive(task_);
+  }
+  return queued;
+}
+
+size_t MidiTransportQueue::depth() const {
+  portENTER_CRITICAL(&mux_);
+  size_t count = count_;
+  portEXIT_CRITICAL(&mux_);
+  return count;
+}
+
+MidiQueueStats MidiTransportQueue::stats() const {
+  portENTER_CRITICAL(&mux_);
+  MidiQueueStats copy = stats_;
+  portEXIT_CRITICAL(&mux_);
+  return copy;
+}
+
+void MidiTransportQueue::resetStats() {
+  portENTER_CRITICAL(&mux_);
+  stats_ = {};
+  portEXIT_CRITICAL(&mux_);
+}
+
+void MidiTransportQueue::senderTask(void *parameter) {
+  static_cast<MidiTransportQueue *>(parameter)->senderLoop();
+}
+
+void MidiTransportQueue::senderLoop() {
+  MidiQueuedMessage batch[kBatch];
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, kIdleWait);
+    for (;;) {
+      portENTER_CRITICAL(&mux_);
+      size_t count = count_ < kBatch ? count_ : kBatch;
+      memcpy(batch, entries_, count * sizeof(MidiQueuedMessage));
+      memmove(entries_, entries_ + count, (count_ - count) * sizeof(MidiQueuedMessage));
+      count_ -= count;
+      portEXIT_CRITICAL(&mux_);
+      if (count == 0) {
+        break;
+      }
+
+      if (sendDelayMs_ > 0) {
+        vTaskDelay(pdMS_TO_TICKS(sendDelayMs_));
+      }
+      uint32_t startUs = micros();
+      {
+        ProfileScope scope(ProfileSection::QUEUE_SEND);
+        sender_(batch, count);
+      }
+      uint32_t elapsedUs = micros() - startUs;
+
+      portENTER_CRITICAL(&mux_);
+      stats_.sent += count;
+      ++stats_.batches;
+      if (elapsedUs > stats_.maxSendUs) {
+        stats_.maxSendUs = elapsedUs;
+      }
+      size_t left = count_;
+      portEXIT_CRITICAL(&mux_);
+      telemetryEmit(TelemetryEventId::QUEUE_SEND, static_cast<uint8_t>(left < 0xFF ? left : 0xFF),
+                    static_cast<uint16_t>(count), elapsedUs, startUs);
+    }
+  }
+}
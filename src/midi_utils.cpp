@@ -1,6 +1,16 @@
 #include "midi_utils.h"
 
+#include "active_notes.h"
+#include "midi_out_buffer.h"
+#include "midi_transport_queue.h"
+#include "wifi_manager.h"
+
 namespace {
+static constexpr size_t kBlePacketBytes = 20;  // Default ATT MTU minus the header
+static constexpr size_t kWifiPacketBytes = MidiTransportQueue::kBatch * 3;
+static constexpr UBaseType_t kQueueSenderPriority = 5;  // Above the UI loop, below the BLE and WiFi stacks
+static constexpr BaseType_t kQueueSenderCore = 0;       // With the radio stacks, off the MIDI output core
+
 struct BleSkipLogState {
   uint32_t last_log_ms = 0;
   uint32_t suppressed = 0;
@@ -11,18 +21,128 @@ struct BleSkipLogState {
 };
 
 BleSkipLogState ble_skip_log;
+
+// One notify per kBlePacketBytes: header, then a timestamp before each message
+void sendBleBatch(const MidiQueuedMessage *messages, size_t count) {
+  if (!deviceConnected || !pCharacteristic) {
+    return;
+  }
+  uint8_t packet[kBlePacketBytes];
+  size_t used = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (used + 1 + messages[i].length > sizeof(packet)) {
+      pCharacteristic->setValue(packet, used);
+      pCharacteristic->notify();
+      used = 0;
+    }
+    if (used == 0) {
+      packet[used++] = midiPacket[0];
+    }
+    packet[used++] = midiPacket[1];
+    packet[used++] = messages[i].status;
+    if (messages[i].length > 1) {
+      packet[used++] = messages[i].data1;
+    }
+    if (messages[i].length > 2) {
+      packet[used++] = messages[i].data2;
+    }
+    if (messages[i].status == 0xF8) {
+      midiClockTraceCount(MidiClockTransport::BLE);
+    }
+  }
+  if (used > 0) {
+    pCharacteristic->setValue(packet, used);
+    pCharacteristic->notify();
+  }
+}
+
+// One UDP datagram per batch; the receiver parses a byte stream
+void sendWiFiBatch(const MidiQueuedMessage *messages, size_t count) {
+  uint8_t packet[kWifiPacketBytes];
+  size_t used = 0;
+  for (size_t i = 0; i < count && used + messages[i].length <= sizeof(packet); ++i) {
+    packet[used++] = messages[i].status;
+    if (messages[i].length > 1) {
+      packet[used++] = messages[i].data1;
+    }
+    if (messages[i].length > 2) {
+      packet[used++] = messages[i].data2;
+    }
+  }
+  sendWiFiMidiMessage(packet, used);
+}
+
+MidiTransportQueue bleQueue("BleMidiOut", sendBleBatch, MIDI_QUEUE_KEEP_REALTIME | MIDI_QUEUE_COALESCE_CC);
+MidiTransportQueue wifiQueue("WifiMidiOut", sendWiFiBatch, MIDI_QUEUE_KEEP_REALTIME | MIDI_QUEUE_COALESCE_CC);
+MidiTransportQueue *const outputQueues[] = {&bleQueue, &wifiQueue};
+
+uint8_t channelMessageLength(uint8_t status) {
+  if (status >= 0xF8) {
+    return 1;  // Realtime forwarded through sendMIDITo()
+  }
+  uint8_t kind = status & 0xF0;
+  return (kind == 0xC0 || kind == 0xD0) ? 2 : 3;
+}
+
+// DIN first: it is the one transport that is written in place
+void sendMIDIRealtime(uint8_t message) {
+  sendHardwareMIDISingle(message);
+
+#if ESP_NOW_ENABLED
+  if (espNowState.initialized && espNowState.mode != ESP_NOW_OFF) {
+    sendEspNowMidi(message, 0x00, 0x00);
+  }
+#endif
+
+  if (deviceConnected) {
+    bleQueue.push(message, 0, 0, 1);
+  }
+#if WIFI_ENABLED
+  if (isWiFiConnected()) {
+    wifiQueue.push(message, 0, 0, 1);
+  }
+#endif
+}
 } // namespace
 
+void initMidiOutputQueues() {
+  for (MidiTransportQueue *queue : outputQueues) {
+    queue->begin(kQueueSenderPriority, kQueueSenderCore);
+  }
+}
+
+uint8_t midiOutputQueueCount() {
+  return sizeof(outputQueues) / sizeof(outputQueues[0]);
+}
+
+MidiTransportQueue *midiOutputQueue(uint8_t index) {
+  return index < midiOutputQueueCount() ? outputQueues[index] : nullptr;
+}
+
 void sendMIDI(byte cmd, byte note, byte vel) {
+  sendMIDIExcept(MidiOutPort::COUNT, cmd, note, vel);
+}
+
+void sendMIDIExcept(MidiOutPort skip, byte cmd, byte note, byte vel) {
+  activeNotesTrack(cmd, note, vel);
+
+  // Send via Hardware MIDI (DIN-5 connector)
+  if (skip != MidiOutPort::DIN) {
+    sendHardwareMIDI(cmd, note, vel);
+  }
+
+  // Send via ESP-NOW MIDI (only if enabled and mode is not OFF)
+#if ESP_NOW_ENABLED
+  if (skip != MidiOutPort::ESP_NOW && espNowState.initialized && espNowState.mode != ESP_NOW_OFF) {
+    sendEspNowMidi(cmd, note, vel);
+  }
+#endif
+
 #if defined(BLE_ENABLED) && BLE_ENABLED
-  if (deviceConnected) {
-    uint8_t localPacket[5] = {midiPacket[0], midiPacket[1], cmd, note, vel};
-    if (pCharacteristic) {
-      pCharacteristic->setValue(localPacket, sizeof(localPacket));
-      pCharacteristic->notify();
-    } else {
-      MIDI_DEBUG("[MIDI] BLE notify skipped - pCharacteristic is NULL\n");
-    }
+  if (skip == MidiOutPort::BLE) {
+    // Input came in over BLE; nothing to send back
+  } else if (deviceConnected) {
+    bleQueue.push(cmd, note, vel, channelMessageLength(cmd));
 
     // Reset skip state once we're connected again.
     ble_skip_log.suppressed = 0;
@@ -46,87 +166,56 @@ void sendMIDI(byte cmd, byte note, byte vel) {
   }
 #endif
 
-  // Send via Hardware MIDI (DIN-5 connector)
-  sendHardwareMIDI(cmd, note, vel);
-
-  // Send via ESP-NOW MIDI (only if enabled and mode is not OFF)
-#if ESP_NOW_ENABLED
-  if (espNowState.initialized && espNowState.mode != ESP_NOW_OFF) {
-    sendEspNowMidi(cmd, note, vel);
+#if WIFI_ENABLED
+  if (skip != MidiOutPort::WIFI && isWiFiConnected()) {
+    wifiQueue.push(cmd, note, vel, channelMessageLength(cmd));
   }
 #endif
-
-  uint8_t wifiBuffer[3] = {cmd, note, vel};
-  sendWiFiMidiMessage(wifiBuffer, sizeof(wifiBuffer));
 }
 
-void sendMIDIClock() {
-  if (deviceConnected) {
-    midiPacket[2] = 0xF8;
-    midiPacket[3] = 0x00;
-    midiPacket[4] = 0x00;
-    if (pCharacteristic) {
-      pCharacteristic->setValue(midiPacket, 5);
-      pCharacteristic->notify();
-    }
-  }
-
-  sendHardwareMIDISingle(0xF8);
-
+void sendMIDITo(MidiOutPort port, byte cmd, byte data1, byte data2) {
+  switch (port) {
+    case MidiOutPort::DIN:
+      sendHardwareMIDI(cmd, data1, data2);
+      break;
+    case MidiOutPort::ESP_NOW:
 #if ESP_NOW_ENABLED
-  if (espNowState.initialized && espNowState.mode != ESP_NOW_OFF) {
-    sendEspNowMidi(0xF8, 0x00, 0x00);
-  }
+      if (espNowState.initialized && espNowState.mode != ESP_NOW_OFF) {
+        sendEspNowMidi(cmd, data1, data2);
+      }
 #endif
+      break;
+    case MidiOutPort::BLE:
+      if (deviceConnected) {
+        bleQueue.push(cmd, data1, data2, channelMessageLength(cmd));
+      }
+      break;
+    case MidiOutPort::WIFI:
+#if WIFI_ENABLED
+      if (isWiFiConnected()) {
+        wifiQueue.push(cmd, data1, data2, channelMessageLength(cmd));
+      }
+#endif
+      break;
+    default:
+      break;
+  }
+}
 
-  uint8_t wifiClock = 0xF8;
-  sendWiFiMidiMessage(&wifiClock, 1);
+void sendMIDIClock() {
+  sendMIDIRealtime(0xF8);
 }
 
 void sendMIDIStart() {
-  if (deviceConnected) {
-    midiPacket[2] = 0xFA;
-    midiPacket[3] = 0x00;
-    midiPacket[4] = 0x00;
-    if (pCharacteristic) {
-      pCharacteristic->setValue(midiPacket, 5);
-      pCharacteristic->notify();
-    }
-  }
-
-  sendHardwareMIDISingle(0xFA);
-
-#if ESP_NOW_ENABLED
-  if (espNowState.initialized && espNowState.mode != ESP_NOW_OFF) {
-    sendEspNowMidi(0xFA, 0x00, 0x00);
-  }
-#endif
+  sendMIDIRealtime(0xFA);
+}
 
-  uint8_t wifiStart = 0xFA;
-  sendWiFiMidiMessage(&wifiStart, 1);
+void sendMIDIContinue() {
+  sendMIDIRealtime(0xFB);
 }
 
 void sendMIDIStop() {
-  if (deviceConnected) {
-    midiPacket[2] = 0xFC;
-    midiPacket[3] = 0x00;
-    midiPacket[4] = 0x00;
-    if (pCharacteristic) {
-      pCharacteristic->setValue(midiPacket, 5);
-      pCharacteristic->notify();
-    }
-  }
-
-  sendHardwareMIDISingle(0xFC);
-
-#if ESP_NOW_ENABLED
-  if (espNowState.initialized && espNowState.mode != ESP_NOW_OFF) {
-    sendEspNowMidi(0xFC, 0x00, 0x00);
-  }
-#endif
-
-  uint8_t wifiStop = 0xFC;
-  sendWiFiMidiMessage(&wifiStop, 1);
+  sendMIDIRealtime(0xFC);
 }
 
 int getNoteInScale(int scaleIndex, int degree, int octave) {
@@ -149,8 +238,6 @@ String getNoteNameFromMIDI(int midiNote) {
 }
 
 void stopAllModes() {
-  // Stop all MIDI notes
-  for (int i = 0; i < 128; i++) {
-    sendMIDI(0x80, i, 0);
-  }
+  // Only notes that are actually sounding, instead of 128 blind note-offs
+  activeNotesReleaseAll();
 }
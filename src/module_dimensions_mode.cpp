@@ -1,4 +1,5 @@
 #include "module_dimensions_mode.h"
+#include "rng_service.h"
 #include <algorithm>
 #include <cstring>
 #include <cmath>
@@ -127,15 +128,15 @@ void dimensionsEvaluateEquation(int equationNum, float t, float a, float b, floa
       break;
       
     case 5: // With randomness
-      px_fl = x + t * sin(a * t/2.0f) + (rnd * (PI/random(2,30) * 1.75f));
-      py_fl = y + t * sin(b * t) + (rnd * (PI/random(5,25) * c));
+      px_fl = x + t * sin(a * t/2.0f) + (rnd * (PI/rngRange(RngStream::DIMENSIONS, 2,30) * 1.75f));
+      py_fl = y + t * sin(b * t) + (rnd * (PI/rngRange(RngStream::DIMENSIONS, 5,25) * c));
       pz_fl = t * cos(a * t / PI * c);
       break;
       
     case 6: // Pure random
-      px_fl = x + random(-64,64);
-      py_fl = y + random(-64,64);
-      pz_fl = t * random(0,127);
+      px_fl = x + rngRange(RngStream::DIMENSIONS, -64,64);
+      py_fl = y + rngRange(RngStream::DIMENSIONS, -64,64);
+      pz_fl = t * rngRange(RngStream::DIMENSIONS, 0,127);
       break;
       
     case 7:
@@ -170,7 +171,7 @@ void dimensionsEvaluateEquation(int equationNum, float t, float a, float b, floa
       
     case 12:
       px_fl = x + t * sin(a * t + PI/2.0f);
-      py_fl = y + random(-64,64) * rnd * 1.0f/64.0f;
+      py_fl = y + rngRange(RngStream::DIMENSIONS, -64,64) * rnd * 1.0f/64.0f;
       pz_fl = t * cos(d * t / PI * c) * 1.0f + b * sin(t * 2.25f);
       break;
       
@@ -182,7 +183,7 @@ void dimensionsEvaluateEquation(int equationNum, float t, float a, float b, floa
       break;
       
     case 14:
-      px_fl = x + random(-64,64) * rnd * 1.0f/64.0f;
+      px_fl = x + rngRange(RngStream::DIMENSIONS, -64,64) * rnd * 1.0f/64.0f;
       py_fl = y + t * sin(a * t + PI/2.0f);
       pz_fl = t * sin(b * t / PI) * 2.0f + b * cos(t * 20.0f);
       break;
@@ -207,9 +208,9 @@ void dimensionsEvaluateEquation(int equationNum, float t, float a, float b, floa
       break;
       
     case 18: // Random with rnd control
-      px_fl = x + random(-abs((int)rnd), abs((int)rnd));
-      py_fl = y + random(-abs((int)rnd), abs((int)rnd));
-      pz_fl = t * random(0, abs((int)rnd));
+      px_fl = x + rngRange(RngStream::DIMENSIONS, -abs((int)rnd), abs((int)rnd));
+      py_fl = y + rngRange(RngStream::DIMENSIONS, -abs((int)rnd), abs((int)rnd));
+      pz_fl = t * rngRange(RngStream::DIMENSIONS, 0, abs((int)rnd));
       break;
       
     case 19:
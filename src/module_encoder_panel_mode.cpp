@@ -4,6 +4,8 @@
 
 #include <Preferences.h>
 
+#include "midi_control_coalescer.h"
+
 // Encoder panel state
 int currentEncoderPage = 0;
 bool encoderFineMode = true;
@@ -261,10 +263,9 @@ void sendEncoderMIDI(int encoderIndex) {
   EncoderMapping &enc = encoderPages[currentEncoderPage].encoders[encoderIndex];
   
   if (enc.type == PARAM_MIDI_CC) {
-    // Send MIDI CC message
-    uint8_t status = 0xB0 | (enc.midiChannel & 0x0F);
+    // Send MIDI CC message (coalesced: a fast turn sends the latest value)
     uint8_t value = constrain(enc.currentValue, 0, 127);
-    sendMIDI(status, enc.midiCC, value);
+    sendMIDIControl(enc.midiChannel & 0x0F, enc.midiCC, value);
   }
   // Add handling for PARAM_INTERNAL if needed in the future
 }
@@ -1,5 +1,7 @@
 #include "module_euclidean_mode.h"
+#include "background_generator.h"
 #include "clock_manager.h"
+#include "scene_store.h"
 
 #ifdef ENABLE_M5_8ENCODER
 #include "drivers/m5_8encoder.h"
@@ -11,6 +13,18 @@
 EuclideanState euclideanState;
 static SequencerSyncState euclidSync;
 
+// Plays the pattern from the clock task whichever screen is shown
+class EuclidGenerator : public BackgroundGenerator {
+public:
+  EuclidGenerator() : BackgroundGenerator("euclid", "Euclid", EUCLID) {}
+
+protected:
+  void advance() override { updateEuclideanSequencer(); }
+};
+
+static EuclidGenerator euclidGenerator;
+REGISTER_BACKGROUND_GENERATOR(euclidGenerator);
+
 // CONTROL_Y_OFFSET removed — unused; layout uses explicit SCALE_* calls
 
 static uint32_t getEuclideanStepIntervalTicks() {
@@ -37,25 +51,121 @@ static void adjustEuclidTempo(int delta) {
 }
 
 static void generateEuclideanPattern(EuclideanVoice &voice) {
-  std::memset(voice.pattern, 0, sizeof(voice.pattern));
-  if (voice.events == 0 || voice.steps == 0) {
+  uint64_t mask = euclidRotate(euclidPattern(voice.events, voice.steps), voice.steps, voice.rotation);
+  voice.mask = voice.inverted ? euclidInvert(mask, voice.steps) : mask;
+  if (voice.position >= voice.steps) {
+    voice.position = voice.steps ? voice.position % voice.steps : 0;
+  }
+}
+
+static void resetEuclideanPositions() {
+  for (EuclideanVoice &voice : euclideanState.voices) {
+    voice.position = 0;
+  }
+}
+
+// One bit per voice for the hits due on this step, after pattern logic
+static uint8_t gatherEuclideanStep() {
+  uint8_t hits = 0;
+  for (int voiceIdx = 0; voiceIdx < EUCLIDEAN_VOICE_COUNT; ++voiceIdx) {
+    const EuclideanVoice &voice = euclideanState.voices[voiceIdx];
+    hits |= static_cast<uint8_t>((voice.mask >> voice.position) & 1u) << voiceIdx;
+  }
+  uint8_t combined = hits;
+  for (int voiceIdx = 0; voiceIdx < EUCLIDEAN_VOICE_COUNT; ++voiceIdx) {
+    const EuclideanVoice &voice = euclideanState.voices[voiceIdx];
+    if (voice.logicOp == EuclidLogicOp::NONE) {
+      continue;
+    }
+    uint8_t own = (hits >> voiceIdx) & 1u;
+    uint8_t other = (hits >> voice.logicSource) & 1u;
+    uint8_t bit = static_cast<uint8_t>(euclidCombine(own, other, voice.logicOp));
+    combined = (combined & ~(1u << voiceIdx)) | (bit << voiceIdx);
+  }
+  return combined;
+}
+
+static void advanceEuclideanPositions() {
+  for (EuclideanVoice &voice : euclideanState.voices) {
+    if (++voice.position >= voice.steps) {
+      voice.position = 0;
+    }
+  }
+}
+
+void setEuclideanVoiceLogic(uint8_t voice, EuclidLogicOp op, uint8_t source) {
+  if (voice >= EUCLIDEAN_VOICE_COUNT || source >= EUCLIDEAN_VOICE_COUNT || op >= EuclidLogicOp::COUNT) {
     return;
   }
+  BackgroundGenerator::ViewLock lock(euclidGenerator);
+  euclideanState.voices[voice].logicOp = source == voice ? EuclidLogicOp::NONE : op;
+  euclideanState.voices[voice].logicSource = source;
+  requestRedraw();
+}
 
-  int bucket = 0;
-  for (int i = 0; i < voice.steps; ++i) {
-    bucket += voice.events;
-    if (bucket >= voice.steps) {
-      bucket -= voice.steps;
-      int pos = (i + voice.rotation) % voice.steps;
-      if (pos < 0) {
-        pos += voice.steps;
-      }
-      voice.pattern[pos] = true;
+void setEuclideanVoiceInverted(uint8_t voice, bool inverted) {
+  if (voice >= EUCLIDEAN_VOICE_COUNT) {
+    return;
+  }
+  BackgroundGenerator::ViewLock lock(euclidGenerator);
+  euclideanState.voices[voice].inverted = inverted;
+  generateEuclideanPattern(euclideanState.voices[voice]);
+  requestRedraw();
+}
+
+// Scene section: the voice settings; positions restart and masks are rebuilt
+static constexpr uint32_t kEuclidSceneTag = SCENE_TAG('E', 'U', 'C', 'L');
+
+static void saveEuclideanScene(SceneWriter &out) {
+  out.u8(euclideanState.tripletMode ? 1 : 0);
+  for (const EuclideanVoice &voice : euclideanState.voices) {
+    out.u8(voice.steps);
+    out.u8(voice.events);
+    out.u8(static_cast<uint8_t>(voice.rotation));
+    out.u8(voice.midiNote);
+    out.u8(voice.inverted ? 1 : 0);
+    out.u8(static_cast<uint8_t>(voice.logicOp));
+    out.u8(voice.logicSource);
+  }
+}
+
+static bool loadEuclideanScene(SceneReader &in, uint16_t version) {
+  if (version != 1) {
+    return false;
+  }
+  bool triplet = in.u8() != 0;
+  EuclideanVoice voices[EUCLIDEAN_VOICE_COUNT];
+  std::memcpy(voices, euclideanState.voices, sizeof(voices));
+  for (EuclideanVoice &voice : voices) {
+    voice.steps = in.u8();
+    voice.events = in.u8();
+    voice.rotation = static_cast<int8_t>(in.u8());
+    voice.midiNote = in.u8() & 0x7F;
+    voice.inverted = in.u8() != 0;
+    voice.logicOp = static_cast<EuclidLogicOp>(in.u8());
+    voice.logicSource = in.u8();
+    voice.position = 0;
+    if (voice.steps < 1 || voice.steps > EUCLIDEAN_MAX_STEPS || voice.events > voice.steps ||
+        voice.logicOp >= EuclidLogicOp::COUNT || voice.logicSource >= EUCLIDEAN_VOICE_COUNT) {
+      return false;
     }
   }
+  if (!in.ok()) {
+    return false;
+  }
+  euclideanState.tripletMode = triplet;
+  for (int i = 0; i < EUCLIDEAN_VOICE_COUNT; ++i) {
+    euclideanState.voices[i] = voices[i];
+    generateEuclideanPattern(euclideanState.voices[i]);
+  }
+  return true;
 }
 
+static const SceneSection kEuclidScene = {kEuclidSceneTag, 1, "euclid voices",
+                                          1 + EUCLIDEAN_VOICE_COUNT * 7, saveEuclideanScene,
+                                          loadEuclideanScene, nullptr};
+REGISTER_SCENE_SECTION(kEuclidScene);
+
 static void releaseEuclideanNotes() {
   for (int voiceIdx = 0; voiceIdx < EUCLIDEAN_VOICE_COUNT; ++voiceIdx) {
     if (!euclideanState.pendingNoteRelease[voiceIdx]) {
@@ -67,27 +177,40 @@ static void releaseEuclideanNotes() {
 }
 
 void initializeEuclideanMode() {
-  const uint8_t baseSteps[EUCLIDEAN_VOICE_COUNT] = {16, 16, 16, 16, 16, 16, 16, 16};
-  const uint8_t baseEvents[EUCLIDEAN_VOICE_COUNT] = {4, 4, 8, 5, 3, 6, 7, 2};
-  const int8_t rotations[EUCLIDEAN_VOICE_COUNT] = {0, 2, 0, 1, 0, 1, 3, 2};
-  const uint8_t notes[EUCLIDEAN_VOICE_COUNT] = {36, 38, 42, 39, 45, 47, 49, 51};
-  const uint16_t colors[EUCLIDEAN_VOICE_COUNT] = {THEME_ERROR, THEME_WARNING, THEME_SUCCESS, THEME_ACCENT, THEME_PRIMARY, 0xFD40, 0x8010, 0xFE19};
+  {
+    BackgroundGenerator::ViewLock lock(euclidGenerator);
+    // Defaults only the first time: the pattern may still be playing from the
+    // last visit
+    static bool initialized = false;
+    if (!initialized) {
+      const uint8_t baseSteps[EUCLIDEAN_VOICE_COUNT] = {16, 16, 16, 16, 16, 16, 16, 16};
+      const uint8_t baseEvents[EUCLIDEAN_VOICE_COUNT] = {4, 4, 8, 5, 3, 6, 7, 2};
+      const int8_t rotations[EUCLIDEAN_VOICE_COUNT] = {0, 2, 0, 1, 0, 1, 3, 2};
+      const uint8_t notes[EUCLIDEAN_VOICE_COUNT] = {36, 38, 42, 39, 45, 47, 49, 51};
+      const uint16_t colors[EUCLIDEAN_VOICE_COUNT] = {THEME_ERROR, THEME_WARNING, THEME_SUCCESS, THEME_ACCENT, THEME_PRIMARY, 0xFD40, 0x8010, 0xFE19};
 
-  for (int i = 0; i < EUCLIDEAN_VOICE_COUNT; ++i) {
-    euclideanState.voices[i].steps = baseSteps[i];
-    euclideanState.voices[i].events = baseEvents[i];
-    euclideanState.voices[i].rotation = rotations[i];
-    euclideanState.voices[i].midiNote = notes[i];
-    euclideanState.voices[i].color = colors[i];
-    generateEuclideanPattern(euclideanState.voices[i]);
-  }
+      for (int i = 0; i < EUCLIDEAN_VOICE_COUNT; ++i) {
+        euclideanState.voices[i].steps = baseSteps[i];
+        euclideanState.voices[i].events = baseEvents[i];
+        euclideanState.voices[i].rotation = rotations[i];
+        euclideanState.voices[i].midiNote = notes[i];
+        euclideanState.voices[i].color = colors[i];
+        euclideanState.voices[i].inverted = false;
+        euclideanState.voices[i].logicOp = EuclidLogicOp::NONE;
+        euclideanState.voices[i].logicSource = i;
+        euclideanState.voices[i].position = 0;
+        generateEuclideanPattern(euclideanState.voices[i]);
+      }
 
-  euclideanState.bpm = sharedBPM;
-  euclideanState.currentStep = 0;
-  euclidSync.reset();
-  euclideanState.tripletMode = false;
-  euclideanState.tripletAccumulator = 0;
-  std::memset(euclideanState.pendingNoteRelease, 0, sizeof(euclideanState.pendingNoteRelease));
+      euclidSync.reset();
+      euclideanState.tripletMode = false;
+      euclideanState.tripletAccumulator = 0;
+      std::memset(euclideanState.pendingNoteRelease, 0, sizeof(euclideanState.pendingNoteRelease));
+      initialized = true;
+    }
+    euclideanState.bpm = sharedBPM;
+    sceneApplyPending(kEuclidSceneTag);
+  }
   
   drawEuclideanMode();
 }
@@ -117,9 +240,8 @@ void drawEuclideanMode() {
       int x = centerX + cos(angle) * layerRadius;
       int y = centerY + sin(angle) * layerRadius;
       
-      bool active = voice.pattern[step];
-      bool isCurrent = (euclidSync.playing &&
-                       step == (euclideanState.currentStep % totalSteps));
+      bool active = (voice.mask >> step) & 1u;
+      bool isCurrent = (euclidSync.playing && step == voice.position);
       
       uint16_t color;
       if (isCurrent && active) {
@@ -140,7 +262,7 @@ void drawEuclideanMode() {
   // Draw sweeping line showing current step position
   if (euclidSync.playing && euclideanState.voices[0].steps > 0) {
     int totalSteps = euclideanState.voices[0].steps;
-    float angle = (2.0 * PI * (euclideanState.currentStep % totalSteps)) / totalSteps - PI/2;
+    float angle = (2.0 * PI * euclideanState.voices[0].position) / totalSteps - PI/2;
     int lineEndX = centerX + cos(angle) * radius;
     int lineEndY = centerY + sin(angle) * radius;
     tft.drawLine(centerX, centerY, lineEndX, lineEndY, THEME_PRIMARY);
@@ -194,7 +316,7 @@ void updateEuclideanSequencer() {
   bool justStarted = euclidSync.playing && !wasPlaying;
   
   if (justStarted) {
-    euclideanState.currentStep = 0;
+    resetEuclideanPositions();
     euclideanState.tripletAccumulator = 0;
   }
   
@@ -213,29 +335,34 @@ void updateEuclideanSequencer() {
     return;
   }
 
-  Serial.printf("[EUCLID] readySteps=%u currentStep=%u\n", readySteps, euclideanState.currentStep);
+#if DEBUG_ENABLED
+  Serial.printf("[EUCLID] readySteps=%u position=%u\n", readySteps, euclideanState.voices[0].position);
+#endif
 
   for (uint32_t i = 0; i < readySteps; ++i) {
     releaseEuclideanNotes();
-    for (int voiceIdx = 0; voiceIdx < EUCLIDEAN_VOICE_COUNT; ++voiceIdx) {
-      EuclideanVoice &voice = euclideanState.voices[voiceIdx];
-      if (voice.steps == 0) {
-        continue;
-      }
-      int stepIndex = euclideanState.currentStep % voice.steps;
-      if (!voice.pattern[stepIndex]) {
-        continue;
-      }
-      sendMIDI(0x90, voice.midiNote, 110);
+    uint8_t hits = gatherEuclideanStep();
+    while (hits) {
+      int voiceIdx = __builtin_ctz(hits);
+      hits &= hits - 1;
+      sendMIDI(0x90, euclideanState.voices[voiceIdx].midiNote, 110);
       euclideanState.pendingNoteRelease[voiceIdx] = true;
     }
-    euclideanState.currentStep = (euclideanState.currentStep + 1) % EUCLIDEAN_MAX_STEPS;
+    advanceEuclideanPositions();
+  }
+  if (euclidGenerator.viewAttached()) {
+    requestRedraw();  // Request redraw to show step progress
   }
-  requestRedraw();  // Request redraw to show step progress
 }
 
 void handleEuclideanMode() {
-  updateEuclideanSequencer();
+  // Leaving the screen keeps the pattern playing
+  if (touch.justPressed && isButtonPressed(BACK_BUTTON_X, BACK_BUTTON_Y, BACK_BUTTON_W, BACK_BUTTON_H)) {
+    exitToMenu();
+    return;
+  }
+
+  BackgroundGenerator::ViewLock lock(euclidGenerator);
 
 #ifdef ENABLE_M5_8ENCODER
   // Poll encoder hardware for parameter changes
@@ -282,11 +409,6 @@ void handleEuclideanMode() {
   if (!touch.justPressed) {
     return;
   }
-  if (isButtonPressed(BACK_BUTTON_X, BACK_BUTTON_Y, BACK_BUTTON_W, BACK_BUTTON_H)) {
-    releaseEuclideanNotes();
-    exitToMenu();
-    return;
-  }
 
   // Calculate right-side control positions
   int centerX = MARGIN_SMALL + SCALE_X(65);
@@ -306,8 +428,9 @@ void handleEuclideanMode() {
       euclidSync.stopPlayback();
       releaseEuclideanNotes();
     } else {
-      euclideanState.currentStep = 0;
+      resetEuclideanPositions();
       euclidSync.requestStart();
+      updateEuclideanSequencer();  // An idle clock restarts on a bar: start now
     }
     requestRedraw();
     return;
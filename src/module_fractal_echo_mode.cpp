@@ -1,5 +1,8 @@
 #include "module_fractal_echo_mode.h"
+#include "midi_transport.h"
 #include <algorithm>
+#include <freertos/FreeRTOS.h>
+#include <freertos/portmacro.h>
 
 // Constants
 namespace {
@@ -10,6 +13,258 @@ namespace {
   constexpr int PAGE_NAV_BUTTON_H = 25;
   constexpr int PAGE_NAV_SPACING = 50;
   constexpr int NUM_PAGES = 3;
+  constexpr uint16_t TEST_NOTE_LENGTH_MS = 300;
+  constexpr size_t MAX_ECHOES_PER_CALL = FRAC_MAX_TAPS * FRAC_MAX_ITER;
+  // Bounds the time spent in one service pass (and the stack batch below)
+  constexpr size_t MAX_SENDS_PER_PASS = 32;
+  // An input Note On equal to an echo sent this recently is that echo coming
+  // back (MIDI thru, another unit echoing) and is not echoed again
+  constexpr size_t RECENT_ECHO_COUNT = 32;
+  constexpr uint32_t RECENT_ECHO_WINDOW_US = 50000;
+
+  // Scheduler heap. Written from the input transports (UI loop, BLE task,
+  // ESP-NOW callback) and drained from the clock task, so every access is
+  // made under fractalMux.
+  FractalEchoEvent eventHeap[FRAC_MAX_EVENTS];
+  size_t eventHeapSize = 0;
+  FractalEchoStats stats = {};
+  bool probeArmed = false;
+  uint32_t probeInputUs = 0;
+  portMUX_TYPE fractalMux = portMUX_INITIALIZER_UNLOCKED;
+
+  struct RecentEcho {
+    uint32_t sentUs;
+    uint8_t status;  // 0: empty
+    uint8_t note;
+    uint8_t velocity;
+  };
+  RecentEcho recentEchoes[RECENT_ECHO_COUNT];
+  size_t recentEchoNext = 0;
+
+  // Started from the CLI, serviced from the clock task; under fractalMux too
+  struct BenchState {
+    bool injecting = false;
+    bool draining = false;
+    uint32_t intervalUs = 0;
+    uint32_t nextUs = 0;
+    uint32_t remaining = 0;
+    uint8_t note = 48;
+  };
+  BenchState bench;
+
+  // Wrap-safe: micros() rolls over every ~71 minutes
+  inline bool dueBefore(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) < 0;
+  }
+
+  uint8_t outPortForSource(uint8_t source) {
+    switch (source) {
+      case CLOCK_HARDWARE: return static_cast<uint8_t>(MidiOutPort::DIN);
+      case CLOCK_BLE:      return static_cast<uint8_t>(MidiOutPort::BLE);
+      case CLOCK_WIFI:     return static_cast<uint8_t>(MidiOutPort::WIFI);
+      case CLOCK_ESP_NOW:  return static_cast<uint8_t>(MidiOutPort::ESP_NOW);
+      default:             return static_cast<uint8_t>(MidiOutPort::COUNT);
+    }
+  }
+
+  void rememberEchoLocked(uint8_t status, uint8_t note, uint8_t velocity, uint32_t sentUs) {
+    recentEchoes[recentEchoNext] = {sentUs, status, note, velocity};
+    recentEchoNext = (recentEchoNext + 1) % RECENT_ECHO_COUNT;
+  }
+
+  bool isRecentEchoLocked(uint8_t status, uint8_t note, uint8_t velocity, uint32_t inputUs) {
+    for (const RecentEcho& echo : recentEchoes) {
+      if (echo.status == status && echo.note == note && echo.velocity == velocity &&
+          inputUs - echo.sentUs < RECENT_ECHO_WINDOW_US) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool pushEventLocked(const FractalEchoEvent& event) {
+    if (eventHeapSize >= FRAC_MAX_EVENTS) {
+      stats.dropped++;
+      return false;
+    }
+    size_t i = eventHeapSize++;
+    while (i > 0) {
+      size_t parent = (i - 1) / 2;
+      if (!dueBefore(event.dueTimeUs, eventHeap[parent].dueTimeUs)) {
+        break;
+      }
+      eventHeap[i] = eventHeap[parent];
+      i = parent;
+    }
+    eventHeap[i] = event;
+    if (eventHeapSize > stats.peakQueued) {
+      stats.peakQueued = static_cast<uint16_t>(eventHeapSize);
+    }
+    return true;
+  }
+
+  FractalEchoEvent popEventLocked() {
+    FractalEchoEvent top = eventHeap[0];
+    FractalEchoEvent last = eventHeap[--eventHeapSize];
+    size_t i = 0;
+    while (true) {
+      size_t child = 2 * i + 1;
+      if (child >= eventHeapSize) {
+        break;
+      }
+      if (child + 1 < eventHeapSize &&
+          dueBefore(eventHeap[child + 1].dueTimeUs, eventHeap[child].dueTimeUs)) {
+        child++;
+      }
+      if (!dueBefore(eventHeap[child].dueTimeUs, last.dueTimeUs)) {
+        break;
+      }
+      eventHeap[i] = eventHeap[child];
+      i = child;
+    }
+    if (eventHeapSize > 0) {
+      eventHeap[i] = last;
+    }
+    return top;
+  }
+
+  void scheduleNoteOff(uint8_t channel, uint8_t note, uint16_t delayMs) {
+    FractalEchoEvent event = {};
+    event.dueTimeUs = micros() + delayMs * 1000UL;
+    event.channel = channel;
+    event.note = note;
+    event.skipPort = static_cast<uint8_t>(MidiOutPort::COUNT);
+    portENTER_CRITICAL(&fractalMux);
+    pushEventLocked(event);
+    portEXIT_CRITICAL(&fractalMux);
+  }
+
+  // Builds the echo set for one input note outside the lock, then inserts it
+  // into the heap in a single critical section.
+  void scheduleEchoes(uint8_t note, uint8_t velocity, uint8_t channel, uint32_t inputUs,
+                      uint8_t skipPort) {
+    FractalEchoEvent echoes[MAX_ECHOES_PER_CALL];
+    size_t count = 0;
+    size_t earliest = 0;
+    uint32_t now = micros();
+
+    for (int iter = 0; iter < fractalParams.iterations && iter < FRAC_MAX_ITER; iter++) {
+      float iterStretch = powf(fractalParams.stretch, iter);
+      float iterVelocityScale = powf(fractalParams.velocityDecay, iter);
+      float iterLengthScale = powf(fractalParams.lengthDecay, iter);
+
+      int iterNote = note + fractalParams.offsets[iter];
+      if (iterNote < 0) iterNote = 0;
+      if (iterNote > 127) iterNote = 127;
+
+      int iterVelocity = (int)(velocity * iterVelocityScale);
+      if (iterVelocity < fractalParams.minVelocity) {
+        break;  // Stop if velocity too low
+      }
+      if (iterVelocity > 127) iterVelocity = 127;
+
+      uint16_t iterLength = (uint16_t)(fractalParams.baseLengthMs * iterLengthScale);
+      if (iterLength > 4095) iterLength = 4095;
+
+      // For each tap
+      for (int tap = 0; tap < FRAC_MAX_TAPS; tap++) {
+        if (fractalParams.tapsMs[tap] == 0) continue;
+
+        uint32_t delayMs = (uint32_t)(fractalParams.tapsMs[tap] * iterStretch);
+
+        FractalEchoEvent& echo = echoes[count];
+        echo = {};
+        echo.dueTimeUs = now + delayMs * 1000UL;
+        echo.channel = channel;
+        echo.noteOn = 1;
+        echo.note = iterNote;
+        echo.velocity = iterVelocity;
+        echo.lengthMs = iterLength;
+        echo.skipPort = skipPort;
+        if (dueBefore(echo.dueTimeUs, echoes[earliest].dueTimeUs)) {
+          earliest = count;
+        }
+        count++;
+
+        // Check max echoes limit
+        if (count >= fractalParams.maxEchoesPerNote || count >= MAX_ECHOES_PER_CALL) {
+          break;
+        }
+      }
+      if (count >= fractalParams.maxEchoesPerNote || count >= MAX_ECHOES_PER_CALL) {
+        break;
+      }
+    }
+
+    uint32_t ingestUs = micros() - inputUs;
+    portENTER_CRITICAL(&fractalMux);
+    bool armProbe = !probeArmed && count > 0;
+    if (armProbe) {
+      echoes[earliest].probe = 1;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (pushEventLocked(echoes[i])) {
+        stats.echoesScheduled++;
+        if (echoes[i].probe) {
+          probeArmed = true;
+          probeInputUs = inputUs;
+        }
+      }
+    }
+    stats.lastIngestUs = ingestUs;
+    if (ingestUs > stats.maxIngestUs) {
+      stats.maxIngestUs = ingestUs;
+    }
+    portEXIT_CRITICAL(&fractalMux);
+  }
+
+  void printFractalEchoStats(const FractalEchoStats& s) {
+    Serial.printf("[FractalEcho] in=%u scheduled=%u sent=%u dropped=%u loops=%u queued=%u peak=%u/%u\n",
+                  s.notesIn, s.echoesScheduled, s.echoesSent, s.dropped, s.loopsIgnored, s.queued,
+                  s.peakQueued, FRAC_MAX_EVENTS);
+    Serial.printf("[FractalEcho] ingest last=%uus max=%uus | lateness max=%uus | "
+                  "first echo last=%uus min=%uus max=%uus\n",
+                  s.lastIngestUs, s.maxIngestUs, s.maxLatenessUs, s.lastFirstEchoUs,
+                  s.minFirstEchoUs == UINT32_MAX ? 0 : s.minFirstEchoUs, s.maxFirstEchoUs);
+  }
+
+  void serviceBench(uint32_t nowUs) {
+    // Claim the notes that are due under the lock, then inject them outside it:
+    // ingest takes fractalMux itself
+    uint32_t due = 0;
+    uint8_t note = 48;
+    bool complete = false;
+    portENTER_CRITICAL(&fractalMux);
+    if (bench.injecting) {
+      if (bench.remaining > 0 && !dueBefore(nowUs, bench.nextUs)) {
+        due = (nowUs - bench.nextUs) / bench.intervalUs + 1;
+        if (due > bench.remaining) {
+          due = bench.remaining;
+        }
+        note = bench.note;
+        bench.note = static_cast<uint8_t>(48 + (bench.note - 48 + due) % 25);
+        bench.nextUs += due * bench.intervalUs;
+        bench.remaining -= due;
+      }
+      if (bench.remaining == 0) {
+        bench.injecting = false;
+        bench.draining = true;
+      }
+    } else if (bench.draining && eventHeapSize == 0) {
+      bench.draining = false;
+      complete = true;
+    }
+    portEXIT_CRITICAL(&fractalMux);
+
+    for (uint32_t i = 0; i < due; ++i) {
+      midiTransportProcessChannelMessage(0x90, note, 100, CLOCK_INTERNAL);
+      note = (note >= 72) ? 48 : note + 1;
+    }
+    if (complete) {
+      Serial.println("[FractalEcho] Bench complete");
+      printFractalEchoStats(getFractalEchoStats());
+    }
+  }
 }
 
 // Global state
@@ -32,16 +287,15 @@ FractalParams fractalParams = {
   .offsets = {0, 7, 12, -5, 5, 0}
 };
 
-MidiEvent eventQueue[FRAC_MAX_EVENTS];
-int eventQueueSize = 0;
 int fractalPage = 0;
 
+void initFractalEchoService() {
+  resetFractalEchoStats();
+  midiTransportSetChannelInputHandler(fractalEchoHandleMidiInput);
+}
+
 void initializeFractalEchoMode() {
-  // Reset event queue
-  eventQueueSize = 0;
-  for (int i = 0; i < FRAC_MAX_EVENTS; i++) {
-    eventQueue[i].active = false;
-  }
+  // Echoes keep running in the background; entering the mode only resets the UI
   fractalPage = 0;
 }
 
@@ -202,9 +456,6 @@ void drawFractalEchoMode() {
 }
 
 void handleFractalEchoMode() {
-  // Process scheduled MIDI events
-  processMidiEvents();
-  
   if (!touch.justPressed) {
     return;
   }
@@ -237,14 +488,7 @@ void handleFractalEchoMode() {
     }
     
     // Schedule note off for original
-    if (eventQueueSize < FRAC_MAX_EVENTS) {
-      eventQueue[eventQueueSize].dueTimeMs = millis() + 300;
-      eventQueue[eventQueueSize].status = 0x80 | testChannel;
-      eventQueue[eventQueueSize].data1 = testNote;
-      eventQueue[eventQueueSize].data2 = 0;
-      eventQueue[eventQueueSize].active = true;
-      eventQueueSize++;
-    }
+    scheduleNoteOff(testChannel, testNote, TEST_NOTE_LENGTH_MS);
     return;
   }
   
@@ -411,88 +655,116 @@ void addFractalEcho(uint8_t note, uint8_t velocity, uint8_t channel) {
   if (!fractalParams.enabled) {
     return;
   }
-  
-  uint32_t now = millis();
-  int echoCount = 0;
-  
-  // For each iteration
-  for (int iter = 0; iter < fractalParams.iterations && iter < FRAC_MAX_ITER; iter++) {
-    float iterStretch = pow(fractalParams.stretch, iter);
-    float iterVelocityScale = pow(fractalParams.velocityDecay, iter);
-    float iterLengthScale = pow(fractalParams.lengthDecay, iter);
-    
-    int iterNote = note + fractalParams.offsets[iter];
-    if (iterNote < 0) iterNote = 0;
-    if (iterNote > 127) iterNote = 127;
-    
-    int iterVelocity = (int)(velocity * iterVelocityScale);
-    if (iterVelocity < fractalParams.minVelocity) {
-      break;  // Stop if velocity too low
-    }
-    if (iterVelocity > 127) iterVelocity = 127;
-    
-    uint16_t iterLength = (uint16_t)(fractalParams.baseLengthMs * iterLengthScale);
-    
-    // For each tap
-    for (int tap = 0; tap < FRAC_MAX_TAPS; tap++) {
-      if (fractalParams.tapsMs[tap] == 0) continue;
-      
-      uint32_t delay = (uint32_t)(fractalParams.tapsMs[tap] * iterStretch);
-      
-      // Add Note On event
-      if (eventQueueSize < FRAC_MAX_EVENTS) {
-        eventQueue[eventQueueSize].dueTimeMs = now + delay;
-        eventQueue[eventQueueSize].status = 0x90 | channel;
-        eventQueue[eventQueueSize].data1 = iterNote;
-        eventQueue[eventQueueSize].data2 = iterVelocity;
-        eventQueue[eventQueueSize].active = true;
-        eventQueueSize++;
-        echoCount++;
-      }
-      
-      // Add Note Off event
-      if (eventQueueSize < FRAC_MAX_EVENTS) {
-        eventQueue[eventQueueSize].dueTimeMs = now + delay + iterLength;
-        eventQueue[eventQueueSize].status = 0x80 | channel;
-        eventQueue[eventQueueSize].data1 = iterNote;
-        eventQueue[eventQueueSize].data2 = 0;
-        eventQueue[eventQueueSize].active = true;
-        eventQueueSize++;
-      }
-      
-      // Check max echoes limit
-      if (echoCount >= fractalParams.maxEchoesPerNote) {
-        return;
-      }
-    }
+  scheduleEchoes(note, velocity, channel, micros(), static_cast<uint8_t>(MidiOutPort::COUNT));
+}
+
+// Live input from any transport (see midiTransportSetChannelInputHandler).
+// Runs on the receiving transport's thread and goes straight into the heap.
+void fractalEchoHandleMidiInput(uint8_t status, uint8_t data1, uint8_t data2,
+                                uint32_t timestampUs, uint8_t source) {
+  if (!fractalParams.enabled || (status & 0xF0) != 0x90 || data2 == 0) {
+    return;
+  }
+  portENTER_CRITICAL(&fractalMux);
+  bool echoedBack = isRecentEchoLocked(status, data1, data2, timestampUs);
+  if (echoedBack) {
+    stats.loopsIgnored++;
+  } else {
+    stats.notesIn++;
   }
+  portEXIT_CRITICAL(&fractalMux);
+  if (echoedBack) {
+    return;
+  }
+  scheduleEchoes(data1 & 0x7F, data2 & 0x7F, status & 0x0F, timestampUs, outPortForSource(source));
 }
 
-// Process scheduled MIDI events
-void processMidiEvents() {
-  uint32_t now = millis();
-  
-  for (int i = 0; i < eventQueueSize; i++) {
-    if (!eventQueue[i].active) continue;
-    
-    if (now >= eventQueue[i].dueTimeMs) {
-      // Send the MIDI event
-      sendMIDI(eventQueue[i].status, eventQueue[i].data1, eventQueue[i].data2);
-      
-      // Mark as inactive
-      eventQueue[i].active = false;
+// Send every due event. Called from the clock task every millisecond.
+void processFractalEcho() {
+  uint32_t nowUs = micros();
+  serviceBench(nowUs);
+
+  struct PendingSend {
+    uint8_t status;
+    uint8_t note;
+    uint8_t velocity;
+    uint8_t skipPort;
+  };
+  PendingSend sends[MAX_SENDS_PER_PASS];
+  size_t sendCount = 0;
+
+  portENTER_CRITICAL(&fractalMux);
+  while (eventHeapSize > 0 && sendCount < MAX_SENDS_PER_PASS &&
+         !dueBefore(nowUs, eventHeap[0].dueTimeUs)) {
+    FractalEchoEvent event = popEventLocked();
+    uint32_t latenessUs = nowUs - event.dueTimeUs;
+    if (latenessUs > stats.maxLatenessUs) {
+      stats.maxLatenessUs = latenessUs;
     }
-  }
-  
-  // Compact the queue (remove inactive events)
-  int writeIdx = 0;
-  for (int readIdx = 0; readIdx < eventQueueSize; readIdx++) {
-    if (eventQueue[readIdx].active) {
-      if (writeIdx != readIdx) {
-        eventQueue[writeIdx] = eventQueue[readIdx];
+    if (event.noteOn) {
+      sends[sendCount++] = {static_cast<uint8_t>(0x90 | event.channel),
+                            static_cast<uint8_t>(event.note),
+                            static_cast<uint8_t>(event.velocity), event.skipPort};
+      rememberEchoLocked(sends[sendCount - 1].status, sends[sendCount - 1].note,
+                         sends[sendCount - 1].velocity, nowUs);
+      stats.echoesSent++;
+      if (event.probe && probeArmed) {
+        uint32_t firstEchoUs = nowUs - probeInputUs;
+        stats.lastFirstEchoUs = firstEchoUs;
+        stats.minFirstEchoUs = std::min(stats.minFirstEchoUs, firstEchoUs);
+        stats.maxFirstEchoUs = std::max(stats.maxFirstEchoUs, firstEchoUs);
+        probeArmed = false;
       }
-      writeIdx++;
+      // Re-arm the same slot as the Note Off; the pop above guarantees room
+      event.dueTimeUs += event.lengthMs * 1000UL;
+      event.noteOn = 0;
+      event.probe = 0;
+      pushEventLocked(event);
+    } else {
+      sends[sendCount++] = {static_cast<uint8_t>(0x80 | event.channel),
+                            static_cast<uint8_t>(event.note), 0, event.skipPort};
     }
   }
-  eventQueueSize = writeIdx;
+  portEXIT_CRITICAL(&fractalMux);
+
+  // Transport sends may block (BLE notify, UDP), so never hold the lock here
+  for (size_t i = 0; i < sendCount; ++i) {
+    sendMIDIExcept(static_cast<MidiOutPort>(sends[i].skipPort), sends[i].status, sends[i].note,
+                   sends[i].velocity);
+  }
+}
+
+FractalEchoStats getFractalEchoStats() {
+  portENTER_CRITICAL(&fractalMux);
+  FractalEchoStats snapshot = stats;
+  snapshot.queued = static_cast<uint16_t>(eventHeapSize);
+  portEXIT_CRITICAL(&fractalMux);
+  return snapshot;
+}
+
+void resetFractalEchoStats() {
+  portENTER_CRITICAL(&fractalMux);
+  stats = {};
+  stats.minFirstEchoUs = UINT32_MAX;
+  stats.peakQueued = static_cast<uint16_t>(eventHeapSize);
+  probeArmed = false;
+  portEXIT_CRITICAL(&fractalMux);
+}
+
+void startFractalEchoBench(uint16_t notesPerSecond, uint16_t seconds) {
+  if (notesPerSecond == 0 || seconds == 0) {
+    return;
+  }
+  resetFractalEchoStats();
+  uint32_t nowUs = micros();
+  portENTER_CRITICAL(&fractalMux);
+  bench.intervalUs = 1000000UL / notesPerSecond;
+  bench.remaining = static_cast<uint32_t>(notesPerSecond) * seconds;
+  bench.nextUs = nowUs;
+  bench.note = 48;
+  bench.draining = false;
+  bench.injecting = true;
+  portEXIT_CRITICAL(&fractalMux);
+  Serial.printf("[FractalEcho] Bench: %u notes/s for %us (%u echoes/note max)\n", notesPerSecond,
+                seconds, fractalParams.maxEchoesPerNote);
 }
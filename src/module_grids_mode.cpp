@@ -1,7 +1,10 @@
 #include "module_grids_mode.h"
+#include "background_generator.h"
 #include "clock_manager.h"
+#include "rng_service.h"
 
 #include <algorithm>
+#include <cstring>
 #include <pgmspace.h>
 
 GridsState grids;
@@ -19,6 +22,8 @@ struct GridsLayout {
   int sliderH;
   int sliderSpacing;
   int sliderPositions[3];
+  int chaosButtonY;
+  int chaosButtonH;
 };
 
 static SequencerSyncState gridsSync;
@@ -26,6 +31,20 @@ static inline bool gridsIsRequested() {
   return gridsSync.playing || gridsSync.startPending;
 }
 
+static void updateGridsPlayback();
+
+// Plays the drums from the clock task whichever screen is shown
+class GridsGenerator : public BackgroundGenerator {
+public:
+  GridsGenerator() : BackgroundGenerator("grids", "Grids", GRIDS) {}
+
+protected:
+  void advance() override { updateGridsPlayback(); }
+};
+
+static GridsGenerator gridsGenerator;
+REGISTER_BACKGROUND_GENERATOR(gridsGenerator);
+
 static GridsLayout calculateGridsLayout() {
   GridsLayout layout;
   const int desiredControlWidth = SCALE_X(90);
@@ -65,66 +84,140 @@ static GridsLayout calculateGridsLayout() {
   for (int i = 0; i < 3; ++i) {
     layout.sliderPositions[i] = sliderStartX + i * (layout.sliderW + layout.sliderSpacing);
   }
+
+  // Chaos sits under PLAY/RNDM and shrinks to stay clear of the slider labels
+  layout.chaosButtonY = layout.padY + 2 * (layout.buttonHeight + layout.buttonSpacing);
+  int sliderLabelY = layout.sliderY - SCALE_Y(8) - SCALE_Y(14);
+  layout.chaosButtonH = std::max(SCALE_Y(16),
+                                 std::min(layout.buttonHeight, sliderLabelY - SCALE_Y(4) - layout.chaosButtonY));
   return layout;
 }
 
-static const uint8_t PROGMEM PATTERN_MAP[4][3][GRIDS_STEPS] = {
-  {
-    {255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0},
-    {0, 0, 0, 0, 200, 0, 0, 0, 0, 0, 0, 0, 200, 0, 0, 0},
-    {150, 80, 150, 80, 150, 80, 150, 80, 150, 80, 150, 80, 150, 80, 150, 80}
-  },
-  {
-    {255, 0, 0, 180, 0, 0, 255, 0, 0, 180, 0, 0, 255, 0, 0, 0},
-    {0, 0, 255, 0, 0, 0, 0, 180, 0, 0, 255, 0, 0, 0, 180, 0},
-    {200, 120, 80, 150, 200, 120, 80, 150, 200, 120, 80, 150, 200, 120, 80, 150}
-  },
-  {
-    {255, 0, 0, 0, 0, 0, 200, 0, 255, 0, 0, 0, 180, 0, 0, 0},
-    {0, 0, 0, 0, 255, 0, 0, 0, 0, 0, 0, 0, 255, 0, 0, 0},
-    {180, 120, 0, 120, 180, 120, 0, 120, 180, 120, 0, 120, 180, 120, 0, 120}
-  },
-  {
-    {255, 0, 0, 0, 0, 0, 220, 0, 180, 0, 0, 0, 0, 0, 200, 0},
-    {0, 0, 0, 0, 255, 0, 0, 120, 0, 0, 0, 0, 255, 0, 0, 80},
-    {150, 100, 150, 100, 150, 100, 150, 100, 150, 100, 150, 100, 150, 100, 150, 100}
-  }
-};
-
 static inline uint8_t lerp(uint8_t a, uint8_t b, uint8_t amount) {
   return a + (((b - a) * amount) >> 8);
 }
 
-static inline uint8_t bilinearInterpolate(uint8_t v00, uint8_t v10, uint8_t v01, uint8_t v11,
-                                           uint8_t x, uint8_t y) {
-  uint8_t v0 = lerp(v00, v10, x);
-  uint8_t v1 = lerp(v01, v11, x);
-  return lerp(v0, v1, y);
+// Quantised pad position: 32 levels per axis
+static constexpr uint8_t kGridsCoordMask = static_cast<uint8_t>(0xFF << GRIDS_COORD_QUANT_SHIFT);
+static constexpr uint16_t kGridsTopLevel = 0xFF >> GRIDS_COORD_QUANT_SHIFT;
+
+// Node position of a pad coordinate in 1/256 node steps. The 32 levels span
+// all four gaps, so both pad edges land exactly on the outer nodes.
+static inline uint16_t gridsNodePosition(uint8_t coord) {
+  return static_cast<uint16_t>((coord >> GRIDS_COORD_QUANT_SHIFT) * ((GRIDS_NODES - 1) << 8) / kGridsTopLevel);
+}
+
+// Bilinear blend of the four nodes surrounding (x, y), written as 96 levels
+static void interpolateGridsPattern(uint8_t x, uint8_t y, uint8_t *out) {
+  const uint16_t px = gridsNodePosition(x);
+  const uint16_t py = gridsNodePosition(y);
+  const int i = px >> 8;
+  const int j = py >> 8;
+  const int i1 = std::min(i + 1, GRIDS_NODES - 1);  // The last node blends with itself
+  const int j1 = std::min(j + 1, GRIDS_NODES - 1);
+  const uint8_t xFrac = static_cast<uint8_t>(px);
+  const uint8_t yFrac = static_cast<uint8_t>(py);
+  const uint8_t *n00 = kGridsNodeMap[i][j];
+  const uint8_t *n10 = kGridsNodeMap[i1][j];
+  const uint8_t *n01 = kGridsNodeMap[i][j1];
+  const uint8_t *n11 = kGridsNodeMap[i1][j1];
+  for (int k = 0; k < GRIDS_NODE_BYTES; ++k) {
+    uint8_t top = lerp(pgm_read_byte(n00 + k), pgm_read_byte(n10 + k), xFrac);
+    uint8_t bottom = lerp(pgm_read_byte(n01 + k), pgm_read_byte(n11 + k), xFrac);
+    out[k] = lerp(top, bottom, yFrac);
+  }
+}
+
+// Direct-mapped cache of interpolated patterns keyed by quantised (x, y).
+// Neighbouring cells map to different slots, so a drag across the pad
+// revisits cached entries instead of re-blending.
+static constexpr int kGridsCacheEntries = 32;
+static constexpr uint16_t kGridsCacheEmpty = 0xFFFF;
+
+struct GridsCacheEntry {
+  uint16_t key;
+  uint8_t levels[GRIDS_NODE_BYTES];
+};
+
+static GridsCacheEntry gridsCache[kGridsCacheEntries];
+static bool gridsCacheReady = false;
+static uint32_t gridsCacheHits = 0;
+static uint32_t gridsCacheMisses = 0;
+
+static const uint8_t *lookupGridsPattern(uint8_t x, uint8_t y) {
+  if (!gridsCacheReady) {
+    for (GridsCacheEntry &entry : gridsCache) {
+      entry.key = kGridsCacheEmpty;
+    }
+    gridsCacheReady = true;
+  }
+  const uint8_t qx = x >> GRIDS_COORD_QUANT_SHIFT;
+  const uint8_t qy = y >> GRIDS_COORD_QUANT_SHIFT;
+  const uint16_t key = static_cast<uint16_t>((qx << 8) | qy);
+  GridsCacheEntry &entry = gridsCache[(qx * 5 + qy) & (kGridsCacheEntries - 1)];
+  if (entry.key == key) {
+    ++gridsCacheHits;
+  } else {
+    ++gridsCacheMisses;
+    interpolateGridsPattern(x, y, entry.levels);
+    entry.key = key;
+  }
+  return entry.levels;
 }
 
 void regenerateGridsPattern() {
-  for (int step = 0; step < GRIDS_STEPS; ++step) {
-    uint8_t kick00 = pgm_read_byte(&PATTERN_MAP[0][0][step]);
-    uint8_t kick10 = pgm_read_byte(&PATTERN_MAP[1][0][step]);
-    uint8_t kick01 = pgm_read_byte(&PATTERN_MAP[2][0][step]);
-    uint8_t kick11 = pgm_read_byte(&PATTERN_MAP[3][0][step]);
-    grids.kickPattern[step] =
-        bilinearInterpolate(kick00, kick10, kick01, kick11, grids.patternX, grids.patternY);
-
-    uint8_t snare00 = pgm_read_byte(&PATTERN_MAP[0][1][step]);
-    uint8_t snare10 = pgm_read_byte(&PATTERN_MAP[1][1][step]);
-    uint8_t snare01 = pgm_read_byte(&PATTERN_MAP[2][1][step]);
-    uint8_t snare11 = pgm_read_byte(&PATTERN_MAP[3][1][step]);
-    grids.snarePattern[step] =
-        bilinearInterpolate(snare00, snare10, snare01, snare11, grids.patternX, grids.patternY);
-
-    uint8_t hat00 = pgm_read_byte(&PATTERN_MAP[0][2][step]);
-    uint8_t hat10 = pgm_read_byte(&PATTERN_MAP[1][2][step]);
-    uint8_t hat01 = pgm_read_byte(&PATTERN_MAP[2][2][step]);
-    uint8_t hat11 = pgm_read_byte(&PATTERN_MAP[3][2][step]);
-    grids.hatPattern[step] =
-        bilinearInterpolate(hat00, hat10, hat01, hat11, grids.patternX, grids.patternY);
+  memcpy(grids.levels, lookupGridsPattern(grids.patternX, grids.patternY), GRIDS_NODE_BYTES);
+}
+
+GridsBenchResult runGridsBenchmark(uint32_t iterations) {
+  GridsBenchResult result = {};
+  result.iterations = iterations;
+  uint8_t scratch[GRIDS_NODE_BYTES];
+  uint32_t hitsBefore = gridsCacheHits;
+  uint32_t missesBefore = gridsCacheMisses;
+
+  // Sweep a diagonal drag so the cached pass sees a realistic mix of hits and misses
+  uint32_t start = micros();
+  for (uint32_t n = 0; n < iterations; ++n) {
+    uint8_t x = static_cast<uint8_t>(n * 3);
+    interpolateGridsPattern(x, static_cast<uint8_t>(255 - x), scratch);
   }
+  result.regenerateUs = micros() - start;
+
+  start = micros();
+  for (uint32_t n = 0; n < iterations; ++n) {
+    uint8_t x = static_cast<uint8_t>(n * 3);
+    memcpy(scratch, lookupGridsPattern(x, static_cast<uint8_t>(255 - x)), GRIDS_NODE_BYTES);
+  }
+  result.cachedUs = micros() - start;
+  result.cacheHits = gridsCacheHits - hitsBefore;
+  result.cacheMisses = gridsCacheMisses - missesBefore;
+  return result;
+}
+
+static uint32_t fnv1a(const uint8_t *data, size_t length) {
+  uint32_t hash = 0x811C9DC5u;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= data[i];
+    hash *= 0x01000193u;
+  }
+  return hash;
+}
+
+int checkGridsGoldenPatterns() {
+  int mismatches = 0;
+  uint8_t levels[GRIDS_NODE_BYTES];
+  for (const GridsGoldenPattern &golden : kGridsGoldenPatterns) {
+    interpolateGridsPattern(golden.x, golden.y, levels);
+    uint32_t direct = fnv1a(levels, sizeof(levels));
+    uint32_t cached = fnv1a(lookupGridsPattern(golden.x, golden.y), GRIDS_NODE_BYTES);
+    if (direct != golden.fnv1a || cached != golden.fnv1a) {
+      Serial.printf("[GRIDS] Golden mismatch at (%u,%u): direct=%08X cached=%08X expected=%08X\n",
+                    golden.x, golden.y, direct, cached, golden.fnv1a);
+      ++mismatches;
+    }
+  }
+  return mismatches;
 }
 
 static inline void triggerDrum(uint8_t note, bool trigger, uint8_t velocity) {
@@ -135,7 +228,7 @@ static inline void triggerDrum(uint8_t note, bool trigger, uint8_t velocity) {
   sendMIDI(0x80, note, 0);
 }
 
-void updateGridsPlayback() {
+static void updateGridsPlayback() {
   bool wasPlaying = gridsSync.playing;
   gridsSync.tryStartIfReady(!instantStartMode);
   bool justStarted = gridsSync.playing && !wasPlaying;
@@ -154,23 +247,30 @@ void updateGridsPlayback() {
     return;
   }
 
+  const uint8_t densities[GRIDS_INSTRUMENTS] = {grids.kickDensity, grids.snareDensity, grids.hatDensity};
+  const uint8_t notes[GRIDS_INSTRUMENTS] = {grids.kickNote, grids.snareNote, grids.hatNote};
+  const uint8_t normalVelocity[GRIDS_INSTRUMENTS] = {100, 100, 90};
+
   // Process all ready steps for tight timing
   for (uint32_t i = 0; i < readySteps; ++i) {
-    bool kickTrigger = grids.kickPattern[grids.step] >= (255 - grids.kickDensity);
-    bool snareTrigger = grids.snarePattern[grids.step] >= (255 - grids.snareDensity);
-    bool hatTrigger = grids.hatPattern[grids.step] >= (255 - grids.hatDensity);
-
-    uint8_t kickVel = grids.kickPattern[grids.step] >= grids.accentThreshold ? 127 : 100;
-    uint8_t snareVel = grids.snarePattern[grids.step] >= grids.accentThreshold ? 127 : 100;
-    uint8_t hatVel = grids.hatPattern[grids.step] >= grids.accentThreshold ? 127 : 90;
-
-    triggerDrum(grids.kickNote, kickTrigger, kickVel);
-    triggerDrum(grids.snareNote, snareTrigger, snareVel);
-    triggerDrum(grids.hatNote, hatTrigger, hatVel);
+    if (grids.step == 0) {
+      for (int inst = 0; inst < GRIDS_INSTRUMENTS; ++inst) {
+        grids.perturbation[inst] = (rngBelow(RngStream::GRIDS, 256) * grids.chaos) >> 8;
+      }
+    }
+    for (int inst = 0; inst < GRIDS_INSTRUMENTS; ++inst) {
+      uint8_t level = grids.levels[inst][grids.step];
+      level = std::min(255, level + grids.perturbation[inst]);
+      bool trigger = level >= (255 - densities[inst]);
+      uint8_t velocity = level >= grids.accentThreshold ? 127 : normalVelocity[inst];
+      triggerDrum(notes[inst], trigger, velocity);
+    }
 
     grids.step = (grids.step + 1) % GRIDS_STEPS;
   }
-  requestRedraw();  // Request redraw to show step progress
+  if (gridsGenerator.viewAttached()) {
+    requestRedraw();  // Request redraw to show step progress
+  }
 }
 
 void drawGridsMode() {
@@ -259,53 +359,76 @@ void drawGridsMode() {
   
   // Random button
   drawRoundButton(controlX, buttonY, controlW, buttonH, "RNDM", THEME_ACCENT, false, 2);
+
+  // Chaos cycles through 0/25/50/75/100%
+  char chaosLabel[12];
+  snprintf(chaosLabel, sizeof(chaosLabel), "CH %d%%", (grids.chaos * 100 + 127) / 255);
+  drawRoundButton(controlX, layout.chaosButtonY, controlW, layout.chaosButtonH, chaosLabel,
+                  grids.chaos > 0 ? THEME_WARNING : THEME_SURFACE, false, 1);
 }
 
 void initializeGridsMode() {
-  grids.step = 0;
-  grids.playing = false;
-  grids.bpm = static_cast<float>(sharedBPM);
-  gridsSync.reset();
-  grids.patternX = 128;
-  grids.patternY = 128;
-  grids.kickDensity = 200;
-  grids.snareDensity = 150;
-  grids.hatDensity = 180;
-  grids.kickNote = 36;
-  grids.snareNote = 38;
-  grids.hatNote = 42;
-  grids.swing = 0;
-  grids.accentThreshold = 200;
-  regenerateGridsPattern();
+  {
+    BackgroundGenerator::ViewLock lock(gridsGenerator);
+    // Defaults only the first time: the drums may still be playing from the
+    // last visit
+    static bool initialized = false;
+    if (!initialized) {
+      grids.step = 0;
+      grids.playing = false;
+      gridsSync.reset();
+      grids.patternX = 128;
+      grids.patternY = 128;
+      grids.kickDensity = 200;
+      grids.snareDensity = 150;
+      grids.hatDensity = 180;
+      grids.kickNote = 36;
+      grids.snareNote = 38;
+      grids.hatNote = 42;
+      grids.swing = 0;
+      grids.accentThreshold = 200;
+      grids.chaos = 0;
+      memset(grids.perturbation, 0, sizeof(grids.perturbation));
+      regenerateGridsPattern();
+      initialized = true;
+    }
+    grids.bpm = static_cast<float>(sharedBPM);
+  }
   drawGridsMode();
 }
 
 void handleGridsMode() {
-  updateGridsPlayback();
-
+  // Leaving the screen keeps the drums playing
   if (touch.justPressed && isButtonPressed(BACK_BUTTON_X, BACK_BUTTON_Y, BACK_BUTTON_W, BACK_BUTTON_H)) {
-    if (gridsIsRequested()) {
-      gridsSync.stopPlayback();
-    }
     exitToMenu();
     return;
   }
 
-  if (!touch.justPressed) {
+  if (!touch.isPressed) {
     return;
   }
 
+  BackgroundGenerator::ViewLock lock(gridsGenerator);
   const GridsLayout layout = calculateGridsLayout();
   const int padX = layout.padX;
   const int padY = layout.padY;
   const int padSize = layout.padSize;
 
+  // Dragging on the pad only regenerates when the quantised cell changes
   if (touch.x >= padX && touch.x < padX + padSize &&
       touch.y >= padY && touch.y < padY + padSize) {
-    grids.patternX = ((touch.x - padX) * 255) / padSize;
-    grids.patternY = ((touch.y - padY) * 255) / padSize;
-    regenerateGridsPattern();
-    requestRedraw();
+    uint8_t x = ((touch.x - padX) * 255) / padSize;
+    uint8_t y = ((touch.y - padY) * 255) / padSize;
+    if (((x ^ grids.patternX) | (y ^ grids.patternY)) & kGridsCoordMask) {
+      grids.patternX = x;
+      grids.patternY = y;
+      regenerateGridsPattern();
+      requestRedraw();
+    }
+    return;
+  }
+
+  if (!touch.justPressed) {
     return;
   }
 
@@ -321,6 +444,7 @@ void handleGridsMode() {
   // BPM button handlers removed - now accessible via header tap
   
   bool randomPressed = isButtonPressed(controlX, buttonY, controlW, buttonH);
+  bool chaosPressed = isButtonPressed(controlX, layout.chaosButtonY, controlW, layout.chaosButtonH);
 
   if (playPressed) {
     if (gridsIsRequested()) {
@@ -328,17 +452,23 @@ void handleGridsMode() {
     } else {
       grids.step = 0;
       gridsSync.requestStart();
+      updateGridsPlayback();  // An idle clock restarts on a bar: start now
     }
     requestRedraw();
     return;
   }
   if (randomPressed) {
-    grids.patternX = random(256);
-    grids.patternY = random(256);
+    grids.patternX = rngBelow(RngStream::GRIDS, 256);
+    grids.patternY = rngBelow(RngStream::GRIDS, 256);
     regenerateGridsPattern();
     requestRedraw();
     return;
   }
+  if (chaosPressed) {
+    grids.chaos = grids.chaos >= 255 ? 0 : std::min(255, grids.chaos + 64);
+    requestRedraw();
+    return;
+  }
 
   // Update slider touch handling for new position
   int sliderYPos = layout.sliderY - SCALE_Y(8);
@@ -4,6 +4,7 @@
 #include <pgmspace.h>
 
 #include "color_utils.h"
+#include "scene_store.h"
 
 MorphState morphState;
 
@@ -406,6 +407,49 @@ void playMorphNote() {
   morphUpdateNoteFromOutput(now, true);
 }
 
+// Scene section: recorded gestures per slot
+static constexpr uint32_t kMorphSceneTag = SCENE_TAG('M', 'R', 'P', 'H');
+
+static void saveMorphScene(SceneWriter &out) {
+  for (const MorphSlot &slot : morphState.slots) {
+    uint16_t length = slot.hasData ? slot.length : 0;
+    out.u16(length);
+    for (uint16_t i = 0; i < length; ++i) {
+      out.u8(slot.points[i].x);
+      out.u8(slot.points[i].y);
+    }
+  }
+}
+
+static bool loadMorphScene(SceneReader &in, uint16_t version) {
+  if (version != 1) {
+    return false;
+  }
+  // Check every length before touching the slots
+  SceneReader check = in;
+  for (int i = 0; i < MORPH_SLOTS; ++i) {
+    uint16_t length = check.u16();
+    MorphPoint scratch[MORPH_MAX_POINTS];
+    if (length > MORPH_MAX_POINTS || !check.bytes(scratch, length * sizeof(MorphPoint))) {
+      return false;
+    }
+  }
+  for (MorphSlot &slot : morphState.slots) {
+    slot.length = in.u16();
+    for (uint16_t i = 0; i < slot.length; ++i) {
+      slot.points[i].x = in.u8();
+      slot.points[i].y = in.u8();
+    }
+    slot.hasData = slot.length > 0;
+  }
+  return in.ok();
+}
+
+static const SceneSection kMorphScene = {kMorphSceneTag, 1, "morph gestures",
+                                         MORPH_SLOTS * (2 + MORPH_MAX_POINTS * 2), saveMorphScene,
+                                         loadMorphScene, nullptr};
+REGISTER_SCENE_SECTION(kMorphScene);
+
 void initializeMorphMode() {
   morphState.morphX = 0.5f;
   morphState.morphY = 0.5f;
@@ -424,6 +468,7 @@ void initializeMorphMode() {
   }
   lastNoteStepMs = 0;
   morphStopHeldNote();
+  sceneApplyPending(kMorphSceneTag);
   drawMorphMode();
 }
 
@@ -1,4 +1,5 @@
 #include "module_physics_drop_mode.h"
+#include "rng_service.h"
 
 static DropBall *dropBalls = nullptr;
 static Platform *platforms = nullptr;
@@ -198,13 +199,13 @@ void spawnDropBall(int x, int y) {
     if (!dropBalls[i].active) {
       dropBalls[i].x = x;
       dropBalls[i].y = y;
-      dropBalls[i].vx = random(-10, 11) / 10.0; // -1 to 1
+      dropBalls[i].vx = rngRange(RngStream::PHYSICS_DROP, -10, 11) / 10.0; // -1 to 1
       dropBalls[i].vy = 0;
-      dropBalls[i].color = random(0x2000, 0x8FFF);
-      dropBalls[i].size = random(3, 6);
+      dropBalls[i].color = rngRange(RngStream::PHYSICS_DROP, 0x2000, 0x8FFF);
+      dropBalls[i].size = rngRange(RngStream::PHYSICS_DROP, 3, 6);
       dropBalls[i].active = true;
       dropBalls[i].spawnTime = millis();
-      dropBalls[i].note = getNoteInScale(dropScale, random(8), dropOctave) + dropKey;
+      dropBalls[i].note = getNoteInScale(dropScale, rngBelow(RngStream::PHYSICS_DROP, 8), dropOctave) + dropKey;
       dropBalls[i].noteName = getNoteNameFromMIDI(dropBalls[i].note);
       numActiveDropBalls++;
       break;
@@ -222,8 +223,8 @@ void addPlatform(int x, int y) {
   platforms[numPlatforms].y = y - 4;
   platforms[numPlatforms].w = 50;
   platforms[numPlatforms].h = 8;
-  platforms[numPlatforms].angle = random(-5, 6) / 10.0; // -0.5 to 0.5 radians
-  platforms[numPlatforms].color = random(0x2000, 0xFFFF);
+  platforms[numPlatforms].angle = rngRange(RngStream::PHYSICS_DROP, -5, 6) / 10.0; // -0.5 to 0.5 radians
+  platforms[numPlatforms].color = rngRange(RngStream::PHYSICS_DROP, 0x2000, 0xFFFF);
   platforms[numPlatforms].active = false;
   platforms[numPlatforms].note = getNoteInScale(dropScale, numPlatforms % 8, dropOctave) + dropKey;
   platforms[numPlatforms].noteName = getNoteNameFromMIDI(platforms[numPlatforms].note);
@@ -252,7 +253,7 @@ void updatePhysics() {
   if (!platformMode && numActiveDropBalls < MAX_DROP_BALLS) {
     if (millis() - lastAutoSpawn > 2000) {
       // Spawn at random X position at top
-      int spawnX = random(SCALE_X(60), SCALE_X(260));
+      int spawnX = rngRange(RngStream::PHYSICS_DROP, SCALE_X(60), SCALE_X(260));
       int spawnY = SCALE_Y(70);
       spawnDropBall(spawnX, spawnY);
       lastAutoSpawn = millis();
@@ -287,7 +288,7 @@ void updatePhysics() {
       
       // Ground hit - play note
       if (deviceConnected && abs(dropBalls[i].vy) > 1) {
-        sendMIDI(0x90, dropBalls[i].note, random(60, 100));
+        sendMIDI(0x90, dropBalls[i].note, rngRange(RngStream::PHYSICS_DROP, 60, 100));
         sendMIDI(0x80, dropBalls[i].note, 0);
       }
     }
@@ -320,7 +321,7 @@ void checkPlatformCollisions() {
         
         // Play platform note
         if (deviceConnected && !platforms[p].active) {
-          sendMIDI(0x90, platforms[p].note, random(70, 110));
+          sendMIDI(0x90, platforms[p].note, rngRange(RngStream::PHYSICS_DROP, 70, 110));
           sendMIDI(0x80, platforms[p].note, 0);
           
           platforms[p].active = true;
@@ -1,8 +1,13 @@
 #include "module_raga_mode.h"
+#include "active_notes.h"
+#include "background_generator.h"
 #include "clock_manager.h"
+#include "raga_markov_tables.h"
+#include "rng_service.h"
 
 #include <Arduino.h>
 #include <algorithm>
+#include <iterator>
 
 const char *const kRagaNames[RAGA_COUNT] = {
     "Bhairavi",
@@ -26,6 +31,9 @@ static constexpr int kRagaScaleNotes = 7;
 static constexpr int kRagaBars = 8;
 static constexpr int kRagaNotesPerBar = 4;
 static constexpr int kRagaMaxPhrase = 128;
+// One note per sixteenth, held for 80% of it, rounded to a tick
+static constexpr uint32_t kRagaNoteTicks = CLOCK_TICKS_PER_SIXTEENTH;
+static constexpr uint32_t kRagaGateTicks = (kRagaNoteTicks * 8 + 5) / 10;
 
 struct TalaPattern {
   int beats;
@@ -94,155 +102,22 @@ static const uint8_t kRagaIntervals[RAGA_COUNT][kRagaScaleNotes] = {
     {0, 3, 5, 8, 10, 0, 0},
 };
 
-static const uint8_t kRagaScaleLengths[RAGA_COUNT] = {7, 7, 5, 7, 7, 5, 7, 5};
-
-// 2nd-Order Markov Chain for Raga Bhairavi
-// Transition probabilities: P(note_i | note_i-1, note_i-2)
-// Stored as [prev_prev_note][prev_note][next_note] = probability weight
-static constexpr int kBhairavi2ndOrderSize = 7; // 7 notes in the scale
-static const uint8_t kBhairavi2ndOrderWeights[kBhairavi2ndOrderSize][kBhairavi2ndOrderSize][kBhairavi2ndOrderSize] = {
-  // From S (0) - Shadja (Samvadi - second highest weight)
-  {
-    // prev=S, current=S -> Strong tendency to move to r or m
-    {40, 30, 15, 25, 10, 5, 5},  // S,S -> S,r,g,m,P,d,n
-    // prev=S, current=r -> Part of pakad "S r g m"
-    {20, 20, 40, 35, 10, 5, 5},  // S,r -> S,r,g,m,P,d,n
-    // prev=S, current=g
-    {15, 25, 20, 50, 10, 5, 5},  // S,g -> S,r,g,m,P,d,n (favor m)
-    // prev=S, current=m
-    {30, 20, 30, 30, 15, 10, 5}, // S,m -> S,r,g,m,P,d,n
-    // prev=S, current=P
-    {25, 15, 20, 40, 20, 15, 10}, // S,P -> S,r,g,m,P,d,n
-    // prev=S, current=d
-    {20, 15, 10, 25, 15, 20, 30}, // S,d -> S,r,g,m,P,d,n
-    // prev=S, current=n
-    {50, 20, 10, 15, 10, 10, 15}, // S,n -> S,r,g,m,P,d,n (favor return to S)
-  },
-  // From r (1) - Komal Re
-  {
-    // prev=r, current=S -> Part of pakad "m g r S"
-    {40, 30, 20, 20, 10, 5, 5},  // r,S -> S,r,g,m,P,d,n
-    // prev=r, current=r -> Oscillation on Re (characteristic)
-    {25, 35, 30, 20, 10, 5, 5},  // r,r -> S,r,g,m,P,d,n
-    // prev=r, current=g -> Part of pakad "S r g m"
-    {15, 20, 25, 45, 15, 5, 5},  // r,g -> S,r,g,m,P,d,n (favor m)
-    // prev=r, current=m
-    {25, 20, 35, 30, 15, 10, 5}, // r,m -> S,r,g,m,P,d,n
-    // prev=r, current=P
-    {20, 25, 20, 35, 20, 10, 5}, // r,P -> S,r,g,m,P,d,n
-    // prev=r, current=d
-    {15, 20, 15, 25, 15, 25, 20}, // r,d -> S,r,g,m,P,d,n
-    // prev=r, current=n
-    {45, 25, 15, 15, 10, 10, 10}, // r,n -> S,r,g,m,P,d,n
-  },
-  // From g (2) - Komal Ga
-  {
-    // prev=g, current=S
-    {35, 30, 20, 25, 10, 5, 5},  // g,S -> S,r,g,m,P,d,n
-    // prev=g, current=r -> Part of pakad "m g r S"
-    {35, 25, 25, 25, 10, 5, 5},  // g,r -> S,r,g,m,P,d,n
-    // prev=g, current=g
-    {20, 25, 25, 35, 15, 10, 5}, // g,g -> S,r,g,m,P,d,n
-    // prev=g, current=m -> Part of pakad "S r g m" and "g m d n S'"
-    {20, 15, 20, 40, 20, 20, 10}, // g,m -> S,r,g,m,P,d,n (favor m)
-    // prev=g, current=P
-    {15, 20, 25, 40, 20, 15, 10}, // g,P -> S,r,g,m,P,d,n
-    // prev=g, current=d
-    {10, 15, 15, 30, 15, 25, 25}, // g,d -> S,r,g,m,P,d,n
-    // prev=g, current=n
-    {40, 25, 15, 15, 10, 10, 15}, // g,n -> S,r,g,m,P,d,n
-  },
-  // From m (3) - Madhyam (Vadi - highest weight)
-  {
-    // prev=m, current=S
-    {45, 30, 20, 20, 10, 5, 5},  // m,S -> S,r,g,m,P,d,n
-    // prev=m, current=r
-    {30, 25, 30, 25, 10, 5, 5},  // m,r -> S,r,g,m,P,d,n
-    // prev=m, current=g -> Part of pakad "m g r S"
-    {25, 35, 25, 25, 10, 5, 5},  // m,g -> S,r,g,m,P,d,n (favor r for pakad)
-    // prev=m, current=m -> Linger on Vadi
-    {25, 20, 25, 40, 20, 15, 10}, // m,m -> S,r,g,m,P,d,n
-    // prev=m, current=P
-    {20, 15, 20, 40, 25, 15, 10}, // m,P -> S,r,g,m,P,d,n
-    // prev=m, current=d -> Part of pakad "g m d n S'"
-    {10, 10, 15, 30, 15, 25, 35}, // m,d -> S,r,g,m,P,d,n (favor n for pakad)
-    // prev=m, current=n
-    {50, 20, 15, 20, 10, 10, 10}, // m,n -> S,r,g,m,P,d,n
-  },
-  // From P (4) - Pancham
-  {
-    // prev=P, current=S
-    {40, 25, 20, 25, 15, 5, 5},  // P,S -> S,r,g,m,P,d,n
-    // prev=P, current=r
-    {25, 25, 25, 30, 15, 10, 5}, // P,r -> S,r,g,m,P,d,n
-    // prev=P, current=g
-    {20, 25, 25, 40, 15, 10, 5}, // P,g -> S,r,g,m,P,d,n
-    // prev=P, current=m
-    {20, 20, 25, 40, 20, 15, 10}, // P,m -> S,r,g,m,P,d,n (favor m)
-    // prev=P, current=P
-    {25, 15, 20, 40, 25, 20, 10}, // P,P -> S,r,g,m,P,d,n
-    // prev=P, current=d
-    {15, 15, 15, 30, 15, 30, 25}, // P,d -> S,r,g,m,P,d,n
-    // prev=P, current=n
-    {45, 20, 15, 20, 15, 10, 10}, // P,n -> S,r,g,m,P,d,n
-  },
-  // From d (5) - Komal Dha
-  {
-    // prev=d, current=S
-    {40, 25, 20, 20, 15, 10, 10}, // d,S -> S,r,g,m,P,d,n
-    // prev=d, current=r
-    {25, 30, 25, 25, 15, 15, 10}, // d,r -> S,r,g,m,P,d,n
-    // prev=d, current=g
-    {20, 25, 25, 35, 15, 15, 10}, // d,g -> S,r,g,m,P,d,n
-    // prev=d, current=m
-    {20, 20, 25, 35, 20, 20, 15}, // d,m -> S,r,g,m,P,d,n
-    // prev=d, current=P
-    {20, 20, 20, 35, 25, 20, 15}, // d,P -> S,r,g,m,P,d,n
-    // prev=d, current=d -> Oscillation on Dha (characteristic)
-    {15, 15, 15, 25, 15, 30, 30}, // d,d -> S,r,g,m,P,d,n
-    // prev=d, current=n -> Part of pakad "g m d n S'"
-    {45, 20, 15, 20, 15, 15, 15}, // d,n -> S,r,g,m,P,d,n (favor S for pakad ending)
-  },
-  // From n (6) - Komal Ni
-  {
-    // prev=n, current=S -> End of pakad "g m d n S'"
-    {50, 25, 15, 20, 10, 10, 10}, // n,S -> S,r,g,m,P,d,n (strong return to S)
-    // prev=n, current=r
-    {30, 30, 25, 25, 15, 10, 5},  // n,r -> S,r,g,m,P,d,n
-    // prev=n, current=g
-    {25, 25, 25, 30, 15, 10, 10}, // n,g -> S,r,g,m,P,d,n
-    // prev=n, current=m
-    {25, 20, 25, 35, 15, 15, 10}, // n,m -> S,r,g,m,P,d,n
-    // prev=n, current=P
-    {25, 20, 20, 35, 20, 15, 10}, // n,P -> S,r,g,m,P,d,n
-    // prev=n, current=d
-    {20, 20, 15, 25, 15, 25, 25}, // n,d -> S,r,g,m,P,d,n
-    // prev=n, current=n
-    {45, 25, 15, 20, 10, 10, 15}, // n,n -> S,r,g,m,P,d,n
-  }
-};
-
 static int8_t g_ragaPhrase[kRagaMaxPhrase];
 static int g_phraseLength = 0;
 static int g_phraseIndex = 0;
-static int8_t g_bhairavi2ndOrderHistory[2] = {0, 0}; // Track last 2 notes for 2nd-order Markov
-static uint32_t g_noteIntervalMs = 0;
-static uint32_t g_noteDurationMs = 0;
-static uint32_t g_noteOffTime = 0;
+static uint8_t g_markovHistory[3] = {0, 0, 0}; // Last three scale degrees, oldest first
+static uint32_t g_noteOnTick = 0;
 static bool g_noteActive = false;
 static uint8_t g_currentNote = 0;
 static bool g_droneActive = false;
 static uint8_t g_droneNote = 0;
-static uint16_t g_activeTempo = 0;
 static int g_talaBeatIndex = 0;
 static int g_lastTalaBeatIndex = -1;
 static SequencerSyncState ragaSync;
 
-static bool updateRagaTempo();
 static void generateRagaPhrase();
-static void generateBhairavi2ndOrderPhrase();
-static int selectNextNoteBhairavi2ndOrder(int prevPrev, int prev);
-static void scheduleNextNote(unsigned long now);
+static int selectNextDegree(const RagaMarkovTable &table, const uint8_t *history);
+static void playNextNote(uint32_t tick);
 static void stopCurrentNote();
 static void updateDroneNote();
 static void resetPhraseState();
@@ -250,7 +125,26 @@ static void updateRagaPlayback();
 static void cycleRaga(int delta);
 static void cycleTala(int delta);
 
+// Plays the phrase and drone from the clock task whichever screen is shown
+class RagaGenerator : public BackgroundGenerator {
+public:
+  RagaGenerator() : BackgroundGenerator("raga", "Raga", RAGA) {}
+
+protected:
+  void advance() override { updateRagaPlayback(); }
+};
+
+static RagaGenerator ragaGenerator;
+REGISTER_BACKGROUND_GENERATOR(ragaGenerator);
+
 void initializeRagaMode() {
+  BackgroundGenerator::ViewLock lock(ragaGenerator);
+  // Defaults only the first time: the phrase may still be playing from the
+  // last visit
+  static bool initialized = false;
+  if (initialized) {
+    return;
+  }
   raga.currentRaga = RAGA_BHAIRAVI;
   raga.currentTala = TALA_TEENTAL;
   raga.rootNote = 60;
@@ -260,10 +154,8 @@ void initializeRagaMode() {
   g_phraseIndex = 0;
   g_noteActive = false;
   g_droneActive = false;
-  g_noteOffTime = 0;
-  g_activeTempo = 0;
   ragaSync.reset();
-  updateRagaTempo();
+  initialized = true;
 }
 
 void drawRagaMode() {
@@ -344,33 +236,31 @@ void drawRagaMode() {
 }
 
 void toggleRagaPlayback() {
+  BackgroundGenerator::ViewLock lock(ragaGenerator);
   if (ragaSync.playing || ragaSync.startPending) {
     ragaSync.stopPlayback();
     stopCurrentNote();
     g_noteActive = false;
-    g_noteOffTime = 0;
     raga.playing = false;
   } else {
-    updateRagaTempo();
     resetPhraseState();
     ragaSync.requestStart();
+    updateRagaPlayback();  // An idle clock restarts on a bar: start now
     raga.playing = true;
   }
   requestRedraw();
 }
 
 void handleRagaMode() {
-  updateRagaPlayback();
-
+  // Leaving the screen keeps the phrase and drone playing
   if (touch.justPressed &&
       isButtonPressed(BACK_BUTTON_X, BACK_BUTTON_Y, BACK_BUTTON_W, BACK_BUTTON_H)) {
-    ragaSync.stopPlayback();
-    stopCurrentNote();
-    raga.playing = false;
     exitToMenu();
     return;
   }
 
+  BackgroundGenerator::ViewLock lock(ragaGenerator);
+
   // Playback controls (bottom section)
   const int controlY = DISPLAY_HEIGHT - SCALE_Y(84);
   const int buttonsY = controlY + SCALE_Y(16);
@@ -386,6 +276,7 @@ void handleRagaMode() {
   if (touch.justPressed &&
       isButtonPressed(MARGIN_SMALL + playBtnW + SCALE_X(8), buttonsY, droneBtnW, SCALE_Y(44))) {
     raga.droneEnabled = !raga.droneEnabled;
+    updateDroneNote();  // Without waiting for a clock tick
     requestRedraw();
     return;
   }
@@ -422,119 +313,58 @@ void handleRagaMode() {
   }
 }
 
-static bool updateRagaTempo() {
-  uint16_t tempo = sharedBPM;
-  if (tempo < 40) {
-    tempo = 40;
-  } else if (tempo > 240) {
-    tempo = 240;
+// Binary search for the first cumulative weight above r
+static int sampleCdfRow(const uint16_t *cdf, int count) {
+  int r = rngBelow(RngStream::RAGA, cdf[count - 1]);
+  int lo = 0;
+  int hi = count - 1;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (cdf[mid] > r) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
   }
-  if (tempo == g_activeTempo) {
-    return false;
+  return lo;
+}
+
+// 3rd-order pakad context if the table has one, otherwise the 2nd-order row
+static int selectNextDegree(const RagaMarkovTable &table, const uint8_t *history) {
+  uint16_t key = (history[0] * kRagaMarkovMaxDegrees + history[1]) * kRagaMarkovMaxDegrees + history[2];
+  const uint16_t *keysEnd = table.order3Keys + table.order3Count;
+  const uint16_t *match = std::lower_bound(table.order3Keys, keysEnd, key);
+  if (match != keysEnd && *match == key) {
+    return sampleCdfRow(table.order3Cdf[match - table.order3Keys], table.degrees);
   }
-  g_activeTempo = tempo;
-  uint32_t interval = 60000UL / g_activeTempo;
-    g_noteIntervalMs = std::max<uint32_t>(40, interval / 4);
-    g_noteDurationMs = std::max<uint32_t>(30, (g_noteIntervalMs * 8) / 10);
-  return true;
+  return sampleCdfRow(table.order2Cdf[history[1] * table.degrees + history[2]], table.degrees);
 }
 
 static void generateRagaPhrase() {
-  // Use 2nd-order Markov chain for Bhairavi, fall back to simple random for others
-  if (raga.currentRaga == RAGA_BHAIRAVI) {
-    generateBhairavi2ndOrderPhrase();
-    return;
-  }
-  
-  // Original implementation for other ragas
   const uint8_t *scale = kRagaIntervals[static_cast<int>(raga.currentRaga)];
-  int scaleLength = kRagaScaleLengths[static_cast<int>(raga.currentRaga)];
+  const RagaMarkovTable &table = kRagaMarkovTables[static_cast<int>(raga.currentRaga)];
   int totalNotes = kRagaBars * kRagaNotesPerBar;
   g_phraseLength = std::min(totalNotes, kRagaMaxPhrase);
-  int degree = random(0, scaleLength);
   int octave = 0;
 
   for (int i = 0; i < g_phraseLength; ++i) {
-    int step = random(3) - 1;
-    degree = std::max(0, std::min(scaleLength - 1, degree + step));
-    if (random(100) < 10) {
-      int octaveShift = random(3) - 1;
-      octave = std::max(-1, std::min(1, octave + octaveShift));
-    }
-    g_ragaPhrase[i] = scale[degree] + octave * 12;
-  }
-  g_phraseIndex = 0;
-}
+    int degree = selectNextDegree(table, g_markovHistory);
 
-// Select next note using 2nd-order Markov chain for Bhairavi
-static int selectNextNoteBhairavi2ndOrder(int prevPrev, int prev) {
-  // Get the probability weights for this sequence
-  const uint8_t *weights = kBhairavi2ndOrderWeights[prevPrev][prev];
-  
-  // Calculate total weight
-  int totalWeight = 0;
-  for (int i = 0; i < kBhairavi2ndOrderSize; ++i) {
-    totalWeight += weights[i];
-  }
-  
-  // Select a random value within the total weight
-  int selection = random(totalWeight);
-  
-  // Find which note corresponds to this selection
-  int cumulative = 0;
-  for (int i = 0; i < kBhairavi2ndOrderSize; ++i) {
-    cumulative += weights[i];
-    if (selection < cumulative) {
-      return i;
-    }
-  }
-  
-  // Fallback (should never reach here)
-  return 0; // Return Sa (tonic)
-}
-
-// Generate phrase using 2nd-order Markov chain for Bhairavi
-static void generateBhairavi2ndOrderPhrase() {
-  const uint8_t *scale = kRagaIntervals[static_cast<int>(RAGA_BHAIRAVI)];
-  int scaleLength = kRagaScaleLengths[static_cast<int>(RAGA_BHAIRAVI)];
-  int totalNotes = kRagaBars * kRagaNotesPerBar;
-  g_phraseLength = std::min(totalNotes, kRagaMaxPhrase);
-  
-  // Initialize with Sa (0) as starting notes
-  int prevPrev = 0; // S
-  int prev = 0;     // S
-  int octave = 0;   // Middle octave
-  
-  // Store starting notes in history
-  g_bhairavi2ndOrderHistory[0] = prevPrev;
-  g_bhairavi2ndOrderHistory[1] = prev;
-  
-  for (int i = 0; i < g_phraseLength; ++i) {
-    // Use 2nd-order Markov chain to select next note degree
-    int degree = selectNextNoteBhairavi2ndOrder(prevPrev, prev);
-    
-    // Occasional octave changes (less frequent than random walk)
-    if (random(100) < 8) {
-      int octaveShift = random(3) - 1;
+    // Occasional octave changes
+    if (rngChance(RngStream::RAGA, 8)) {
+      int octaveShift = rngRange(RngStream::RAGA, -1, 2);
       octave = std::max(-1, std::min(1, octave + octaveShift));
     }
-    
-    // Store the actual MIDI offset
     g_ragaPhrase[i] = scale[degree] + octave * 12;
-    
-    // Update history for next iteration
-    prevPrev = prev;
-    prev = degree;
+
+    g_markovHistory[0] = g_markovHistory[1];
+    g_markovHistory[1] = g_markovHistory[2];
+    g_markovHistory[2] = static_cast<uint8_t>(degree);
   }
-  
-  // Update global history with last two notes
-  g_bhairavi2ndOrderHistory[0] = prevPrev;
-  g_bhairavi2ndOrderHistory[1] = prev;
-  
   g_phraseIndex = 0;
 }
 
-static void scheduleNextNote(unsigned long now) {
+static void playNextNote(uint32_t tick) {
   if (g_phraseLength == 0 || g_phraseIndex >= g_phraseLength) {
     generateRagaPhrase();
   }
@@ -545,10 +375,12 @@ static void scheduleNextNote(unsigned long now) {
   uint8_t accent = pattern.accents[beat];
   uint8_t velocity = std::min<uint8_t>(127, static_cast<uint8_t>(100 + accent * 8));
   sendMIDI(0x90, note, velocity);
+#if DEBUG_ENABLED
   Serial.printf("[RAGA] NoteOn note=%u vel=%u beat=%d\n", note, velocity, beat);
+#endif
   g_currentNote = note;
   g_noteActive = true;
-  g_noteOffTime = now + g_noteDurationMs;
+  g_noteOnTick = tick;
   g_lastTalaBeatIndex = beat;
   g_talaBeatIndex = (beat + 1) % pattern.beats;
 }
@@ -556,13 +388,19 @@ static void scheduleNextNote(unsigned long now) {
 static void stopCurrentNote() {
   if (g_noteActive) {
     sendMIDI(0x80, g_currentNote, 0);
+#if DEBUG_ENABLED
     Serial.printf("[RAGA] NoteOff note=%u\n", g_currentNote);
+#endif
     g_noteActive = false;
   }
 }
 
 static void updateDroneNote() {
   if (raga.droneEnabled) {
+    // A mode switch or panic releases every sounding note; strike it again
+    if (g_droneActive && !activeNoteIsSounding(0, g_droneNote)) {
+      g_droneActive = false;
+    }
     if (!g_droneActive || g_droneNote != raga.rootNote) {
       if (g_droneActive) {
         sendMIDI(0x80, g_droneNote, 0);
@@ -582,16 +420,16 @@ static void updateDroneNote() {
 
 static void resetPhraseState() {
   stopCurrentNote();
+  // Restart from Sa so the history never holds degrees from another raga
+  std::fill(std::begin(g_markovHistory), std::end(g_markovHistory), 0);
   generateRagaPhrase();
   g_phraseIndex = 0;
   g_noteActive = false;
-  g_noteOffTime = 0;
   g_talaBeatIndex = 0;
   g_lastTalaBeatIndex = -1;
 }
 
 static void updateRagaPlayback() {
-  updateRagaTempo();
   updateDroneNote();
 
   bool wasPlaying = ragaSync.playing;
@@ -599,11 +437,7 @@ static void updateRagaPlayback() {
   bool justStarted = ragaSync.playing && !wasPlaying;
   raga.playing = ragaSync.playing;
 
-  // Use time-based note scheduling instead of step-based
-  static unsigned long lastNoteTime = 0;
-  
   if (justStarted) {
-    lastNoteTime = 0;  // Reset timer on start
     resetPhraseState();
   }
 
@@ -611,21 +445,21 @@ static void updateRagaPlayback() {
     return;
   }
 
-  // Raga uses time-based scheduling, not step-based
-  unsigned long now = millis();
-  
-  // Check if it's time to play the next note
-  if (lastNoteTime == 0 || now - lastNoteTime >= g_noteIntervalMs) {
-    if (g_noteActive && now >= g_noteOffTime) {
-      stopCurrentNote();
-    }
-    scheduleNextNote(now);
-    lastNoteTime = now;
-    Serial.printf("[RAGA] played note, interval=%ums\n", g_noteIntervalMs);
-  } else if (g_noteActive && now >= g_noteOffTime) {
-    // Still turn off notes even if not scheduling new ones
+  // A note every sixteenth of the clock; the first one on the start tick
+  uint32_t tickNow = clockManagerGetTickCount();
+  if (g_noteActive && tickNow - g_noteOnTick >= kRagaGateTicks) {
     stopCurrentNote();
   }
+  uint32_t readySteps = justStarted ? 1 : ragaSync.consumeReadySteps(kRagaNoteTicks);
+  if (readySteps == 0) {
+    return;
+  }
+  // Steps missed while the clock task was busy collapse into one note rather
+  // than a burst
+  playNextNote(tickNow);
+  if (ragaGenerator.viewAttached()) {
+    requestRedraw();  // Tala beat display
+  }
 }
 
 static void cycleRaga(int delta) {
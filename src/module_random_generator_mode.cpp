@@ -1,4 +1,5 @@
 #include "module_random_generator_mode.h"
+#include "rng_service.h"
 #include "clock_manager.h"
 
 RandomGen randomGen;
@@ -302,11 +303,11 @@ void playRandomNote() {
   }
   
   // Check probability
-  if (random(100) < randomGen.probability) {
+  if (rngChance(RngStream::RANDOM_GEN, randomGen.probability)) {
     // Generate random note in scale and octave range
     Scale& scale = scales[randomGen.scaleType];
-    int degree = random(scale.numNotes);
-    int octave = random(randomGen.minOctave, randomGen.maxOctave + 1);
+    int degree = rngBelow(RngStream::RANDOM_GEN, scale.numNotes);
+    int octave = rngRange(RngStream::RANDOM_GEN, randomGen.minOctave, randomGen.maxOctave + 1);
     int note = randomGen.rootNote % 12 + scale.intervals[degree] + (octave * 12);
     
     if (note >= 0 && note <= 127) {
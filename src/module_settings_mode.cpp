@@ -1,4 +1,5 @@
 #include "module_settings_mode.h"
+#include "clock_runtime.h"
 #include "wifi_manager.h"
 #include "ui_elements.h"
 #include "esp_now_midi_module.h"
@@ -23,6 +24,41 @@ static inline int clampInt(int value, int minValue, int maxValue) {
   return value;
 }
 
+// Consecutive slots of one module (the Slot Performer's twelve) share a row
+struct ModuleLoadRow {
+  const char *name;
+  uint8_t count;
+  bool background;
+  uint32_t usPerTickX10;
+  uint32_t maxUs;
+  uint32_t deferred;
+};
+
+static constexpr size_t kMaxModuleLoadRows = 8;
+
+static size_t gatherModuleLoadRows(ModuleLoadRow *rows) {
+  size_t rowCount = 0;
+  for (size_t i = 0; i < clockRuntime.getModuleCount(); ++i) {
+    ClockRuntime::ModuleLoad load;
+    if (!clockRuntime.getModuleLoad(static_cast<int>(i), load)) {
+      continue;
+    }
+    if (rowCount > 0 && rows[rowCount - 1].name == load.name) {
+      ModuleLoadRow &row = rows[rowCount - 1];
+      row.count++;
+      row.usPerTickX10 += load.usPerTickX10;
+      row.maxUs = std::max(row.maxUs, load.maxUs);
+      row.deferred += load.deferred;
+      continue;
+    }
+    if (rowCount >= kMaxModuleLoadRows) {
+      break;
+    }
+    rows[rowCount++] = {load.name, 1, load.background, load.usPerTickX10, load.maxUs, load.deferred};
+  }
+  return rowCount;
+}
+
 struct SettingsLayout {
   int viewTop;
   int viewHeight;
@@ -42,6 +78,8 @@ struct SettingsLayout {
   int espNowStatusRowY;
   int displayRowY;
   int screenshotRowY;
+  int moduleLoadRowY;   // Background total, then one row per module
+  int moduleLoadRowCount;
   int scrollbarTouchX;
   int scrollbarTrackX;
 };
@@ -83,6 +121,10 @@ static SettingsLayout computeSettingsLayout() {
   y += compactRowHeight() + settingsRowSpacing();
   layout.screenshotRowY = y;
   y += compactRowHeight() + settingsRowSpacing();
+  ModuleLoadRow loadRows[kMaxModuleLoadRows];
+  layout.moduleLoadRowY = y + SCALE_Y(18);  // Below its label
+  layout.moduleLoadRowCount = static_cast<int>(gatherModuleLoadRows(loadRows));
+  y = layout.moduleLoadRowY + (layout.moduleLoadRowCount + 1) * statusRowHeight() + settingsRowSpacing();
   layout.contentHeight = y - layout.viewTop + contentPadding();
   return layout;
 }
@@ -231,9 +273,16 @@ void drawSettingsMode() {
   if ((espNowStatusRowY + statusRowHeight() > layout.viewTop && espNowStatusRowY < viewBottom) ||
       (espNowStatusLabelY + statusRowHeight() > layout.viewTop && espNowStatusLabelY < viewBottom)) {
     tft.setTextColor(THEME_TEXT, THEME_SURFACE);
+    uint32_t lostFrames = 0;
+    uint8_t mac[6];
+    EspNowLinkStats linkStats;
+    for (uint8_t i = 0; getEspNowLinkStats(i, mac, linkStats); ++i) {
+      lostFrames += linkStats.lostFrames;
+    }
     String espNowStatus = String("ESP-NOW: Peers=") + getEspNowPeerCount() + 
                          " TX=" + espNowState.messagesSent + 
-                         " RX=" + espNowState.messagesReceived;
+                         " RX=" + espNowState.messagesReceived +
+                         " Lost=" + lostFrames;
     tft.drawString(espNowStatus, rowInnerLeft, espNowStatusRowY, 2);
   }
 #endif
@@ -272,6 +321,50 @@ void drawSettingsMode() {
                     "Capture All Screens", THEME_SECONDARY, false, 2);
   }
 
+  // Clock module CPU: onStep() time per clock tick, averaged over the last bar
+  const int loadRowY = layout.moduleLoadRowY - settingsScrollOffset;
+  const int loadLabelY = loadRowY - SCALE_Y(18);
+  if (loadLabelY + SCALE_Y(18) > layout.viewTop && loadLabelY < viewBottom) {
+    tft.setTextColor(THEME_TEXT_DIM, THEME_SURFACE);
+    tft.drawString("Clock Modules (us/tick)", rowInnerLeft, loadLabelY, 2);
+  }
+  if (loadRowY + statusRowHeight() > layout.viewTop && loadRowY < viewBottom) {
+    char line[64];
+    uint32_t totalX10 = clockRuntime.getBackgroundUsPerTickX10();
+    snprintf(line, sizeof(line), "Background %lu.%lu of %lu budget",
+             static_cast<unsigned long>(totalX10 / 10), static_cast<unsigned long>(totalX10 % 10),
+             static_cast<unsigned long>(clockRuntime.getBackgroundBudgetUs()));
+    tft.setTextColor(THEME_TEXT, THEME_SURFACE);
+    tft.drawString(line, rowInnerLeft, loadRowY, 2);
+  }
+  ModuleLoadRow loadRows[kMaxModuleLoadRows];
+  const int loadRowCount = std::min(static_cast<int>(gatherModuleLoadRows(loadRows)), layout.moduleLoadRowCount);
+  for (int i = 0; i < loadRowCount; ++i) {
+    const int rowY = loadRowY + (i + 1) * statusRowHeight();
+    if (rowY + statusRowHeight() <= layout.viewTop || rowY >= viewBottom) {
+      continue;
+    }
+    const ModuleLoadRow &row = loadRows[i];
+    char name[24];
+    if (row.count > 1) {
+      snprintf(name, sizeof(name), "%s x%u", row.name, row.count);
+    } else {
+      snprintf(name, sizeof(name), "%s", row.name);
+    }
+    char line[64];
+    if (row.background) {
+      snprintf(line, sizeof(line), "%s %lu.%lu max %lu def %lu", name,
+               static_cast<unsigned long>(row.usPerTickX10 / 10), static_cast<unsigned long>(row.usPerTickX10 % 10),
+               static_cast<unsigned long>(row.maxUs), static_cast<unsigned long>(row.deferred));
+    } else {
+      snprintf(line, sizeof(line), "%s %lu.%lu max %lu", name,
+               static_cast<unsigned long>(row.usPerTickX10 / 10), static_cast<unsigned long>(row.usPerTickX10 % 10),
+               static_cast<unsigned long>(row.maxUs));
+    }
+    tft.setTextColor(row.background ? THEME_TEXT : THEME_TEXT_DIM, THEME_SURFACE);
+    tft.drawString(line, rowInnerLeft, rowY, 2);
+  }
+
   int maxScroll = std::max(0, layout.contentHeight - layout.viewHeight);
   if (maxScroll > 0) {
     int trackTop = layout.viewTop + SCALE_Y(3);
@@ -1,4 +1,5 @@
 #include "module_slink_mode.h"
+#include "rng_service.h"
 #include <new>
 
 // Global state instance
@@ -292,7 +293,7 @@ void updateModulators(float delta_time_s, float bpm) {
                 break;
             case 4: // Random (sample & hold)
                 if (mod->phase < (rate_radians_per_sec * delta_time_s)) {
-                    mod->output = ((float)random(0, 2000) / 1000.0f) - 1.0f;
+                    mod->output = rngUnit(RngStream::SLINK) * 2.0f - 1.0f;
                 }
                 break;
         }
@@ -679,7 +680,7 @@ void enableRandomBand() {
     }
     
     if (count > 0) {
-        int idx = disabled[random(0, count)];
+        int idx = disabled[rngBelow(RngStream::SLINK, count)];
         slink_state.bands[idx].enabled = true;
     }
 }
@@ -695,7 +696,7 @@ void disableRandomBand() {
     }
     
     if (count > 0) {
-        int idx = enabled[random(0, count)];
+        int idx = enabled[rngBelow(RngStream::SLINK, count)];
         slink_state.bands[idx].enabled = false;
     }
 }
@@ -712,7 +713,7 @@ void shuffleEnabledBands() {
     
     // Shuffle using Fisher-Yates
     for (int i = count - 1; i > 0; i--) {
-        int j = random(0, i + 1);
+        int j = rngBelow(RngStream::SLINK, i + 1);
         int temp = enabled[i];
         enabled[i] = enabled[j];
         enabled[j] = temp;
@@ -724,7 +725,7 @@ void shuffleEnabledBands() {
         slink_state.bands[i].enabled = false;
     }
     for (int i = 0; i < count; i++) {
-        int new_idx = random(0, SLINK_BANDS);
+        int new_idx = rngBelow(RngStream::SLINK, SLINK_BANDS);
         while (slink_state.bands[new_idx].enabled) {
             new_idx = (new_idx + 1) % SLINK_BANDS;
         }
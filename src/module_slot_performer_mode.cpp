@@ -1,12 +1,23 @@
 #include "module_slot_performer_mode.h"
 
+#include "active_notes.h"
 #include "app/app_modes.h"
+#include "clock_manager.h"
+#include "clock_runtime.h"
+#include "clocked_module.h"
 #include "common_definitions.h"
+#include "memory_pools.h"
 #include "midi_out_buffer.h"
 #include "midi_utils.h"
+#include "scene_store.h"
 #include "ui_elements.h"
 
 #include <Arduino.h>
+#include <algorithm>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <new>
 #include <stdlib.h>
 #include <string.h>
 
@@ -15,10 +26,13 @@ namespace {
 static constexpr uint8_t kQuantizeOptions = 5;
 static constexpr uint8_t kMaxMidiChannels = 16;
 static constexpr uint8_t kPatternSteps = 16;
-static constexpr uint8_t kSwingTicksMaxOffset = 3;  // ~half-step offset at 16th resolution
+static constexpr uint16_t kEngineTicksPerStep = 6;  // 1/16 notes; swing is applied by ClockRuntime
 static constexpr uint16_t kTicksPerQuarter = 24;
 static constexpr uint16_t kTicksPerBar = 96;
 static constexpr uint16_t kMaxLoopEvents = 384;
+// Shared by every looper slot, so one busy loop can use the capacity of empty ones
+static constexpr uint16_t kLoopPoolEvents = SLOT_SYSTEM_MAX_SLOTS * kMaxLoopEvents;
+static constexpr uint16_t kNoLoopTick = 0xFFFF;
 static constexpr uint8_t kNoSlot = 0xFF;
 static constexpr uint8_t kDefaultEngineVelocity = 96;
 static constexpr uint8_t kDefaultEngineDurationTicks = 4;
@@ -36,19 +50,25 @@ enum class RecordMode : uint8_t {
   OVERDUB
 };
 
+// Packed to 4 bytes: loops are at most 8 bars (768 ticks), well inside 14 bits
 struct LoopEvent {
-  uint16_t tick = 0;
-  uint8_t note = 60;
-  uint8_t velocity = 100;
-  bool noteOn = true;
+  uint32_t tick : 14;
+  uint32_t note : 7;
+  uint32_t velocity : 7;
+  uint32_t noteOn : 1;
+  uint32_t spare : 1;  // Free for a per-event flag
 };
+static_assert(sizeof(LoopEvent) == 4, "LoopEvent must stay packed");
 
 struct PendingNoteOff {
   bool active = false;
+  bool retired = false;       // Left by an outgoing scene: kept until its release marker has run
   uint8_t slotIndex = 0;
+  uint8_t channel = 0;        // 0-15, as the note-on went out
   uint8_t note = 0;
   uint8_t velocity = 0;
   uint32_t offTick = 0;
+  uint32_t releaseTicket = 0;  // midiOutBuffer.releaseSounding() ticket for retired entries
 };
 
 struct SlotState {
@@ -58,7 +78,6 @@ struct SlotState {
   uint8_t baseNote = 60;
   uint8_t density = 5;  // 1-16 for step generators
   uint16_t engineStepIndex = 0;
-  uint32_t nextEngineTick = 0;
   bool recordArmed = false;
   bool activity = false;
   uint32_t activityUntilMs = 0;
@@ -67,20 +86,22 @@ struct SlotState {
   bool looperHasContent = false;
   uint16_t loopLengthTicks = 4 * kTicksPerBar;
   uint8_t loopQuantizeTicks = 6;
-  LoopEvent loopEvents[kMaxLoopEvents];
-  uint16_t loopEventCount = 0;
-};
-
-struct CaptureNoteState {
-  bool active = false;
-  uint16_t onTick = 0;
+  uint16_t loopEventCount = 0;          // Events in this slot's segment of loopPool
+  uint16_t playCursor = 0;              // Index of the next event to play within the segment
+  uint16_t lastLoopTick = kNoLoopTick;  // Loop position of the previous tick, for wrap detection
 };
 
 struct SlotPerformerState {
   SlotState slots[SLOT_SYSTEM_MAX_SLOTS];
   PendingNoteOff pendingNoteOffs[64];
 
-  bool transportRunning = false;
+  // Looper events: one tick-sorted segment per slot, laid out in slot order.
+  // The pool lives in PSRAM when present; counts and cursors stay here in DRAM.
+  LoopEvent *loopPool = nullptr;
+  uint16_t loopPoolCapacity = 0;
+  uint32_t droppedLoopEvents = 0;  // Events refused during the current recording pass
+
+  bool transportRunning = false;  // Requested by the UI; ClockRuntime follows it
   uint16_t bpm = 120;
   uint8_t swing = 0;  // 0..50
   uint8_t configuredSlots = 6;
@@ -88,7 +109,14 @@ struct SlotPerformerState {
   uint8_t page = 0;
 
   uint32_t currentTick = 0;
-  uint32_t lastTickMicros = 0;
+  uint32_t originTick = 0;     // ClockRuntime tick at which currentTick was 0
+  bool originPending = false;  // Set on transport start; the next tick becomes the origin
+
+  // Drift check: ticks processed vs F8 pulses sent and engine steps dispatched
+  uint32_t processedTicks = 0;
+  uint32_t originClocks = 0;  // F8 pulses sent for ticks before originTick
+  uint32_t engineSteps = 0;
+  bool dryRun = false;  // Dispatch check: process everything but send no MIDI
 
   uint8_t bars = 4;
   uint8_t quantizeIndex = 2;  // 1/16 by default
@@ -99,7 +127,9 @@ struct SlotPerformerState {
   uint8_t recordTargetSlot = kNoSlot;
   uint32_t recordStartTick = 0;
   uint32_t recordEndTick = 0;
-  CaptureNoteState captureNotes[128];
+  uint32_t captureActive[4] = {0, 0, 0, 0};  // Bit per note: recorded note-on awaiting its note-off
+  uint16_t captureOnTick[128];
+  uint8_t heldCaptureNotes = 0;
 
   bool detailOpen = false;
 } gState;
@@ -140,12 +170,6 @@ static uint8_t clampConfiguredSlotCount() {
   return slotSystemSlotCount;
 }
 
-static uint32_t tickIntervalMicros() {
-  uint16_t bpm = gState.bpm;
-  if (bpm < 40) bpm = 40;
-  return 60000000UL / (static_cast<uint32_t>(bpm) * kTicksPerQuarter);
-}
-
 static uint16_t loopLengthTicksFromBars(uint8_t bars) {
   uint8_t safeBars = bars;
   if (safeBars < 1) safeBars = 1;
@@ -178,22 +202,23 @@ static void touchActivity(uint8_t slotIndex) {
   gState.slots[slotIndex].activityUntilMs = millis() + 120;
 }
 
-static void sendSlotMidi(uint8_t slotIndex, uint8_t status, uint8_t data1, uint8_t data2) {
-  if (slotIndex >= gState.configuredSlots) {
+static void sendSlotMidi(uint8_t slotIndex, uint8_t status, uint8_t data1, uint8_t data2, bool muted) {
+  if (slotIndex >= gState.configuredSlots || gState.dryRun) {
     return;
   }
-  const SlotState &slot = gState.slots[slotIndex];
-  if (!slot.muted) {
+  if (!muted) {
     sendMIDI(status, data1, data2);
   }
   touchActivity(slotIndex);
 }
 
-static void queueNoteOff(uint8_t slotIndex, uint8_t note, uint8_t velocity, uint32_t offTick) {
+static void queueNoteOff(uint8_t slotIndex, uint8_t channel, uint8_t note, uint8_t velocity, uint32_t offTick) {
   for (PendingNoteOff &entry : gState.pendingNoteOffs) {
     if (!entry.active) {
       entry.active = true;
+      entry.retired = false;
       entry.slotIndex = slotIndex;
+      entry.channel = channel;
       entry.note = note;
       entry.velocity = velocity;
       entry.offTick = offTick;
@@ -202,23 +227,73 @@ static void queueNoteOff(uint8_t slotIndex, uint8_t note, uint8_t velocity, uint
   }
 }
 
+static void resetCaptureNotes() {
+  memset(gState.captureActive, 0, sizeof(gState.captureActive));
+  gState.heldCaptureNotes = 0;
+}
+
+static bool captureActive(uint8_t note) {
+  return (gState.captureActive[note >> 5] >> (note & 31)) & 1U;
+}
+
+static void setCaptureActive(uint8_t note, bool active) {
+  uint32_t bit = 1UL << (note & 31);
+  if (active) {
+    gState.captureActive[note >> 5] |= bit;
+  } else {
+    gState.captureActive[note >> 5] &= ~bit;
+  }
+}
+
 static bool isRecordingSource(uint8_t slotIndex) {
   return gState.recording && gState.recordSourceSlot == slotIndex && gState.recordTargetSlot != kNoSlot;
 }
 
-static void appendLoopEvent(SlotState &target, uint16_t tick, uint8_t note, uint8_t velocity, bool noteOn) {
-  if (target.loopEventCount >= kMaxLoopEvents) {
-    return;
+static uint16_t loopSegmentStart(uint8_t slotIndex) {
+  uint16_t start = 0;
+  for (uint8_t i = 0; i < slotIndex; ++i) {
+    start = static_cast<uint16_t>(start + gState.slots[i].loopEventCount);
+  }
+  return start;
+}
+
+static uint16_t loopPoolUsed() {
+  return loopSegmentStart(SLOT_SYSTEM_MAX_SLOTS);
+}
+
+// Inserts after any events already on the same tick, keeping arrival order
+static bool insertLoopEvent(uint8_t slotIndex, uint16_t tick, uint8_t note, uint8_t velocity, bool noteOn) {
+  SlotState &target = gState.slots[slotIndex];
+  uint16_t used = loopPoolUsed();
+  // A note-on also reserves its own note-off and those of held notes, so a full pool never leaves a note hanging
+  uint16_t reserve = noteOn ? static_cast<uint16_t>(gState.heldCaptureNotes + 2) : 1;
+  if (gState.loopPoolCapacity - used < reserve) {
+    gState.droppedLoopEvents++;  // Reported when the recording pass ends
+    return false;
   }
   if (tick >= target.loopLengthTicks) {
     tick = static_cast<uint16_t>(tick % target.loopLengthTicks);
   }
-  LoopEvent &event = target.loopEvents[target.loopEventCount++];
-  event.tick = tick;
-  event.note = note;
-  event.velocity = velocity;
-  event.noteOn = noteOn;
+
+  LoopEvent *segment = &gState.loopPool[loopSegmentStart(slotIndex)];
+  LoopEvent *segmentEnd = segment + target.loopEventCount;
+  LoopEvent *pos = std::upper_bound(segment, segmentEnd, tick,
+                                    [](uint16_t t, const LoopEvent &event) { return t < event.tick; });
+  LoopEvent *poolEnd = &gState.loopPool[used];
+  memmove(pos + 1, pos, static_cast<size_t>(poolEnd - pos) * sizeof(LoopEvent));
+  pos->tick = tick;
+  pos->note = note;
+  pos->velocity = velocity;
+  pos->noteOn = noteOn;
+  pos->spare = 0;
+
+  uint16_t index = static_cast<uint16_t>(pos - segment);
+  if (index < target.playCursor) {
+    target.playCursor++;  // Already behind the playhead this pass
+  }
+  target.loopEventCount++;
   target.looperHasContent = true;
+  return true;
 }
 
 static void captureRecordEvent(uint8_t slotIndex, uint8_t note, uint8_t velocity, bool noteOn) {
@@ -240,54 +315,82 @@ static void captureRecordEvent(uint8_t slotIndex, uint8_t note, uint8_t velocity
   uint16_t qt = quantizeTick(relTick, target.loopQuantizeTicks);
 
   if (noteOn) {
-    gState.captureNotes[note].active = true;
-    gState.captureNotes[note].onTick = qt;
-    appendLoopEvent(target, qt, note, velocity, true);
+    if (insertLoopEvent(gState.recordTargetSlot, qt, note, velocity, true) && !captureActive(note)) {
+      setCaptureActive(note, true);
+      gState.captureOnTick[note] = qt;
+      gState.heldCaptureNotes++;
+    }
     return;
   }
 
-  if (gState.captureNotes[note].active) {
-    uint32_t minOffRaw = static_cast<uint32_t>(gState.captureNotes[note].onTick) +
+  if (captureActive(note)) {
+    uint32_t minOffRaw = static_cast<uint32_t>(gState.captureOnTick[note]) +
                          static_cast<uint32_t>(target.loopQuantizeTicks);
     uint16_t minOff = saturateToUint16(minOffRaw);
     if (qt < minOff) {
       qt = minOff;
     }
-    gState.captureNotes[note].active = false;
+    setCaptureActive(note, false);
+    gState.heldCaptureNotes--;
   }
 
-  appendLoopEvent(target, qt, note, velocity, false);
+  insertLoopEvent(gState.recordTargetSlot, qt, note, velocity, false);
 }
 
-static void emitNoteWithDuration(uint8_t slotIndex, uint8_t note, uint8_t velocity, uint16_t durationTicks) {
+static void emitNoteWithDuration(uint8_t slotIndex, uint8_t note, uint8_t velocity, uint16_t durationTicks,
+                                 bool muted) {
   if (slotIndex >= gState.configuredSlots || durationTicks == 0) {
     return;
   }
   SlotState &slot = gState.slots[slotIndex];
   uint8_t channel = static_cast<uint8_t>((slot.midiChannel - 1) & 0x0F);
-  sendSlotMidi(slotIndex, static_cast<uint8_t>(0x90 | channel), note, velocity);
+  sendSlotMidi(slotIndex, static_cast<uint8_t>(0x90 | channel), note, velocity, muted);
   captureRecordEvent(slotIndex, note, velocity, true);
-  queueNoteOff(slotIndex, note, 0, gState.currentTick + durationTicks);
+  queueNoteOff(slotIndex, channel, note, 0, gState.currentTick + durationTicks);
 }
 
 static void processPendingNoteOffs() {
   for (PendingNoteOff &entry : gState.pendingNoteOffs) {
-    if (!entry.active || gState.currentTick < entry.offTick) {
+    if (!entry.active) {
+      continue;
+    }
+    if (entry.retired) {
+      // The release marker covers the note once it has run; until then the
+      // note-off still goes out on time, on the outgoing scene's channel
+      if (midiOutBuffer.releaseDone(entry.releaseTicket)) {
+        entry.active = false;
+      } else if (gState.currentTick >= entry.offTick) {
+        entry.active = false;
+        if (!gState.dryRun) {
+          sendMIDI(static_cast<uint8_t>(0x80 | entry.channel), entry.note, entry.velocity);
+        }
+      }
+      continue;
+    }
+    if (gState.currentTick < entry.offTick) {
       continue;
     }
     entry.active = false;
     if (entry.slotIndex >= gState.configuredSlots) {
       continue;
     }
-    SlotState &slot = gState.slots[entry.slotIndex];
-    uint8_t channel = static_cast<uint8_t>((slot.midiChannel - 1) & 0x0F);
-    sendSlotMidi(entry.slotIndex, static_cast<uint8_t>(0x80 | channel), entry.note, entry.velocity);
+    // Note-offs go out even if the slot was muted since, so nothing hangs
+    sendSlotMidi(entry.slotIndex, static_cast<uint8_t>(0x80 | entry.channel), entry.note, entry.velocity, false);
     captureRecordEvent(entry.slotIndex, entry.note, entry.velocity, false);
   }
 }
 
-static void clearLoop(SlotState &slot) {
+static void clearLoop(uint8_t slotIndex) {
+  SlotState &slot = gState.slots[slotIndex];
+  if (slot.loopEventCount > 0) {
+    uint16_t start = loopSegmentStart(slotIndex);
+    uint16_t used = loopPoolUsed();
+    uint16_t tail = static_cast<uint16_t>(used - start - slot.loopEventCount);
+    memmove(&gState.loopPool[start], &gState.loopPool[start + slot.loopEventCount], tail * sizeof(LoopEvent));
+  }
   slot.loopEventCount = 0;
+  slot.playCursor = 0;
+  slot.lastLoopTick = kNoLoopTick;
   slot.looperHasContent = false;
 }
 
@@ -314,17 +417,16 @@ static void stopTransport() {
   gState.recording = false;
   gState.recordSourceSlot = kNoSlot;
   gState.recordTargetSlot = kNoSlot;
-  memset(gState.captureNotes, 0, sizeof(gState.captureNotes));
+  resetCaptureNotes();
   for (PendingNoteOff &entry : gState.pendingNoteOffs) {
     entry.active = false;
   }
-  midiOutBuffer.panic();
+  midiOutBuffer.softPanic();
 }
 
 static void startTransport() {
   if (!gState.transportRunning) {
     gState.transportRunning = true;
-    gState.lastTickMicros = micros();
   }
 }
 
@@ -346,9 +448,9 @@ static void armRecordingForSelectedSlot() {
   targetSlot.loopLengthTicks = loopLengthTicksFromBars(gState.bars);
   targetSlot.loopQuantizeTicks = quantizeTicks(gState.quantizeIndex);
   if (gState.recordMode == RecordMode::REPLACE) {
-    clearLoop(targetSlot);
+    clearLoop(target);
   }
-  memset(gState.captureNotes, 0, sizeof(gState.captureNotes));
+  resetCaptureNotes();
   startTransport();
 }
 
@@ -361,7 +463,8 @@ static void beginRecordingNow() {
   gState.recordStartTick = gState.currentTick;
   const SlotState &targetSlot = gState.slots[gState.recordTargetSlot];
   gState.recordEndTick = gState.recordStartTick + targetSlot.loopLengthTicks;
-  memset(gState.captureNotes, 0, sizeof(gState.captureNotes));
+  gState.droppedLoopEvents = 0;
+  resetCaptureNotes();
 }
 
 static void maybeStopRecording() {
@@ -371,27 +474,38 @@ static void maybeStopRecording() {
   if (gState.currentTick < gState.recordEndTick) {
     return;
   }
+  if (gState.droppedLoopEvents > 0) {
+    Serial.printf("[SLOTS] Loop pool full (%u events): dropped %lu recorded events\n", gState.loopPoolCapacity,
+                  static_cast<unsigned long>(gState.droppedLoopEvents));
+  }
   gState.recording = false;
   gState.recordSourceSlot = kNoSlot;
   gState.recordTargetSlot = kNoSlot;
-  memset(gState.captureNotes, 0, sizeof(gState.captureNotes));
+  resetCaptureNotes();
 }
 
-static void processLooperSlot(uint8_t slotIndex) {
+// Plays only the events due on this tick by advancing the slot's cursor
+static void processLooperSlot(uint8_t slotIndex, bool muted) {
   SlotState &slot = gState.slots[slotIndex];
   if (slot.type != SlotType::LOOPER || !slot.looperHasContent || slot.loopLengthTicks == 0) {
     return;
   }
   uint16_t loopTick = static_cast<uint16_t>(gState.currentTick % slot.loopLengthTicks);
+  if (slot.lastLoopTick == kNoLoopTick || loopTick <= slot.lastLoopTick) {
+    slot.playCursor = 0;  // Wrapped (or first tick): start the pass over
+  }
+  slot.lastLoopTick = loopTick;
+
+  const LoopEvent *segment = &gState.loopPool[loopSegmentStart(slotIndex)];
   uint8_t channel = static_cast<uint8_t>((slot.midiChannel - 1) & 0x0F);
-  for (uint16_t i = 0; i < slot.loopEventCount; ++i) {
-    const LoopEvent &event = slot.loopEvents[i];
-    if (event.tick != loopTick) {
-      continue;
-    }
+  while (slot.playCursor < slot.loopEventCount && segment[slot.playCursor].tick < loopTick) {
+    slot.playCursor++;  // Skip events left behind by a position jump
+  }
+  while (slot.playCursor < slot.loopEventCount && segment[slot.playCursor].tick == loopTick) {
+    const LoopEvent &event = segment[slot.playCursor++];
     uint8_t status = event.noteOn ? static_cast<uint8_t>(0x90 | channel)
                                   : static_cast<uint8_t>(0x80 | channel);
-    sendSlotMidi(slotIndex, status, event.note, event.velocity);
+    sendSlotMidi(slotIndex, status, event.note, event.velocity, muted);
   }
 }
 
@@ -406,49 +520,405 @@ static bool engineShouldTrigger(const SlotState &slot, uint16_t stepIndex) {
   return value < clampDensity(slot.density);
 }
 
-static void processEngineSlot(uint8_t slotIndex) {
+// Called on each of the slot's steps; ClockRuntime applies the swing offset
+static void processEngineStep(uint8_t slotIndex, bool muted) {
   SlotState &slot = gState.slots[slotIndex];
   if (slot.type != SlotType::ENGINE_EUCLID && slot.type != SlotType::ENGINE_DIMENSIONS) {
     return;
   }
+  gState.engineSteps++;
+  uint16_t step = slot.engineStepIndex++;
+  if (engineShouldTrigger(slot, step)) {
+    uint8_t note = static_cast<uint8_t>(slot.baseNote + (step % 8));
+    emitNoteWithDuration(slotIndex, note, kDefaultEngineVelocity, kDefaultEngineDurationTicks, muted);
+  }
+}
 
-  while (gState.currentTick >= slot.nextEngineTick) {
-    uint16_t step = slot.engineStepIndex++;
-    if (engineShouldTrigger(slot, step)) {
-      uint8_t note = static_cast<uint8_t>(slot.baseNote + (step % 8));
-      emitNoteWithDuration(slotIndex, note, kDefaultEngineVelocity, kDefaultEngineDurationTicks);
+// Runs first on every tick, before the slot modules
+static void processConductorTick(uint32_t runtimeTick) {
+  if (gState.originPending) {
+    // Slot time restarts on the clock's start tick, the first one dispatched.
+    // Baseline for the drift check: the pulses sent before it, assuming the
+    // ones between the last sent and this tick follow in order.
+    gState.originPending = false;
+    gState.originTick = runtimeTick;
+    uint32_t sent = 0;
+    uint32_t lastSentTick = 0;
+    midiClockSentCount(sent, lastSentTick);
+    gState.originClocks = sent - lastSentTick + runtimeTick - 1;
+  }
+  maybeStopRecording();  // Closes a window that ended on the previous tick
+  gState.currentTick = runtimeTick - gState.originTick;
+  gState.processedTicks++;
+
+  if (gState.recordPending && gState.currentTick >= gState.recordStartTick) {
+    beginRecordingNow();
+  }
+  processPendingNoteOffs();
+}
+
+// Scene payload: settings, slot roles and every loop. Version byte first so
+// the format can grow without a new scene section.
+static constexpr uint32_t kSlotSceneTag = SCENE_TAG('S', 'L', 'O', 'T');
+static constexpr uint8_t kSlotSceneVersion = 1;
+static constexpr size_t kSlotSceneSlotBytes = 10;
+static constexpr size_t kSlotSceneMaxBytes =
+    5 + SLOT_SYSTEM_MAX_SLOTS * kSlotSceneSlotBytes + kLoopPoolEvents * 4;
+
+static void writeSlotScene(SceneWriter &out) {
+  out.u8(kSlotSceneVersion);
+  out.u8(gState.bars);
+  out.u8(gState.quantizeIndex);
+  out.u8(static_cast<uint8_t>(gState.recordMode));
+  out.u8(gState.swing);
+  uint16_t segment = 0;
+  for (const SlotState &slot : gState.slots) {
+    out.u8(static_cast<uint8_t>(slot.type));
+    out.u8(slot.midiChannel);
+    out.u8(slot.muted ? 1 : 0);
+    out.u8(slot.baseNote);
+    out.u8(slot.density);
+    out.u8(slot.loopQuantizeTicks);
+    out.u16(slot.loopLengthTicks);
+    out.u16(slot.loopEventCount);
+    for (uint16_t i = 0; i < slot.loopEventCount; ++i) {
+      const LoopEvent &event = gState.loopPool[segment + i];
+      out.u16(static_cast<uint16_t>(event.tick));
+      out.u8(static_cast<uint8_t>(event.note));
+      out.u8(static_cast<uint8_t>(event.velocity | (event.noteOn << 7)));
     }
+    segment = static_cast<uint16_t>(segment + slot.loopEventCount);
+  }
+}
+
+// Where a decoded scene goes: the live state, or the shadow a live switch fills
+struct SlotSceneImage {
+  SlotState slots[SLOT_SYSTEM_MAX_SLOTS];
+  LoopEvent *pool;
+  uint16_t poolCapacity;
+  uint8_t bars;
+  uint8_t quantizeIndex;
+  RecordMode recordMode;
+  uint8_t swing;
+};
 
-    uint8_t swingTicks =
-        static_cast<uint8_t>((gState.swing * kSwingTicksMaxOffset) / 50);
-    uint8_t baseStep = 6;
-    uint8_t duration = baseStep;
-    if ((step & 1U) == 0U) {
-      duration = static_cast<uint8_t>(baseStep + swingTicks);
-    } else if (swingTicks < baseStep) {
-      duration = static_cast<uint8_t>(baseStep - swingTicks);
+// With a null image the scene is only validated
+static bool readSlotScene(SceneReader &in, SlotSceneImage *image, uint16_t poolCapacity) {
+  if (in.u8() != kSlotSceneVersion) {
+    return false;
+  }
+  uint8_t bars = in.u8();
+  uint8_t quantizeIndex = in.u8();
+  uint8_t recordMode = in.u8();
+  uint8_t swing = in.u8();
+  if (bars < 1 || bars > 8 || quantizeIndex >= kQuantizeOptions || recordMode > 1 || swing > 50) {
+    return false;
+  }
+  if (image) {
+    image->bars = bars;
+    image->quantizeIndex = quantizeIndex;
+    image->recordMode = static_cast<RecordMode>(recordMode);
+    image->swing = swing;
+  }
+  uint16_t used = 0;
+  for (uint8_t slotIndex = 0; slotIndex < SLOT_SYSTEM_MAX_SLOTS; ++slotIndex) {
+    SlotState slot;
+    slot.type = static_cast<SlotType>(in.u8());
+    slot.midiChannel = in.u8();
+    slot.muted = in.u8() != 0;
+    slot.baseNote = in.u8() & 0x7F;
+    slot.density = clampDensity(in.u8());
+    slot.loopQuantizeTicks = in.u8();
+    slot.loopLengthTicks = in.u16();
+    slot.loopEventCount = in.u16();
+    if (slot.type > SlotType::LOOPER || slot.midiChannel < 1 || slot.midiChannel > kMaxMidiChannels ||
+        slot.loopLengthTicks < kTicksPerBar || slot.loopLengthTicks > 8 * kTicksPerBar ||
+        slot.loopEventCount > poolCapacity - used) {
+      return false;
     }
-    if (duration == 0) {
-      duration = 1;
+    uint16_t previousTick = 0;
+    for (uint16_t i = 0; i < slot.loopEventCount; ++i) {
+      uint16_t tick = in.u16();
+      uint8_t note = in.u8();
+      uint8_t packed = in.u8();
+      // Segments must stay tick-sorted for the play cursor
+      if (tick >= slot.loopLengthTicks || tick < previousTick || note > 127) {
+        return false;
+      }
+      previousTick = tick;
+      if (image) {
+        LoopEvent &event = image->pool[used + i];
+        event.tick = tick;
+        event.note = note;
+        event.velocity = packed & 0x7F;
+        event.noteOn = packed >> 7;
+        event.spare = 0;
+      }
+    }
+    used = static_cast<uint16_t>(used + slot.loopEventCount);
+    slot.looperHasContent = slot.loopEventCount > 0;
+    if (image) {
+      image->slots[slotIndex] = slot;
     }
-    slot.nextEngineTick += duration;
   }
+  return in.ok();
+}
+
+// Installs a decoded image; the caller holds the slot lock. The notes the
+// outgoing slots left sounding are released by markers queued on the output
+// buffer, after any of their note-ons still queued there; nothing is sent
+// from here. Returns the notes sounding on the released channels.
+static uint16_t installSlotScene(SlotSceneImage &image) {
+  uint16_t noteOffs = 0;
+  uint32_t tickets[kMaxMidiChannels] = {};
+  uint16_t releasedChannels = 0;
+  for (const SlotState &slot : gState.slots) {
+    uint8_t channel = static_cast<uint8_t>((slot.midiChannel - 1) & 0x0F);
+    if (slot.type != SlotType::EMPTY && !(releasedChannels & (1u << channel))) {
+      releasedChannels |= static_cast<uint16_t>(1u << channel);
+      noteOffs = static_cast<uint16_t>(noteOffs + activeNotesVoiceCount(channel));
+      tickets[channel] = midiOutBuffer.releaseSounding(channel);
+    }
+  }
+  for (PendingNoteOff &entry : gState.pendingNoteOffs) {
+    if (entry.active && !entry.retired && (releasedChannels & (1u << entry.channel))) {
+      entry.retired = true;
+      entry.releaseTicket = tickets[entry.channel];
+    }
+  }
+  gState.recordPending = false;
+  gState.recording = false;
+  gState.recordSourceSlot = kNoSlot;
+  gState.recordTargetSlot = kNoSlot;
+  resetCaptureNotes();
+
+  if (image.pool != gState.loopPool) {
+    std::swap(gState.loopPool, image.pool);  // Same capacity; the old pool becomes the next shadow
+  }
+  memcpy(gState.slots, image.slots, sizeof(gState.slots));
+  gState.bars = image.bars;
+  gState.quantizeIndex = image.quantizeIndex;
+  gState.recordMode = image.recordMode;
+  gState.swing = image.swing;
+  return noteOffs;
 }
 
-static void processTick() {
-  gState.currentTick++;
+static SemaphoreHandle_t gSlotLock = nullptr;
 
-  if (gState.recordPending && gState.currentTick >= gState.recordStartTick) {
-    beginRecordingNow();
+// Guards gState between the UI task and the clock task
+static void lockSlots() {
+  if (gSlotLock) {
+    xSemaphoreTake(gSlotLock, portMAX_DELAY);
   }
+}
 
-  for (uint8_t i = 0; i < gState.configuredSlots; ++i) {
-    processEngineSlot(i);
-    processLooperSlot(i);
+static void unlockSlots() {
+  if (gSlotLock) {
+    xSemaphoreGive(gSlotLock);
   }
+}
 
-  processPendingNoteOffs();
-  maybeStopRecording();
+// Decode target for scenes; during a live switch it holds the incoming scene
+// and a second loop pool until the bar commit swaps it in
+SlotSceneImage gSceneImage;
+LoopEvent *gShadowPool = nullptr;
+
+class SlotConductorModule : public ClockedModule {
+public:
+  const char *typeId() const override { return "slot_performer_conductor"; }
+  const char *displayName() const override { return "Slot Performer"; }
+  void init() override {}
+  void reset() override {}
+  void onTransportStart() override {
+    lockSlots();
+    // An armed recording gets a one-bar count-in from the start tick
+    gState.originPending = true;
+    gState.currentTick = 0;
+    gState.processedTicks = 0;
+    gState.engineSteps = 0;
+    if (gState.recordPending) {
+      gState.recordStartTick = kTicksPerBar;
+    }
+    unlockSlots();
+  }
+  uint16_t ticksPerStep() const override { return 1; }
+  void onStep(const StepContext &ctx) override {
+    lockSlots();
+    processConductorTick(ctx.tick);
+    unlockSlots();
+  }
+  void setParam(uint16_t, int32_t) override {}
+  int32_t getParam(uint16_t) const override { return 0; }
+
+  // The conductor persists the whole mode for the scene store
+  void serialize(uint8_t *buffer, size_t maxSize, size_t &outSize) const override {
+    SceneWriter out(buffer, maxSize);
+    lockSlots();
+    writeSlotScene(out);
+    unlockSlots();
+    outSize = out.size();
+  }
+  bool deserialize(const uint8_t *buffer, size_t size) override {
+    SceneReader check(buffer, size);
+    if (!readSlotScene(check, nullptr, gState.loopPoolCapacity)) {
+      return false;
+    }
+    // Decoded straight into the live pool; nothing is playing while a mode initialises
+    SceneReader in(buffer, size);
+    lockSlots();
+    gSceneImage.pool = gState.loopPool;
+    readSlotScene(in, &gSceneImage, gState.loopPoolCapacity);
+    installSlotScene(gSceneImage);
+    unlockSlots();
+    return true;
+  }
+};
+
+// One per slot: engines step every 1/16 (swung by the runtime), loopers every tick
+class SlotClockedModule : public ClockedModule {
+public:
+  void bind(uint8_t slotIndex) { slotIndex_ = slotIndex; }
+  const char *typeId() const override { return "slot_performer_slot"; }
+  const char *displayName() const override { return "Slot Performer Slot"; }
+  void init() override {}
+  void reset() override {}
+  uint16_t ticksPerStep() const override {
+    switch (gState.slots[slotIndex_].type) {
+      case SlotType::ENGINE_EUCLID:
+      case SlotType::ENGINE_DIMENSIONS:
+        return kEngineTicksPerStep;
+      case SlotType::LOOPER:
+        return 1;
+      default:
+        return 0;  // Empty and live-input slots have nothing to clock
+    }
+  }
+  void onStep(const StepContext &ctx) override {
+    lockSlots();
+    if (slotIndex_ < gState.configuredSlots) {
+      if (gState.slots[slotIndex_].type == SlotType::LOOPER) {
+        processLooperSlot(slotIndex_, ctx.muted);
+      } else {
+        processEngineStep(slotIndex_, ctx.muted);
+      }
+    }
+    unlockSlots();
+  }
+  void setParam(uint16_t, int32_t) override {}
+  int32_t getParam(uint16_t) const override { return 0; }
+
+private:
+  uint8_t slotIndex_ = 0;
+};
+
+SlotConductorModule gConductor;
+SlotClockedModule gSlotModules[SLOT_SYSTEM_MAX_SLOTS];
+int gConductorId = -1;
+int gSlotModuleIds[SLOT_SYSTEM_MAX_SLOTS];
+bool gPushedMute[SLOT_SYSTEM_MAX_SLOTS];
+uint8_t gPushedSwing = 0;
+SequencerSyncState slotSync;
+
+// Live switch: decode into the shadow pool in the UI task, swap pools at the bar
+static bool prepareSlotScene(SceneReader &in, uint16_t version) {
+  if (version != 1 || !gState.loopPool) {
+    return false;
+  }
+  if (!gShadowPool) {
+    gShadowPool = static_cast<LoopEvent *>(
+        poolAllocatePreferPsram("slot scene shadow", kLoopPoolEvents * sizeof(LoopEvent)));
+    if (!gShadowPool) {
+      return false;
+    }
+  }
+  SceneReader check = in;
+  if (!readSlotScene(check, nullptr, gState.loopPoolCapacity)) {
+    return false;
+  }
+  gSceneImage.pool = gShadowPool;
+  return readSlotScene(in, &gSceneImage, gState.loopPoolCapacity);
+}
+
+static uint16_t commitSlotScene() {
+  lockSlots();
+  uint16_t noteOffs = installSlotScene(gSceneImage);
+  gShadowPool = gSceneImage.pool;  // The outgoing pool
+  unlockSlots();
+  // The incoming mutes and swing reach the runtime on the UI task's next sync
+  return noteOffs;
+}
+
+const SceneHotSwap kSlotSceneHotSwap = {prepareSlotScene, commitSlotScene};
+
+struct SlotSceneRegistrar {
+  SlotSceneRegistrar() {
+    sceneRegisterClockedModule(kSlotSceneTag, "slot performer", &gConductor, kSlotSceneMaxBytes,
+                               &kSlotSceneHotSwap);
+  }
+} gSlotSceneRegistrar;
+
+// Registered once and kept: the runtime only dispatches them while Slot Performer runs it
+static void ensureSlotModulesRegistered() {
+  if (!gSlotLock) {
+    gSlotLock = xSemaphoreCreateMutex();
+  }
+  if (gConductorId >= 0) {
+    return;
+  }
+  gConductorId = clockRuntime.registerModule(&gConductor);
+  for (uint8_t i = 0; i < SLOT_SYSTEM_MAX_SLOTS; ++i) {
+    gSlotModules[i].bind(i);
+    gSlotModuleIds[i] = gConductorId >= 0 ? clockRuntime.registerModule(&gSlotModules[i]) : -1;
+    gPushedMute[i] = false;
+    clockRuntime.setModuleSwing(gSlotModuleIds[i], gPushedSwing);
+  }
+  if (gConductorId < 0 || gSlotModuleIds[SLOT_SYSTEM_MAX_SLOTS - 1] < 0) {
+    Serial.println("[SLOTS] ClockRuntime registration failed; slots will not play");
+  }
+}
+
+// Pushes slot mute and swing to the runtime. UI task only: gPushedMute and
+// gPushedSwing are its own, and the state is snapshotted under the slot lock
+// but pushed outside it, since the runtime calls back into the slots
+static void syncRuntimeSlots() {
+  bool muted[SLOT_SYSTEM_MAX_SLOTS];
+  lockSlots();
+  for (uint8_t i = 0; i < SLOT_SYSTEM_MAX_SLOTS; ++i) {
+    muted[i] = gState.slots[i].muted;
+  }
+  uint8_t swing = gState.swing;
+  unlockSlots();
+
+  for (uint8_t i = 0; i < SLOT_SYSTEM_MAX_SLOTS; ++i) {
+    if (muted[i] != gPushedMute[i]) {
+      gPushedMute[i] = muted[i];
+      clockRuntime.setModuleMute(gSlotModuleIds[i], gPushedMute[i]);
+    }
+  }
+  if (swing != gPushedSwing) {
+    gPushedSwing = swing;
+    for (int id : gSlotModuleIds) {
+      clockRuntime.setModuleSwing(id, gPushedSwing);
+    }
+  }
+}
+
+// Starts or stops ClockRuntime to match the UI; called outside the slot lock
+// because runtime transitions call back into the conductor
+static void syncRuntimeTransport() {
+  slotSync.tryStartIfReady(false);
+  bool runtimeActive = !clockRuntime.isStopped();
+  if (gState.transportRunning && !runtimeActive) {
+    // Join a clock that is already running on its next bar; otherwise start now
+    bool clockIdle = !clockManagerIsRunning();
+    slotSync.requestStart();
+    clockRuntime.setStartQuantize((instantStartMode || clockIdle) ? QuantizeMode::IMMEDIATE
+                                                                   : QuantizeMode::NEXT_BAR);
+    clockRuntime.requestStart();
+  } else if (!gState.transportRunning && runtimeActive) {
+    clockRuntime.forceStop();
+    slotSync.stopPlayback();
+  }
 }
 
 static bool transportButtonPressed() {
@@ -627,6 +1097,7 @@ static void resetSlotState(uint8_t slotIndex, SlotType newType) {
   if (slotIndex >= gState.configuredSlots) {
     return;
   }
+  clearLoop(slotIndex);  // Release the slot's pool segment before its count is reset
   SlotState replacement;
   replacement.type = newType;
   replacement.midiChannel = static_cast<uint8_t>((slotIndex % kMaxMidiChannels) + 1);
@@ -634,7 +1105,7 @@ static void resetSlotState(uint8_t slotIndex, SlotType newType) {
   replacement.loopLengthTicks = loopLengthTicksFromBars(gState.bars);
   replacement.loopQuantizeTicks = quantizeTicks(gState.quantizeIndex);
   gState.slots[slotIndex] = replacement;
-  midiOutBuffer.allNotesOff(static_cast<uint8_t>((replacement.midiChannel - 1) & 0x0F));
+  midiOutBuffer.releaseSounding(static_cast<uint8_t>((replacement.midiChannel - 1) & 0x0F));
 }
 
 static SlotType nextSlotType(SlotType type) {
@@ -656,8 +1127,20 @@ static SlotType nextSlotType(SlotType type) {
 
 }  // namespace
 
+void initSlotPerformerMemory() {
+  if (gState.loopPool) {
+    return;
+  }
+  gState.loopPool = static_cast<LoopEvent *>(
+      poolAllocatePreferPsram("slot loop events", kLoopPoolEvents * sizeof(LoopEvent)));
+  gState.loopPoolCapacity = gState.loopPool ? kLoopPoolEvents : 0;
+  poolNoteStatic("slot performer state", sizeof(gState));
+}
+
 void initializeSlotPerformerMode() {
   randomSeed(micros());
+  ensureSlotModulesRegistered();
+  lockSlots();
   gState.bpm = sharedBPM;
   gState.swing = 0;
   gState.configuredSlots = clampConfiguredSlotCount();
@@ -674,8 +1157,12 @@ void initializeSlotPerformerMode() {
   gState.recordTargetSlot = kNoSlot;
   gState.detailOpen = false;
   memset(gState.pendingNoteOffs, 0, sizeof(gState.pendingNoteOffs));
-  memset(gState.captureNotes, 0, sizeof(gState.captureNotes));
+  resetCaptureNotes();
 
+  // Empty the loop pool outright; resetSlotState skips slots beyond the configured count
+  for (SlotState &slot : gState.slots) {
+    slot.loopEventCount = 0;
+  }
   for (uint8_t i = 0; i < SLOT_SYSTEM_MAX_SLOTS; ++i) {
     resetSlotState(i, SlotType::EMPTY);
   }
@@ -684,6 +1171,8 @@ void initializeSlotPerformerMode() {
   if (gState.configuredSlots > 1) resetSlotState(1, SlotType::ENGINE_DIMENSIONS);
   if (gState.configuredSlots > 2) resetSlotState(2, SlotType::LIVE_INPUT);
   if (gState.configuredSlots > 3) resetSlotState(3, SlotType::LOOPER);
+  unlockSlots();
+  sceneApplyPending(kSlotSceneTag);  // Takes the slot lock itself
 }
 
 void drawSlotPerformerMode() {
@@ -697,27 +1186,12 @@ void drawSlotPerformerMode() {
   }
 }
 
-void handleSlotPerformerMode() {
-  if (touch.justPressed && isButtonPressed(BACK_BUTTON_X, BACK_BUTTON_Y, BACK_BUTTON_W, BACK_BUTTON_H)) {
-    stopTransport();
-    exitToMenu();
-    return;
-  }
-
+static void handleSlotPerformerTouch() {
   gState.configuredSlots = clampConfiguredSlotCount();
   if (gState.selectedSlot >= gState.configuredSlots) {
     gState.selectedSlot = 0;
   }
 
-  if (gState.transportRunning) {
-    uint32_t nowMicros = micros();
-    uint32_t interval = tickIntervalMicros();
-    while (nowMicros - gState.lastTickMicros >= interval) {
-      gState.lastTickMicros += interval;
-      processTick();
-    }
-  }
-
   if (!touch.justPressed) {
     return;
   }
@@ -767,7 +1241,7 @@ void handleSlotPerformerMode() {
     if (isButtonPressed(x + SCALE_X(20) + halfW, rowY, halfW, rowH)) {
       SlotState &slot = gState.slots[gState.selectedSlot];
       if (slot.type == SlotType::LOOPER) {
-        clearLoop(slot);
+        clearLoop(gState.selectedSlot);
       } else {
         armRecordingForSelectedSlot();
       }
@@ -779,7 +1253,7 @@ void handleSlotPerformerMode() {
     if (gState.slots[gState.selectedSlot].type == SlotType::LIVE_INPUT &&
         isButtonPressed(x + SCALE_X(10), rowY, w - SCALE_X(20), rowH)) {
       uint8_t note = static_cast<uint8_t>(gState.slots[gState.selectedSlot].baseNote);
-      emitNoteWithDuration(gState.selectedSlot, note, 110, 6);
+      emitNoteWithDuration(gState.selectedSlot, note, 110, 6, gState.slots[gState.selectedSlot].muted);
       requestRedraw();
       return;
     }
@@ -900,3 +1374,174 @@ void handleSlotPerformerMode() {
     }
   }
 }
+
+void handleSlotPerformerMode() {
+  if (touch.justPressed && isButtonPressed(BACK_BUTTON_X, BACK_BUTTON_Y, BACK_BUTTON_W, BACK_BUTTON_H)) {
+    lockSlots();
+    stopTransport();
+    unlockSlots();
+    syncRuntimeTransport();
+    exitToMenu();
+    return;
+  }
+
+  // Ticks are processed by ClockRuntime in the clock task; the UI only edits state
+  lockSlots();
+  handleSlotPerformerTouch();
+  unlockSlots();
+  syncRuntimeTransport();
+  syncRuntimeSlots();
+}
+
+SlotLooperBenchResult runSlotLooperBenchmark(uint32_t bars) {
+  SlotLooperBenchResult result = {bars, 0, 0, 0, 0};
+  const uint16_t loopTicks = 4 * kTicksPerBar;  // Default loop length: one event per tick
+  // Same placement as the live pool, so the timings reflect PSRAM where it is used
+  size_t poolBytes = kLoopPoolEvents * sizeof(LoopEvent);
+  LoopEvent *pool = static_cast<LoopEvent *>(poolAllocatePreferPsram("slot bench scratch", poolBytes));
+  if (!pool) {
+    Serial.println("[SLOTS] Bench: scratch pool allocation failed");
+    return result;
+  }
+  // Full loopers, events spread evenly (and therefore sorted) across one bar
+  for (uint16_t i = 0; i < kLoopPoolEvents; ++i) {
+    uint16_t local = static_cast<uint16_t>(i % kMaxLoopEvents);
+    pool[i].tick = static_cast<uint16_t>((static_cast<uint32_t>(local) * loopTicks) / kMaxLoopEvents);
+    pool[i].note = static_cast<uint8_t>(36 + (local % 48));
+    pool[i].velocity = 100;
+    pool[i].noteOn = (local & 1) == 0;
+    pool[i].spare = 0;
+  }
+  result.events = kLoopPoolEvents;
+  uint32_t totalTicks = bars * kTicksPerBar;
+  volatile uint32_t sink = 0;
+  uint32_t scanPlayed = 0;
+
+  uint32_t start = micros();
+  for (uint32_t t = 0; t < totalTicks; ++t) {
+    uint16_t loopTick = static_cast<uint16_t>(t % loopTicks);
+    for (uint8_t slot = 0; slot < SLOT_SYSTEM_MAX_SLOTS; ++slot) {
+      const LoopEvent *segment = &pool[slot * kMaxLoopEvents];
+      for (uint16_t i = 0; i < kMaxLoopEvents; ++i) {
+        if (segment[i].tick == loopTick) {
+          sink += segment[i].note;
+          scanPlayed++;
+        }
+      }
+    }
+  }
+  result.scanUs = micros() - start;
+
+  uint16_t cursors[SLOT_SYSTEM_MAX_SLOTS] = {0};
+  start = micros();
+  for (uint32_t t = 0; t < totalTicks; ++t) {
+    uint16_t loopTick = static_cast<uint16_t>(t % loopTicks);
+    for (uint8_t slot = 0; slot < SLOT_SYSTEM_MAX_SLOTS; ++slot) {
+      const LoopEvent *segment = &pool[slot * kMaxLoopEvents];
+      uint16_t &cursor = cursors[slot];
+      if (loopTick == 0) {
+        cursor = 0;
+      }
+      while (cursor < kMaxLoopEvents && segment[cursor].tick == loopTick) {
+        sink += segment[cursor++].note;
+        result.played++;
+      }
+    }
+  }
+  result.cursorUs = micros() - start;
+
+  if (scanPlayed != result.played) {
+    Serial.printf("[SLOTS] Bench: scan played %u events, cursor played %u\n", scanPlayed, result.played);
+  }
+  heap_caps_free(pool);
+  (void)sink;
+  return result;
+}
+
+SlotDriftResult measureSlotPerformerDrift() {
+  SlotDriftResult result = {false, 0, 0, 0, 0};
+  if (!clockRuntime.isRunning()) {
+    return result;
+  }
+  uint32_t sent = 0;
+  uint32_t lastSentTick = 0;
+  lockSlots();
+  if (gState.processedTicks > 0 && !gState.originPending) {
+    // The conductor does not run while the lock is held, so the pulses are
+    // counted up to the last tick it processed: the output task may be a
+    // pulse ahead of the dispatch, or behind it
+    midiClockSentCount(sent, lastSentTick);
+    uint32_t lastProcessedTick = gState.originTick + gState.currentTick;
+    result.ran = true;
+    result.clockTicks = sent - (lastSentTick - lastProcessedTick) - gState.originClocks;
+    result.slotTicks = gState.processedTicks;
+    result.engineSteps = gState.engineSteps;
+  }
+  unlockSlots();
+  result.drift = static_cast<int32_t>(result.clockTicks - result.slotTicks);
+  return result;
+}
+
+SlotDispatchResult runSlotPerformerDispatchCheck(uint32_t minutes) {
+  SlotDispatchResult result = {false, 0, 0, 0, 0};
+  if (gState.transportRunning || !clockRuntime.isStopped() || clockManagerIsRunning()) {
+    return result;
+  }
+  ensureSlotModulesRegistered();
+
+  // A runtime of its own: the clock task keeps driving the shared one, and
+  // its tick count is left as it was
+  ClockRuntime *runtime = new (std::nothrow) ClockRuntime();
+  if (runtime == nullptr) {
+    return result;
+  }
+  runtime->init();
+  bool registered = runtime->registerModule(&gConductor) >= 0;
+  for (uint8_t i = 0; i < SLOT_SYSTEM_MAX_SLOTS && registered; ++i) {
+    int id = runtime->registerModule(&gSlotModules[i]);
+    registered = id >= 0;
+    runtime->setModuleMute(id, gPushedMute[i]);
+    runtime->setModuleSwing(id, gPushedSwing);
+  }
+  if (!registered) {
+    delete runtime;
+    return result;
+  }
+
+  uint32_t ticks = minutes * gState.bpm * kTicksPerQuarter;
+  uint8_t engineSlots = 0;
+  for (uint8_t i = 0; i < gState.configuredSlots; ++i) {
+    SlotType type = gState.slots[i].type;
+    engineSlots += (type == SlotType::ENGINE_EUCLID || type == SlotType::ENGINE_DIMENSIONS) ? 1 : 0;
+  }
+
+  // Start on a bar line so every engine step falls inside the run. No F8 goes
+  // out, so this checks dispatch only: clock drift needs the live check.
+  uint32_t startTick = 2 * kTicksPerBar;
+  gState.dryRun = true;
+  runtime->processTick(startTick);
+  runtime->setStartQuantize(QuantizeMode::IMMEDIATE);
+  runtime->requestStart();
+  for (uint32_t t = 1; t < ticks; ++t) {
+    runtime->processTick(startTick + t);
+  }
+
+  lockSlots();
+  result.ran = runtime->isRunning();
+  result.fedTicks = ticks;
+  result.processedTicks = gState.processedTicks;
+  result.engineSteps = gState.engineSteps;
+  unlockSlots();
+  runtime->forceStop();
+  delete runtime;
+
+  lockSlots();
+  gState.dryRun = false;
+  for (PendingNoteOff &entry : gState.pendingNoteOffs) {
+    entry.active = false;
+  }
+  unlockSlots();
+
+  result.expectedEngineSteps = (ticks / kEngineTicksPerStep) * engineSlots;
+  return result;
+}
@@ -1,6 +1,8 @@
 #include "module_tb3po_mode.h"
 #include "clock_manager.h"
+#include "rng_service.h"
 #include <uClock.h>
+#include <esp_system.h>
 
 TB3POState tb3po;
 static SequencerSyncState tb3poSync;
@@ -26,13 +28,12 @@ static void onTb3poStepISR(uint32_t step, uint8_t track) {
 }
 
 static bool randBit(int probability) {
-  return (random(100) < probability);
+  return rngChance(RngStream::TB3PO, probability);
 }
 
 static void reseed() {
   if (!tb3po.lockSeed) {
-    randomSeed(millis());
-    tb3po.seed = random(1, 65536);
+    tb3po.seed = 1 + esp_random() % 65535;
   }
 }
 
@@ -46,7 +47,7 @@ static int getPitchChangeDensity() {
 }
 
 static void regeneratePitches() {
-  randomSeed(tb3po.seed);
+  rngSeed(RngStream::TB3PO, tb3po.seed);
   const Scale &scale = scales[tb3po.scaleIndex];
   int pitchChangeDens = getPitchChangeDensity();
   int availablePitches = 0;
@@ -73,7 +74,7 @@ static void regeneratePitches() {
     if (s > 0 && randBit(forceRepeatProb)) {
       tb3po.notes[s] = tb3po.notes[s - 1];
     } else {
-      tb3po.notes[s] = random(0, availablePitches + 1);
+      tb3po.notes[s] = rngBelow(RngStream::TB3PO, availablePitches + 1);
       tb3po.oct_ups <<= 1;
       tb3po.oct_downs <<= 1;
       if (randBit(40)) {
@@ -88,7 +89,9 @@ static void regeneratePitches() {
 }
 
 static void applyDensity() {
-  randomSeed(tb3po.seed + 1000);
+  rngSeed(RngStream::TB3PO, tb3po.seed + 1000);
+  uint8_t rolls[TB3PO_MAX_STEPS][3];
+  rngFillBelow(RngStream::TB3PO, &rolls[0][0], sizeof(rolls), 100);
   int onOffDens = getOnOffDensity();
   int densProb = 10 + onOffDens * 6;
   int latestSlide = 0;
@@ -99,16 +102,16 @@ static void applyDensity() {
 
   for (int i = 0; i < TB3PO_MAX_STEPS; ++i) {
     tb3po.gates <<= 1;
-    if (randBit(densProb)) {
+    if (rolls[i][0] < densProb) {
       tb3po.gates |= 1;
     }
     tb3po.slides <<= 1;
-    latestSlide = randBit(latestSlide ? 10 : 18);
+    latestSlide = rolls[i][1] < (latestSlide ? 10 : 18);
     if (latestSlide) {
       tb3po.slides |= 1;
     }
     tb3po.accents <<= 1;
-    latestAccent = randBit(latestAccent ? 7 : 16);
+    latestAccent = rolls[i][2] < (latestAccent ? 7 : 16);
     if (latestAccent) {
       tb3po.accents |= 1;
     }
@@ -1,6 +1,7 @@
 #include "module_waaave_mode.h"
 #include "common_definitions.h"
 #include "ui_elements.h"
+#include "midi_control_coalescer.h"
 #include "midi_utils.h"
 #include <Arduino.h>
 #include <cmath>
@@ -58,6 +59,11 @@ static void sendCC(uint8_t cc, uint8_t value) {
   sendMIDI(0xB0, cc, value);  // Control Change on channel 1
 }
 
+// Knobs and sliders: only the latest position goes out
+static void sendContinuousCC(uint8_t cc, uint8_t value) {
+  sendMIDIControl(0, cc, value);
+}
+
 // Page navigation helpers
 static inline int numPages() { return 3; }
 
@@ -307,7 +313,7 @@ static void handleControlPage(int channelStart) {
         newValue = constrain(newValue, 0, 127);
         if (newValue != state.knobs[ch]) {
           state.knobs[ch] = newValue;
-          sendCC(CC_KNOB_BASE + ch, state.knobs[ch]);
+          sendContinuousCC(CC_KNOB_BASE + ch, state.knobs[ch]);
           requestRedraw();
         }
         state.lastKnobX[ch] = touch.x;
@@ -329,7 +335,7 @@ static void handleControlPage(int channelStart) {
       int newValue = 127 - ((relY * 127) / sliderH);
       newValue = constrain(newValue, 0, 127);
       state.sliders[ch] = newValue;
-      sendCC(CC_SLIDER_BASE + ch, state.sliders[ch]);
+      sendContinuousCC(CC_SLIDER_BASE + ch, state.sliders[ch]);
       requestRedraw();
     }
     
@@ -1,5 +1,7 @@
 #include "module_xy_pad_mode.h"
 
+#include "midi_control_coalescer.h"
+
 int xCC = 1;  // CC number for X axis (Modulation Wheel by default)
 int yCC = 7;  // CC number for Y axis (Volume by default)
 int xValue = 64;  // Current X value (0-127)
@@ -202,10 +204,9 @@ void updateXYValues(int touchX, int touchY) {
 
 void sendXYValues() {
   if (deviceConnected) {
-    // Send X CC
-    sendMIDI(0xB0, xCC, xValue);
-    // Send Y CC
-    sendMIDI(0xB0, yCC, yValue);
+    // Every touch move updates both; only the latest values go out
+    sendMIDIControl(0, xCC, xValue);
+    sendMIDIControl(0, yCC, yValue);
   }
 }
 
@@ -1,5 +1,6 @@
 #include "module_zynthian_pad_mode.h"
 
+#include "midi_out_buffer.h"
 #include "midi_utils.h"
 #include "ui_elements.h"
 
@@ -148,9 +149,9 @@ static void performAction(ZynthianPadAction action, bool emitMidi) {
     case ZynthianPadAction::TOGGLE_MIDI_PLAY:
       gPadState.transportRunning = !gPadState.transportRunning;
       if (gPadState.transportRunning) {
-        sendMIDIStart();
+        midiOutBuffer.midiStart();
       } else {
-        sendMIDIStop();
+        midiOutBuffer.midiStop();
       }
       requestRedraw();
       break;
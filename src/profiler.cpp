@@ -0,0 +1,325 @@
+#include "profiler.h"
+#include "memory_pools.h"
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <new>
+#include <string.h>
+
+namespace {
+static constexpr size_t kSectionCount = static_cast<size_t>(ProfileSection::COUNT);
+static const char *const kSectionNames[kSectionCount] = {"render",         "flush",          "handle",
+                                                         "clock_dispatch", "transport_send", "queue_send"};
+
+struct SectionCounters {
+  uint32_t calls;
+  uint64_t cycles;
+  uint32_t maxCycles;
+};
+
+static portMUX_TYPE profilerMux = portMUX_INITIALIZER_UNLOCKED;
+static SectionCounters windowCounters[kSectionCount];
+static ProfileSectionStats published[kSectionCount];
+static uint32_t droppedSamples[kSectionCount];
+static uint32_t peakMaxCycles[kSectionCount];
+static uint32_t cyclesPerUs = 0;
+static uint32_t windowStartMs = 0;
+static uint32_t publishedWindowMs = 0;
+
+static ProfileTaskStats taskStats[kProfileMaxTasks];
+static size_t taskCount = 0;
+static size_t taskTotal = 0;  // Tasks at the last sample, published or not
+
+#if configUSE_TRACE_FACILITY
+// Sized from uxTaskGetNumberOfTasks(), which uxTaskGetSystemState() needs
+// room for or it returns nothing; the spare covers tasks created in between
+static constexpr size_t kTaskStatusSpare = 4;
+static TaskStatus_t *taskStatus = nullptr;
+static size_t taskCapacity = 0;
+#if configGENERATE_RUN_TIME_STATS
+struct TaskRunTime {
+  TaskHandle_t handle;
+  uint32_t counter;
+};
+static TaskRunTime *lastRunTime = nullptr;
+static size_t lastRunTimeCount = 0;
+static uint32_t lastTotalRunTime = 0;
+#endif
+
+static bool reserveTaskStatus(size_t tasks) {
+  if (tasks <= taskCapacity) {
+    return true;
+  }
+  size_t capacity = tasks + kTaskStatusSpare;
+  TaskStatus_t *status = new (std::nothrow) TaskStatus_t[capacity];
+#if configGENERATE_RUN_TIME_STATS
+  TaskRunTime *runTime = new (std::nothrow) TaskRunTime[capacity];
+  if (status == nullptr || runTime == nullptr) {
+    delete[] status;
+    delete[] runTime;
+    return false;
+  }
+  if (lastRunTime != nullptr) {
+    memcpy(runTime, lastRunTime, lastRunTimeCount * sizeof(TaskRunTime));
+  }
+  delete[] lastRunTime;
+  lastRunTime = runTime;
+#else
+  if (status == nullptr) {
+    return false;
+  }
+#endif
+  delete[] taskStatus;
+  taskStatus = status;
+  taskCapacity = capacity;
+  return true;
+}
+#endif
+
+static ProfileTraceEvent *traceRing = nullptr;
+static size_t traceCount = 0;
+static volatile bool traceArmed = false;
+static uint32_t traceEndMs = 0;
+
+static uint32_t cyclesToUs(uint64_t cycles) {
+  return static_cast<uint32_t>(cycles / cyclesPerUs);
+}
+
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+// Share of one core since the last sample, from the tasks' run-time counters
+static int16_t cpuPermille(const TaskStatus_t &status, uint32_t totalDelta) {
+  for (size_t i = 0; i < lastRunTimeCount; ++i) {
+    if (lastRunTime[i].handle == status.xHandle) {
+      if (totalDelta == 0) {
+        return 0;
+      }
+      uint64_t delta = static_cast<uint32_t>(status.ulRunTimeCounter - lastRunTime[i].counter);
+      return static_cast<int16_t>(min<uint64_t>(delta * 1000 / totalDelta, 1000));
+    }
+  }
+  return -1;  // Started since the last sample
+}
+#endif
+
+static void sampleTasks() {
+#if configUSE_TRACE_FACILITY
+  if (!reserveTaskStatus(uxTaskGetNumberOfTasks())) {
+    return;  // Keeps the last sample
+  }
+  uint32_t totalRunTime = 0;
+  UBaseType_t count = uxTaskGetSystemState(taskStatus, taskCapacity, &totalRunTime);
+  if (count == 0) {
+    return;  // More tasks than the spare covers: grown on the next sample
+  }
+#if configGENERATE_RUN_TIME_STATS
+  uint32_t totalDelta = totalRunTime - lastTotalRunTime;
+#endif
+  // Every task feeds the run-time baseline; the first kProfileMaxTasks are published
+  for (UBaseType_t i = 0; i < count && i < kProfileMaxTasks; ++i) {
+    const TaskStatus_t &status = taskStatus[i];
+    ProfileTaskStats &stats = taskStats[i];
+    strncpy(stats.name, status.pcTaskName, kProfileTaskNameLen - 1);
+    stats.name[kProfileTaskNameLen - 1] = '\0';
+    stats.priority = static_cast<uint8_t>(status.uxCurrentPriority);
+#if configTASKLIST_INCLUDE_COREID
+    stats.core = status.xCoreID == tskNO_AFFINITY ? -1 : static_cast<int8_t>(status.xCoreID);
+#else
+    stats.core = -1;
+#endif
+    stats.stackFree = static_cast<uint32_t>(status.usStackHighWaterMark) * sizeof(StackType_t);
+#if configGENERATE_RUN_TIME_STATS
+    stats.cpuPermille = cpuPermille(status, totalDelta);
+#else
+    stats.cpuPermille = -1;
+#endif
+  }
+#if configGENERATE_RUN_TIME_STATS
+  for (UBaseType_t i = 0; i < count; ++i) {
+    lastRunTime[i] = {taskStatus[i].xHandle, taskStatus[i].ulRunTimeCounter};
+  }
+  lastRunTimeCount = count;
+  lastTotalRunTime = totalRunTime;
+#endif
+  taskTotal = count;
+  taskCount = min<size_t>(count, kProfileMaxTasks);
+#else
+  taskCount = 0;  // uxTaskGetSystemState() needs configUSE_TRACE_FACILITY
+  taskTotal = 0;
+#endif
+}
+}  // namespace
+
+const char *profileSectionName(ProfileSection section) {
+  size_t index = static_cast<size_t>(section);
+  return index < kSectionCount ? kSectionNames[index] : "?";
+}
+
+ProfileScope::ProfileScope(ProfileSection section)
+    : section_(section), core_(static_cast<uint8_t>(xPortGetCoreID())), startCycles_(ESP.getCycleCount()) {}
+
+ProfileScope::~ProfileScope() {
+  profilerRecord(section_, startCycles_, core_);
+}
+
+void profilerRecord(ProfileSection section, uint32_t startCycles, uint8_t startCore) {
+  uint32_t cycles = ESP.getCycleCount() - startCycles;
+  size_t index = static_cast<size_t>(section);
+  if (index >= kSectionCount) {
+    return;
+  }
+  uint8_t core = static_cast<uint8_t>(xPortGetCoreID());
+  if (core != startCore) {
+    portENTER_CRITICAL(&profilerMux);
+    droppedSamples[index]++;
+    portEXIT_CRITICAL(&profilerMux);
+    return;
+  }
+
+  portENTER_CRITICAL(&profilerMux);
+  SectionCounters &counters = windowCounters[index];
+  counters.calls++;
+  counters.cycles += cycles;
+  if (cycles > counters.maxCycles) {
+    counters.maxCycles = cycles;
+  }
+  if (cycles > peakMaxCycles[index]) {
+    peakMaxCycles[index] = cycles;
+  }
+  portEXIT_CRITICAL(&profilerMux);
+
+  if (!traceArmed || cyclesPerUs == 0) {
+    return;
+  }
+  ProfileTraceEvent event;
+  uint32_t nowUs = micros();
+  event.durationUs = cycles / cyclesPerUs;
+  event.startUs = nowUs - event.durationUs;
+  event.section = section;
+  event.core = core;
+  strncpy(event.task, pcTaskGetName(nullptr), kProfileTaskNameLen - 1);
+  event.task[kProfileTaskNameLen - 1] = '\0';
+  bool expired = static_cast<int32_t>(millis() - traceEndMs) >= 0;
+
+  portENTER_CRITICAL(&profilerMux);
+  if (traceArmed) {
+    if (expired) {
+      traceArmed = false;
+    } else {
+      traceRing[traceCount++] = event;
+      if (traceCount >= kProfileTraceEvents) {
+        traceArmed = false;
+      }
+    }
+  }
+  portEXIT_CRITICAL(&profilerMux);
+}
+
+void profilerService(uint32_t nowMs) {
+  if (cyclesPerUs == 0) {
+    cyclesPerUs = ESP.getCpuFreqMHz();
+    windowStartMs = nowMs;
+    return;
+  }
+  if (nowMs - windowStartMs < kProfileWindowMs) {
+    return;
+  }
+
+  SectionCounters window[kSectionCount];
+  uint32_t dropped[kSectionCount];
+  uint32_t peak[kSectionCount];
+  portENTER_CRITICAL(&profilerMux);
+  memcpy(window, windowCounters, sizeof(window));
+  memcpy(dropped, droppedSamples, sizeof(dropped));
+  memcpy(peak, peakMaxCycles, sizeof(peak));
+  memset(windowCounters, 0, sizeof(windowCounters));
+  portEXIT_CRITICAL(&profilerMux);
+
+  for (size_t i = 0; i < kSectionCount; ++i) {
+    published[i].calls = window[i].calls;
+    published[i].totalUs = cyclesToUs(window[i].cycles);
+    published[i].maxUs = cyclesToUs(window[i].maxCycles);
+    published[i].dropped = dropped[i];
+    published[i].peakMaxUs = cyclesToUs(peak[i]);
+  }
+  publishedWindowMs = nowMs - windowStartMs;
+  windowStartMs = nowMs;
+  sampleTasks();
+
+  if (traceArmed && static_cast<int32_t>(nowMs - traceEndMs) >= 0) {
+    traceArmed = false;  // No scope ran since it expired
+  }
+}
+
+ProfileSectionStats profilerGetSection(ProfileSection section) {
+  size_t index = static_cast<size_t>(section);
+  return index < kSectionCount ? published[index] : ProfileSectionStats{};
+}
+
+size_t profilerGetTasks(ProfileTaskStats *out, size_t maxTasks) {
+  size_t count = min(taskCount, maxTasks);
+  memcpy(out, taskStats, count * sizeof(ProfileTaskStats));
+  return count;
+}
+
+size_t profilerTaskTotal() {
+  return taskTotal;
+}
+
+uint32_t profilerWindowMs() {
+  return publishedWindowMs;
+}
+
+bool profilerHasRunTimeStats() {
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+void profilerResetStats() {
+  portENTER_CRITICAL(&profilerMux);
+  memset(windowCounters, 0, sizeof(windowCounters));
+  memset(droppedSamples, 0, sizeof(droppedSamples));
+  memset(peakMaxCycles, 0, sizeof(peakMaxCycles));
+  portEXIT_CRITICAL(&profilerMux);
+  memset(published, 0, sizeof(published));
+  windowStartMs = millis();
+}
+
+bool profilerTraceStart(uint32_t durationMs) {
+  if (traceRing == nullptr) {
+    // Only allocated the first time a trace is taken
+    traceRing = static_cast<ProfileTraceEvent *>(
+        poolAllocatePreferPsram("profiler trace", kProfileTraceEvents * sizeof(ProfileTraceEvent)));
+    if (traceRing == nullptr) {
+      return false;
+    }
+  }
+  portENTER_CRITICAL(&profilerMux);
+  traceCount = 0;
+  traceEndMs = millis() + durationMs;
+  traceArmed = true;
+  portEXIT_CRITICAL(&profilerMux);
+  return true;
+}
+
+bool profilerTraceArmed() {
+  return traceArmed;
+}
+
+size_t profilerTraceCount() {
+  return traceCount;
+}
+
+bool profilerTraceEvent(size_t index, ProfileTraceEvent &out) {
+  bool ok = false;
+  portENTER_CRITICAL(&profilerMux);
+  if (traceRing != nullptr && index < traceCount) {
+    out = traceRing[index];
+    ok = true;
+  }
+  portEXIT_CRITICAL(&profilerMux);
+  return ok;
+}
@@ -0,0 +1,165 @@
+#include "rng_service.h"
+
+#include <Arduino.h>
+#include <esp_system.h>
+
+static RngState rngStreams[static_cast<uint8_t>(RngStream::COUNT)];
+
+static inline RngState &streamState(RngStream stream) {
+  return rngStreams[static_cast<uint8_t>(stream)];
+}
+
+static inline uint32_t rotl(uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+static uint32_t splitmix32(uint32_t &x) {
+  uint32_t z = (x += 0x9E3779B9u);
+  z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+  z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+  return z ^ (z >> 16);
+}
+
+// The stream index is mixed in so equal seeds still give distinct streams
+static void seedState(RngState &state, uint32_t seed, uint8_t streamIndex) {
+  uint32_t x = seed ^ (0x632BE5ABu * (streamIndex + 1u));
+  for (uint32_t &word : state.s) {
+    word = splitmix32(x);
+  }
+  if ((state.s[0] | state.s[1] | state.s[2] | state.s[3]) == 0) {
+    state.s[0] = 1;  // xoshiro must never be all zero
+  }
+}
+
+static inline uint32_t belowFrom(uint32_t value, uint32_t bound) {
+  // Multiply-shift: one multiply instead of a divide
+  return static_cast<uint32_t>((static_cast<uint64_t>(value) * bound) >> 32);
+}
+
+void initRngService() {
+  for (uint8_t i = 0; i < static_cast<uint8_t>(RngStream::COUNT); ++i) {
+    seedState(rngStreams[i], esp_random(), i);
+  }
+}
+
+void rngSeed(RngStream stream, uint32_t seed) {
+  seedState(streamState(stream), seed, static_cast<uint8_t>(stream));
+}
+
+uint32_t rngNext(RngState &state) {
+  uint32_t *s = state.s;
+  const uint32_t result = rotl(s[1] * 5u, 7) * 9u;
+  const uint32_t t = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl(s[3], 11);
+  return result;
+}
+
+uint32_t rngNext(RngStream stream) {
+  return rngNext(streamState(stream));
+}
+
+uint32_t rngBelow(RngStream stream, uint32_t bound) {
+  return belowFrom(rngNext(streamState(stream)), bound);
+}
+
+int32_t rngRange(RngStream stream, int32_t min, int32_t max) {
+  if (max <= min) {
+    return min;
+  }
+  return min + static_cast<int32_t>(rngBelow(stream, static_cast<uint32_t>(max - min)));
+}
+
+float rngUnit(RngStream stream) {
+  return (rngNext(streamState(stream)) >> 8) * (1.0f / 16777216.0f);
+}
+
+RngState rngSnapshot(RngStream stream) {
+  return streamState(stream);
+}
+
+void rngRestore(RngStream stream, const RngState &state) {
+  streamState(stream) = state;
+}
+
+void rngFill(RngStream stream, uint32_t *out, size_t count) {
+  RngState state = streamState(stream);
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = rngNext(state);
+  }
+  streamState(stream) = state;
+}
+
+void rngFillBelow(RngStream stream, uint8_t *out, size_t count, uint8_t bound) {
+  RngState state = streamState(stream);
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = static_cast<uint8_t>(belowFrom(rngNext(state), bound));
+  }
+  streamState(stream) = state;
+}
+
+RngBenchResult rngRunBenchmark(uint32_t iterations) {
+  RngBenchResult result = {iterations, 0, 0, 0};
+  RngState saved = rngSnapshot(RngStream::RANDOM_GEN);
+  volatile uint32_t sink = 0;
+
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < iterations; ++i) {
+    sink += random(100);
+  }
+  result.arduinoUs = micros() - start;
+
+  start = micros();
+  for (uint32_t i = 0; i < iterations; ++i) {
+    sink += rngBelow(RngStream::RANDOM_GEN, 100);
+  }
+  result.serviceUs = micros() - start;
+
+  uint8_t batch[64];
+  start = micros();
+  for (uint32_t done = 0; done < iterations; done += sizeof(batch)) {
+    size_t count = iterations - done < sizeof(batch) ? iterations - done : sizeof(batch);
+    rngFillBelow(RngStream::RANDOM_GEN, batch, count, 100);
+    sink += batch[0];
+  }
+  result.batchUs = micros() - start;
+
+  // Benchmarks must not disturb the Random Generator's sequence
+  rngRestore(RngStream::RANDOM_GEN, saved);
+  (void)sink;
+  return result;
+}
+
+bool rngRunReproducibilityCheck() {
+  // First outputs of seed 12345 on stream 0, fixed so a change to the
+  // generator or seeding shows up here rather than as silently different patterns
+  static const uint32_t kExpected[4] = {0xC87BD7BBu, 0xAF3B4D05u, 0xF559AC65u, 0xB7FBCE77u};
+  RngState a;
+  RngState b;
+  seedState(a, 12345, 0);
+  seedState(b, 12345, 0);
+  bool ok = true;
+  for (uint32_t expected : kExpected) {
+    uint32_t va = rngNext(a);
+    ok = ok && va == expected && rngNext(b) == va;
+  }
+
+  // Batch fill, single draws and snapshot/restore must all agree on a module stream
+  RngState saved = rngSnapshot(RngStream::TB3PO);
+  rngSeed(RngStream::TB3PO, 4242);
+  RngState mark = rngSnapshot(RngStream::TB3PO);
+  uint8_t batch[32];
+  rngFillBelow(RngStream::TB3PO, batch, sizeof(batch), 100);
+  rngRestore(RngStream::TB3PO, mark);
+  for (uint8_t value : batch) {
+    ok = ok && rngBelow(RngStream::TB3PO, 100) == value;
+  }
+  rngSeed(RngStream::TB3PO, 4242);
+  ok = ok && rngBelow(RngStream::TB3PO, 100) == batch[0];
+  rngRestore(RngStream::TB3PO, saved);
+  return ok;
+}
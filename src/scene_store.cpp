@@ -0,0 +1,675 @@
+#include "scene_store.h"
+
+#include "clock_runtime.h"
+#include "clocked_module.h"
+#include "memory_pools.h"
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <string.h>
+
+namespace {
+static constexpr uint32_t kSceneMagic = SCENE_TAG('S', 'C', 'N', 'E');
+static constexpr uint16_t kSceneFormatVersion = 1;
+static constexpr size_t kHeaderBytes = 20;         // magic, format, sections, generation, payload, crc
+static constexpr size_t kHeaderCrcOffset = 16;
+static constexpr size_t kSectionHeaderBytes = 12;  // tag, version, reserved, length
+static constexpr uint8_t kMaxSections = 16;
+static constexpr const char *kSceneDir = "/scenes";
+
+static constexpr const char *kTaskName = "SceneWriter";
+static constexpr UBaseType_t kTaskPriority = 1;  // Below the UI loop; flash writes can wait
+static constexpr uint16_t kStackDepth = 4096;
+
+struct SectionEntry {
+  uint32_t tag;
+  uint16_t version;
+  const char *name;
+  size_t maxBytes;
+  const SceneSection *section;  // Either a section or a ClockedModule
+  ClockedModule *module;
+  const SceneHotSwap *hotSwap;
+
+  uint32_t bytes;
+  uint32_t saveUs;
+  uint32_t loadUs;
+  bool pending;
+  uint16_t pendingVersion;
+  uint32_t pendingOffset;  // Into stagedBlob
+  uint32_t pendingLength;
+  bool prepared;  // Shadow state ready; committed by the next switch
+};
+
+struct SaveJob {
+  uint8_t scene;
+  uint8_t *blob;
+  uint32_t size;
+};
+
+static SectionEntry sections[kMaxSections];
+static uint8_t sectionCount = 0;
+
+static QueueHandle_t saveQueue = nullptr;
+static volatile bool mounted = false;
+static volatile bool writing = false;  // Set by sceneSave, cleared by the writer task
+
+// Last loaded blob; only touched from the UI task
+static uint8_t *stagedBlob = nullptr;
+
+// Set while prepared sections wait for their bar; load and save refuse to run
+static volatile bool switchArmed = false;
+static uint32_t switchRequestUs = 0;
+
+static SceneStoreStats stats = {};
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t length) {
+  static const uint32_t kNibble[16] = {
+      0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu, 0x76DC4190u, 0x6B6B51F4u,
+      0x4DB26158u, 0x5005713Cu, 0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+      0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu};
+  crc = ~crc;
+  for (size_t i = 0; i < length; ++i) {
+    crc ^= data[i];
+    crc = (crc >> 4) ^ kNibble[crc & 0x0F];
+    crc = (crc >> 4) ^ kNibble[crc & 0x0F];
+  }
+  return ~crc;
+}
+
+static uint16_t get16(const uint8_t *p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static void put16(uint8_t *p, uint16_t value) {
+  p[0] = static_cast<uint8_t>(value);
+  p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+static void put32(uint8_t *p, uint32_t value) {
+  p[0] = static_cast<uint8_t>(value);
+  p[1] = static_cast<uint8_t>(value >> 8);
+  p[2] = static_cast<uint8_t>(value >> 16);
+  p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+// Blobs are transient, so they take PSRAM first like the long-lived pools
+static uint8_t *allocateScratch(size_t bytes) {
+  return static_cast<uint8_t *>(poolAllocatePreferPsram("scene blob", bytes));
+}
+
+static void scenePath(char *out, size_t size, uint8_t scene, uint8_t copy) {
+  snprintf(out, size, "%s/scene%u_%c.bin", kSceneDir, static_cast<unsigned>(scene),
+           copy == 0 ? 'a' : 'b');
+}
+
+static SectionEntry *findSection(uint32_t tag) {
+  for (uint8_t i = 0; i < sectionCount; ++i) {
+    if (sections[i].tag == tag) {
+      return &sections[i];
+    }
+  }
+  return nullptr;
+}
+
+static SectionEntry *addSection(uint32_t tag, const char *name) {
+  if (findSection(tag)) {
+    Serial.printf("[SCENE] Duplicate section %s ignored\n", name);
+    return nullptr;
+  }
+  if (sectionCount >= kMaxSections) {
+    Serial.printf("[SCENE] No room to register section %s\n", name);
+    return nullptr;
+  }
+  SectionEntry &entry = sections[sectionCount++];
+  memset(&entry, 0, sizeof(entry));
+  entry.tag = tag;
+  entry.name = name;
+  return &entry;
+}
+
+static bool validHeader(const uint8_t *header, size_t fileSize) {
+  return get32(header) == kSceneMagic && get16(header + 4) == kSceneFormatVersion &&
+         kHeaderBytes + get32(header + 12) == fileSize;
+}
+
+// Streams the file through the CRC without buffering it; true if the copy is intact
+static bool probeCopy(const char *path, uint32_t &generation, size_t &size) {
+  if (!LittleFS.exists(path)) {
+    return false;
+  }
+  File file = LittleFS.open(path, "r");
+  if (!file) {
+    return false;
+  }
+  uint8_t chunk[256];
+  size = file.size();
+  bool ok = size >= kHeaderBytes && file.read(chunk, kHeaderBytes) == kHeaderBytes &&
+            validHeader(chunk, size);
+  if (ok) {
+    generation = get32(chunk + 8);
+    uint32_t expected = get32(chunk + kHeaderCrcOffset);
+    uint32_t crc = crc32Update(0, chunk, kHeaderCrcOffset);
+    size_t left = size - kHeaderBytes;
+    while (ok && left > 0) {
+      size_t want = left < sizeof(chunk) ? left : sizeof(chunk);
+      ok = file.read(chunk, want) == want;
+      crc = crc32Update(crc, chunk, want);
+      left -= want;
+    }
+    ok = ok && crc == expected;
+  }
+  file.close();
+  return ok;
+}
+
+static SceneResult writeJob(const SaveJob &job) {
+  char paths[2][32];
+  bool valid[2];
+  uint32_t generations[2] = {0, 0};
+  for (uint8_t copy = 0; copy < 2; ++copy) {
+    size_t size = 0;
+    scenePath(paths[copy], sizeof(paths[copy]), job.scene, copy);
+    valid[copy] = probeCopy(paths[copy], generations[copy], size);
+  }
+
+  // Overwrite a damaged copy first, otherwise the older one
+  uint8_t target = 0;
+  if (valid[0] && (!valid[1] || generations[1] < generations[0])) {
+    target = 1;
+  }
+  uint32_t newest = valid[0] ? generations[0] : 0;
+  if (valid[1] && generations[1] > newest) {
+    newest = generations[1];
+  }
+  uint32_t generation = newest + 1;
+
+  put32(job.blob + 8, generation);
+  uint32_t crc = crc32Update(0, job.blob, kHeaderCrcOffset);
+  crc = crc32Update(crc, job.blob + kHeaderBytes, job.size - kHeaderBytes);
+  put32(job.blob + kHeaderCrcOffset, crc);
+
+  File file = LittleFS.open(paths[target], "w");
+  if (!file) {
+    return SceneResult::IO_ERROR;
+  }
+  size_t written = file.write(job.blob, job.size);
+  file.close();
+  if (written != job.size) {
+    return SceneResult::IO_ERROR;
+  }
+  stats.lastGeneration = generation;
+  return SceneResult::OK;
+}
+
+static void sceneWriterTask(void *) {
+  // Mounting here keeps a first-boot format off the boot path
+  if (!LittleFS.begin(true)) {
+    Serial.println("[SCENE] LittleFS mount failed; scenes disabled");
+    vTaskDelete(nullptr);
+    return;
+  }
+  if (!LittleFS.exists(kSceneDir)) {
+    LittleFS.mkdir(kSceneDir);
+  }
+  mounted = true;
+
+  SaveJob job;
+  for (;;) {
+    if (xQueueReceive(saveQueue, &job, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    uint32_t start = micros();
+    SceneResult result = writeJob(job);
+    stats.writeUs = micros() - start;
+    stats.lastWriteResult = result;
+    heap_caps_free(job.blob);
+    if (result != SceneResult::OK) {
+      Serial.printf("[SCENE] Writing scene %u failed: %s\n", static_cast<unsigned>(job.scene),
+                    sceneResultName(result));
+    }
+    writing = false;
+  }
+}
+
+static void releaseStaged() {
+  for (uint8_t i = 0; i < sectionCount; ++i) {
+    sections[i].pending = false;
+  }
+  if (stagedBlob) {
+    heap_caps_free(stagedBlob);
+    stagedBlob = nullptr;
+  }
+}
+
+// Frees the staged blob once nothing needs it; commits on the clock task leave that to here
+static void releaseStagedIfApplied() {
+  for (uint8_t i = 0; i < sectionCount; ++i) {
+    if (sections[i].pending) {
+      return;
+    }
+  }
+  releaseStaged();
+}
+
+// Bar action: installs every prepared section back to back
+static void commitSwitch(void *) {
+  uint32_t start = micros();
+  uint16_t noteOffs = 0;
+  for (uint8_t i = 0; i < sectionCount; ++i) {
+    SectionEntry &entry = sections[i];
+    if (entry.prepared) {
+      noteOffs = static_cast<uint16_t>(noteOffs + entry.hotSwap->commit());
+      entry.prepared = false;
+      entry.pending = false;
+    }
+  }
+  stats.switchCommitUs = micros() - start;
+  stats.switchWaitUs = start - switchRequestUs;
+  stats.switchNoteOffs = noteOffs;
+  switchArmed = false;
+}
+
+// Bar action cancel hook: the transport stopped before the bar, so the switch is
+// dropped. The staged blob is freed by the next load or save on the UI task.
+static void cancelSwitch(void *) {
+  for (uint8_t i = 0; i < sectionCount; ++i) {
+    SectionEntry &entry = sections[i];
+    if (entry.prepared) {
+      entry.prepared = false;
+      entry.pending = false;  // Never carried into a save as if it were live
+    }
+  }
+  ++stats.switchesCancelled;
+  switchArmed = false;
+}
+
+// Serialises one live section into dest; returns bytes written, or -1 on overflow
+static int32_t saveSection(const SectionEntry &entry, uint8_t *dest, size_t capacity) {
+  if (entry.module) {
+    size_t outSize = 0;
+    entry.module->serialize(dest, capacity, outSize);
+    return outSize <= capacity ? static_cast<int32_t>(outSize) : -1;
+  }
+  SceneWriter out(dest, capacity);
+  entry.section->save(out);
+  return out.ok() ? static_cast<int32_t>(out.size()) : -1;
+}
+
+static bool loadSection(const SectionEntry &entry, const uint8_t *data, size_t length,
+                        uint16_t version) {
+  if (entry.module) {
+    return version == entry.version && entry.module->deserialize(data, length);
+  }
+  SceneReader in(data, length);
+  return entry.section->load(in, version) && in.ok();
+}
+}  // namespace
+
+void SceneWriter::u8(uint8_t value) {
+  bytes(&value, 1);
+}
+
+void SceneWriter::u16(uint16_t value) {
+  uint8_t raw[2];
+  put16(raw, value);
+  bytes(raw, sizeof(raw));
+}
+
+void SceneWriter::u32(uint32_t value) {
+  uint8_t raw[4];
+  put32(raw, value);
+  bytes(raw, sizeof(raw));
+}
+
+void SceneWriter::bytes(const void *data, size_t length) {
+  if (buffer_) {
+    if (size_ + length <= capacity_) {
+      memcpy(buffer_ + size_, data, length);
+    } else {
+      overflow_ = true;
+    }
+  }
+  size_ += length;  // Keeps counting past an overflow so size() reports what was needed
+}
+
+uint8_t SceneReader::u8() {
+  uint8_t value = 0;
+  bytes(&value, 1);
+  return value;
+}
+
+uint16_t SceneReader::u16() {
+  uint8_t raw[2] = {0, 0};
+  bytes(raw, sizeof(raw));
+  return get16(raw);
+}
+
+uint32_t SceneReader::u32() {
+  uint8_t raw[4] = {0, 0, 0, 0};
+  bytes(raw, sizeof(raw));
+  return get32(raw);
+}
+
+bool SceneReader::bytes(void *out, size_t length) {
+  if (length > remaining()) {
+    underflow_ = true;
+    offset_ = size_;
+    return false;
+  }
+  memcpy(out, data_ + offset_, length);
+  offset_ += length;
+  return true;
+}
+
+const char *sceneResultName(SceneResult result) {
+  switch (result) {
+    case SceneResult::OK:           return "ok";
+    case SceneResult::BUSY:         return "busy";
+    case SceneResult::NOT_READY:    return "not ready";
+    case SceneResult::NO_MEMORY:    return "no memory";
+    case SceneResult::NOT_FOUND:    return "not found";
+    case SceneResult::CORRUPT:      return "corrupt";
+    case SceneResult::IO_ERROR:     return "io error";
+    default:                        return "bad argument";
+  }
+}
+
+void sceneRegisterSection(const SceneSection *section) {
+  SectionEntry *entry = addSection(section->tag, section->name);
+  if (entry) {
+    entry->version = section->version;
+    entry->maxBytes = section->maxBytes;
+    entry->section = section;
+    entry->hotSwap = section->hotSwap;
+  }
+}
+
+void sceneRegisterClockedModule(uint32_t tag, const char *name, ClockedModule *module,
+                                size_t maxBytes, const SceneHotSwap *hotSwap) {
+  SectionEntry *entry = addSection(tag, name);
+  if (entry) {
+    entry->version = 1;  // The module versions its own payload
+    entry->maxBytes = maxBytes;
+    entry->module = module;
+    entry->hotSwap = hotSwap;
+  }
+}
+
+void initSceneStore() {
+  if (saveQueue) {
+    return;
+  }
+  saveQueue = xQueueCreate(1, sizeof(SaveJob));
+  if (!saveQueue) {
+    Serial.println("[SCENE] Failed to create save queue");
+    return;
+  }
+  stats.lastScene = 0xFF;
+  stats.switchScene = 0xFF;
+  BaseType_t result = xTaskCreatePinnedToCore(sceneWriterTask, kTaskName, kStackDepth, nullptr,
+                                              kTaskPriority, nullptr, 0);
+  if (result != pdPASS) {
+    Serial.println("[SCENE] Failed to create writer task");
+  }
+}
+
+SceneResult sceneSave(uint8_t scene) {
+  if (scene >= kSceneCount) {
+    return SceneResult::BAD_ARGUMENT;
+  }
+  if (!mounted) {
+    return SceneResult::NOT_READY;
+  }
+  if (writing || switchArmed) {
+    return SceneResult::BUSY;
+  }
+  releaseStagedIfApplied();
+
+  uint32_t start = micros();
+  size_t capacity = kHeaderBytes;
+  for (uint8_t i = 0; i < sectionCount; ++i) {
+    const SectionEntry &entry = sections[i];
+    capacity += kSectionHeaderBytes + (entry.pending ? entry.pendingLength : entry.maxBytes);
+  }
+  uint8_t *blob = allocateScratch(capacity);
+  if (!blob) {
+    return SceneResult::NO_MEMORY;
+  }
+
+  size_t offset = kHeaderBytes;
+  uint16_t written = 0;
+  for (uint8_t i = 0; i < sectionCount; ++i) {
+    SectionEntry &entry = sections[i];
+    uint8_t *header = blob + offset;
+    uint8_t *data = header + kSectionHeaderBytes;
+    uint16_t version = entry.version;
+    int32_t length;
+    uint32_t sectionStart = micros();
+    if (entry.pending) {
+      // Never opened since the last load: carry its staged bytes over unchanged
+      memcpy(data, stagedBlob + entry.pendingOffset, entry.pendingLength);
+      version = entry.pendingVersion;
+      length = static_cast<int32_t>(entry.pendingLength);
+    } else {
+      length = saveSection(entry, data, entry.maxBytes);
+    }
+    entry.saveUs = micros() - sectionStart;
+    if (length < 0) {
+      Serial.printf("[SCENE] %s exceeds %u bytes; section skipped\n", entry.name,
+                    static_cast<unsigned>(entry.maxBytes));
+      continue;
+    }
+    put32(header, entry.tag);
+    put16(header + 4, version);
+    put16(header + 6, 0);
+    put32(header + 8, static_cast<uint32_t>(length));
+    entry.bytes = static_cast<uint32_t>(length);
+    offset += kSectionHeaderBytes + static_cast<size_t>(length);
+    ++written;
+  }
+
+  // Generation and CRC are filled in by the writer once it has picked a copy
+  put32(blob, kSceneMagic);
+  put16(blob + 4, kSceneFormatVersion);
+  put16(blob + 6, written);
+  put32(blob + 8, 0);
+  put32(blob + 12, static_cast<uint32_t>(offset - kHeaderBytes));
+  put32(blob + kHeaderCrcOffset, 0);
+
+  SaveJob job = {scene, blob, static_cast<uint32_t>(offset)};
+  writing = true;
+  if (xQueueSend(saveQueue, &job, 0) != pdTRUE) {
+    writing = false;
+    heap_caps_free(blob);
+    return SceneResult::BUSY;
+  }
+  stats.lastScene = scene;
+  stats.blobBytes = job.size;
+  stats.snapshotUs = micros() - start;
+  return SceneResult::OK;
+}
+
+SceneResult sceneLoad(uint8_t scene) {
+  if (scene >= kSceneCount) {
+    return SceneResult::BAD_ARGUMENT;
+  }
+  if (!mounted) {
+    return SceneResult::NOT_READY;
+  }
+  if (writing || switchArmed) {
+    return SceneResult::BUSY;  // The file being written may be the one we would read
+  }
+
+  uint32_t start = micros();
+  char path[32];
+  char newestPath[32] = "";
+  uint32_t newestGeneration = 0;
+  size_t newestSize = 0;
+  bool anyExists = false;
+  for (uint8_t copy = 0; copy < 2; ++copy) {
+    uint32_t generation = 0;
+    size_t size = 0;
+    scenePath(path, sizeof(path), scene, copy);
+    anyExists = anyExists || LittleFS.exists(path);
+    if (probeCopy(path, generation, size) &&
+        (newestPath[0] == '\0' || generation > newestGeneration)) {
+      strcpy(newestPath, path);
+      newestGeneration = generation;
+      newestSize = size;
+    }
+  }
+  if (newestPath[0] == '\0') {
+    return anyExists ? SceneResult::CORRUPT : SceneResult::NOT_FOUND;
+  }
+
+  uint8_t *blob = allocateScratch(newestSize);
+  if (!blob) {
+    return SceneResult::NO_MEMORY;
+  }
+  File file = LittleFS.open(newestPath, "r");
+  bool ok = file && file.read(blob, newestSize) == newestSize;
+  if (file) {
+    file.close();
+  }
+  // Re-check what was actually read, then walk the section table
+  ok = ok && validHeader(blob, newestSize) &&
+       crc32Update(crc32Update(0, blob, kHeaderCrcOffset), blob + kHeaderBytes,
+                   newestSize - kHeaderBytes) == get32(blob + kHeaderCrcOffset);
+  if (!ok) {
+    heap_caps_free(blob);
+    return SceneResult::CORRUPT;
+  }
+
+  releaseStaged();
+  stagedBlob = blob;
+  uint16_t count = get16(blob + 6);
+  size_t offset = kHeaderBytes;
+  for (uint16_t i = 0; i < count; ++i) {
+    if (offset + kSectionHeaderBytes > newestSize) {
+      break;
+    }
+    const uint8_t *header = blob + offset;
+    uint32_t tag = get32(header);
+    uint32_t length = get32(header + 8);
+    size_t dataOffset = offset + kSectionHeaderBytes;
+    if (length > newestSize - dataOffset) {
+      break;
+    }
+    SectionEntry *entry = findSection(tag);
+    if (entry) {
+      entry->pending = true;
+      entry->pendingVersion = get16(header + 4);
+      entry->pendingOffset = static_cast<uint32_t>(dataOffset);
+      entry->pendingLength = length;
+      entry->bytes = length;
+    } else {
+      Serial.printf("[SCENE] Scene %u: unknown section %08lX skipped\n",
+                    static_cast<unsigned>(scene), static_cast<unsigned long>(tag));
+    }
+    offset = dataOffset + length;
+  }
+
+  stats.lastScene = scene;
+  stats.lastGeneration = newestGeneration;
+  stats.blobBytes = static_cast<uint32_t>(newestSize);
+  stats.readUs = micros() - start;
+  return SceneResult::OK;
+}
+
+void sceneApplyPending(uint32_t tag) {
+  SectionEntry *entry = findSection(tag);
+  if (!entry || !entry->pending || entry->prepared || !stagedBlob) {
+    return;  // Prepared sections belong to the armed switch
+  }
+  uint32_t start = micros();
+  bool ok = loadSection(*entry, stagedBlob + entry->pendingOffset, entry->pendingLength,
+                        entry->pendingVersion);
+  entry->loadUs = micros() - start;
+  entry->pending = false;
+  if (!ok) {
+    Serial.printf("[SCENE] %s: section v%u rejected, keeping defaults\n", entry->name,
+                  static_cast<unsigned>(entry->pendingVersion));
+  }
+
+  releaseStagedIfApplied();
+}
+
+SceneResult sceneScheduleSwitch(uint8_t scene) {
+  if (switchArmed) {
+    return SceneResult::BUSY;
+  }
+  uint32_t start = micros();
+  SceneResult result = sceneLoad(scene);
+  if (result != SceneResult::OK) {
+    return result;
+  }
+
+  bool any = false;
+  for (uint8_t i = 0; i < sectionCount; ++i) {
+    SectionEntry &entry = sections[i];
+    if (!entry.pending || !entry.hotSwap) {
+      continue;
+    }
+    SceneReader in(stagedBlob + entry.pendingOffset, entry.pendingLength);
+    if (entry.hotSwap->prepare(in, entry.pendingVersion) && in.ok()) {
+      entry.prepared = true;
+      any = true;
+    } else {
+      entry.pending = false;
+      Serial.printf("[SCENE] %s: section v%u rejected, keeping current state\n", entry.name,
+                    static_cast<unsigned>(entry.pendingVersion));
+    }
+  }
+  stats.switchScene = scene;
+  stats.switchPrepareUs = micros() - start;
+  if (!any) {
+    return SceneResult::OK;
+  }
+
+  switchRequestUs = micros();
+  switchArmed = true;
+  if (clockRuntime.requestBarAction(commitSwitch, nullptr, cancelSwitch)) {
+    return SceneResult::OK;
+  }
+  if (clockRuntime.isStopped()) {
+    commitSwitch(nullptr);  // Nothing is playing, so there is no bar to wait for
+  } else {
+    // Another bar action is queued; the sections stay staged for their next open
+    for (uint8_t i = 0; i < sectionCount; ++i) {
+      sections[i].prepared = false;
+    }
+    switchArmed = false;
+    return SceneResult::BUSY;
+  }
+  return SceneResult::OK;
+}
+
+bool sceneSwitchPending() {
+  return switchArmed;
+}
+
+SceneStoreStats sceneGetStats() {
+  SceneStoreStats result = stats;
+  result.mounted = mounted;
+  result.writing = writing;
+  result.sectionCount = sectionCount;
+  return result;
+}
+
+bool sceneGetSectionStats(uint8_t index, SceneSectionStats &out) {
+  if (index >= sectionCount) {
+    return false;
+  }
+  const SectionEntry &entry = sections[index];
+  out = {entry.name, entry.tag, entry.bytes, entry.saveUs, entry.loadUs, entry.pending};
+  return true;
+}
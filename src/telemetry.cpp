@@ -0,0 +1,332 @@
+#include "telemetry.h"
+
+#include "hardware_midi.h"
+#include "memory_pools.h"
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <new>
+#include <string.h>
+
+namespace {
+static constexpr const char *kTaskName = "Telemetry";
+static constexpr uint16_t kStackDepth = 3072;
+static constexpr UBaseType_t kTaskPriority = 1;  // Above idle only: output waits for everything else
+static constexpr size_t kBatchEvents = 32;
+static constexpr TickType_t kIdleWait = pdMS_TO_TICKS(10);
+static constexpr uint32_t kQueueMask = kTelemetryQueueSize - 1;
+
+static_assert((kTelemetryQueueSize & kQueueMask) == 0, "kTelemetryQueueSize must be a power of two");
+
+static TelemetryQueue queue;
+static std::atomic<bool> enabled{false};
+static std::atomic<uint32_t> emittedCount{0};
+static std::atomic<uint32_t> droppedCount{0};
+static uint32_t frameCount = 0;    // Sender task only
+static uint32_t byteCount = 0;
+static uint16_t maxDepth = 0;
+static TaskHandle_t senderTask = nullptr;
+
+static void putLe16(uint8_t *out, uint16_t value) {
+  out[0] = static_cast<uint8_t>(value);
+  out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+static void putLe32(uint8_t *out, uint32_t value) {
+  for (uint8_t i = 0; i < 4; ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+static uint32_t getLe32(const uint8_t *in) {
+  return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+         (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+static uint8_t checksum(const uint8_t *data, size_t length) {
+  uint8_t sum = 0;
+  for (size_t i = 0; i < length; ++i) {
+    sum = static_cast<uint8_t>(sum + data[i]);
+  }
+  return static_cast<uint8_t>(0xFF - sum);
+}
+
+// Sends only what the TX buffer takes without blocking, so the UART lock is
+// never held while the clock task waits to print
+static void senderLoop() {
+  uint8_t buffer[kBatchEvents * kTelemetryMaxFrameBytes];
+  uint32_t lastSyncMs = millis();
+  for (;;) {
+    uint32_t now = millis();
+    if (now - lastSyncMs >= kTelemetrySyncIntervalMs) {
+      lastSyncMs = now;
+      telemetryEmit(TelemetryEventId::SYNC, 0, kTelemetryProtocolVersion, droppedCount.load());
+    }
+
+    size_t depth = queue.depth();
+    if (depth > maxDepth) {
+      maxDepth = static_cast<uint16_t>(depth);
+    }
+    size_t room = static_cast<size_t>(Serial.availableForWrite()) / kTelemetryMaxFrameBytes;
+    size_t budget = room < kBatchEvents ? room : kBatchEvents;
+    size_t length = 0;
+    size_t frames = 0;
+    TelemetryEvent event;
+    while (frames < budget && queue.pop(event)) {
+      length += telemetryEncodeFrame(event, buffer + length);
+      ++frames;
+    }
+    if (frames == 0) {
+      vTaskDelay(kIdleWait);
+      continue;
+    }
+    if (enabled.load(std::memory_order_relaxed)) {
+      Serial.write(buffer, length);  // One call: the frames stay together
+      frameCount += frames;
+      byteCount += length;
+    }
+  }
+}
+
+static void senderTaskEntry(void *parameter) {
+  (void)parameter;
+  senderLoop();
+}
+}  // namespace
+
+TelemetryQueue::TelemetryQueue() {
+  for (uint32_t i = 0; i < kTelemetryQueueSize; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool TelemetryQueue::push(const TelemetryEvent &event) {
+  uint32_t pos = enqueuePos_.load(std::memory_order_relaxed);
+  Cell *cell;
+  for (;;) {
+    cell = &cells_[pos & kQueueMask];
+    uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+    int32_t diff = static_cast<int32_t>(sequence - pos);
+    if (diff == 0) {
+      if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false;  // Full: the consumer has not freed this cell yet
+    } else {
+      pos = enqueuePos_.load(std::memory_order_relaxed);
+    }
+  }
+  cell->event = event;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool TelemetryQueue::pop(TelemetryEvent &event) {
+  Cell &cell = cells_[dequeuePos_ & kQueueMask];
+  uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+  if (static_cast<int32_t>(sequence - (dequeuePos_ + 1)) < 0) {
+    return false;  // Empty, or the producer that claimed it is still writing
+  }
+  event = cell.event;
+  cell.sequence.store(dequeuePos_ + kTelemetryQueueSize, std::memory_order_release);
+  ++dequeuePos_;
+  return true;
+}
+
+size_t TelemetryQueue::depth() const {
+  return enqueuePos_.load(std::memory_order_relaxed) - dequeuePos_;
+}
+
+size_t cobsEncode(const uint8_t *data, size_t length, uint8_t *out) {
+  size_t write = 1;
+  size_t codeIndex = 0;
+  uint8_t code = 1;
+  for (size_t read = 0; read < length; ++read) {
+    if (data[read] == 0) {
+      out[codeIndex] = code;
+      code = 1;
+      codeIndex = write++;
+    } else {
+      out[write++] = data[read];
+      if (++code == 0xFF) {
+        out[codeIndex] = code;
+        code = 1;
+        codeIndex = write++;
+      }
+    }
+  }
+  out[codeIndex] = code;
+  return write;
+}
+
+size_t cobsDecode(const uint8_t *data, size_t length, uint8_t *out) {
+  size_t read = 0;
+  size_t write = 0;
+  while (read < length) {
+    uint8_t code = data[read];
+    if (code == 0 || read + code > length) {
+      return 0;
+    }
+    ++read;
+    for (uint8_t i = 1; i < code; ++i) {
+      out[write++] = data[read++];
+    }
+    if (code != 0xFF && read != length) {
+      out[write++] = 0;
+    }
+  }
+  return write;
+}
+
+size_t telemetryEncodeFrame(const TelemetryEvent &event, uint8_t *out) {
+  uint8_t payload[kTelemetryPayloadBytes];
+  payload[0] = static_cast<uint8_t>(event.id);
+  payload[1] = event.arg8;
+  putLe16(payload + 2, event.arg16);
+  putLe32(payload + 4, event.timestampUs);
+  putLe32(payload + 8, event.value);
+  payload[12] = checksum(payload, 12);
+
+  out[0] = 0;
+  size_t length = cobsEncode(payload, kTelemetryPayloadBytes, out + 1);
+  out[length + 1] = 0;
+  return length + 2;
+}
+
+bool telemetryDecodePayload(const uint8_t *payload, size_t length, TelemetryEvent &event) {
+  if (length != kTelemetryPayloadBytes || checksum(payload, 12) != payload[12] ||
+      payload[0] >= static_cast<uint8_t>(TelemetryEventId::COUNT)) {
+    return false;
+  }
+  event.id = static_cast<TelemetryEventId>(payload[0]);
+  event.arg8 = payload[1];
+  event.arg16 = static_cast<uint16_t>(payload[2] | (payload[3] << 8));
+  event.timestampUs = getLe32(payload + 4);
+  event.value = getLe32(payload + 8);
+  return true;
+}
+
+void initTelemetry() {
+#if DEBUG_ENABLED
+  if (senderTask != nullptr) {
+    return;
+  }
+  poolNoteStatic("telemetry queue", sizeof(queue));
+  BaseType_t result = xTaskCreatePinnedToCore(senderTaskEntry, kTaskName, kStackDepth, nullptr, kTaskPriority,
+                                              &senderTask, 0);
+  if (result != pdPASS) {
+    senderTask = nullptr;
+    Serial.println("[Telemetry] Failed to create sender task");
+  }
+#endif
+}
+
+void telemetryEmit(TelemetryEventId id, uint8_t arg8, uint16_t arg16, uint32_t value, uint32_t timestampUs) {
+  if (!enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  TelemetryEvent event;
+  event.timestampUs = timestampUs;
+  event.value = value;
+  event.arg16 = arg16;
+  event.id = id;
+  event.arg8 = arg8;
+  if (queue.push(event)) {
+    emittedCount.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void telemetryEmit(TelemetryEventId id, uint8_t arg8, uint16_t arg16, uint32_t value) {
+  if (enabled.load(std::memory_order_relaxed)) {
+    telemetryEmit(id, arg8, arg16, value, micros());
+  }
+}
+
+void telemetrySetEnabled(bool enable) {
+  // Without the sender task nothing would drain the queue; Serial may be MIDI
+  enabled.store(enable && senderTask != nullptr);
+}
+
+bool telemetryEnabled() {
+  return enabled.load();
+}
+
+TelemetryStats telemetryGetStats() {
+  TelemetryStats stats;
+  stats.emitted = emittedCount.load();
+  stats.dropped = droppedCount.load();
+  stats.frames = frameCount;
+  stats.bytes = byteCount;
+  stats.maxDepth = maxDepth;
+  stats.enabled = enabled.load();
+  return stats;
+}
+
+void telemetryResetStats() {
+  emittedCount.store(0);
+  droppedCount.store(0);
+  frameCount = 0;
+  byteCount = 0;
+  maxDepth = 0;
+}
+
+uint32_t telemetrySelfTest(uint32_t events) {
+  // Heap, not the UI loop's stack: about 7 KB
+  struct SelfTest {
+    TelemetryQueue queue;
+    TelemetryEvent sent[kTelemetryQueueSize];
+  };
+  SelfTest *test = new (std::nothrow) SelfTest();
+  if (test == nullptr) {
+    return events;
+  }
+  TelemetryQueue *testQueue = &test->queue;
+  TelemetryEvent *sent = test->sent;
+  uint32_t failures = 0;
+  uint32_t done = 0;
+  while (done < events) {
+    // Fill the queue past capacity: exactly kTelemetryQueueSize must fit
+    size_t batch = 0;
+    for (size_t i = 0; i <= kTelemetryQueueSize; ++i) {
+      TelemetryEvent event;
+      event.timestampUs = esp_random();
+      event.value = (i & 3) == 0 ? 0 : esp_random();  // Zero bytes exercise COBS
+      event.arg16 = static_cast<uint16_t>(esp_random());
+      event.id = static_cast<TelemetryEventId>(esp_random() % static_cast<uint32_t>(TelemetryEventId::COUNT));
+      event.arg8 = static_cast<uint8_t>(i);
+      bool pushed = testQueue->push(event);
+      if (pushed != (i < kTelemetryQueueSize)) {
+        failures++;
+      }
+      if (pushed) {
+        sent[batch++] = event;
+      }
+    }
+    for (size_t i = 0; i < batch && done < events; ++i, ++done) {
+      TelemetryEvent popped;
+      uint8_t frame[kTelemetryMaxFrameBytes];
+      uint8_t payload[kTelemetryMaxFrameBytes];
+      TelemetryEvent decoded;
+      if (!testQueue->pop(popped)) {
+        failures++;
+        continue;
+      }
+      size_t length = telemetryEncodeFrame(popped, frame);
+      bool framed = frame[0] == 0 && frame[length - 1] == 0 && memchr(frame + 1, 0, length - 2) == nullptr;
+      size_t payloadLength = cobsDecode(frame + 1, length - 2, payload);
+      if (!framed || !telemetryDecodePayload(payload, payloadLength, decoded) ||
+          decoded.timestampUs != sent[i].timestampUs || decoded.value != sent[i].value ||
+          decoded.arg16 != sent[i].arg16 || decoded.id != sent[i].id || decoded.arg8 != sent[i].arg8) {
+        failures++;
+      }
+    }
+    while (testQueue->pop(*sent)) {
+    }
+  }
+  delete test;
+  return failures;
+}